@@ -0,0 +1,353 @@
+/**
+ * @file autotuner_check_main.cpp
+ * @author WFZ
+ * @brief Class_PID_Autotuner的主机检查: 解析已知的一阶惯性加纯滞后对象上核对临界增益与周期, 再在C610电机模型上整定拨弹电机速度环
+ * @version 0.0
+ * @date 2026-2-4
+ *
+ * @note 编译(在仓库根目录, 主机g++):
+ *       g++ -std=c++11 -O2 -ISimulation/Stub -ISimulation/Motor -IUser/1_Middleware/1_Driver/CAN -IUser/1_Middleware/1_Driver/DWT
+ *           -IUser/1_Middleware/1_Driver/Math -IUser/1_Middleware/2_Algorithm/PID -IUser/1_Middleware/2_Algorithm/Waveform
+ *           -IUser/1_Middleware/2_Algorithm/Autotuner -IUser/2_Device/Motor
+ *           -x c++ User/1_Middleware/1_Driver/CAN/drv_can.c -x none
+ *           User/1_Middleware/1_Driver/Math/drv_math.cpp User/1_Middleware/1_Driver/DWT/drv_dwt.cpp
+ *           User/1_Middleware/2_Algorithm/PID/alg_pid.cpp User/1_Middleware/2_Algorithm/Waveform/alg_waveform.cpp
+ *           User/1_Middleware/2_Algorithm/Autotuner/alg_autotuner.cpp
+ *           User/2_Device/Motor/dvc_motor.cpp Simulation/Stub/sim_hal.cpp
+ *           Simulation/Motor/sim_motor.cpp Simulation/Autotuner/autotuner_check_main.cpp -o autotuner_check
+ *
+ *       运行: ./autotuner_check, 逐项输出整定结果与闭环阶跃指标, 全部通过时返回0
+ *
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "alg_autotuner.h"
+#include "dvc_motor.h"
+#include "sim_motor.h"
+
+/* Private macros ------------------------------------------------------------*/
+
+// 控制周期, s
+#define AUTOTUNER_CHECK_DT 0.001f
+// 纯滞后缓冲区长度, 控制周期数
+#define AUTOTUNER_CHECK_DELAY_MAX 256
+// 每个控制周期内电机物理模型的细分步数
+#define AUTOTUNER_CHECK_SUB_STEP_NUM 10
+
+/* Private types -------------------------------------------------------------*/
+
+/**
+ * @brief 一阶惯性加纯滞后对象 K·e^(-θs)/(τs+1), 按控制周期离散
+ *
+ */
+struct Struct_FOPDT_Plant
+{
+    float K;
+    float Tau;
+    float Theta;
+    float Y;
+    float Delay[AUTOTUNER_CHECK_DELAY_MAX];
+    uint16_t Delay_Num;
+    uint16_t Delay_Index;
+
+    void Init(float __K, float __Tau, float __Theta)
+    {
+        K = __K;
+        Tau = __Tau;
+        Theta = __Theta;
+        Y = 0.0f;
+        memset(Delay, 0, sizeof(Delay));
+        Delay_Num = (uint16_t) (Theta / AUTOTUNER_CHECK_DT + 0.5f);
+        Delay_Index = 0;
+    }
+
+    float Step(float U)
+    {
+        // 零阶保持下的精确离散
+        float u = U;
+        if (Delay_Num > 0)
+        {
+            u = Delay[Delay_Index];
+            Delay[Delay_Index] = U;
+            Delay_Index = (Delay_Index + 1) % Delay_Num;
+        }
+        float a = expf(-AUTOTUNER_CHECK_DT / Tau);
+        Y = a * Y + (1.0f - a) * K * u;
+        return (Y);
+    }
+};
+
+/**
+ * @brief 一次闭环阶跃的指标
+ *
+ */
+struct Struct_Autotuner_Check_Step
+{
+    // 超调量, %
+    float Overshoot;
+    // 进入并保持在2%误差带内的时间, s, 仿真结束时仍在误差带外为-1
+    float Settling_Time;
+};
+
+/* Private variables ---------------------------------------------------------*/
+
+bool init_finished = false;
+
+static uint32_t Fail_Num = 0;
+
+static const char *Rule_Name[PID_Autotuner_Rule_NUM] = {"zn_pi", "zn_pid", "tl_pi", "tl_pid", "simc_pi"};
+
+/* Private function declarations ---------------------------------------------*/
+
+/* Function prototypes -------------------------------------------------------*/
+
+/**
+ * @brief 记录一项检查
+ *
+ * @param Pass 是否通过
+ * @param Name 检查项名称
+ */
+static void Check(bool Pass, const char *Name)
+{
+    if (!Pass)
+    {
+        Fail_Num++;
+        printf("FAIL %s\n", Name);
+    }
+}
+
+/**
+ * @brief 一阶惯性加纯滞后对象的理论临界点, 相位 θω + atan(τω) = π
+ *
+ * 反馈晚一个周期进入继电, 零阶保持再滞后半个周期, 计入纯滞后
+ *
+ * @param Plant 对象
+ * @param Ultimate_Gain 临界增益
+ * @param Ultimate_Period 临界周期, s
+ */
+static void FOPDT_Ultimate(const Struct_FOPDT_Plant &Plant, float *Ultimate_Gain, float *Ultimate_Period)
+{
+    double theta = Plant.Theta + 1.5 * AUTOTUNER_CHECK_DT;
+    double low = 0.0, high = M_PI / theta;
+    for (int i = 0; i < 60; i++)
+    {
+        double omega = (low + high) / 2.0;
+        if (theta * omega + atan(Plant.Tau * omega) < M_PI)
+        {
+            low = omega;
+        }
+        else
+        {
+            high = omega;
+        }
+    }
+    *Ultimate_Gain = (float) (sqrt(1.0 + Plant.Tau * low * Plant.Tau * low) / Plant.K);
+    *Ultimate_Period = (float) (2.0 * M_PI / low);
+}
+
+/**
+ * @brief 在一阶惯性加纯滞后对象上整定, 再以各规则闭环阶跃
+ *
+ * @param K 静态增益
+ * @param Tau 时间常数, s
+ * @param Theta 纯滞后, s
+ */
+static void Check_FOPDT(float K, float Tau, float Theta)
+{
+    Struct_FOPDT_Plant plant;
+    Class_PID_Autotuner autotuner;
+    char name[64];
+
+    plant.Init(K, Tau, Theta);
+    float ultimate_gain, ultimate_period;
+    FOPDT_Ultimate(plant, &ultimate_gain, &ultimate_period);
+
+    // 无滞环时继电振荡点即相位穿越点, 目标偏离初值以估计静态增益
+    float target = 1.0f;
+    autotuner.Init(2.0f / K, 0.0f, AUTOTUNER_CHECK_DT, 60.0f);
+    autotuner.Start(target, 0.0f, 0.0f);
+    float y = 0.0f;
+    while (autotuner.Get_Status() == PID_Autotuner_Status_RUNNING)
+    {
+        autotuner.TIM_Calculate_PeriodElapsedCallback(y);
+        y = plant.Step(autotuner.Get_Out());
+    }
+
+    printf("fopdt K=%g tau=%g theta=%g: Ku %.3f (%.3f) Tu %.4f (%.4f) K %.3f tau %.4f theta %.4f, %u cycles in %.2f s\n",
+           K, Tau, Theta, autotuner.Get_Ultimate_Gain(), ultimate_gain, autotuner.Get_Ultimate_Period(), ultimate_period,
+           autotuner.Get_Static_Gain(), autotuner.Get_Time_Constant(), autotuner.Get_Dead_Time(), autotuner.Get_Cycle_Num(), autotuner.Get_Time());
+
+    snprintf(name, sizeof(name), "fopdt %g/%g/%g status", K, Tau, Theta);
+    Check(autotuner.Get_Status() == PID_Autotuner_Status_SUCCESS, name);
+    // 描述函数只计基波, 纯滞后占比小时继电振荡远非正弦, 与理论值的偏差放宽到20%
+    snprintf(name, sizeof(name), "fopdt %g/%g/%g Ku", K, Tau, Theta);
+    Check(fabsf(autotuner.Get_Ultimate_Gain() / ultimate_gain - 1.0f) < 0.2f, name);
+    snprintf(name, sizeof(name), "fopdt %g/%g/%g Tu", K, Tau, Theta);
+    Check(fabsf(autotuner.Get_Ultimate_Period() / ultimate_period - 1.0f) < 0.2f, name);
+    snprintf(name, sizeof(name), "fopdt %g/%g/%g K", K, Tau, Theta);
+    Check(fabsf(autotuner.Get_Static_Gain() / K - 1.0f) < 0.1f, name);
+
+    for (int rule = 0; rule < PID_Autotuner_Rule_NUM; rule++)
+    {
+        Class_PID pid;
+        pid.Init(0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, AUTOTUNER_CHECK_DT);
+        autotuner.Apply(&pid, (Enum_PID_Autotuner_Rule) rule);
+
+        plant.Init(K, Tau, Theta);
+        y = 0.0f;
+        float peak = 0.0f, last_outside = 0.0f, time = 50.0f * (Tau + Theta);
+        uint32_t tick_num = (uint32_t) (time / AUTOTUNER_CHECK_DT);
+        for (uint32_t tick = 0; tick < tick_num; tick++)
+        {
+            pid.Set_Target(target);
+            pid.Set_Now(y);
+            pid.TIM_Adjust_PeriodElapsedCallback();
+            y = plant.Step(pid.Get_Out());
+            peak = fmaxf(peak, y);
+            if (fabsf(y - target) > 0.02f * target)
+            {
+                last_outside = (tick + 1) * AUTOTUNER_CHECK_DT;
+            }
+        }
+        float overshoot = (peak / target - 1.0f) * 100.0f;
+        printf("    %-8s overshoot %6.2f%% settle %.3f s\n", Rule_Name[rule], overshoot, last_outside);
+
+        // 各规则均须在最后10%时间内稳定在误差带内, T-L偏保守, 纯滞后占比大时调节较慢; Z-N以外的规则超调应较小
+        snprintf(name, sizeof(name), "fopdt %g/%g/%g %s settle", K, Tau, Theta, Rule_Name[rule]);
+        Check(last_outside < time * 0.9f, name);
+        if (rule != PID_Autotuner_Rule_ZIEGLER_NICHOLS_PI && rule != PID_Autotuner_Rule_ZIEGLER_NICHOLS_PID)
+        {
+            snprintf(name, sizeof(name), "fopdt %g/%g/%g %s overshoot", K, Tau, Theta, Rule_Name[rule]);
+            Check(overshoot < 30.0f, name);
+        }
+    }
+}
+
+/**
+ * @brief 推进一个控制周期, 与sim_motor_main的CAN收发顺序一致
+ *
+ * @param Motor 固件电机
+ * @param Plant 仿真电机
+ */
+static void Motor_Tick(Class_Motor_C610 &Motor, Class_Sim_Motor &Plant)
+{
+    Sim_Motor_Send_Feedback_All();
+    CAN_Rx_Dispatch(&hcan1);
+    Motor.TIM_Calculate_PeriodElapsedCallback();
+    CAN_Send_Data(&hcan1, Plant.Get_Control_ID(), CAN1_0x200_Tx_Data, 8);
+    Sim_Motor_Step_All(AUTOTUNER_CHECK_DT, AUTOTUNER_CHECK_SUB_STEP_NUM);
+    Sim_HAL_Tick_Increment(1);
+}
+
+/**
+ * @brief 在C610电机模型上整定速度环, 继电结束后以整定参数闭环, 再做一次速度阶跃
+ *
+ * @param Rule 整定规则
+ * @param Result 阶跃指标
+ * @return true 整定成功
+ */
+static bool Check_C610(Enum_PID_Autotuner_Rule Rule, Struct_Autotuner_Check_Step *Result)
+{
+    Class_Motor_C610 motor;
+    Class_Sim_Motor plant;
+    Class_PID_Autotuner autotuner;
+
+    Sim_HAL_Reset();
+    Sim_Motor_Bus_Init();
+    memset(CAN1_0x200_Tx_Data, 0, 8);
+
+    // 与crt_booster中拨弹电机一致, 参数由整定写入
+    motor.PID_Omega.Init(0.0f, 0.0f, 0.0f, 0.0f, 10.0f, 10.0f, 10.0f);
+    motor.Init(&hcan1, Motor_CAN_ID_0x203, Motor_Control_Method_CURRENT, 0, 36.0f);
+    plant.Init(&hcan1, 0x203, Sim_Motor_Type_M2006, Sim_Motor_Driver_Mode_Current);
+    CAN_Init(&hcan1, NULL);
+    init_finished = true;
+
+    // 与crt_booster中的继电参数一致
+    float target = 10.0f;
+    autotuner.Init(0.3f, 0.5f, AUTOTUNER_CHECK_DT, 5.0f, 20.0f);
+    autotuner.Start(target, motor.Get_Now_Omega(), 0.0f);
+    while (autotuner.Get_Status() == PID_Autotuner_Status_RUNNING)
+    {
+        autotuner.TIM_Calculate_PeriodElapsedCallback(motor.Get_Now_Omega());
+        motor.Set_Target_Current(autotuner.Get_Out());
+        Motor_Tick(motor, plant);
+    }
+
+    bool success = autotuner.Apply(&motor.PID_Omega, Rule);
+    if (Rule == PID_Autotuner_Rule_ZIEGLER_NICHOLS_PI)
+    {
+        printf("c610 omega: Ku %.4f Tu %.4f a %.3f K %.3f tau %.4f theta %.4f, %u cycles in %.2f s\n",
+               autotuner.Get_Ultimate_Gain(), autotuner.Get_Ultimate_Period(), autotuner.Get_Oscillation_Amplitude(),
+               autotuner.Get_Static_Gain(), autotuner.Get_Time_Constant(), autotuner.Get_Dead_Time(), autotuner.Get_Cycle_Num(), autotuner.Get_Time());
+    }
+
+    // 以整定参数恢复速度环, 保持目标0.3s后阶跃
+    motor.Set_Control_Method(Motor_Control_Method_OMEGA);
+    float step_target = 2.0f * target, step_time = 0.3f, time = 1.3f;
+    float peak = 0.0f, last_outside = step_time;
+    bool settled = false;
+    for (uint32_t tick = 0; tick < (uint32_t) (time / AUTOTUNER_CHECK_DT); tick++)
+    {
+        float now_time = tick * AUTOTUNER_CHECK_DT;
+        float now_target = now_time < step_time ? target : step_target;
+        motor.Set_Target_Omega(now_target);
+        Motor_Tick(motor, plant);
+        if (now_time < step_time)
+        {
+            continue;
+        }
+        float now = motor.Get_Now_Omega();
+        peak = fmaxf(peak, now);
+        if (fabsf(now - step_target) > 0.02f * step_target)
+        {
+            last_outside = now_time + AUTOTUNER_CHECK_DT;
+            settled = false;
+        }
+        else
+        {
+            settled = true;
+        }
+    }
+    Result->Overshoot = (peak - step_target) / (step_target - target) * 100.0f;
+    Result->Settling_Time = settled ? last_outside - step_time : -1.0f;
+
+    init_finished = false;
+    CAN_Unregister_Rx_Handler(&hcan1, 0x203);
+    return (success);
+}
+
+int main()
+{
+    // 纯滞后占比由小到大
+    Check_FOPDT(2.0f, 0.1f, 0.01f);
+    Check_FOPDT(1.0f, 0.05f, 0.02f);
+    Check_FOPDT(0.5f, 0.02f, 0.03f);
+
+    for (int rule = 0; rule < PID_Autotuner_Rule_NUM; rule++)
+    {
+        Struct_Autotuner_Check_Step result;
+        char name[64];
+        bool success = Check_C610((Enum_PID_Autotuner_Rule) rule, &result);
+        printf("    %-8s overshoot %6.2f%% settle %.3f s\n", Rule_Name[rule], result.Overshoot, result.Settling_Time);
+
+        snprintf(name, sizeof(name), "c610 %s status", Rule_Name[rule]);
+        Check(success, name);
+        snprintf(name, sizeof(name), "c610 %s settle", Rule_Name[rule]);
+        Check(result.Settling_Time >= 0.0f && result.Settling_Time < 0.5f, name);
+        if (rule != PID_Autotuner_Rule_ZIEGLER_NICHOLS_PI && rule != PID_Autotuner_Rule_ZIEGLER_NICHOLS_PID)
+        {
+            snprintf(name, sizeof(name), "c610 %s overshoot", Rule_Name[rule]);
+            Check(result.Overshoot < 30.0f, name);
+        }
+    }
+
+    printf("%s, %u failed\n", Fail_Num == 0 ? "PASS" : "FAIL", Fail_Num);
+    return (Fail_Num == 0 ? 0 : 1);
+}
+
+/*****************************************************************************/
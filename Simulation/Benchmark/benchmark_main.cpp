@@ -0,0 +1,893 @@
+/**
+ * @file benchmark_main.cpp
+ * @author WFZ
+ * @brief 算法内核的主机微基准: PID各功能组合, PID组批量计算, PID编译期功能裁剪, PID增益调度, 各类波形发生, 角度取模归一化与三角内核, 结果以JSON输出
+ * @version 0.0
+ * @date 2026-1-24
+ *
+ * @note 编译(在仓库根目录, 主机g++):
+ *       g++ -std=c++11 -O2 -IUser/1_Middleware/1_Driver/Math -IUser/1_Middleware/2_Algorithm/PID
+ *           -IUser/1_Middleware/2_Algorithm/Waveform -IUser/1_Middleware/2_Algorithm/Gain_Schedule
+ *           User/1_Middleware/1_Driver/Math/drv_math.cpp User/1_Middleware/2_Algorithm/PID/alg_pid.cpp
+ *           User/1_Middleware/2_Algorithm/Waveform/alg_waveform.cpp User/1_Middleware/2_Algorithm/Gain_Schedule/alg_gain_schedule.cpp
+ *           Simulation/Benchmark/benchmark_main.cpp -o benchmark
+ *
+ *       运行: ./benchmark 参数名=值 ...
+ *       iteration=每轮调用次数  repeat=轮数  filter=只跑名称含该子串的用例  json=结果文件(缺省输出到stdout)
+ *
+ *       每个用例测的是1kHz任务中的一次完整调用, PID用例包含Set_Target/Set_Now/Get_Out,
+ *       与任务层的用法一致. ns_per_call取各轮中位数; instructions_per_call来自perf_event_open
+ *       的用户态指令计数, 内核不允许时为null. 主机耗时只用于前后对比, 指令数更接近目标板上的开销.
+ *
+ *       例: ./benchmark filter=pid/ json=pid_before.json
+ *
+ *       pid_bank/用例测的是一个控制周期内的一组控制器, 逐个Class_PID与Class_PID_Bank成对出现;
+ *       另加 -O3 -fno-trapping-math 编译时主机上组内遍历会被向量化
+ *
+ *       pid_t/用例为同一组参数下全功能的Class_PID与只启用所需功能的Class_PID_T成对比较
+ *
+ *       gain_schedule/用例为先调度再计算的一次PI调用, pid_only为不调度的基线;
+ *       drift为缓慢变化的调度变量, 命中上一段或相邻段, jump为每周期随机跳变并越出表外, 走二分查找
+ *
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <stdint.h>
+#include <algorithm>
+#include "drv_math.h"
+#include "alg_pid.h"
+#include "alg_waveform.h"
+#include "alg_gain_schedule.h"
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+/* Private macros ------------------------------------------------------------*/
+
+// 输入序列长度, 2的幂
+#define BENCHMARK_INPUT_LENGTH 1024
+// 轮数上限
+#define BENCHMARK_REPEAT_MAX 31
+// 控制周期, s
+#define BENCHMARK_DT 0.001f
+
+/* Private types -------------------------------------------------------------*/
+
+/**
+ * @brief 一个用例的测量结果
+ *
+ */
+struct Struct_Benchmark_Result
+{
+    // 每次调用耗时中位数, ns
+    double NS_Per_Call;
+    // 每次调用耗时最小值, ns
+    double NS_Per_Call_Min;
+    // 每次调用指令数, 小于0表示不可用
+    double Instruction_Per_Call;
+};
+
+/**
+ * @brief PID功能开关, 按位组合
+ *
+ */
+enum Enum_Benchmark_PID_Feature
+{
+    Benchmark_PID_Feature_DEAD_ZONE = 1 << 0,
+    Benchmark_PID_Feature_VARIABLE_SPEED_I = 1 << 1,
+    Benchmark_PID_Feature_I_SEPARATE = 1 << 2,
+    Benchmark_PID_Feature_D_FIRST = 1 << 3,
+    Benchmark_PID_Feature_D_FILTER = 1 << 4,
+    Benchmark_PID_Feature_ZPIB = 1 << 5,
+    Benchmark_PID_Feature_NUM = 6,
+};
+
+/* Private variables ---------------------------------------------------------*/
+
+static const char *Benchmark_PID_Feature_Name[Benchmark_PID_Feature_NUM] = {
+    "dead_zone", "variable_speed_i", "i_separate", "d_first", "d_filter", "zpib",
+};
+
+static uint32_t Benchmark_Iteration = 200000;
+static uint32_t Benchmark_Repeat = 7;
+static const char *Benchmark_Filter = NULL;
+static const char *Benchmark_JSON_Name = NULL;
+
+static FILE *Benchmark_JSON = NULL;
+static bool Benchmark_First_Result = true;
+
+// perf计数器文件描述符, 小于0表示不可用
+static int Benchmark_Perf_FD = -1;
+
+// 防止被测结果被编译器优化掉
+static volatile float Benchmark_Sink;
+
+// 输入序列
+static float Benchmark_Target[BENCHMARK_INPUT_LENGTH];
+static float Benchmark_Now[BENCHMARK_INPUT_LENGTH];
+static float Benchmark_Angle[BENCHMARK_INPUT_LENGTH];
+
+/* Private function declarations ---------------------------------------------*/
+
+/* Function prototypes -------------------------------------------------------*/
+
+/**
+ * @brief 单调时钟
+ *
+ * @return uint64_t 当前时间, ns
+ */
+static uint64_t Benchmark_Time_NS()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t) now.tv_sec * 1000000000ULL + (uint64_t) now.tv_nsec);
+}
+
+/**
+ * @brief 打开用户态指令计数器
+ *
+ */
+static void Benchmark_Perf_Init()
+{
+#ifdef __linux__
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    Benchmark_Perf_FD = (int) syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+}
+
+/**
+ * @brief 计数器清零并开始计数
+ *
+ */
+static inline void Benchmark_Perf_Start()
+{
+#ifdef __linux__
+    if (Benchmark_Perf_FD >= 0)
+    {
+        ioctl(Benchmark_Perf_FD, PERF_EVENT_IOC_RESET, 0);
+        ioctl(Benchmark_Perf_FD, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+}
+
+/**
+ * @brief 停止计数并读出
+ *
+ * @return int64_t 指令数, 不可用时返回-1
+ */
+static inline int64_t Benchmark_Perf_Stop()
+{
+#ifdef __linux__
+    if (Benchmark_Perf_FD >= 0)
+    {
+        int64_t count = 0;
+        ioctl(Benchmark_Perf_FD, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(Benchmark_Perf_FD, &count, sizeof(count)) == sizeof(count))
+        {
+            return (count);
+        }
+    }
+#endif
+    return (-1);
+}
+
+/**
+ * @brief 生成确定性的输入序列, 误差覆盖死区/变速积分/积分分离的各个区间
+ *
+ */
+static void Benchmark_Input_Init()
+{
+    uint32_t seed = 0x12345678u;
+    float now = 0.0f;
+
+    for (int i = 0; i < BENCHMARK_INPUT_LENGTH; i++)
+    {
+        // 每256个周期在0与2之间切换的阶跃目标, 穿插一段零目标用于零位积分泄放
+        float target = ((i / 256) % 2 == 0) ? 2.0f : 0.0f;
+
+        // 一阶滞后跟随, 叠加小幅噪声
+        seed = seed * 1664525u + 1013904223u;
+        float noise = ((seed >> 8) / 16777216.0f - 0.5f) * 0.04f;
+        now += (target - now) * 0.02f;
+
+        Benchmark_Target[i] = target;
+        Benchmark_Now[i] = now + noise;
+
+        // 角度覆盖 ±4圈, 包含已在范围内的值
+        seed = seed * 1664525u + 1013904223u;
+        Benchmark_Angle[i] = ((seed >> 8) / 16777216.0f - 0.5f) * 16.0f * PI;
+    }
+}
+
+/**
+ * @brief 名称是否通过过滤
+ *
+ * @param Name 用例名称
+ * @return true 需要运行
+ */
+static bool Benchmark_Selected(const char *Name)
+{
+    return (Benchmark_Filter == NULL || strstr(Name, Benchmark_Filter) != NULL);
+}
+
+/**
+ * @brief 输出一个用例的JSON结果
+ *
+ * @param Group 分组
+ * @param Name 用例名称
+ * @param Result 测量结果
+ */
+static void Benchmark_Report(const char *Group, const char *Name, const Struct_Benchmark_Result &Result)
+{
+    fprintf(Benchmark_JSON, "%s\n    {\"name\": \"%s\", \"group\": \"%s\", \"ns_per_call\": %.3f, \"ns_per_call_min\": %.3f, ", Benchmark_First_Result ? "" : ",", Name, Group, Result.NS_Per_Call, Result.NS_Per_Call_Min);
+    if (Result.Instruction_Per_Call >= 0.0)
+    {
+        fprintf(Benchmark_JSON, "\"instructions_per_call\": %.2f, ", Result.Instruction_Per_Call);
+    }
+    else
+    {
+        fprintf(Benchmark_JSON, "\"instructions_per_call\": null, ");
+    }
+    // 在1kHz任务中每周期调用一次时占用的周期比例
+    fprintf(Benchmark_JSON, "\"tick_1khz_percent\": %.5f}", Result.NS_Per_Call / 1.0e6 * 100.0);
+    Benchmark_First_Result = false;
+
+    if (Benchmark_JSON != stdout)
+    {
+        printf("%-64s %10.2f ns", Name, Result.NS_Per_Call);
+        if (Result.Instruction_Per_Call >= 0.0)
+        {
+            printf(" %10.1f instr", Result.Instruction_Per_Call);
+        }
+        printf("\n");
+    }
+}
+
+/**
+ * @brief 测量一个用例
+ *
+ * @tparam Type_Setup 每轮开始前的复位操作
+ * @tparam Type_Body 被测的一次调用, 参数为调用序号
+ * @param Setup 复位操作
+ * @param Body 被测调用
+ * @return Struct_Benchmark_Result 测量结果
+ */
+template <typename Type_Setup, typename Type_Body>
+static Struct_Benchmark_Result Benchmark_Measure(Type_Setup &Setup, Type_Body &Body)
+{
+    double ns[BENCHMARK_REPEAT_MAX];
+    double instruction_min = -1.0;
+
+    // 预热, 让分支预测与缓存进入稳态
+    Setup();
+    for (uint32_t i = 0; i < Benchmark_Iteration / 10; i++)
+    {
+        Body(i);
+    }
+
+    for (uint32_t repeat = 0; repeat < Benchmark_Repeat; repeat++)
+    {
+        Setup();
+
+        Benchmark_Perf_Start();
+        uint64_t start = Benchmark_Time_NS();
+        for (uint32_t i = 0; i < Benchmark_Iteration; i++)
+        {
+            Body(i);
+        }
+        uint64_t end = Benchmark_Time_NS();
+        int64_t instruction = Benchmark_Perf_Stop();
+
+        ns[repeat] = (double) (end - start) / Benchmark_Iteration;
+        if (instruction >= 0)
+        {
+            double instruction_per_call = (double) instruction / Benchmark_Iteration;
+            if (instruction_min < 0.0 || instruction_per_call < instruction_min)
+            {
+                instruction_min = instruction_per_call;
+            }
+        }
+    }
+
+    std::sort(ns, ns + Benchmark_Repeat);
+
+    Struct_Benchmark_Result result;
+    result.NS_Per_Call = ns[Benchmark_Repeat / 2];
+    result.NS_Per_Call_Min = ns[0];
+    result.Instruction_Per_Call = instruction_min;
+    return (result);
+}
+
+/**
+ * @brief PID各功能组合, 共2^6种
+ *
+ */
+static void Benchmark_PID()
+{
+    for (int feature = 0; feature < (1 << Benchmark_PID_Feature_NUM); feature++)
+    {
+        char name[160] = "pid/";
+        if (feature == 0)
+        {
+            strcat(name, "base");
+        }
+        for (int i = 0; i < Benchmark_PID_Feature_NUM; i++)
+        {
+            if (feature & (1 << i))
+            {
+                if (name[4] != '\0')
+                {
+                    strcat(name, "+");
+                }
+                strcat(name, Benchmark_PID_Feature_Name[i]);
+            }
+        }
+        if (!Benchmark_Selected(name))
+        {
+            continue;
+        }
+
+        Class_PID pid;
+        auto setup = [&]() {
+            pid.Init(1.0f, 10.0f, 0.01f, 0.0f,
+                     5.0f, 0.0f, 10.0f,
+                     BENCHMARK_DT,
+                     (feature & Benchmark_PID_Feature_DEAD_ZONE) ? 0.05f : 0.0f,
+                     (feature & Benchmark_PID_Feature_VARIABLE_SPEED_I) ? 0.5f : 0.0f, (feature & Benchmark_PID_Feature_VARIABLE_SPEED_I) ? 1.0f : 0.0f, (feature & Benchmark_PID_Feature_I_SEPARATE) ? 1.0f : 0.0f, (feature & Benchmark_PID_Feature_D_FIRST) ? PID_D_First_ENABLE : PID_D_First_DISABLE,
+                     PID_DIRECT,
+                     (feature & Benchmark_PID_Feature_D_FILTER) ? 0.3f : 0.0f,
+                     (feature & Benchmark_PID_Feature_ZPIB) ? PID_ZPIB_ENABLE : PID_ZPIB_DISABLE);
+        };
+        auto body = [&](uint32_t i) {
+            pid.Set_Target(Benchmark_Target[i & (BENCHMARK_INPUT_LENGTH - 1)]);
+            pid.Set_Now(Benchmark_Now[i & (BENCHMARK_INPUT_LENGTH - 1)]);
+            pid.TIM_Adjust_PeriodElapsedCallback();
+            Benchmark_Sink = pid.Get_Out();
+        };
+
+        Benchmark_Report("pid", name, Benchmark_Measure(setup, body));
+    }
+}
+
+/**
+ * @brief PID组用例的控制器参数
+ *
+ * @tparam Type_PID 控制器类型
+ * @param PID 控制器
+ * @param Full true为全功能参数, false为底盘轮速环的纯P参数
+ */
+template <typename Type_PID>
+static void Benchmark_PID_Bank_Init(Type_PID *PID, bool Full)
+{
+    if (Full)
+    {
+        PID->Init(1.0f, 10.0f, 0.01f, 0.0f,
+                  5.0f, 0.0f, 10.0f,
+                  BENCHMARK_DT,
+                  0.05f,
+                  0.5f, 1.0f, 1.0f, PID_D_First_DISABLE,
+                  PID_DIRECT,
+                  0.3f,
+                  PID_ZPIB_DISABLE);
+    }
+    else
+    {
+        PID->Init(0.73242f, 0.0f, 0.0f, 0.0f);
+    }
+}
+
+/**
+ * @brief 一个控制周期内Num个控制器, 逐个Class_PID与PID组批量计算成对比较
+ *
+ * @param Config 参数名称, chassis为底盘轮速环的纯P参数, full为死区/变速积分/积分分离/D项滤波全开
+ */
+template <uint32_t Num>
+static void Benchmark_PID_Bank_Case(const char *Config)
+{
+    bool full = strcmp(Config, "full") == 0;
+    char name_class_pid[96], name_bank[96];
+    snprintf(name_class_pid, sizeof(name_class_pid), "pid_bank/%s_x%u_class_pid", Config, (unsigned) Num);
+    snprintf(name_bank, sizeof(name_bank), "pid_bank/%s_x%u_bank", Config, (unsigned) Num);
+
+    static Class_PID pid[Num];
+    // 绑定到组内的控制器需启用PID_Feature_BANK
+    static Class_PID_T<PID_Feature_ALL> pid_bound[Num];
+    static Class_PID_Bank<Num> bank;
+
+    if (Benchmark_Selected(name_class_pid))
+    {
+        auto setup = [&]() {
+            for (uint32_t j = 0; j < Num; j++)
+            {
+                pid[j] = Class_PID();
+                Benchmark_PID_Bank_Init(&pid[j], full);
+            }
+        };
+        auto body = [&](uint32_t i) {
+            for (uint32_t j = 0; j < Num; j++)
+            {
+                pid[j].Set_Target(Benchmark_Target[(i + j * 131) & (BENCHMARK_INPUT_LENGTH - 1)]);
+                pid[j].Set_Now(Benchmark_Now[(i + j * 131) & (BENCHMARK_INPUT_LENGTH - 1)]);
+                pid[j].TIM_Adjust_PeriodElapsedCallback();
+            }
+            for (uint32_t j = 0; j < Num; j++)
+            {
+                Benchmark_Sink = pid[j].Get_Out();
+            }
+        };
+        Benchmark_Report("pid_bank", name_class_pid, Benchmark_Measure(setup, body));
+    }
+
+    if (Benchmark_Selected(name_bank))
+    {
+        // 通过绑定后的Class_PID装入与取出, 组内一次算完
+        auto setup = [&]() {
+            bank.Init();
+            for (uint32_t j = 0; j < Num; j++)
+            {
+                pid_bound[j] = Class_PID_T<PID_Feature_ALL>();
+                Benchmark_PID_Bank_Init(&pid_bound[j], full);
+                pid_bound[j].Bind_Bank(&bank, j);
+            }
+        };
+        auto body = [&](uint32_t i) {
+            for (uint32_t j = 0; j < Num; j++)
+            {
+                pid_bound[j].Set_Target(Benchmark_Target[(i + j * 131) & (BENCHMARK_INPUT_LENGTH - 1)]);
+                pid_bound[j].Set_Now(Benchmark_Now[(i + j * 131) & (BENCHMARK_INPUT_LENGTH - 1)]);
+            }
+            bank.TIM_Adjust_PeriodElapsedCallback();
+            for (uint32_t j = 0; j < Num; j++)
+            {
+                Benchmark_Sink = pid_bound[j].Get_Out();
+            }
+        };
+        Benchmark_Report("pid_bank", name_bank, Benchmark_Measure(setup, body));
+    }
+}
+
+/**
+ * @brief PID组批量计算, 4个为底盘轮速环, 8个为两台底盘规模
+ *
+ */
+static void Benchmark_PID_Bank()
+{
+    Benchmark_PID_Bank_Case<4>("chassis");
+    Benchmark_PID_Bank_Case<4>("full");
+    Benchmark_PID_Bank_Case<8>("chassis");
+    Benchmark_PID_Bank_Case<8>("full");
+}
+
+/**
+ * @brief 同一组参数下的一个控制器, 全功能Class_PID或只启用所需功能的Class_PID_T
+ *
+ * @tparam Type_PID 控制器类型
+ * @param Name 用例名称
+ * @param Full 死区/变速积分/积分分离/D项滤波全开, 否则为P+I加限幅
+ */
+template <typename Type_PID>
+static void Benchmark_PID_T_Case(const char *Name, bool Full)
+{
+    if (!Benchmark_Selected(Name))
+    {
+        return;
+    }
+
+    Type_PID pid;
+    auto setup = [&]() {
+        pid = Type_PID();
+        pid.Init(1.0f, 10.0f, Full ? 0.01f : 0.0f, 0.0f,
+                 5.0f, 0.0f, 10.0f,
+                 BENCHMARK_DT,
+                 Full ? 0.05f : 0.0f,
+                 Full ? 0.5f : 0.0f, Full ? 1.0f : 0.0f, Full ? 1.0f : 0.0f, PID_D_First_DISABLE,
+                 PID_DIRECT,
+                 Full ? 0.3f : 0.0f,
+                 PID_ZPIB_DISABLE);
+    };
+    auto body = [&](uint32_t i) {
+        pid.Set_Target(Benchmark_Target[i & (BENCHMARK_INPUT_LENGTH - 1)]);
+        pid.Set_Now(Benchmark_Now[i & (BENCHMARK_INPUT_LENGTH - 1)]);
+        pid.TIM_Adjust_PeriodElapsedCallback();
+        Benchmark_Sink = pid.Get_Out();
+    };
+
+    Benchmark_Report("pid_t", Name, Benchmark_Measure(setup, body));
+}
+
+/**
+ * @brief 编译期功能裁剪前后对比
+ *
+ */
+static void Benchmark_PID_T()
+{
+    Benchmark_PID_T_Case<Class_PID>("pid_t/pi_class_pid", false);
+    Benchmark_PID_T_Case<Class_PID_T<PID_Feature_I_LIMIT, PID_Feature_OUT_LIMIT>>("pid_t/pi_class_pid_t", false);
+    Benchmark_PID_T_Case<Class_PID>("pid_t/full_class_pid", true);
+    Benchmark_PID_T_Case<Class_PID_T<PID_Feature_DEAD_ZONE, PID_Feature_VARIABLE_SPEED_I, PID_Feature_I_SEPARATE, PID_Feature_I_LIMIT,
+                                     PID_Feature_D, PID_Feature_D_FILTER, PID_Feature_OUT_LIMIT>>("pid_t/full_class_pid_t", true);
+}
+
+/**
+ * @brief 一个增益调度用例
+ *
+ * @param Name 用例名称
+ * @param Point_Num 断点表行数, 0表示不调度
+ * @param Jump 调度变量每周期随机跳变, 否则缓慢变化
+ */
+static void Benchmark_Gain_Schedule_Case(const char *Name, uint8_t Point_Num, bool Jump)
+{
+    if (!Benchmark_Selected(Name))
+    {
+        return;
+    }
+
+    // 断点均布在 [0, 2.2], 覆盖缓慢变化的反馈
+    static Struct_PID_Gain_Schedule_Point table[32];
+    for (uint8_t i = 0; i < Point_Num; i++)
+    {
+        float x = 2.2f * i / (Point_Num - 1);
+        table[i] = {x, 1.0f + 0.5f * x, 10.0f - 2.0f * x, 0.0f, 0.0f, 5.0f, 10.0f - x};
+    }
+
+    Class_PID pid;
+    Class_PID_Gain_Schedule schedule;
+    auto setup = [&]() {
+        pid = Class_PID();
+        pid.Init(1.0f, 10.0f, 0.0f, 0.0f,
+                 5.0f, 0.0f, 10.0f,
+                 BENCHMARK_DT);
+        if (Point_Num > 0)
+        {
+            schedule.Init(&pid, table, Point_Num);
+        }
+    };
+    auto body = [&](uint32_t i) {
+        uint32_t index = i & (BENCHMARK_INPUT_LENGTH - 1);
+        if (Point_Num > 0)
+        {
+            // 随机角度 ±8π 缩放到 [-0.16, 2.36]
+            schedule.TIM_Calculate_PeriodElapsedCallback(Jump ? Benchmark_Angle[index] * 0.05f + 1.1f : Benchmark_Now[index]);
+        }
+        pid.Set_Target(Benchmark_Target[index]);
+        pid.Set_Now(Benchmark_Now[index]);
+        pid.TIM_Adjust_PeriodElapsedCallback();
+        Benchmark_Sink = pid.Get_Out();
+    };
+
+    Benchmark_Report("gain_schedule", Name, Benchmark_Measure(setup, body));
+}
+
+/**
+ * @brief 增益调度查表与写入的开销
+ *
+ */
+static void Benchmark_Gain_Schedule()
+{
+    Benchmark_Gain_Schedule_Case("gain_schedule/pid_only", 0, false);
+    Benchmark_Gain_Schedule_Case("gain_schedule/drift_4pt", 4, false);
+    Benchmark_Gain_Schedule_Case("gain_schedule/drift_32pt", 32, false);
+    Benchmark_Gain_Schedule_Case("gain_schedule/jump_4pt", 4, true);
+    Benchmark_Gain_Schedule_Case("gain_schedule/jump_32pt", 32, true);
+}
+
+/**
+ * @brief 各类波形的Update
+ *
+ */
+static void Benchmark_Waveform()
+{
+    static const char *waveform_name[] = {
+        "hold", "step", "square", "sine", "triangle", "saw", "ramp",
+        "pulse", "doublet", "chirp", "prbs", "noise", "relay",
+    };
+
+    for (int type = Waveform_Type_HOLD; type <= Waveform_Type_RELAY; type++)
+    {
+        char name[64];
+        snprintf(name, sizeof(name), "waveform/%s", waveform_name[type]);
+        if (!Benchmark_Selected(name))
+        {
+            continue;
+        }
+
+        Class_Waveform waveform;
+        float feedback = 0.0f;
+        auto setup = [&]() {
+            waveform.Init(BENCHMARK_DT);
+            switch (type)
+            {
+            case (Waveform_Type_HOLD):
+                waveform.Hold(1.0f);
+                break;
+            case (Waveform_Type_STEP):
+                waveform.Step(0.0f, 1.0f, 0.5f);
+                break;
+            case (Waveform_Type_SQUARE):
+                waveform.Square(1.0f, 2.0f);
+                break;
+            case (Waveform_Type_SINE):
+                waveform.Sine(1.0f, 2.0f);
+                break;
+            case (Waveform_Type_TRIANGLE):
+                waveform.Triangle(1.0f, 2.0f);
+                break;
+            case (Waveform_Type_SAW):
+                waveform.Saw(1.0f, 2.0f);
+                break;
+            case (Waveform_Type_RAMP):
+                waveform.Ramp(1.0f, 0.0f, 2.0f);
+                break;
+            case (Waveform_Type_PULSE):
+                waveform.Pulse(0.0f, 1.0f, 0.5f, 0.1f);
+                break;
+            case (Waveform_Type_DOUBLET):
+                waveform.Doublet(1.0f, 0.2f, 0.1f, 0.2f);
+                break;
+            case (Waveform_Type_CHIRP):
+                waveform.Chirp(1.0f, 0.5f, 20.0f, 10.0f);
+                break;
+            case (Waveform_Type_PRBS):
+                waveform.PRBS(1.0f, 0.01f);
+                break;
+            case (Waveform_Type_NOISE):
+                waveform.Noise(0.02f);
+                break;
+            case (Waveform_Type_RELAY):
+                waveform.Relay(1.0f, 0.05f);
+                break;
+            }
+            feedback = 0.0f;
+        };
+        auto body = [&](uint32_t i) {
+            (void) i;
+            float out = waveform.Update(feedback);
+            // 继电器激励需要反馈, 用一阶滞后对象闭环, 其他波形忽略反馈
+            feedback += (out - feedback) * 0.05f;
+            Benchmark_Sink = out;
+        };
+
+        Benchmark_Report("waveform", name, Benchmark_Measure(setup, body));
+    }
+}
+
+/**
+ * @brief 角度取模归一化与单精度三角内核, 与libm写法成对比较
+ *
+ */
+static void Benchmark_Math()
+{
+    if (Benchmark_Selected("math/modulus_normalization"))
+    {
+        auto setup = []() {};
+        auto body = [](uint32_t i) {
+            Benchmark_Sink = Math_Modulus_Normalization(Benchmark_Angle[i & (BENCHMARK_INPUT_LENGTH - 1)], 2.0f * PI);
+        };
+        Benchmark_Report("math", "math/modulus_normalization", Benchmark_Measure(setup, body));
+    }
+
+    if (Benchmark_Selected("math/modulus_normalization_in_range"))
+    {
+        // 控制中最常见的情况: 输入已经在 ±PI 内
+        auto setup = []() {};
+        auto body = [](uint32_t i) {
+            float angle = Benchmark_Angle[i & (BENCHMARK_INPUT_LENGTH - 1)] * (1.0f / 8.0f);
+            Benchmark_Sink = Math_Modulus_Normalization(angle, 2.0f * PI);
+        };
+        Benchmark_Report("math", "math/modulus_normalization_in_range", Benchmark_Measure(setup, body));
+    }
+
+    // 以下成对出现: *_libm为替换前的写法, 另一个为drv_math单精度内核
+    if (Benchmark_Selected("math/wrap_pi_libm"))
+    {
+        // 原云台就近转位的写法, 双精度fmod
+        auto setup = []() {};
+        auto body = [](uint32_t i) {
+            float tmp = (float) fmod((double) Benchmark_Angle[i & (BENCHMARK_INPUT_LENGTH - 1)], 2.0 * PI);
+            if (tmp > PI)
+            {
+                tmp -= 2.0f * PI;
+            }
+            else if (tmp < -PI)
+            {
+                tmp += 2.0f * PI;
+            }
+            Benchmark_Sink = tmp;
+        };
+        Benchmark_Report("math", "math/wrap_pi_libm", Benchmark_Measure(setup, body));
+    }
+
+    if (Benchmark_Selected("math/wrap_pi"))
+    {
+        auto setup = []() {};
+        auto body = [](uint32_t i) {
+            Benchmark_Sink = Math_Wrap_Pi(Benchmark_Angle[i & (BENCHMARK_INPUT_LENGTH - 1)]);
+        };
+        Benchmark_Report("math", "math/wrap_pi", Benchmark_Measure(setup, body));
+    }
+
+    if (Benchmark_Selected("math/sin_libm"))
+    {
+        auto setup = []() {};
+        auto body = [](uint32_t i) {
+            Benchmark_Sink = sinf(Benchmark_Angle[i & (BENCHMARK_INPUT_LENGTH - 1)]);
+        };
+        Benchmark_Report("math", "math/sin_libm", Benchmark_Measure(setup, body));
+    }
+
+    if (Benchmark_Selected("math/sin"))
+    {
+        auto setup = []() {};
+        auto body = [](uint32_t i) {
+            Benchmark_Sink = Math_Sin(Benchmark_Angle[i & (BENCHMARK_INPUT_LENGTH - 1)]);
+        };
+        Benchmark_Report("math", "math/sin", Benchmark_Measure(setup, body));
+    }
+
+    if (Benchmark_Selected("math/sin_cos_libm"))
+    {
+        // 底盘运动学与偏航角速度投影中的一次旋转
+        auto setup = []() {};
+        auto body = [](uint32_t i) {
+            float angle = Benchmark_Angle[i & (BENCHMARK_INPUT_LENGTH - 1)];
+            Benchmark_Sink = sinf(angle) + cosf(angle);
+        };
+        Benchmark_Report("math", "math/sin_cos_libm", Benchmark_Measure(setup, body));
+    }
+
+    if (Benchmark_Selected("math/sin_cos"))
+    {
+        auto setup = []() {};
+        auto body = [](uint32_t i) {
+            float s, c;
+            Math_Sin_Cos(Benchmark_Angle[i & (BENCHMARK_INPUT_LENGTH - 1)], &s, &c);
+            Benchmark_Sink = s + c;
+        };
+        Benchmark_Report("math", "math/sin_cos", Benchmark_Measure(setup, body));
+    }
+
+    if (Benchmark_Selected("math/atan2_libm"))
+    {
+        auto setup = []() {};
+        auto body = [](uint32_t i) {
+            Benchmark_Sink = atan2f(Benchmark_Target[i & (BENCHMARK_INPUT_LENGTH - 1)], Benchmark_Now[i & (BENCHMARK_INPUT_LENGTH - 1)]);
+        };
+        Benchmark_Report("math", "math/atan2_libm", Benchmark_Measure(setup, body));
+    }
+
+    if (Benchmark_Selected("math/atan2"))
+    {
+        auto setup = []() {};
+        auto body = [](uint32_t i) {
+            Benchmark_Sink = Math_Atan2(Benchmark_Target[i & (BENCHMARK_INPUT_LENGTH - 1)], Benchmark_Now[i & (BENCHMARK_INPUT_LENGTH - 1)]);
+        };
+        Benchmark_Report("math", "math/atan2", Benchmark_Measure(setup, body));
+    }
+
+    if (Benchmark_Selected("math/inv_sqrt_libm"))
+    {
+        auto setup = []() {};
+        auto body = [](uint32_t i) {
+            Benchmark_Sink = 1.0f / sqrtf(fabsf(Benchmark_Angle[i & (BENCHMARK_INPUT_LENGTH - 1)]) + 0.1f);
+        };
+        Benchmark_Report("math", "math/inv_sqrt_libm", Benchmark_Measure(setup, body));
+    }
+
+    if (Benchmark_Selected("math/inv_sqrt"))
+    {
+        auto setup = []() {};
+        auto body = [](uint32_t i) {
+            Benchmark_Sink = Math_Inv_Sqrt(fabsf(Benchmark_Angle[i & (BENCHMARK_INPUT_LENGTH - 1)]) + 0.1f);
+        };
+        Benchmark_Report("math", "math/inv_sqrt", Benchmark_Measure(setup, body));
+    }
+}
+
+/**
+ * @brief 主函数
+ *
+ * @param argc 参数个数
+ * @param argv 参数列表
+ * @return int 返回值
+ */
+int main(int argc, char **argv)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        char *value = strchr(argv[i], '=');
+        if (value == NULL)
+        {
+            fprintf(stderr, "参数格式应为 参数名=值: %s\n", argv[i]);
+            return (1);
+        }
+        *value++ = '\0';
+
+        if (strcmp(argv[i], "iteration") == 0)
+        {
+            Benchmark_Iteration = (uint32_t) strtoul(value, NULL, 0);
+        }
+        else if (strcmp(argv[i], "repeat") == 0)
+        {
+            Benchmark_Repeat = (uint32_t) strtoul(value, NULL, 0);
+        }
+        else if (strcmp(argv[i], "filter") == 0)
+        {
+            Benchmark_Filter = value;
+        }
+        else if (strcmp(argv[i], "json") == 0)
+        {
+            Benchmark_JSON_Name = value;
+        }
+        else
+        {
+            fprintf(stderr, "未知参数: %s\n", argv[i]);
+            return (1);
+        }
+    }
+    if (Benchmark_Iteration == 0)
+    {
+        Benchmark_Iteration = 1;
+    }
+    if (Benchmark_Repeat == 0 || Benchmark_Repeat > BENCHMARK_REPEAT_MAX)
+    {
+        Benchmark_Repeat = Benchmark_Repeat == 0 ? 1 : BENCHMARK_REPEAT_MAX;
+    }
+
+    Benchmark_JSON = stdout;
+    if (Benchmark_JSON_Name != NULL)
+    {
+        Benchmark_JSON = fopen(Benchmark_JSON_Name, "w");
+        if (Benchmark_JSON == NULL)
+        {
+            fprintf(stderr, "无法写入 %s\n", Benchmark_JSON_Name);
+            return (1);
+        }
+    }
+
+    Benchmark_Perf_Init();
+    Benchmark_Input_Init();
+
+    fprintf(Benchmark_JSON, "{\n  \"iteration\": %u,\n  \"repeat\": %u,\n  \"instruction_counter\": %s,\n  \"results\": [",
+            Benchmark_Iteration, Benchmark_Repeat, Benchmark_Perf_FD >= 0 ? "true" : "false");
+
+    Benchmark_PID();
+    Benchmark_PID_Bank();
+    Benchmark_PID_T();
+    Benchmark_Gain_Schedule();
+    Benchmark_Waveform();
+    Benchmark_Math();
+
+    fprintf(Benchmark_JSON, "\n  ]\n}\n");
+
+    if (Benchmark_JSON != stdout)
+    {
+        fclose(Benchmark_JSON);
+    }
+#ifdef __linux__
+    if (Benchmark_Perf_FD >= 0)
+    {
+        close(Benchmark_Perf_FD);
+    }
+#endif
+
+    return (0);
+}
+
+/*****************************************************************************/
@@ -0,0 +1,407 @@
+/**
+ * @file can_filter_check_main.cpp
+ * @author WFZ
+ * @brief CAN过滤器规划的主机检查: CAN_Filter_Plan的组数、模式、FIFO负载, 以及CAN_Filter_Apply后仿真过滤器放行的ID
+ * @version 0.0
+ * @date 2026-2-8
+ *
+ * @note 编译(在仓库根目录, 主机g++):
+ *       g++ -std=c++11 -O2 -Wall -ISimulation/Stub -IUser/1_Middleware/1_Driver/CAN -IUser/1_Middleware/1_Driver/DWT
+ *           -x c++ User/1_Middleware/1_Driver/CAN/drv_can.c -x none User/1_Middleware/1_Driver/DWT/drv_dwt.cpp
+ *           Simulation/Stub/sim_hal.cpp Simulation/CAN/can_filter_check_main.cpp -o can_filter_check
+ *
+ *       运行: ./can_filter_check, 逐项输出不一致的次数, 全部通过时返回0
+ *       整车布局: 当前车(CAN1底盘4×C620与云台2×GM6020, CAN2发射机构3个电机)、8×C620、7×GM6020,
+ *       按布局登记电机反馈ID后CAN_Filter_Apply, 再向两路总线逐个注入0x000~0x7ff, 只有登记的ID应被接收并分发;
+ *       另对随机ID集合直接检查CAN_Filter_Plan的放行集合、组号范围与FIFO负载
+ *
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "drv_can.h"
+#include "sim_hal.h"
+
+/* Private macros ------------------------------------------------------------*/
+
+// 随机ID集合的组数
+#define CAN_FILTER_CHECK_RANDOM_NUM 2000
+
+/* Private types -------------------------------------------------------------*/
+
+/**
+ * @brief 一种整车布局, 两路CAN各自登记的反馈ID与预期的规划结果
+ *
+ */
+struct Struct_CAN_Filter_Layout
+{
+    const char *Name;
+    uint16_t ID[2][16];
+    uint8_t ID_Num[2];
+    // 预期的掩码组数与列表组数
+    uint8_t Mask_Num[2];
+    uint8_t List_Num[2];
+    // 预期的FIFO0与FIFO1负载
+    uint8_t FIFO_Load[2][2];
+};
+
+/* Private variables ---------------------------------------------------------*/
+
+bool init_finished = false;
+
+static uint32_t Fail_Num = 0;
+static uint32_t Random_State = 0x9E3779B9U;
+
+// 各ID的处理函数被调用的次数, 按总线与ID
+static uint32_t Rx_Count[2][0x800];
+
+static const Struct_CAN_Filter_Layout Layout[] = {
+    {"robot",
+     {{0x201, 0x202, 0x203, 0x204, 0x205, 0x208}, {0x201, 0x202, 0x203}},
+     {6, 3},
+     {0, 0},
+     {3, 2},
+     {{4, 2}, {2, 1}}},
+    {"8xC620 / 7xGM6020",
+     {{0x201, 0x202, 0x203, 0x204, 0x205, 0x206, 0x207, 0x208}, {0x205, 0x206, 0x207, 0x208, 0x209, 0x20a, 0x20b}},
+     {8, 7},
+     {1, 1},
+     {2, 2},
+     {{4, 4}, {4, 3}}},
+    {"7xGM6020 / 8xC620",
+     {{0x205, 0x206, 0x207, 0x208, 0x209, 0x20a, 0x20b}, {0x201, 0x202, 0x203, 0x204, 0x205, 0x206, 0x207, 0x208}},
+     {7, 8},
+     {1, 1},
+     {2, 2},
+     {{4, 3}, {4, 4}}},
+};
+
+/* Private function declarations ---------------------------------------------*/
+
+/* Function prototypes -------------------------------------------------------*/
+
+/**
+ * @brief 随机数
+ *
+ * @return uint32_t 32位随机数
+ */
+static uint32_t Random()
+{
+    Random_State ^= Random_State << 13;
+    Random_State ^= Random_State >> 17;
+    Random_State ^= Random_State << 5;
+    return (Random_State);
+}
+
+/**
+ * @brief 输出一项检查结果并累计失败数
+ *
+ * @param Mismatch 不一致的次数
+ * @param Name 检查项
+ */
+static void Report(uint32_t Mismatch, const char *Name)
+{
+    printf("%-40s %s (%u)\n", Name, Mismatch == 0 ? "ok" : "FAIL", (unsigned) Mismatch);
+    Fail_Num += Mismatch;
+}
+
+/**
+ * @brief 登记的处理函数, 对象即该ID的计数
+ *
+ */
+static void Count_Rx_Handler(void *Object, uint8_t *Rx_Data)
+{
+    (void) Rx_Data;
+    (*(uint32_t *) Object)++;
+}
+
+/**
+ * @brief 按规划结果判断一个ID是否被放行
+ *
+ * @param Bank 过滤器组
+ * @param Bank_Num 组数
+ * @param StdId 标准帧ID
+ * @return int8_t 放行时返回第一个匹配组的FIFO, 否则返回-1
+ */
+static int8_t Plan_Match(const Struct_CAN_Filter_Bank *Bank, uint8_t Bank_Num, uint16_t StdId)
+{
+    for (uint8_t i = 0; i < Bank_Num; i++)
+    {
+        bool match = Bank[i].Mode == CAN_FILTERMODE_IDMASK ? ((StdId ^ Bank[i].ID[0]) & Bank[i].ID[1]) == 0 : (StdId == Bank[i].ID[0] || StdId == Bank[i].ID[1]);
+        if (match)
+        {
+            return (Bank[i].FIFO);
+        }
+    }
+    return (-1);
+}
+
+/**
+ * @brief 检查一次规划: 放行集合恰为ID集合, 组号在可用范围内, 各组ID数与模式一致, 两个FIFO负载之差不超过最大的一组
+ *
+ * @param ID ID集合
+ * @param ID_Num ID个数
+ * @param First_Bank 可用的第一个过滤器组编号
+ * @param Bank_Num 可用的过滤器组数
+ * @param Bank 规划结果
+ * @param Used_Num 使用的组数
+ * @return uint32_t 不一致的次数
+ */
+static uint32_t Check_Plan(const uint16_t *ID, uint8_t ID_Num, uint8_t First_Bank, uint8_t Bank_Num, const Struct_CAN_Filter_Bank *Bank, uint8_t Used_Num)
+{
+    uint32_t mismatch = 0;
+    bool in_set[0x800] = {};
+    uint8_t fifo_load[2] = {0, 0};
+    uint8_t bank_load_max = 0;
+
+    if (Used_Num == CAN_FILTER_PLAN_FAIL || Used_Num > Bank_Num)
+    {
+        return (1);
+    }
+
+    for (uint8_t i = 0; i < ID_Num; i++)
+    {
+        in_set[ID[i]] = true;
+    }
+    for (uint16_t std_id = 0; std_id < 0x800; std_id++)
+    {
+        mismatch += (Plan_Match(Bank, Used_Num, std_id) >= 0) != in_set[std_id] ? 1 : 0;
+    }
+
+    for (uint8_t i = 0; i < Used_Num; i++)
+    {
+        // 组号连续且在本路CAN可用的范围内
+        mismatch += Bank[i].Bank != First_Bank + i ? 1 : 0;
+
+        uint8_t id_num = 0;
+        for (uint8_t j = 0; j < ID_Num; j++)
+        {
+            id_num += Plan_Match(&Bank[i], 1, ID[j]) >= 0 ? 1 : 0;
+        }
+        if (Bank[i].Mode == CAN_FILTERMODE_IDMASK)
+        {
+            // 掩码组只在新覆盖3个及以上ID时使用, 组内ID都应登记
+            mismatch += (Bank[i].ID_Num < 3 || id_num < Bank[i].ID_Num) ? 1 : 0;
+        }
+        else
+        {
+            mismatch += (Bank[i].ID_Num != id_num || (id_num == 1) != (Bank[i].ID[0] == Bank[i].ID[1])) ? 1 : 0;
+        }
+
+        fifo_load[Bank[i].FIFO == CAN_RX_FIFO0 ? 0 : 1] += Bank[i].ID_Num;
+        bank_load_max = Bank[i].ID_Num > bank_load_max ? Bank[i].ID_Num : bank_load_max;
+    }
+
+    // 各ID只计入一组的负载, 两个FIFO负载之差不超过最大的一组
+    mismatch += fifo_load[0] + fifo_load[1] != ID_Num ? 1 : 0;
+    mismatch += abs(fifo_load[0] - fifo_load[1]) > bank_load_max ? 1 : 0;
+
+    return (mismatch);
+}
+
+/**
+ * @brief 随机ID集合, 一半集中在一段连续ID附近以产生掩码组
+ *
+ * @param ID 输出的ID集合
+ * @return uint8_t ID个数
+ */
+static uint8_t Random_ID_Set(uint16_t *ID)
+{
+    uint8_t id_num = 1 + Random() % 24;
+    uint16_t base = Random() & 0x7c0;
+    uint16_t span = (Random() & 1) ? 0x3f : 0x7ff;
+    uint8_t num = 0;
+
+    while (num < id_num)
+    {
+        uint16_t std_id = (span == 0x7ff) ? (Random() & 0x7ff) : (base | (Random() & span));
+        bool exist = false;
+        for (uint8_t i = 0; i < num && !exist; i++)
+        {
+            exist = ID[i] == std_id;
+        }
+        if (!exist)
+        {
+            ID[num++] = std_id;
+        }
+    }
+    return (num);
+}
+
+/**
+ * @brief 随机ID集合直接检查CAN_Filter_Plan, 两路CAN的组号范围各检查一次
+ *
+ * @return uint32_t 不一致的次数
+ */
+static uint32_t Check_Random()
+{
+    uint32_t mismatch = 0;
+    uint16_t id[32];
+    Struct_CAN_Filter_Bank bank[CAN_FILTER_SLAVE_START_BANK];
+
+    for (uint32_t n = 0; n < CAN_FILTER_CHECK_RANDOM_NUM; n++)
+    {
+        uint8_t id_num = Random_ID_Set(id);
+        uint8_t first_bank = (n & 1) ? CAN_FILTER_SLAVE_START_BANK : 0;
+        uint8_t bank_limit = (n & 1) ? CAN_FILTER_BANK_NUM - CAN_FILTER_SLAVE_START_BANK : CAN_FILTER_SLAVE_START_BANK;
+
+        uint8_t bank_num = CAN_Filter_Plan(id, id_num, first_bank, bank_limit, bank);
+        mismatch += Check_Plan(id, id_num, first_bank, bank_limit, bank, bank_num) != 0 ? 1 : 0;
+    }
+    return (mismatch);
+}
+
+/**
+ * @brief 组数不够或ID过多时规划失败
+ *
+ * @return uint32_t 不一致的次数
+ */
+static uint32_t Check_Plan_Fail()
+{
+    uint32_t mismatch = 0;
+    uint16_t id[33];
+    Struct_CAN_Filter_Bank bank[CAN_FILTER_SLAVE_START_BANK];
+
+    // 取偶校验的ID, 两两至少相差2位, 不能合并成掩码组, 29个ID需要15个列表组
+    uint8_t id_num = 0;
+    for (uint16_t std_id = 0; id_num < 33; std_id++)
+    {
+        if (__builtin_parity(std_id) == 0)
+        {
+            id[id_num++] = std_id;
+        }
+    }
+    mismatch += CAN_Filter_Plan(id, 29, 0, CAN_FILTER_SLAVE_START_BANK, bank) != CAN_FILTER_PLAN_FAIL ? 1 : 0;
+    mismatch += CAN_Filter_Plan(id, 28, 0, CAN_FILTER_SLAVE_START_BANK, bank) != CAN_FILTER_SLAVE_START_BANK ? 1 : 0;
+    mismatch += CAN_Filter_Plan(id, 33, 0, CAN_FILTER_SLAVE_START_BANK, bank) != CAN_FILTER_PLAN_FAIL ? 1 : 0;
+    mismatch += CAN_Filter_Plan(id, 0, 0, CAN_FILTER_SLAVE_START_BANK, bank) != 0 ? 1 : 0;
+    return (mismatch);
+}
+
+/**
+ * @brief 一种整车布局: 规划结果与预期一致, 硬件过滤器与规划一致, 只有登记的ID被接收并分发到处理函数
+ *
+ * @param Now 布局
+ */
+static void Check_Layout(const Struct_CAN_Filter_Layout *Now)
+{
+    CAN_HandleTypeDef *hcan[2] = {&hcan1, &hcan2};
+    uint8_t data[8] = {};
+    char name[64];
+
+    Sim_HAL_Reset();
+    init_finished = false;
+    CAN_Init(&hcan1, NULL);
+    CAN_Init(&hcan2, NULL);
+    memset(Rx_Count, 0, sizeof(Rx_Count));
+    for (uint8_t bus = 0; bus < 2; bus++)
+    {
+        for (uint8_t i = 0; i < Now->ID_Num[bus]; i++)
+        {
+            uint16_t std_id = Now->ID[bus][i];
+            CAN_Register_Rx_Handler(hcan[bus], std_id, Count_Rx_Handler, &Rx_Count[bus][std_id]);
+        }
+    }
+    CAN_Filter_Apply();
+    init_finished = true;
+
+    for (uint8_t bus = 0; bus < 2; bus++)
+    {
+        uint8_t first_bank = bus == 0 ? 0 : CAN_FILTER_SLAVE_START_BANK;
+        uint8_t bank_limit = bus == 0 ? CAN_FILTER_SLAVE_START_BANK : CAN_FILTER_BANK_NUM - CAN_FILTER_SLAVE_START_BANK;
+        Struct_CAN_Filter_Bank bank[CAN_FILTER_SLAVE_START_BANK];
+        uint32_t mismatch;
+
+        // 规划结果: 组数、模式与FIFO负载与预期一致
+        uint8_t bank_num = CAN_Filter_Plan(Now->ID[bus], Now->ID_Num[bus], first_bank, bank_limit, bank);
+        mismatch = Check_Plan(Now->ID[bus], Now->ID_Num[bus], first_bank, bank_limit, bank, bank_num);
+        uint8_t mask_num = 0;
+        uint8_t fifo_load[2] = {0, 0};
+        for (uint8_t i = 0; i < bank_num && bank_num != CAN_FILTER_PLAN_FAIL; i++)
+        {
+            mask_num += bank[i].Mode == CAN_FILTERMODE_IDMASK ? 1 : 0;
+            fifo_load[bank[i].FIFO == CAN_RX_FIFO0 ? 0 : 1] += bank[i].ID_Num;
+        }
+        mismatch += (mask_num != Now->Mask_Num[bus] || bank_num - mask_num != Now->List_Num[bus]) ? 1 : 0;
+        mismatch += (fifo_load[0] != Now->FIFO_Load[bus][0] || fifo_load[1] != Now->FIFO_Load[bus][1]) ? 1 : 0;
+        printf("  CAN%u %2u ids: %u mask + %u list banks, FIFO0/FIFO1 load %u/%u\n", bus + 1, Now->ID_Num[bus], mask_num, bank_num - mask_num, fifo_load[0], fifo_load[1]);
+        snprintf(name, sizeof(name), "%s CAN%u plan", Now->Name, bus + 1);
+        Report(mismatch, name);
+
+        // 硬件过滤器: 本路范围内恰好启用规划的各组, 模式与FIFO一致, 另一路的组不受影响
+        mismatch = 0;
+        for (uint8_t i = 0; i < bank_limit; i++)
+        {
+            uint32_t filter_bit = 1U << (first_bank + i);
+            bool active = (CAN1->FA1R & filter_bit) != 0;
+            mismatch += active != (i < bank_num) ? 1 : 0;
+            if (i < bank_num && active)
+            {
+                mismatch += ((CAN1->FM1R & filter_bit) != 0) != (bank[i].Mode == CAN_FILTERMODE_IDLIST) ? 1 : 0;
+                mismatch += ((CAN1->FFA1R & filter_bit) != 0) != (bank[i].FIFO == CAN_RX_FIFO1) ? 1 : 0;
+                mismatch += (CAN1->FS1R & filter_bit) == 0 ? 1 : 0;
+            }
+        }
+        mismatch += ((CAN1->FMR >> 8) & 0x3f) != CAN_FILTER_SLAVE_START_BANK ? 1 : 0;
+        snprintf(name, sizeof(name), "%s CAN%u registers", Now->Name, bus + 1);
+        Report(mismatch, name);
+
+        // 逐个注入全部标准帧ID, 只有登记的ID被接收, 且恰好分发一次
+        mismatch = 0;
+        Struct_Sim_CAN_Statistic statistic_start = Sim_CAN_Get_Statistic(hcan[bus]);
+        for (uint16_t std_id = 0; std_id < 0x800; std_id++)
+        {
+            bool registered = false;
+            for (uint8_t i = 0; i < Now->ID_Num[bus]; i++)
+            {
+                registered = registered || Now->ID[bus][i] == std_id;
+            }
+
+            bool accepted = Sim_CAN_Receive(hcan[bus], std_id, data, 8);
+            CAN_Rx_Dispatch(hcan[bus]);
+            mismatch += accepted != registered ? 1 : 0;
+            mismatch += Rx_Count[bus][std_id] != (registered ? 1U : 0U) ? 1 : 0;
+        }
+        Struct_Sim_CAN_Statistic statistic_end = Sim_CAN_Get_Statistic(hcan[bus]);
+        mismatch += statistic_end.Rx_Frame_Num - statistic_start.Rx_Frame_Num != Now->ID_Num[bus] ? 1 : 0;
+        mismatch += statistic_end.Rx_Filtered_Num - statistic_start.Rx_Filtered_Num != 0x800U - Now->ID_Num[bus] ? 1 : 0;
+        mismatch += statistic_end.Rx_Overrun_Num != statistic_start.Rx_Overrun_Num ? 1 : 0;
+        snprintf(name, sizeof(name), "%s CAN%u accepted ids", Now->Name, bus + 1);
+        Report(mismatch, name);
+    }
+
+    // 注销本布局的登记, 下一种布局从空注册表开始
+    init_finished = false;
+    for (uint8_t bus = 0; bus < 2; bus++)
+    {
+        for (uint8_t i = 0; i < Now->ID_Num[bus]; i++)
+        {
+            CAN_Unregister_Rx_Handler(hcan[bus], Now->ID[bus][i]);
+        }
+    }
+}
+
+/**
+ * @brief 主函数
+ *
+ * @return int 全部通过返回0
+ */
+int main()
+{
+    for (const Struct_CAN_Filter_Layout &now : Layout)
+    {
+        printf("%s\n", now.Name);
+        Check_Layout(&now);
+    }
+    Report(CAN_Get_Register_Error_Num(), "register errors");
+    Report(Check_Random(), "random id sets");
+    Report(Check_Plan_Fail(), "plan fail");
+
+    printf("%s, %u failed\n", Fail_Num == 0 ? "PASS" : "FAIL", (unsigned) Fail_Num);
+    return (Fail_Num == 0 ? 0 : 1);
+}
+
+/*****************************************************************************/
@@ -0,0 +1,282 @@
+/**
+ * @file sim_bmi088.cpp
+ * @author WFZ
+ * @brief BMI088的主机寄存器模型, 挂在仿真SPI1上, 让固件的IMU驱动在主机上原样运行
+ * @version 0.0
+ * @date 2026-1-22
+ *
+ * @note 片选引脚与dvc_bmi088.h一致: 加速度计PA4, 陀螺仪PB0, 低电平有效.
+ *       片选期间第一个字节是地址, 最高位为1表示读, 之后的字节按地址自增连续读写.
+ *       加速度计读操作在地址之后有1个dummy字节, 这里dummy字节回送所寻址的寄存器,
+ *       这样固件中2字节的单寄存器读取与跳过dummy的连续读取都能读到正确的值.
+ *       数据寄存器按量程寄存器的当前设置量化, 温度按手册0.125°C/LSB的11位补码编码.
+ *
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "sim_bmi088.h"
+#include <math.h>
+
+/* Private macros ------------------------------------------------------------*/
+
+#define SIM_BMI088_GRAVITY 9.80665f
+#define SIM_BMI088_RAD_TO_DEG (180.0f / 3.14159265358979f)
+
+/* Private types -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+
+// 仿真SPI与GPIO的截获回调只有一个, 同一时刻只挂一片仿真BMI088
+static Class_Sim_BMI088 *Sim_BMI088_Instance = NULL;
+
+/* Private function declarations ---------------------------------------------*/
+
+static void Sim_BMI088_GPIO_Write_Call_Back(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState);
+
+static void Sim_BMI088_SPI_Call_Back(SPI_HandleTypeDef *hspi, const uint8_t *Tx_Data, uint8_t *Rx_Data, uint16_t Length);
+
+static void Sim_BMI088_Write_Int16(uint8_t *Register, float Value);
+
+/* Function prototypes -------------------------------------------------------*/
+
+/**
+ * @brief 仿真BMI088初始化, 并接管仿真SPI与GPIO的截获
+ *
+ * @param hspi 绑定的SPI
+ */
+void Class_Sim_BMI088::Init(SPI_HandleTypeDef *hspi)
+{
+    SPI_Handler = hspi;
+
+    Reset_Acc();
+    Reset_Gyro();
+    Acc_Selected = false;
+    Gyro_Selected = false;
+    Byte_Index = 0;
+
+    Sim_BMI088_Instance = this;
+    Sim_SPI_Set_Call_Back(Sim_BMI088_SPI_Call_Back);
+    Sim_GPIO_Set_Write_Call_Back(Sim_BMI088_GPIO_Write_Call_Back);
+}
+
+/**
+ * @brief 设定角速度, rad/s
+ *
+ * @param Gyro_X X轴角速度
+ * @param Gyro_Y Y轴角速度
+ * @param Gyro_Z Z轴角速度
+ */
+void Class_Sim_BMI088::Set_Gyro(float Gyro_X, float Gyro_Y, float Gyro_Z)
+{
+    Gyro[0] = Gyro_X;
+    Gyro[1] = Gyro_Y;
+    Gyro[2] = Gyro_Z;
+}
+
+/**
+ * @brief 设定加速度, m/s², 静止水平放置时为(0, 0, g)
+ *
+ * @param Acc_X X轴加速度
+ * @param Acc_Y Y轴加速度
+ * @param Acc_Z Z轴加速度
+ */
+void Class_Sim_BMI088::Set_Acc(float Acc_X, float Acc_Y, float Acc_Z)
+{
+    Acc[0] = Acc_X;
+    Acc[1] = Acc_Y;
+    Acc[2] = Acc_Z;
+}
+
+/**
+ * @brief 设定温度, °C
+ *
+ * @param __Temperature 温度
+ */
+void Class_Sim_BMI088::Set_Temperature(float __Temperature)
+{
+    Temperature = __Temperature;
+}
+
+/**
+ * @brief 处理片选引脚的电平变化, 片选拉低开始一次传输
+ *
+ * @param GPIOx GPIO端口
+ * @param GPIO_Pin 引脚
+ * @param PinState 电平
+ */
+void Class_Sim_BMI088::GPIO_Write(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState)
+{
+    if (GPIOx == GPIOA && GPIO_Pin == GPIO_PIN_4)
+    {
+        Acc_Selected = PinState == GPIO_PIN_RESET;
+        Byte_Index = 0;
+    }
+    else if (GPIOx == GPIOB && GPIO_Pin == GPIO_PIN_0)
+    {
+        Gyro_Selected = PinState == GPIO_PIN_RESET;
+        Byte_Index = 0;
+    }
+}
+
+/**
+ * @brief 处理一段SPI传输
+ *
+ * @param hspi SPI编号
+ * @param Tx_Data 主机发送的数据, NULL表示主机只接收, 总线上发送0xff
+ * @param Rx_Data 主机接收的数据, NULL表示主机只发送
+ * @param Length 字节数
+ */
+void Class_Sim_BMI088::SPI_Transfer(SPI_HandleTypeDef *hspi, const uint8_t *Tx_Data, uint8_t *Rx_Data, uint16_t Length)
+{
+    // 两片同时选中时总线冲突, 真实硬件上读回的数据也不可用
+    if (hspi->Instance != SPI_Handler->Instance || Acc_Selected == Gyro_Selected)
+    {
+        return;
+    }
+
+    uint8_t *reg = Acc_Selected ? Acc_Register : Gyro_Register;
+
+    for (uint16_t i = 0; i < Length; i++)
+    {
+        uint8_t tx = Tx_Data != NULL ? Tx_Data[i] : 0xff;
+        uint8_t rx = 0;
+
+        if (Byte_Index == 0)
+        {
+            Read_Flag = (tx & 0x80) != 0;
+            Address = tx & 0x7f;
+            if (Read_Flag)
+            {
+                Update_Data_Register();
+            }
+        }
+        else if (Read_Flag)
+        {
+            rx = reg[Address];
+            // 加速度计的第一个字节是dummy, 地址不自增
+            if (!(Acc_Selected && Byte_Index == 1))
+            {
+                Address = (Address + 1) & 0x7f;
+            }
+        }
+        else
+        {
+            if (Address == 0x7e && tx == 0xb6 && Acc_Selected)
+            {
+                Reset_Acc();
+            }
+            else if (Address == 0x14 && tx == 0xb6 && Gyro_Selected)
+            {
+                Reset_Gyro();
+            }
+            else if (Address != 0x00)
+            {
+                reg[Address] = tx;
+            }
+            Address = (Address + 1) & 0x7f;
+        }
+
+        if (Rx_Data != NULL)
+        {
+            Rx_Data[i] = rx;
+        }
+        Byte_Index++;
+    }
+}
+
+/**
+ * @brief 加速度计寄存器恢复上电默认值
+ *
+ */
+void Class_Sim_BMI088::Reset_Acc()
+{
+    memset(Acc_Register, 0, sizeof(Acc_Register));
+    Acc_Register[0x00] = Acc_Chip_ID;
+    Acc_Register[0x40] = 0xa8;
+    Acc_Register[0x41] = 0x01;
+    Acc_Register[0x7c] = 0x03;
+}
+
+/**
+ * @brief 陀螺仪寄存器恢复上电默认值
+ *
+ */
+void Class_Sim_BMI088::Reset_Gyro()
+{
+    memset(Gyro_Register, 0, sizeof(Gyro_Register));
+    Gyro_Register[0x00] = Gyro_Chip_ID;
+    Gyro_Register[0x0f] = 0x00;
+    Gyro_Register[0x10] = 0x80;
+}
+
+/**
+ * @brief 按当前量程把物理量量化到数据寄存器, 每次读操作开始时刷新
+ *
+ */
+void Class_Sim_BMI088::Update_Data_Register()
+{
+    // 加速度计量程3g<<range, 满量程对应32768
+    float acc_lsb_per_g = 32768.0f / (float) (3 << (Acc_Register[0x41] & 0x03));
+    for (int i = 0; i < 3; i++)
+    {
+        Sim_BMI088_Write_Int16(&Acc_Register[0x12 + i * 2], Acc[i] / SIM_BMI088_GRAVITY * acc_lsb_per_g);
+    }
+
+    // 陀螺仪量程2000dps>>range, 满量程对应32768
+    uint8_t gyro_range = Gyro_Register[0x0f] & 0x07;
+    float gyro_lsb_per_dps = 32768.0f / (float) (2000 >> (gyro_range > 4 ? 0 : gyro_range));
+    for (int i = 0; i < 3; i++)
+    {
+        Sim_BMI088_Write_Int16(&Gyro_Register[0x02 + i * 2], Gyro[i] * SIM_BMI088_RAD_TO_DEG * gyro_lsb_per_dps);
+    }
+
+    // 温度, 11位补码, 高8位在0x22, 低3位在0x23的高3位
+    int32_t temp = (int32_t) lroundf((Temperature - 23.0f) / 0.125f);
+    if (temp > 1023) temp = 1023;
+    if (temp < -1024) temp = -1024;
+    uint16_t temp_raw = (uint16_t) temp & 0x07ff;
+    Acc_Register[0x22] = temp_raw >> 3;
+    Acc_Register[0x23] = (temp_raw & 0x07) << 5;
+}
+
+/**
+ * @brief 仿真GPIO截获, 转发给仿真BMI088
+ *
+ */
+static void Sim_BMI088_GPIO_Write_Call_Back(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState)
+{
+    if (Sim_BMI088_Instance != NULL)
+    {
+        Sim_BMI088_Instance->GPIO_Write(GPIOx, GPIO_Pin, PinState);
+    }
+}
+
+/**
+ * @brief 仿真SPI截获, 转发给仿真BMI088
+ *
+ */
+static void Sim_BMI088_SPI_Call_Back(SPI_HandleTypeDef *hspi, const uint8_t *Tx_Data, uint8_t *Rx_Data, uint16_t Length)
+{
+    if (Sim_BMI088_Instance != NULL)
+    {
+        Sim_BMI088_Instance->SPI_Transfer(hspi, Tx_Data, Rx_Data, Length);
+    }
+}
+
+/**
+ * @brief 饱和并以小端序写入一个16位数据寄存器
+ *
+ * @param Register 低字节寄存器
+ * @param Value 原始值
+ */
+static void Sim_BMI088_Write_Int16(uint8_t *Register, float Value)
+{
+    int32_t tmp = (int32_t) lroundf(Value);
+    if (tmp > INT16_MAX) tmp = INT16_MAX;
+    if (tmp < INT16_MIN) tmp = INT16_MIN;
+    Register[0] = (uint16_t) tmp;
+    Register[1] = (uint16_t) tmp >> 8;
+}
+
+/*****************************************************************************/
@@ -0,0 +1,95 @@
+/**
+ * @file sim_bmi088.h
+ * @author WFZ
+ * @brief BMI088的主机寄存器模型, 挂在仿真SPI1上, 让固件的IMU驱动在主机上原样运行
+ * @version 0.0
+ * @date 2026-1-22
+ *
+ *
+ */
+
+#ifndef SIM_BMI088_H
+#define SIM_BMI088_H
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "sim_hal.h"
+
+/* Exported macros -----------------------------------------------------------*/
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+ * @brief 仿真BMI088, 加速度计与陀螺仪各有一份寄存器表, 由片选引脚决定访问哪一个
+ *
+ */
+class Class_Sim_BMI088
+{
+public:
+    void Init(SPI_HandleTypeDef *hspi);
+
+    void Set_Gyro(float Gyro_X, float Gyro_Y, float Gyro_Z);
+
+    void Set_Acc(float Acc_X, float Acc_Y, float Acc_Z);
+
+    void Set_Temperature(float Temperature);
+
+    void GPIO_Write(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState);
+
+    void SPI_Transfer(SPI_HandleTypeDef *hspi, const uint8_t *Tx_Data, uint8_t *Rx_Data, uint16_t Length);
+
+protected:
+    // 初始化相关常量
+
+    // 绑定的SPI
+    SPI_HandleTypeDef *SPI_Handler;
+
+    // 常量
+
+    // 加速度计芯片ID
+    uint8_t Acc_Chip_ID = 0x1e;
+    // 陀螺仪芯片ID
+    uint8_t Gyro_Chip_ID = 0x0f;
+
+    // 内部变量
+
+    // 加速度计寄存器表
+    uint8_t Acc_Register[128];
+    // 陀螺仪寄存器表
+    uint8_t Gyro_Register[128];
+    // 加速度计片选有效
+    bool Acc_Selected = false;
+    // 陀螺仪片选有效
+    bool Gyro_Selected = false;
+    // 本次片选内已传输的字节数, 0表示下一个字节是地址
+    uint16_t Byte_Index = 0;
+    // 本次片选内访问的寄存器地址, 连续读写时自增
+    uint8_t Address = 0;
+    // 本次片选是读操作
+    bool Read_Flag = false;
+
+    // 读变量
+
+    // 角速度, rad/s
+    float Gyro[3] = {0.0f, 0.0f, 0.0f};
+    // 加速度, m/s²
+    float Acc[3] = {0.0f, 0.0f, 9.80665f};
+    // 温度, °C
+    float Temperature = 25.0f;
+
+    // 内部函数
+
+    void Reset_Acc();
+
+    void Reset_Gyro();
+
+    void Update_Data_Register();
+};
+
+/* Exported variables --------------------------------------------------------*/
+
+/* Exported function declarations --------------------------------------------*/
+
+#endif
+
+/*****************************************************************************/
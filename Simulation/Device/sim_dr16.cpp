@@ -0,0 +1,144 @@
+/**
+ * @file sim_dr16.cpp
+ * @author WFZ
+ * @brief DR16接收机的主机模型, 按实物格式打包18字节帧并从仿真USART3送入固件
+ * @version 0.0
+ * @date 2026-1-24
+ *
+ * @note 帧格式直接使用dvc_dr16.h中的Struct_DR16_UART_Data, 与固件解析保证一致.
+ *       摇杆输入归一化到-1~1, 鼠标输入归一化到-1~1, 开关取SWITCH_UP/SWITCH_MIDDLE/SWITCH_DOWN.
+ *
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "sim_dr16.h"
+
+/* Private macros ------------------------------------------------------------*/
+
+/* Private types -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+
+/* Private function declarations ---------------------------------------------*/
+
+/* Function prototypes -------------------------------------------------------*/
+
+/**
+ * @brief 仿真DR16初始化, 摇杆居中, 开关拨到上
+ *
+ * @param huart 绑定的UART
+ */
+void Class_Sim_DR16::Init(UART_HandleTypeDef *huart)
+{
+    UART_Handler = huart;
+
+    memset(&Frame, 0, sizeof(Frame));
+    Set_Rocker(0.0f, 0.0f, 0.0f, 0.0f);
+    Set_Yaw(0.0f);
+    Set_Switch(SWITCH_UP, SWITCH_UP);
+}
+
+/**
+ * @brief 设定摇杆, -1~1
+ *
+ * @param Right_X 右摇杆X, 通道0
+ * @param Right_Y 右摇杆Y, 通道1
+ * @param Left_X 左摇杆X, 通道2
+ * @param Left_Y 左摇杆Y, 通道3
+ */
+void Class_Sim_DR16::Set_Rocker(float Right_X, float Right_Y, float Left_X, float Left_Y)
+{
+    Frame.Channel_0 = Rocker_To_Raw(Right_X);
+    Frame.Channel_1 = Rocker_To_Raw(Right_Y);
+    Frame.Channel_2 = Rocker_To_Raw(Left_X);
+    Frame.Channel_3 = Rocker_To_Raw(Left_Y);
+}
+
+/**
+ * @brief 设定拨轮, -1~1
+ *
+ * @param Yaw 拨轮
+ */
+void Class_Sim_DR16::Set_Yaw(float Yaw)
+{
+    Frame.Channel_Yaw = Rocker_To_Raw(Yaw);
+}
+
+/**
+ * @brief 设定拨动开关
+ *
+ * @param Left_Switch 左开关, SWITCH_UP/SWITCH_MIDDLE/SWITCH_DOWN
+ * @param Right_Switch 右开关, SWITCH_UP/SWITCH_MIDDLE/SWITCH_DOWN
+ */
+void Class_Sim_DR16::Set_Switch(uint8_t Left_Switch, uint8_t Right_Switch)
+{
+    Frame.Switch_1 = Left_Switch;
+    Frame.Switch_2 = Right_Switch;
+}
+
+/**
+ * @brief 设定鼠标移动, -1~1
+ *
+ * @param Mouse_X 鼠标X
+ * @param Mouse_Y 鼠标Y
+ * @param Mouse_Z 鼠标滚轮
+ */
+void Class_Sim_DR16::Set_Mouse(float Mouse_X, float Mouse_Y, float Mouse_Z)
+{
+    Math_Constrain(&Mouse_X, -1.0f, 32767.0f / 32768.0f);
+    Math_Constrain(&Mouse_Y, -1.0f, 32767.0f / 32768.0f);
+    Math_Constrain(&Mouse_Z, -1.0f, 32767.0f / 32768.0f);
+    Frame.Mouse_X = (int16_t) lroundf(Mouse_X * 32768.0f);
+    Frame.Mouse_Y = (int16_t) lroundf(Mouse_Y * 32768.0f);
+    Frame.Mouse_Z = (int16_t) lroundf(Mouse_Z * 32768.0f);
+}
+
+/**
+ * @brief 设定鼠标按键
+ *
+ * @param Left_Key 左键, KEY_FREE/KEY_PRESSED
+ * @param Right_Key 右键, KEY_FREE/KEY_PRESSED
+ */
+void Class_Sim_DR16::Set_Mouse_Key(uint8_t Left_Key, uint8_t Right_Key)
+{
+    Frame.Mouse_Left_Key = Left_Key;
+    Frame.Mouse_Right_Key = Right_Key;
+}
+
+/**
+ * @brief 设定键盘按键
+ *
+ * @param Keyboard_Key 按键位图, 位序见KEY_W等宏定义
+ */
+void Class_Sim_DR16::Set_Keyboard(uint16_t Keyboard_Key)
+{
+    Frame.Keyboard_Key = Keyboard_Key;
+}
+
+/**
+ * @brief 发送一帧, 实物每SIM_DR16_PERIOD_MS发送一次
+ *
+ * @return true 固件收到了该帧
+ * @return false 固件未开启接收
+ */
+bool Class_Sim_DR16::Send()
+{
+    uint8_t buffer[18] = {0};
+    memcpy(buffer, &Frame, sizeof(Frame) < sizeof(buffer) ? sizeof(Frame) : sizeof(buffer));
+    return (Sim_UART_Receive(UART_Handler, buffer, 18));
+}
+
+/**
+ * @brief 摇杆归一化值转换为原始值
+ *
+ * @param Value 归一化值, -1~1
+ * @return uint16_t 原始值, 364~1684
+ */
+uint16_t Class_Sim_DR16::Rocker_To_Raw(float Value)
+{
+    Math_Constrain(&Value, -1.0f, 1.0f);
+    return ((uint16_t) lroundf(Rocker_Offset + Value * Rocker_Num));
+}
+
+/*****************************************************************************/
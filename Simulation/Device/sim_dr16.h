@@ -0,0 +1,78 @@
+/**
+ * @file sim_dr16.h
+ * @author WFZ
+ * @brief DR16接收机的主机模型, 按实物格式打包18字节帧并从仿真USART3送入固件
+ * @version 0.0
+ * @date 2026-1-24
+ *
+ *
+ */
+
+#ifndef SIM_DR16_H
+#define SIM_DR16_H
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "sim_hal.h"
+#include "dvc_dr16.h"
+
+/* Exported macros -----------------------------------------------------------*/
+
+// 实物接收机的发送周期, ms
+#define SIM_DR16_PERIOD_MS 14
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+ * @brief 仿真DR16, 保存当前的摇杆/开关/键鼠状态, 每次Send发送一帧
+ *
+ */
+class Class_Sim_DR16
+{
+public:
+    void Init(UART_HandleTypeDef *huart);
+
+    void Set_Rocker(float Right_X, float Right_Y, float Left_X, float Left_Y);
+
+    void Set_Yaw(float Yaw);
+
+    void Set_Switch(uint8_t Left_Switch, uint8_t Right_Switch);
+
+    void Set_Mouse(float Mouse_X, float Mouse_Y, float Mouse_Z);
+
+    void Set_Mouse_Key(uint8_t Left_Key, uint8_t Right_Key);
+
+    void Set_Keyboard(uint16_t Keyboard_Key);
+
+    bool Send();
+
+protected:
+    // 初始化相关常量
+
+    // 绑定的UART
+    UART_HandleTypeDef *UART_Handler;
+
+    // 常量
+
+    // 摇杆中值
+    uint16_t Rocker_Offset = 1024;
+    // 摇杆半行程
+    uint16_t Rocker_Num = 660;
+
+    // 内部变量
+
+    // 待发送的帧
+    Struct_DR16_UART_Data Frame;
+
+    // 内部函数
+
+    uint16_t Rocker_To_Raw(float Value);
+};
+
+/* Exported variables --------------------------------------------------------*/
+
+/* Exported function declarations --------------------------------------------*/
+
+#endif
+
+/*****************************************************************************/
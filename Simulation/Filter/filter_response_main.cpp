@@ -0,0 +1,323 @@
+/**
+ * @file filter_response_main.cpp
+ * @author WFZ
+ * @brief alg_filter的主机检查: 双二阶低通/高通/陷波与巴特沃斯级联的实测幅频响应对比解析式,
+ *        滑动平均对比sinc解析式与逐窗求和, 滑动中值对比逐窗排序, 变化率限制与多通道独立性
+ * @version 0.0
+ * @date 2026-1-31
+ *
+ * @note 编译(在仓库根目录, 主机g++):
+ *       g++ -std=c++11 -O2 -IUser/1_Middleware/1_Driver/Math -IUser/1_Middleware/2_Algorithm/Filter
+ *           User/1_Middleware/1_Driver/Math/drv_math.cpp
+ *           Simulation/Filter/filter_response_main.cpp -o filter_response
+ *
+ *       运行: ./filter_response, 逐项输出最大误差, 全部通过时返回0
+ *       幅频响应用正弦激励, 稳定后在整数个周期上做正交解调求增益; 解析式按预畸变双线性变换,
+ *       即数字频率f对应模拟归一化频率 tan(PI * f / fs) / tan(PI * fc / fs)
+ *
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <math.h>
+#include <stdint.h>
+#include <algorithm>
+#include "alg_filter.h"
+
+/* Private macros ------------------------------------------------------------*/
+
+// 采样频率, Hz
+#define FILTER_RESPONSE_FS 1000.0
+// 激励稳定时间与测量时间, 样本数, 测量时间为10s, 0.1Hz整数倍的频率恰为整数个周期
+#define FILTER_RESPONSE_SETTLE 20000
+#define FILTER_RESPONSE_MEASURE 10000
+// 增益误差上限, 相对通带增益
+#define FILTER_RESPONSE_GAIN_TOLERANCE 2.0e-3
+
+/* Private types -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+
+static uint32_t Fail_Num = 0;
+static uint32_t Random_State = 0x9E3779B9U;
+
+// 系数在编译期设计
+static constexpr Struct_Filter_Biquad_Coefficient Low_Pass_50 = Filter_Biquad_Low_Pass(50.0f, 1000.0f);
+static constexpr Struct_Filter_Biquad_Coefficient High_Pass_20 = Filter_Biquad_High_Pass(20.0f, 1000.0f);
+static constexpr Struct_Filter_Biquad_Coefficient Notch_50 = Filter_Biquad_Notch(50.0f, 1000.0f, 5.0f);
+static constexpr Struct_Filter_Biquad_Coefficient Butterworth_4_80[2] = {
+    Filter_Biquad_Low_Pass(80.0f, 1000.0f, Filter_Butterworth_Q(0, 2)),
+    Filter_Biquad_Low_Pass(80.0f, 1000.0f, Filter_Butterworth_Q(1, 2)),
+};
+// 直流增益为1: (B0 + B1 + B2) / (1 + A1 + A2)
+static_assert(Low_Pass_50.B0 > 0.0f && Low_Pass_50.B0 + Low_Pass_50.B1 + Low_Pass_50.B2 > 0.99f * (1.0f + Low_Pass_50.A1 + Low_Pass_50.A2),
+              "low pass designed at compile time");
+static_assert(Filter_Butterworth_Q(0, 2) > 0.54f && Filter_Butterworth_Q(0, 2) < 0.542f, "butterworth Q of 4th order, first section");
+
+/* Private function declarations ---------------------------------------------*/
+
+/* Function prototypes -------------------------------------------------------*/
+
+/**
+ * @brief [-1, 1) 均匀随机数
+ *
+ * @return float 随机数
+ */
+static float Random()
+{
+    Random_State ^= Random_State << 13;
+    Random_State ^= Random_State >> 17;
+    Random_State ^= Random_State << 5;
+    return ((float) (Random_State >> 8) / 8388608.0f - 1.0f);
+}
+
+/**
+ * @brief 输出一项结果并与上限比较
+ *
+ * @param Name 名称
+ * @param Error 最大误差
+ * @param Limit 上限
+ */
+static void Check(const char *Name, double Error, double Limit)
+{
+    bool pass = Error <= Limit;
+
+    printf("  %-40s max %.3e (limit %.1e)  %s\n", Name, Error, Limit, pass ? "ok" : "FAIL");
+    if (!pass)
+    {
+        Fail_Num++;
+    }
+}
+
+/**
+ * @brief 正弦激励下的实测增益
+ *
+ * @param Filter 滤波函数, 输入一个样本返回输出
+ * @param Frequency 激励频率, Hz
+ * @return double 增益
+ */
+template <typename Type_Filter>
+static double Measure_Gain(Type_Filter Filter, double Frequency)
+{
+    double in_phase = 0.0, quadrature = 0.0;
+
+    for (uint32_t n = 0; n < FILTER_RESPONSE_SETTLE + FILTER_RESPONSE_MEASURE; n++)
+    {
+        double phase = 2.0 * M_PI * Frequency * n / FILTER_RESPONSE_FS;
+        double y = Filter((float) sin(phase));
+
+        if (n >= FILTER_RESPONSE_SETTLE)
+        {
+            in_phase += y * sin(phase);
+            quadrature += y * cos(phase);
+        }
+    }
+
+    return (2.0 * sqrt(in_phase * in_phase + quadrature * quadrature) / FILTER_RESPONSE_MEASURE);
+}
+
+/**
+ * @brief 模拟归一化频率 r = tan(PI f / fs) / tan(PI fc / fs)
+ *
+ */
+static double Normalized_Frequency(double Frequency, double Cutoff_Frequency)
+{
+    return (tan(M_PI * Frequency / FILTER_RESPONSE_FS) / tan(M_PI * Cutoff_Frequency / FILTER_RESPONSE_FS));
+}
+
+/**
+ * @brief 检查频率表
+ *
+ */
+static const double Frequency_List[] = {1.0, 5.0, 10.0, 20.0, 35.0, 45.0, 50.0, 55.0, 80.0, 120.0, 200.0, 350.0, 450.0};
+
+/**
+ * @brief 双二阶各类型的幅频响应
+ *
+ */
+static void Check_Biquad()
+{
+    printf("biquad magnitude response vs analytic, fs = %.0f Hz\n", FILTER_RESPONSE_FS);
+
+    double error_low_pass = 0.0, error_high_pass = 0.0, error_notch = 0.0, error_butterworth = 0.0;
+    for (uint32_t i = 0; i < sizeof(Frequency_List) / sizeof(Frequency_List[0]); i++)
+    {
+        double f = Frequency_List[i];
+
+        {
+            Class_Filter_Biquad<1> filter;
+            filter.Init(&Low_Pass_50);
+            double r = Normalized_Frequency(f, 50.0);
+            double q = 0.70710678;
+            double analytic = 1.0 / sqrt((1.0 - r * r) * (1.0 - r * r) + (r / q) * (r / q));
+            error_low_pass = fmax(error_low_pass, fabs(Measure_Gain([&](float x) { return filter.Update(x); }, f) - analytic));
+        }
+        {
+            Class_Filter_Biquad<1> filter;
+            filter.Init(&High_Pass_20);
+            double r = Normalized_Frequency(f, 20.0);
+            double q = 0.70710678;
+            double analytic = r * r / sqrt((1.0 - r * r) * (1.0 - r * r) + (r / q) * (r / q));
+            error_high_pass = fmax(error_high_pass, fabs(Measure_Gain([&](float x) { return filter.Update(x); }, f) - analytic));
+        }
+        {
+            Class_Filter_Biquad<1> filter;
+            filter.Init(&Notch_50);
+            double r = Normalized_Frequency(f, 50.0);
+            double q = 5.0;
+            double analytic = fabs(1.0 - r * r) / sqrt((1.0 - r * r) * (1.0 - r * r) + (r / q) * (r / q));
+            error_notch = fmax(error_notch, fabs(Measure_Gain([&](float x) { return filter.Update(x); }, f) - analytic));
+        }
+        {
+            Class_Filter_Biquad<2> filter;
+            filter.Init(Butterworth_4_80);
+            double r = Normalized_Frequency(f, 80.0);
+            double analytic = 1.0 / sqrt(1.0 + pow(r, 8.0));
+            error_butterworth = fmax(error_butterworth, fabs(Measure_Gain([&](float x) { return filter.Update(x); }, f) - analytic));
+        }
+    }
+    Check("low pass 50 Hz, Q 0.707", error_low_pass, FILTER_RESPONSE_GAIN_TOLERANCE);
+    Check("high pass 20 Hz, Q 0.707", error_high_pass, FILTER_RESPONSE_GAIN_TOLERANCE);
+    Check("notch 50 Hz, Q 5", error_notch, FILTER_RESPONSE_GAIN_TOLERANCE);
+    Check("butterworth 4th order 80 Hz", error_butterworth, FILTER_RESPONSE_GAIN_TOLERANCE);
+
+    Class_Filter_Biquad<1> notch;
+    notch.Init(&Notch_50);
+    Check("notch gain at 50 Hz", Measure_Gain([&](float x) { return notch.Update(x); }, 50.0), 1.0e-3);
+}
+
+/**
+ * @brief 滑动平均: 幅频响应对比sinc解析式, 输出对比逐窗求和
+ *
+ */
+static void Check_Moving_Average()
+{
+    const uint32_t window = 8;
+
+    printf("moving average, window %u\n", (unsigned) window);
+
+    double error_response = 0.0;
+    for (uint32_t i = 0; i < sizeof(Frequency_List) / sizeof(Frequency_List[0]); i++)
+    {
+        double f = Frequency_List[i];
+        Class_Filter_Moving_Average<window> filter;
+        filter.Reset();
+        double analytic = fabs(sin(M_PI * f * window / FILTER_RESPONSE_FS) / (window * sin(M_PI * f / FILTER_RESPONSE_FS)));
+        error_response = fmax(error_response, fabs(Measure_Gain([&](float x) { return filter.Update(x); }, f) - analytic));
+    }
+    Check("magnitude vs |sin(PI f N / fs) / (N sin(PI f / fs))|", error_response, FILTER_RESPONSE_GAIN_TOLERANCE);
+
+    Class_Filter_Moving_Average<window> filter;
+    float history[window] = {};
+    double error_direct = 0.0;
+    filter.Reset();
+    for (uint32_t n = 0; n < 100000; n++)
+    {
+        float x = 100.0f + 10.0f * Random();
+        history[n % window] = x;
+        double sum = 0.0;
+        for (uint32_t i = 0; i < window; i++)
+        {
+            sum += history[i];
+        }
+        error_direct = fmax(error_direct, fabs(filter.Update(x) - sum / window));
+    }
+    Check("output vs direct window sum, offset 100", error_direct, 1.0e-4);
+}
+
+/**
+ * @brief 滑动中值: 对比逐窗排序, 输入含重复值与尖峰
+ *
+ */
+static void Check_Median()
+{
+    const uint32_t window = 5;
+
+    printf("sliding median, window %u\n", (unsigned) window);
+
+    Class_Filter_Median<window> filter;
+    float history[window] = {};
+    uint32_t mismatch = 0;
+    filter.Reset();
+    for (uint32_t n = 0; n < 100000; n++)
+    {
+        // 量化到0.25产生大量重复值, 偶尔加入尖峰
+        float x = floorf(Random() * 8.0f) * 0.25f;
+        if ((n % 97) == 0)
+        {
+            x += 1000.0f;
+        }
+        history[n % window] = x;
+        float sorted[window];
+        std::copy(history, history + window, sorted);
+        std::sort(sorted, sorted + window);
+        mismatch += (filter.Update(x) != sorted[window / 2]) ? 1 : 0;
+    }
+    Check("mismatches vs sorted window", mismatch, 0.0);
+}
+
+/**
+ * @brief 变化率限制与多通道独立性
+ *
+ */
+static void Check_Rate_Limiter_And_Channel()
+{
+    printf("rate limiter and channels\n");
+
+    Class_Filter_Rate_Limiter<1> limiter;
+    limiter.Init(2.0f, 4.0f, 0.001f);
+    double error = 0.0;
+    for (uint32_t n = 1; n <= 400; n++)
+    {
+        // 上升2/s, 阶跃到1需要500个周期
+        error = fmax(error, fabs(limiter.Update(1.0f) - 0.002 * n));
+    }
+    for (uint32_t n = 0; n < 200; n++)
+    {
+        limiter.Update(1.0f);
+    }
+    error = fmax(error, fabs(limiter.Get_Out() - 1.0));
+    for (uint32_t n = 1; n <= 100; n++)
+    {
+        // 下降4/s
+        error = fmax(error, fabs(limiter.Update(-1.0f) - (1.0 - 0.004 * n)));
+    }
+    Check("ramp slope, rise 2/s fall 4/s", error, 1.0e-5);
+
+    Class_Filter_Biquad<2, 3> multi;
+    Class_Filter_Biquad<2> single[3];
+    multi.Init(Butterworth_4_80);
+    double error_channel = 0.0;
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        single[i].Init(Butterworth_4_80);
+    }
+    for (uint32_t n = 0; n < 10000; n++)
+    {
+        for (uint32_t i = 0; i < 3; i++)
+        {
+            float x = Random() * (float) (i + 1);
+            error_channel = fmax(error_channel, fabs(multi.Update(x, i) - single[i].Update(x)));
+        }
+    }
+    Check("3-channel biquad vs 3 single channels", error_channel, 0.0);
+}
+
+/**
+ * @brief 主函数
+ *
+ * @return int 全部通过返回0
+ */
+int main()
+{
+    Check_Biquad();
+    Check_Moving_Average();
+    Check_Median();
+    Check_Rate_Limiter_And_Channel();
+
+    printf("%s, %u failed\n", Fail_Num == 0 ? "PASS" : "FAIL", (unsigned) Fail_Num);
+    return (Fail_Num == 0 ? 0 : 1);
+}
+
+/*****************************************************************************/
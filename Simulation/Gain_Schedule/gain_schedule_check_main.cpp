@@ -0,0 +1,310 @@
+/**
+ * @file gain_schedule_check_main.cpp
+ * @author WFZ
+ * @brief Class_PID_Gain_Schedule的主机检查: 查表插值与逐行扫描的参考实现逐位比较, 再检查写入PID与K_I变化时积分项输出连续
+ * @version 0.0
+ * @date 2026-2-6
+ *
+ * @note 编译(在仓库根目录, 主机g++):
+ *       g++ -std=c++11 -O2 -IUser/1_Middleware/1_Driver/Math -IUser/1_Middleware/2_Algorithm/PID -IUser/1_Middleware/2_Algorithm/Gain_Schedule
+ *           User/1_Middleware/1_Driver/Math/drv_math.cpp User/1_Middleware/2_Algorithm/PID/alg_pid.cpp
+ *           User/1_Middleware/2_Algorithm/Gain_Schedule/alg_gain_schedule.cpp
+ *           Simulation/Gain_Schedule/gain_schedule_check_main.cpp -o gain_schedule_check
+ *
+ *       运行: ./gain_schedule_check, 逐项输出不一致的次数, 全部通过时返回0
+ *
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include "alg_gain_schedule.h"
+
+/* Private macros ------------------------------------------------------------*/
+
+// 断点表行数上限
+#define GAIN_SCHEDULE_CHECK_POINT_MAX 64
+// 每种序列的周期数
+#define GAIN_SCHEDULE_CHECK_TICK 3000
+
+/* Private types -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+
+static uint32_t Fail_Num = 0;
+static uint32_t Random_State = 0x3C6EF372U;
+
+/* Private function declarations ---------------------------------------------*/
+
+/* Function prototypes -------------------------------------------------------*/
+
+/**
+ * @brief [-1, 1) 均匀随机数
+ *
+ * @return float 随机数
+ */
+static float Random()
+{
+    Random_State ^= Random_State << 13;
+    Random_State ^= Random_State >> 17;
+    Random_State ^= Random_State << 5;
+    return ((float) (Random_State >> 8) / 8388608.0f - 1.0f);
+}
+
+/**
+ * @brief 逐位比较两个浮点数
+ *
+ */
+static bool Same(float a, float b)
+{
+    return (memcmp(&a, &b, sizeof(float)) == 0);
+}
+
+/**
+ * @brief 记录一项检查
+ *
+ * @param Mismatch 不一致的次数
+ * @param Name 检查项名称
+ */
+static void Report(uint32_t Mismatch, const char *Name)
+{
+    printf("%-40s %s (%u)\n", Name, Mismatch == 0 ? "ok" : "FAIL", Mismatch);
+    Fail_Num += Mismatch;
+}
+
+/**
+ * @brief 参考实现: 逐行扫描找段, 与被测实现相同的插值公式
+ *
+ * @param Table 断点表
+ * @param Point_Num 行数
+ * @param X 调度变量
+ * @param Point 插值结果
+ * @return uint8_t 段号
+ */
+static uint8_t Reference_Lookup(const Struct_PID_Gain_Schedule_Point *Table, uint8_t Point_Num, float X, Struct_PID_Gain_Schedule_Point *Point)
+{
+    uint8_t segment = 0;
+    for (uint8_t i = 0; i + 1 < Point_Num; i++)
+    {
+        if (Table[i].X <= X)
+        {
+            segment = i;
+        }
+    }
+    const Struct_PID_Gain_Schedule_Point *left = &Table[segment];
+    const Struct_PID_Gain_Schedule_Point *right = &Table[segment + 1];
+    float ratio = (X - left->X) / (right->X - left->X);
+    ratio = ratio < 0.0f ? 0.0f : (ratio > 1.0f ? 1.0f : ratio);
+
+    Point->X = X;
+    Point->K_P = left->K_P + (right->K_P - left->K_P) * ratio;
+    Point->K_I = left->K_I + (right->K_I - left->K_I) * ratio;
+    Point->K_D = left->K_D + (right->K_D - left->K_D) * ratio;
+    Point->K_F = left->K_F + (right->K_F - left->K_F) * ratio;
+    Point->I_Out_Max = left->I_Out_Max + (right->I_Out_Max - left->I_Out_Max) * ratio;
+    Point->Out_Max = left->Out_Max + (right->Out_Max - left->Out_Max) * ratio;
+    return (segment);
+}
+
+/**
+ * @brief 生成随机断点表, 调度变量严格递增, 间距不均
+ *
+ * @param Table 断点表
+ * @param Point_Num 行数
+ */
+static void Table_Init(Struct_PID_Gain_Schedule_Point *Table, uint8_t Point_Num)
+{
+    float x = -10.0f;
+    for (uint8_t i = 0; i < Point_Num; i++)
+    {
+        x += 0.05f + 1.5f * (Random() + 1.0f);
+        Table[i] = {x, 2.0f + Random(), 10.0f + 5.0f * Random(), 0.01f + 0.005f * Random(), 0.1f * Random(), 5.0f + Random(), 10.0f + Random()};
+    }
+}
+
+/**
+ * @brief 一种序列下查表结果与参考实现比较
+ *
+ * @param Point_Num 行数
+ * @param Mode 0缓慢变化, 1随机跳变并越出表外, 2每周期落在断点上
+ * @return uint32_t 不一致的次数
+ */
+static uint32_t Check_Lookup(uint8_t Point_Num, int Mode)
+{
+    Struct_PID_Gain_Schedule_Point table[GAIN_SCHEDULE_CHECK_POINT_MAX];
+    Table_Init(table, Point_Num);
+    float x_min = table[0].X, x_max = table[Point_Num - 1].X;
+
+    Class_PID pid;
+    Class_PID_Gain_Schedule schedule;
+    pid.Init(0.0f, 0.0f, 0.0f);
+    schedule.Init(&pid, table, Point_Num);
+
+    uint32_t mismatch = 0;
+    float x = x_min;
+    for (uint32_t tick = 0; tick < GAIN_SCHEDULE_CHECK_TICK; tick++)
+    {
+        if (Mode == 0)
+        {
+            x += (x_max - x_min) * 0.002f * Random() + 0.0005f * (x_max - x_min);
+            x = x > x_max + 1.0f ? x_min - 1.0f : x;
+        }
+        else if (Mode == 1)
+        {
+            x = (x_min + x_max) / 2.0f + (x_max - x_min) * 0.6f * Random();
+        }
+        else
+        {
+            x = table[(uint32_t) ((Random() + 1.0f) * 0.5f * Point_Num) % Point_Num].X;
+        }
+
+        schedule.TIM_Calculate_PeriodElapsedCallback(x);
+
+        Struct_PID_Gain_Schedule_Point reference;
+        uint8_t segment = Reference_Lookup(table, Point_Num, x, &reference);
+        const Struct_PID_Gain_Schedule_Point &now = schedule.Get_Now_Point();
+        if (schedule.Get_Segment() != segment || !Same(now.X, reference.X) || !Same(now.K_P, reference.K_P) || !Same(now.K_I, reference.K_I) ||
+            !Same(now.K_D, reference.K_D) || !Same(now.K_F, reference.K_F) || !Same(now.I_Out_Max, reference.I_Out_Max) || !Same(now.Out_Max, reference.Out_Max))
+        {
+            mismatch++;
+        }
+    }
+    return (mismatch);
+}
+
+/**
+ * @brief 调度后的PID与直接写入参考参数的PID逐位比较, 覆盖绝对值取法
+ *
+ * @return uint32_t 不一致的次数
+ */
+static uint32_t Check_PID()
+{
+    Struct_PID_Gain_Schedule_Point table[8];
+    Table_Init(table, 8);
+    float x_min = table[0].X, x_max = table[7].X;
+
+    Class_PID scheduled, reference;
+    Class_PID_Gain_Schedule schedule;
+    scheduled.Init(0.0f, 0.0f, 0.0f);
+    reference.Init(0.0f, 0.0f, 0.0f);
+    schedule.Init(&scheduled, table, 8, PID_Gain_Schedule_Input_ABS);
+
+    Struct_PID_Gain_Schedule_Point point = table[0];
+    reference.Set_K_P(point.K_P);
+    reference.Set_K_I(point.K_I);
+    reference.Set_K_D(point.K_D);
+    reference.Set_K_F(point.K_F);
+    reference.Set_I_Out_Max(point.I_Out_Max);
+    reference.Set_Out_Max(point.Out_Max);
+
+    uint32_t mismatch = 0;
+    float now = 0.0f, pre_abs_x = x_min;
+    for (uint32_t tick = 0; tick < GAIN_SCHEDULE_CHECK_TICK; tick++)
+    {
+        // 调度变量正负交替, 绝对值缓慢扫过整张表
+        float abs_x = x_min + (x_max - x_min) * (0.5f + 0.6f * sinf(tick * 0.005f));
+        abs_x = abs_x < 0.0f ? 0.0f : abs_x;
+        float x = (tick & 1) ? -abs_x : abs_x;
+        float target = ((tick / 400) % 2 == 0) ? 2.0f : -1.0f;
+        now += (target - now) * 0.01f;
+        float feedback = now + 0.02f * Random();
+
+        schedule.TIM_Calculate_PeriodElapsedCallback(x);
+        if (abs_x != pre_abs_x)
+        {
+            float pre_k_i = point.K_I;
+            Reference_Lookup(table, 8, abs_x, &point);
+            if (point.K_I != pre_k_i && point.K_I != 0.0f && pre_k_i != 0.0f)
+            {
+                reference.Set_Integral_Error(reference.Get_Integral_Error() * pre_k_i / point.K_I);
+            }
+            reference.Set_K_P(point.K_P);
+            reference.Set_K_I(point.K_I);
+            reference.Set_K_D(point.K_D);
+            reference.Set_K_F(point.K_F);
+            reference.Set_I_Out_Max(point.I_Out_Max);
+            reference.Set_Out_Max(point.Out_Max);
+            pre_abs_x = abs_x;
+        }
+
+        scheduled.Set_Target(target);
+        scheduled.Set_Now(feedback);
+        scheduled.TIM_Adjust_PeriodElapsedCallback();
+        reference.Set_Target(target);
+        reference.Set_Now(feedback);
+        reference.TIM_Adjust_PeriodElapsedCallback();
+
+        if (!Same(scheduled.Get_Out(), reference.Get_Out()))
+        {
+            mismatch++;
+        }
+    }
+    return (mismatch);
+}
+
+/**
+ * @brief 只有积分项时, K_I随调度变量变化而输出保持不变
+ *
+ * @return uint32_t 不一致的次数
+ */
+static uint32_t Check_Integral_Hold()
+{
+    static const Struct_PID_Gain_Schedule_Point table[] = {
+        {0.0f, 0.0f, 10.0f, 0.0f, 0.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 40.0f, 0.0f, 0.0f, 0.0f, 0.0f},
+        {2.0f, 0.0f, 5.0f, 0.0f, 0.0f, 0.0f, 0.0f},
+    };
+    Class_PID pid;
+    Class_PID_Gain_Schedule schedule;
+    pid.Init(0.0f, 0.0f, 0.0f);
+    schedule.Init(&pid, table, 3);
+
+    // 先以单位误差积分100个周期, 积分项输出为1
+    for (int i = 0; i < 100; i++)
+    {
+        pid.Set_Target(1.0f);
+        pid.Set_Now(0.0f);
+        pid.TIM_Adjust_PeriodElapsedCallback();
+    }
+    float out = pid.Get_Out();
+
+    uint32_t mismatch = 0;
+    for (int i = 0; i <= 400; i++)
+    {
+        schedule.TIM_Calculate_PeriodElapsedCallback(2.0f * fabsf(sinf(i * 0.02f)));
+        pid.Set_Target(0.0f);
+        pid.Set_Now(0.0f);
+        pid.TIM_Adjust_PeriodElapsedCallback();
+        if (fabsf(pid.Get_Out() - out) > 1e-4f)
+        {
+            mismatch++;
+        }
+    }
+    return (mismatch);
+}
+
+int main()
+{
+    static const uint8_t point_num[] = {2, 3, 4, 7, 16, 64};
+    static const char *mode_name[] = {"drift", "jump", "breakpoint"};
+    char name[64];
+
+    for (uint8_t n : point_num)
+    {
+        for (int mode = 0; mode < 3; mode++)
+        {
+            snprintf(name, sizeof(name), "lookup %upt %s", n, mode_name[mode]);
+            Report(Check_Lookup(n, mode), name);
+        }
+    }
+    Report(Check_PID(), "pid abs");
+    Report(Check_Integral_Hold(), "integral hold");
+
+    printf("%s, %u failed\n", Fail_Num == 0 ? "PASS" : "FAIL", Fail_Num);
+    return (Fail_Num == 0 ? 0 : 1);
+}
+
+/*****************************************************************************/
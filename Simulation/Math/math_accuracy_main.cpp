@@ -0,0 +1,230 @@
+/**
+ * @file math_accuracy_main.cpp
+ * @author WFZ
+ * @brief drv_math单精度三角/反三角/平方根倒数内核的精度检查: 与双精度libm逐点比较, 误差超过文档标称值则失败
+ * @version 0.0
+ * @date 2026-1-29
+ *
+ * @note 编译(在仓库根目录, 主机g++):
+ *       g++ -std=c++11 -O2 -IUser/1_Middleware/1_Driver/Math
+ *           User/1_Middleware/1_Driver/Math/drv_math.cpp
+ *           Simulation/Math/math_accuracy_main.cpp -o math_accuracy
+ *
+ *       运行: ./math_accuracy, 逐项输出最大误差与出现位置, 全部通过时返回0
+ *       角度类为绝对误差, rad; 平方根倒数为相对误差. 耗时对比见Simulation/Benchmark的math/用例
+ *
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <math.h>
+#include <stdint.h>
+#include "drv_math.h"
+
+/* Private macros ------------------------------------------------------------*/
+
+// 三角函数的输入范围, rad, 覆盖多圈累计的电机角度
+#define MATH_ACCURACY_TRIG_RANGE 1.0e4f
+// 与drv_math.cpp中注释一致的误差上限
+#define MATH_ACCURACY_SIN_COS_MAX 1.0e-7
+#define MATH_ACCURACY_WRAP_PI_MAX 3.5e-7
+#define MATH_ACCURACY_ATAN2_MAX 3.0e-7
+#define MATH_ACCURACY_INV_SQRT_MAX 4.8e-6
+
+/* Private types -------------------------------------------------------------*/
+
+/**
+ * @brief 一项误差统计
+ *
+ */
+struct Struct_Math_Accuracy_Error
+{
+    // 最大误差
+    double Max;
+    // 最大误差出现处的输入
+    double At_x;
+    double At_y;
+    // 比较的点数
+    uint32_t Num;
+};
+
+/* Private variables ---------------------------------------------------------*/
+
+static uint32_t Fail_Num = 0;
+
+/* Private function declarations ---------------------------------------------*/
+
+/* Function prototypes -------------------------------------------------------*/
+
+/**
+ * @brief 记录一个点的误差
+ *
+ * @param Error 统计
+ * @param Value 误差
+ * @param x 输入
+ * @param y 第二个输入, 单输入时传0
+ */
+static void Error_Add(Struct_Math_Accuracy_Error *Error, double Value, double x, double y)
+{
+    Value = fabs(Value);
+    if (Value > Error->Max)
+    {
+        Error->Max = Value;
+        Error->At_x = x;
+        Error->At_y = y;
+    }
+    Error->Num++;
+}
+
+/**
+ * @brief 输出一项统计并与上限比较
+ *
+ * @param Name 名称
+ * @param Error 统计
+ * @param Limit 上限
+ */
+static void Check(const char *Name, const Struct_Math_Accuracy_Error &Error, double Limit)
+{
+    bool pass = Error.Max <= Limit;
+
+    printf("  %-22s max %.3e (limit %.1e) at (%.7g, %.7g), %u points  %s\n", Name, Error.Max, Limit, Error.At_x, Error.At_y,
+           (unsigned) Error.Num, pass ? "ok" : "FAIL");
+    if (!pass)
+    {
+        Fail_Num++;
+    }
+}
+
+/**
+ * @brief 三角函数的输入序列: 一圈内密集, 多圈上稀疏, 外加象限边界附近的点
+ *
+ * @param i 序号
+ * @param Num 总数
+ * @return float 输入, rad
+ */
+static float Trig_Input(uint32_t i, uint32_t Num)
+{
+    uint32_t part = Num / 3;
+
+    if (i < part)
+    {
+        return (-2.0f * PI + 4.0f * PI * (float) i / (float) part);
+    }
+    if (i < 2 * part)
+    {
+        return (-MATH_ACCURACY_TRIG_RANGE + 2.0f * MATH_ACCURACY_TRIG_RANGE * (float) (i - part) / (float) part);
+    }
+    // k * PI/4 两侧各取几个ulp
+    int32_t k = (int32_t) (((i - 2 * part) / 8) % 25000) - 12500;
+    float center = (float) k * (PI / 4.0f);
+    float x = center;
+    for (uint32_t step = 0; step < (i & 7); step++)
+    {
+        x = nextafterf(x, (i & 4) ? -INFINITY : INFINITY);
+    }
+    return (x);
+}
+
+/**
+ * @brief 主函数
+ *
+ * @return int 全部通过返回0
+ */
+int main()
+{
+    const uint32_t trig_num = 3000000;
+
+    printf("sin/cos/sincos vs libm double, |x| <= %g\n", (double) MATH_ACCURACY_TRIG_RANGE);
+    {
+        Struct_Math_Accuracy_Error error_sin = {}, error_cos = {}, error_sin_cos = {};
+        for (uint32_t i = 0; i < trig_num; i++)
+        {
+            float x = Trig_Input(i, trig_num);
+            double reference_sin = sin((double) x);
+            double reference_cos = cos((double) x);
+            float s, c;
+
+            Error_Add(&error_sin, (double) Math_Sin(x) - reference_sin, x, 0.0);
+            Error_Add(&error_cos, (double) Math_Cos(x) - reference_cos, x, 0.0);
+            Math_Sin_Cos(x, &s, &c);
+            Error_Add(&error_sin_cos, fmax(fabs((double) s - reference_sin), fabs((double) c - reference_cos)), x, 0.0);
+        }
+        Check("Math_Sin", error_sin, MATH_ACCURACY_SIN_COS_MAX);
+        Check("Math_Cos", error_cos, MATH_ACCURACY_SIN_COS_MAX);
+        Check("Math_Sin_Cos", error_sin_cos, MATH_ACCURACY_SIN_COS_MAX);
+    }
+
+    printf("wrap to [-PI, PI) vs double remainder\n");
+    {
+        Struct_Math_Accuracy_Error error = {};
+        bool in_range = true;
+        for (uint32_t i = 0; i < trig_num; i++)
+        {
+            float x = Trig_Input(i, trig_num);
+            float wrap = Math_Wrap_Pi(x);
+            double reference = remainder((double) x, 2.0 * M_PI);
+            double diff = (double) wrap - reference;
+
+            // 边界 ±PI 两侧的结果相差2PI, 属于同一角度
+            if (diff > M_PI)
+            {
+                diff -= 2.0 * M_PI;
+            }
+            else if (diff < -M_PI)
+            {
+                diff += 2.0 * M_PI;
+            }
+            Error_Add(&error, diff, x, 0.0);
+            in_range = in_range && wrap >= -PI && wrap < PI;
+        }
+        Check("Math_Wrap_Pi", error, MATH_ACCURACY_WRAP_PI_MAX);
+        printf("  %-22s %s\n", "result in [-PI, PI)", in_range ? "ok" : "FAIL");
+        Fail_Num += in_range ? 0 : 1;
+    }
+
+    printf("atan2 vs libm double, all quadrants, radius 1e-3..1e3\n");
+    {
+        Struct_Math_Accuracy_Error error = {};
+        const uint32_t angle_num = 200000;
+        const float radius[] = {1.0e-3f, 0.37f, 1.0f, 25.0f, 1.0e3f};
+        for (uint32_t r = 0; r < sizeof(radius) / sizeof(radius[0]); r++)
+        {
+            for (uint32_t i = 0; i <= angle_num; i++)
+            {
+                double angle = -M_PI + 2.0 * M_PI * (double) i / (double) angle_num;
+                float x = (float) (radius[r] * cos(angle));
+                float y = (float) (radius[r] * sin(angle));
+
+                Error_Add(&error, (double) Math_Atan2(y, x) - atan2((double) y, (double) x), x, y);
+            }
+        }
+        // 坐标轴上与原点
+        const float axis[][2] = {{0.0f, 1.0f}, {0.0f, -1.0f}, {1.0f, 0.0f}, {-1.0f, 0.0f}, {1.0f, 1.0f}, {-1.0f, -1.0f}};
+        for (uint32_t i = 0; i < sizeof(axis) / sizeof(axis[0]); i++)
+        {
+            Error_Add(&error, (double) Math_Atan2(axis[i][1], axis[i][0]) - atan2((double) axis[i][1], (double) axis[i][0]),
+                      axis[i][0], axis[i][1]);
+        }
+        Check("Math_Atan2", error, MATH_ACCURACY_ATAN2_MAX);
+        printf("  %-22s %s\n", "atan2(0, 0) == 0", Math_Atan2(0.0f, 0.0f) == 0.0f ? "ok" : "FAIL");
+        Fail_Num += Math_Atan2(0.0f, 0.0f) == 0.0f ? 0 : 1;
+    }
+
+    printf("inverse sqrt vs libm double, relative, 1e-6..1e6\n");
+    {
+        Struct_Math_Accuracy_Error error = {};
+        for (float x = 1.0e-6f; x < 1.0e6f; x *= 1.0000137f)
+        {
+            double reference = 1.0 / sqrt((double) x);
+
+            Error_Add(&error, ((double) Math_Inv_Sqrt(x) - reference) / reference, x, 0.0);
+        }
+        Check("Math_Inv_Sqrt", error, MATH_ACCURACY_INV_SQRT_MAX);
+    }
+
+    printf("%s, %u failed\n", Fail_Num == 0 ? "PASS" : "FAIL", (unsigned) Fail_Num);
+    return (Fail_Num == 0 ? 0 : 1);
+}
+
+/*****************************************************************************/
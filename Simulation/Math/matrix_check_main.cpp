@@ -0,0 +1,279 @@
+/**
+ * @file matrix_check_main.cpp
+ * @author WFZ
+ * @brief drv_matrix定长矩阵模板的检查: 与双精度朴素实现逐元素比较, 并核对底盘运动学矩阵与原手写展开式一致
+ * @version 0.0
+ * @date 2026-1-30
+ *
+ * @note 编译(在仓库根目录, 主机g++):
+ *       g++ -std=c++11 -O2 -IUser/1_Middleware/1_Driver/Math
+ *           User/1_Middleware/1_Driver/Math/drv_math.cpp
+ *           Simulation/Math/matrix_check_main.cpp -o matrix_check
+ *
+ *       运行: ./matrix_check, 逐项输出最大相对误差, 全部通过时返回0
+ *       维度检查在编译期完成, 本程序中的static_assert同时确认constexpr构造可用
+ *
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <math.h>
+#include <stdint.h>
+#include "drv_matrix.h"
+
+/* Private macros ------------------------------------------------------------*/
+
+// 每项随机用例数
+#define MATRIX_CHECK_CASE_NUM 20000
+// 单精度运算相对双精度参考的误差上限
+#define MATRIX_CHECK_TOLERANCE 1.0e-5
+
+/* Private types -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+
+static uint32_t Fail_Num = 0;
+static uint32_t Random_State = 0x2545F491U;
+
+// constexpr构造与编译期取元素
+static constexpr Class_Matrix<2, 3> Constexpr_Matrix = {{{1.0f, 2.0f, 3.0f}, {4.0f, 5.0f, 6.0f}}};
+static_assert(Constexpr_Matrix(1, 2) == 6.0f, "constexpr element access");
+
+/* Private function declarations ---------------------------------------------*/
+
+/* Function prototypes -------------------------------------------------------*/
+
+/**
+ * @brief [-1, 1) 均匀随机数
+ *
+ * @return float 随机数
+ */
+static float Random()
+{
+    Random_State ^= Random_State << 13;
+    Random_State ^= Random_State >> 17;
+    Random_State ^= Random_State << 5;
+    return ((float) (Random_State >> 8) / 8388608.0f - 1.0f);
+}
+
+/**
+ * @brief 随机矩阵
+ *
+ * @return Class_Matrix 随机矩阵
+ */
+template <uint32_t Row, uint32_t Column>
+static Class_Matrix<Row, Column> Random_Matrix()
+{
+    Class_Matrix<Row, Column> result;
+    for (uint32_t i = 0; i < Row; i++)
+    {
+        for (uint32_t j = 0; j < Column; j++)
+        {
+            result(i, j) = Random();
+        }
+    }
+    return (result);
+}
+
+/**
+ * @brief 输出一项结果并与上限比较
+ *
+ * @param Name 名称
+ * @param Error 最大误差
+ * @param Limit 上限
+ */
+static void Check(const char *Name, double Error, double Limit)
+{
+    bool pass = Error <= Limit;
+
+    printf("  %-34s max %.3e (limit %.1e)  %s\n", Name, Error, Limit, pass ? "ok" : "FAIL");
+    if (!pass)
+    {
+        Fail_Num++;
+    }
+}
+
+/**
+ * @brief 乘法、加减、数乘与转置, 与双精度朴素实现比较
+ *
+ * @return double 最大相对误差
+ */
+template <uint32_t Row, uint32_t Inner, uint32_t Column>
+static double Check_Arithmetic()
+{
+    double error = 0.0;
+
+    for (uint32_t n = 0; n < MATRIX_CHECK_CASE_NUM; n++)
+    {
+        Class_Matrix<Row, Inner> a = Random_Matrix<Row, Inner>();
+        Class_Matrix<Inner, Column> b = Random_Matrix<Inner, Column>();
+        Class_Matrix<Row, Inner> c = Random_Matrix<Row, Inner>();
+        float scale = Random();
+
+        Class_Matrix<Row, Column> product = a * b;
+        Class_Matrix<Row, Inner> combination = (a + c) * scale - c;
+        Class_Matrix<Inner, Row> transpose = a.Transpose();
+
+        for (uint32_t i = 0; i < Row; i++)
+        {
+            for (uint32_t j = 0; j < Column; j++)
+            {
+                double reference = 0.0, magnitude = 0.0;
+                for (uint32_t k = 0; k < Inner; k++)
+                {
+                    reference += (double) a(i, k) * (double) b(k, j);
+                    magnitude += fabs((double) a(i, k) * (double) b(k, j));
+                }
+                error = fmax(error, fabs((double) product(i, j) - reference) / fmax(magnitude, 1.0e-30));
+            }
+            for (uint32_t k = 0; k < Inner; k++)
+            {
+                double reference = ((double) a(i, k) + (double) c(i, k)) * scale - (double) c(i, k);
+                error = fmax(error, fabs((double) combination(i, k) - reference) / fmax(fabs(reference), 1.0));
+                error = fmax(error, (double) fabsf(transpose(k, i) - a(i, k)));
+            }
+        }
+    }
+
+    return (error);
+}
+
+/**
+ * @brief 求逆, 检查 A * A^-1 与单位阵的偏差
+ *
+ * @return double 最大偏差
+ */
+template <uint32_t N>
+static double Check_Inverse()
+{
+    double error = 0.0;
+
+    for (uint32_t n = 0; n < MATRIX_CHECK_CASE_NUM; n++)
+    {
+        // 加对角占优项保证条件数有界
+        Class_Matrix<N, N> a = Random_Matrix<N, N>() + Class_Matrix<N, N>::Identity() * (float) N;
+        Class_Matrix<N, N> inverse;
+
+        if (!a.Inverse(&inverse))
+        {
+            return (INFINITY);
+        }
+        Class_Matrix<N, N> identity = a * inverse;
+        for (uint32_t i = 0; i < N; i++)
+        {
+            for (uint32_t j = 0; j < N; j++)
+            {
+                error = fmax(error, fabs((double) identity(i, j) - (i == j ? 1.0 : 0.0)));
+            }
+        }
+    }
+
+    return (error);
+}
+
+/**
+ * @brief 底盘运动学: 矩阵形式与原手写展开式比较, 常量与crt_chassis.h一致
+ *
+ * @return double 最大相对误差
+ */
+static double Check_Chassis_Kinematics()
+{
+    const float half_length = 0.185f, half_width = 0.2f, wheel_radius = 0.075f;
+    const float rotate_radius = half_length + half_width;
+    static constexpr float r = 0.075f, rr = 0.185f + 0.2f;
+    static constexpr Class_Matrix<4, 3> inverse_matrix = {{
+        { 1.0f / r,  1.0f / r, -rr / r},
+        { 1.0f / r, -1.0f / r, -rr / r},
+        {-1.0f / r, -1.0f / r, -rr / r},
+        {-1.0f / r,  1.0f / r, -rr / r},
+    }};
+    static constexpr Class_Matrix<3, 4> forward_matrix = {{
+        { r / 4.0f,  r / 4.0f, -r / 4.0f, -r / 4.0f},
+        { r / 4.0f, -r / 4.0f, -r / 4.0f,  r / 4.0f},
+        {-r / (4.0f * rr), -r / (4.0f * rr), -r / (4.0f * rr), -r / (4.0f * rr)},
+    }};
+    double error = 0.0;
+
+    for (uint32_t n = 0; n < MATRIX_CHECK_CASE_NUM; n++)
+    {
+        float vx = Random(), vy = Random(), omega = 4.0f * Random();
+
+        // 原逆解展开式
+        float wheel_speeds[4];
+        wheel_speeds[0] = vx + vy - omega * rotate_radius;
+        wheel_speeds[1] = vx - vy - omega * rotate_radius;
+        wheel_speeds[2] = -(vx + vy + omega * rotate_radius);
+        wheel_speeds[3] = -(vx - vy + omega * rotate_radius);
+
+        Class_Vector<3> velocity;
+        velocity[0] = vx;
+        velocity[1] = vy;
+        velocity[2] = omega;
+        Class_Vector<4> wheel_omega = inverse_matrix * velocity;
+        for (uint32_t i = 0; i < 4; i++)
+        {
+            float reference = wheel_speeds[i] / wheel_radius;
+            error = fmax(error, fabs((double) (wheel_omega[i] - reference)) / fmax(fabs((double) reference), 1.0));
+        }
+
+        // 原正解展开式, 输入为上面逆解得到的电机角速度, 正解后应回到原速度
+        float speeds[4];
+        for (uint32_t i = 0; i < 4; i++)
+        {
+            speeds[i] = wheel_omega[i] * wheel_radius;
+        }
+        speeds[2] = -speeds[2];
+        speeds[3] = -speeds[3];
+        float reference[3];
+        reference[0] = (speeds[0] + speeds[1] + speeds[2] + speeds[3]) / 4.0f;
+        reference[1] = (speeds[0] - speeds[1] + speeds[2] - speeds[3]) / 4.0f;
+        reference[2] = (-speeds[0] - speeds[1] + speeds[2] + speeds[3]) / (4.0f * rotate_radius);
+
+        Class_Vector<3> now = forward_matrix * wheel_omega;
+        for (uint32_t i = 0; i < 3; i++)
+        {
+            error = fmax(error, fabs((double) (now[i] - reference[i])) / fmax(fabs((double) reference[i]), 1.0));
+            error = fmax(error, fabs((double) (now[i] - velocity[i])) / fmax(fabs((double) velocity[i]), 1.0));
+        }
+    }
+
+    return (error);
+}
+
+/**
+ * @brief 主函数
+ *
+ * @return int 全部通过返回0
+ */
+int main()
+{
+    printf("arithmetic vs double reference\n");
+    Check("2x2 * 2x2", Check_Arithmetic<2, 2, 2>(), MATRIX_CHECK_TOLERANCE);
+    Check("3x3 * 3x1", Check_Arithmetic<3, 3, 1>(), MATRIX_CHECK_TOLERANCE);
+    Check("4x3 * 3x1", Check_Arithmetic<4, 3, 1>(), MATRIX_CHECK_TOLERANCE);
+    Check("3x4 * 4x1", Check_Arithmetic<3, 4, 1>(), MATRIX_CHECK_TOLERANCE);
+    Check("6x6 * 6x6", Check_Arithmetic<6, 6, 6>(), MATRIX_CHECK_TOLERANCE);
+    Check("9x9 * 9x4", Check_Arithmetic<9, 9, 4>(), MATRIX_CHECK_TOLERANCE);
+
+    printf("inverse, A * A^-1 vs identity\n");
+    Check("2x2", Check_Inverse<2>(), MATRIX_CHECK_TOLERANCE);
+    Check("3x3", Check_Inverse<3>(), MATRIX_CHECK_TOLERANCE);
+    Check("6x6", Check_Inverse<6>(), MATRIX_CHECK_TOLERANCE);
+
+    {
+        Class_Matrix<3, 3> singular = {{{1.0f, 2.0f, 3.0f}, {2.0f, 4.0f, 6.0f}, {0.0f, 1.0f, 1.0f}}};
+        Class_Matrix<3, 3> inverse;
+        bool pass = !singular.Inverse(&inverse);
+        printf("  %-34s %s\n", "singular matrix rejected", pass ? "ok" : "FAIL");
+        Fail_Num += pass ? 0 : 1;
+    }
+
+    printf("chassis kinematics, matrix form vs hand-unrolled\n");
+    Check("inverse and forward resolution", Check_Chassis_Kinematics(), MATRIX_CHECK_TOLERANCE);
+
+    printf("%s, %u failed\n", Fail_Num == 0 ? "PASS" : "FAIL", (unsigned) Fail_Num);
+    return (Fail_Num == 0 ? 0 : 1);
+}
+
+/*****************************************************************************/
@@ -0,0 +1,282 @@
+/**
+ * @file sim_motor.cpp
+ * @author WFZ
+ * @brief 大疆电机(M3508+C620, M2006+C610, GM6020)的主机物理模型, 通过仿真CAN总线与固件闭环
+ * @version 0.0
+ * @date 2026-1-20
+ *
+ * @note 模型: 电调电流环等效为一阶惯性环节, 电流受电调上限与母线电压-反电动势共同限制;
+ *       GM6020电压控制时按R-L电路求解电流; 机械部分为 J·dω/dt = K_T·i - B·ω - 库仑摩擦 + 负载转矩.
+ *       反馈报文与实物一致: 转子编码器0~8191, 转子转速rpm(int16), 电流原始值(int16), 大端序.
+ *       参数取自官方手册的近似值, 具体机构的负载惯量需要按实际情况另行设置.
+ *
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "sim_motor.h"
+#include <math.h>
+
+/* Private macros ------------------------------------------------------------*/
+
+#define SIM_PI 3.14159265358979
+
+/* Private types -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+
+/**
+ * @brief 各型号电机的默认物理参数, 顺序与Enum_Sim_Motor_Type一致
+ *
+ */
+static const Struct_Sim_Motor_Parameter Sim_Motor_Default_Parameter[3] = {
+    // M3508+C620, 额定24V空载482rpm(输出轴), 转矩常数0.3N·m/A
+    {3591.0f / 187.0f, 0.3f, 0.0248f, 0.194f, 0.0f, 1.0e-3f, 2.5e-3f, 0.10f, 20.0f, 0.5e-3f, 16384.0f / 20.0f, 24.0f, 0.0f},
+    // M2006+C610, 额定24V空载500rpm(输出轴), 转矩常数0.18N·m/A
+    {36.0f, 0.18f, 0.0127f, 0.13f, 0.0f, 5.0e-4f, 5.0e-4f, 0.03f, 10.0f, 0.5e-3f, 10000.0f / 10.0f, 24.0f, 0.0f},
+    // GM6020, 直驱, 额定24V空载320rpm, 转矩常数0.741N·m/A
+    {1.0f, 0.741f, 0.716f, 1.8f, 1.3e-3f, 7.5e-4f, 2.0e-3f, 0.05f, 3.0f, 0.5e-3f, 16384.0f / 3.0f, 24.0f, 25000.0f / 24.0f},
+};
+
+// 挂在仿真总线上的电机
+static Class_Sim_Motor *Sim_Motor_List[SIM_MOTOR_NUM_MAX];
+static uint16_t Sim_Motor_Num = 0;
+
+/* Private function declarations ---------------------------------------------*/
+
+static void Sim_Motor_CAN_Tx_Call_Back(CAN_HandleTypeDef *hcan, const CAN_TxHeaderTypeDef *Header, const uint8_t *Data);
+
+/* Function prototypes -------------------------------------------------------*/
+
+/**
+ * @brief 清空仿真总线上的电机并接管仿真CAN的发送截获
+ *
+ */
+void Sim_Motor_Bus_Init()
+{
+    Sim_Motor_Num = 0;
+    Sim_CAN_Set_Tx_Call_Back(Sim_Motor_CAN_Tx_Call_Back);
+}
+
+/**
+ * @brief 所有仿真电机发送一次反馈报文, 每个控制周期调用一次
+ *
+ */
+void Sim_Motor_Send_Feedback_All()
+{
+    for (uint16_t i = 0; i < Sim_Motor_Num; i++)
+    {
+        Sim_Motor_List[i]->Send_Feedback();
+    }
+}
+
+/**
+ * @brief 所有仿真电机推进一个控制周期
+ *
+ * @param DT 控制周期, s
+ * @param Sub_Step_Num 细分步数, 保证电流环的积分稳定
+ */
+void Sim_Motor_Step_All(float DT, uint16_t Sub_Step_Num)
+{
+    float sub_dt = DT / Sub_Step_Num;
+
+    for (uint16_t step = 0; step < Sub_Step_Num; step++)
+    {
+        for (uint16_t i = 0; i < Sim_Motor_Num; i++)
+        {
+            Sim_Motor_List[i]->Step(sub_dt);
+        }
+    }
+}
+
+/**
+ * @brief 仿真电机初始化, 并挂到仿真总线上
+ *
+ * @param hcan 绑定的CAN总线
+ * @param __Feedback_ID 反馈报文ID, C6系列0x201~0x208, GM系列0x205~0x20b
+ * @param __Type 电机型号
+ * @param __Driver_Mode GM6020驱动模式, 其他型号忽略
+ * @param __Load_Inertia 负载转动惯量(折算到输出轴), kg·m²
+ * @param __Gearbox_Rate 减速比, 0表示使用原装减速箱, 拆去减速箱则设为1
+ */
+void Class_Sim_Motor::Init(CAN_HandleTypeDef *hcan, uint16_t __Feedback_ID, Enum_Sim_Motor_Type __Type, Enum_Sim_Motor_Driver_Mode __Driver_Mode, float __Load_Inertia, float __Gearbox_Rate)
+{
+    CAN_Handler = hcan;
+    Feedback_ID = __Feedback_ID;
+    Type = __Type;
+    Driver_Mode = __Driver_Mode;
+    Parameter = Sim_Motor_Default_Parameter[__Type];
+    Load_Inertia = __Load_Inertia;
+    if (__Gearbox_Rate > 0.0f)
+    {
+        // 拆减速箱后输出轴惯量与转矩常数均按减速比折算
+        float ratio = __Gearbox_Rate / Parameter.Gearbox_Rate;
+        Parameter.Inertia *= ratio * ratio;
+        Parameter.K_T *= ratio;
+        Parameter.Viscous_Friction *= ratio * ratio;
+        Parameter.Coulomb_Friction *= ratio;
+        Parameter.Gearbox_Rate = __Gearbox_Rate;
+    }
+
+    Angle = 0.0f;
+    Omega = 0.0f;
+    Current = 0.0f;
+    Command_Raw = 0;
+
+    if (Type == Sim_Motor_Type_GM6020)
+    {
+        uint16_t index = Feedback_ID - 0x205;
+        if (Driver_Mode == Sim_Motor_Driver_Mode_Voltage)
+        {
+            Control_ID = index < 4 ? 0x1ff : 0x2ff;
+        }
+        else
+        {
+            Control_ID = index < 4 ? 0x1fe : 0x2fe;
+        }
+        Control_Offset = (index % 4) * 2;
+    }
+    else
+    {
+        uint16_t index = Feedback_ID - 0x201;
+        Control_ID = index < 4 ? 0x200 : 0x1ff;
+        Control_Offset = (index % 4) * 2;
+    }
+
+    for (uint16_t i = 0; i < Sim_Motor_Num; i++)
+    {
+        if (Sim_Motor_List[i] == this)
+        {
+            return;
+        }
+    }
+    if (Sim_Motor_Num < SIM_MOTOR_NUM_MAX)
+    {
+        Sim_Motor_List[Sim_Motor_Num++] = this;
+    }
+}
+
+/**
+ * @brief 处理固件发出的控制报文
+ *
+ * @param hcan CAN编号
+ * @param StdId 报文ID
+ * @param Data 报文数据
+ */
+void Class_Sim_Motor::CAN_Tx_Command(CAN_HandleTypeDef *hcan, uint16_t StdId, const uint8_t *Data)
+{
+    if (hcan->Instance != CAN_Handler->Instance || StdId != Control_ID)
+    {
+        return;
+    }
+    Command_Raw = (int16_t) ((Data[Control_Offset] << 8) | Data[Control_Offset + 1]);
+}
+
+/**
+ * @brief 按实物格式量化并发送反馈报文
+ *
+ */
+void Class_Sim_Motor::Send_Feedback()
+{
+    uint8_t data[8];
+
+    // 转子编码器
+    double rotor_round = (double) Angle * Parameter.Gearbox_Rate / (2.0 * SIM_PI);
+    rotor_round -= floor(rotor_round);
+    uint16_t encoder = (uint16_t) (rotor_round * Encoder_Num_Per_Round) % Encoder_Num_Per_Round;
+
+    // 转子转速, rpm
+    float rpm = Omega * Parameter.Gearbox_Rate * 60.0f / (2.0f * (float) SIM_PI);
+    int32_t tmp_rpm = (int32_t) lroundf(rpm);
+    if (tmp_rpm > INT16_MAX) tmp_rpm = INT16_MAX;
+    if (tmp_rpm < INT16_MIN) tmp_rpm = INT16_MIN;
+
+    // 转矩电流原始值
+    int32_t tmp_current = (int32_t) lroundf(Current * Parameter.Current_To_Raw);
+    if (tmp_current > INT16_MAX) tmp_current = INT16_MAX;
+    if (tmp_current < INT16_MIN) tmp_current = INT16_MIN;
+
+    data[0] = encoder >> 8;
+    data[1] = encoder;
+    data[2] = (uint16_t) tmp_rpm >> 8;
+    data[3] = (uint16_t) tmp_rpm;
+    data[4] = (uint16_t) tmp_current >> 8;
+    data[5] = (uint16_t) tmp_current;
+    data[6] = 40;
+    data[7] = 0;
+
+    Sim_CAN_Receive(CAN_Handler, Feedback_ID, data, 8);
+}
+
+/**
+ * @brief 推进物理模型
+ *
+ * @param DT 步长, s
+ */
+void Class_Sim_Motor::Step(float DT)
+{
+    float back_emf = Parameter.K_E * Omega * Parameter.Gearbox_Rate;
+
+    if (Type == Sim_Motor_Type_GM6020 && Driver_Mode == Sim_Motor_Driver_Mode_Voltage)
+    {
+        float voltage = Command_Raw / Parameter.Voltage_To_Raw;
+        if (voltage > Parameter.Voltage_Max) voltage = Parameter.Voltage_Max;
+        if (voltage < -Parameter.Voltage_Max) voltage = -Parameter.Voltage_Max;
+
+        // L·di/dt = V - R·i - E, 隐式欧拉
+        Current = (Current + DT / Parameter.Inductance * (voltage - back_emf)) / (1.0f + DT * Parameter.Resistance / Parameter.Inductance);
+    }
+    else
+    {
+        float target_current = Command_Raw / Parameter.Current_To_Raw;
+        if (target_current > Parameter.Current_Max) target_current = Parameter.Current_Max;
+        if (target_current < -Parameter.Current_Max) target_current = -Parameter.Current_Max;
+
+        Current += (target_current - Current) * DT / (Parameter.Current_Tau + DT);
+
+        // 母线电压扣除反电动势后能推出的电流有限, 高速时电流环饱和
+        float current_upper = (Parameter.Voltage_Max - back_emf) / Parameter.Resistance;
+        float current_lower = (-Parameter.Voltage_Max - back_emf) / Parameter.Resistance;
+        if (Current > current_upper) Current = current_upper;
+        if (Current < current_lower) Current = current_lower;
+    }
+
+    float inertia = Parameter.Inertia + Load_Inertia;
+    float torque = Parameter.K_T * Current + Load_Torque - Parameter.Viscous_Friction * Omega;
+
+    if (Omega == 0.0f && fabsf(torque) <= Parameter.Coulomb_Friction)
+    {
+        // 静摩擦未被克服
+    }
+    else
+    {
+        float direction = Omega != 0.0f ? (Omega > 0.0f ? 1.0f : -1.0f) : (torque > 0.0f ? 1.0f : -1.0f);
+        float next_omega = Omega + (torque - direction * Parameter.Coulomb_Friction) / inertia * DT;
+
+        // 摩擦力只能让电机停下, 不能让电机反转
+        if (Omega != 0.0f && next_omega * Omega < 0.0f)
+        {
+            next_omega = 0.0f;
+        }
+        Omega = next_omega;
+    }
+
+    Angle += (double) Omega * DT;
+}
+
+/**
+ * @brief 仿真CAN发送截获, 把控制报文分发给总线上的电机
+ *
+ * @param hcan CAN编号
+ * @param Header 报文头
+ * @param Data 报文数据
+ */
+static void Sim_Motor_CAN_Tx_Call_Back(CAN_HandleTypeDef *hcan, const CAN_TxHeaderTypeDef *Header, const uint8_t *Data)
+{
+    for (uint16_t i = 0; i < Sim_Motor_Num; i++)
+    {
+        Sim_Motor_List[i]->CAN_Tx_Command(hcan, Header->StdId, Data);
+    }
+}
+
+/*****************************************************************************/
@@ -0,0 +1,273 @@
+/**
+ * @file sim_motor.h
+ * @author WFZ
+ * @brief 大疆电机(M3508+C620, M2006+C610, GM6020)的主机物理模型, 通过仿真CAN总线与固件闭环
+ * @version 0.0
+ * @date 2026-1-20
+ *
+ *
+ */
+
+#ifndef SIM_MOTOR_H
+#define SIM_MOTOR_H
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "sim_hal.h"
+
+/* Exported macros -----------------------------------------------------------*/
+
+// 同时挂在仿真总线上的电机数量上限
+#define SIM_MOTOR_NUM_MAX 16
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+ * @brief 仿真电机型号
+ *
+ */
+typedef enum
+{
+    Sim_Motor_Type_M3508 = 0, // C620电调, 电调内部电流环
+    Sim_Motor_Type_M2006,     // C610电调, 电调内部电流环
+    Sim_Motor_Type_GM6020,    // 电压控制或电流控制
+} Enum_Sim_Motor_Type;
+
+/**
+ * @brief GM6020仿真驱动模式, 与固件中的Enum_GM6020_Driver_Mode对应
+ *
+ */
+typedef enum
+{
+    Sim_Motor_Driver_Mode_Voltage = 0,
+    Sim_Motor_Driver_Mode_Current,
+} Enum_Sim_Motor_Driver_Mode;
+
+/**
+ * @brief 电机物理参数, 转矩与惯量均折算到减速箱输出轴
+ *
+ */
+typedef struct
+{
+    // 减速比
+    float Gearbox_Rate;
+    // 输出轴转矩常数, N·m/A
+    float K_T;
+    // 转子反电动势常数, V/(rad/s)
+    float K_E;
+    // 相电阻, Ω
+    float Resistance;
+    // 相电感, H, 仅电压控制模式使用
+    float Inductance;
+    // 输出轴转动惯量(不含负载), kg·m²
+    float Inertia;
+    // 输出轴粘滞摩擦系数, N·m/(rad/s)
+    float Viscous_Friction;
+    // 输出轴库仑摩擦, N·m
+    float Coulomb_Friction;
+    // 电调允许的最大电流, A
+    float Current_Max;
+    // 电调电流环等效一阶时间常数, s
+    float Current_Tau;
+    // 电流指令与反馈的原始值/安培
+    float Current_To_Raw;
+    // 母线电压, V
+    float Voltage_Max;
+    // 电压指令的原始值/伏特
+    float Voltage_To_Raw;
+} Struct_Sim_Motor_Parameter;
+
+/**
+ * @brief 仿真电机, 接收固件发出的控制报文, 以1kHz回送量化后的反馈报文
+ *
+ */
+class Class_Sim_Motor
+{
+public:
+    void Init(CAN_HandleTypeDef *hcan, uint16_t __Feedback_ID, Enum_Sim_Motor_Type __Type, Enum_Sim_Motor_Driver_Mode __Driver_Mode = Sim_Motor_Driver_Mode_Current, float __Load_Inertia = 0.0f, float __Gearbox_Rate = 0.0f);
+
+    inline Struct_Sim_Motor_Parameter *Get_Parameter();
+
+    inline uint16_t Get_Control_ID();
+
+    inline float Get_Angle();
+
+    inline float Get_Omega();
+
+    inline float Get_Current();
+
+    inline float Get_Command();
+
+    inline void Set_Load_Inertia(float __Load_Inertia);
+
+    inline void Set_Load_Torque(float __Load_Torque);
+
+    inline void Set_Angle(float __Angle);
+
+    inline void Set_Omega(float __Omega);
+
+    void CAN_Tx_Command(CAN_HandleTypeDef *hcan, uint16_t StdId, const uint8_t *Data);
+
+    void Send_Feedback();
+
+    void Step(float DT);
+
+protected:
+    // 初始化相关常量
+
+    // 绑定的CAN
+    CAN_HandleTypeDef *CAN_Handler;
+    // 反馈报文ID
+    uint16_t Feedback_ID;
+    // 控制报文ID
+    uint16_t Control_ID;
+    // 控制报文中的字节偏移
+    uint8_t Control_Offset;
+    // 电机型号
+    Enum_Sim_Motor_Type Type;
+    // 驱动模式
+    Enum_Sim_Motor_Driver_Mode Driver_Mode;
+    // 物理参数
+    Struct_Sim_Motor_Parameter Parameter;
+
+    // 常量
+
+    // 一圈编码器刻度
+    uint16_t Encoder_Num_Per_Round = 8192;
+
+    // 内部变量
+
+    // 负载转动惯量, kg·m²
+    float Load_Inertia = 0.0f;
+    // 负载转矩, N·m, 与转动方向无关的外力矩(如重力)
+    float Load_Torque = 0.0f;
+    // 最近一次收到的控制原始值
+    int16_t Command_Raw = 0;
+
+    // 读变量
+
+    // 输出轴角度, rad, 长时间高速运行时用双精度避免累加误差
+    double Angle = 0.0;
+    // 输出轴角速度, rad/s
+    float Omega = 0.0f;
+    // 相电流, A
+    float Current = 0.0f;
+};
+
+/* Exported variables --------------------------------------------------------*/
+
+/* Exported function declarations --------------------------------------------*/
+
+void Sim_Motor_Bus_Init();
+
+void Sim_Motor_Send_Feedback_All();
+
+void Sim_Motor_Step_All(float DT, uint16_t Sub_Step_Num);
+
+/**
+ * @brief 获取物理参数, 可在Init之后修改
+ *
+ * @return Struct_Sim_Motor_Parameter* 物理参数
+ */
+inline Struct_Sim_Motor_Parameter *Class_Sim_Motor::Get_Parameter()
+{
+    return (&Parameter);
+}
+
+/**
+ * @brief 获取控制报文ID
+ *
+ * @return uint16_t 控制报文ID
+ */
+inline uint16_t Class_Sim_Motor::Get_Control_ID()
+{
+    return (Control_ID);
+}
+
+/**
+ * @brief 获取输出轴角度, rad
+ *
+ * @return float 输出轴角度, rad
+ */
+inline float Class_Sim_Motor::Get_Angle()
+{
+    return ((float) Angle);
+}
+
+/**
+ * @brief 获取输出轴角速度, rad/s
+ *
+ * @return float 输出轴角速度, rad/s
+ */
+inline float Class_Sim_Motor::Get_Omega()
+{
+    return (Omega);
+}
+
+/**
+ * @brief 获取相电流, A
+ *
+ * @return float 相电流, A
+ */
+inline float Class_Sim_Motor::Get_Current()
+{
+    return (Current);
+}
+
+/**
+ * @brief 获取最近一次控制指令, 电流控制时单位A, 电压控制时单位V
+ *
+ * @return float 控制指令
+ */
+inline float Class_Sim_Motor::Get_Command()
+{
+    if (Type == Sim_Motor_Type_GM6020 && Driver_Mode == Sim_Motor_Driver_Mode_Voltage)
+    {
+        return (Command_Raw / Parameter.Voltage_To_Raw);
+    }
+    return (Command_Raw / Parameter.Current_To_Raw);
+}
+
+/**
+ * @brief 设定负载转动惯量, kg·m²
+ *
+ * @param __Load_Inertia 负载转动惯量, kg·m²
+ */
+inline void Class_Sim_Motor::Set_Load_Inertia(float __Load_Inertia)
+{
+    Load_Inertia = __Load_Inertia;
+}
+
+/**
+ * @brief 设定负载转矩, N·m
+ *
+ * @param __Load_Torque 负载转矩, N·m
+ */
+inline void Class_Sim_Motor::Set_Load_Torque(float __Load_Torque)
+{
+    Load_Torque = __Load_Torque;
+}
+
+/**
+ * @brief 设定输出轴角度, rad, 用于设置初始位置
+ *
+ * @param __Angle 输出轴角度, rad
+ */
+inline void Class_Sim_Motor::Set_Angle(float __Angle)
+{
+    Angle = __Angle;
+}
+
+/**
+ * @brief 设定输出轴角速度, rad/s, 用于机械限位和冲击
+ *
+ * @param __Omega 输出轴角速度, rad/s
+ */
+inline void Class_Sim_Motor::Set_Omega(float __Omega)
+{
+    Omega = __Omega;
+}
+
+#endif
+
+/*****************************************************************************/
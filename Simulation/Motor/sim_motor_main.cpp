@@ -0,0 +1,528 @@
+/**
+ * @file sim_motor_main.cpp
+ * @author WFZ
+ * @brief 单电机闭环阶跃仿真: 固件的dvc_motor与alg_pid原样编译, 通过仿真CAN总线驱动电机物理模型
+ * @version 0.0
+ * @date 2026-1-20
+ *
+ * @note 编译(在仓库根目录, 主机g++):
+ *       g++ -std=c++11 -O2 -ISimulation/Stub -ISimulation/Motor -IUser/1_Middleware/1_Driver/CAN -IUser/1_Middleware/1_Driver/DWT
+ *           -IUser/1_Middleware/1_Driver/Math -IUser/1_Middleware/2_Algorithm/PID -IUser/2_Device/Motor
+ *           -x c++ User/1_Middleware/1_Driver/CAN/drv_can.c -x none
+ *           User/1_Middleware/1_Driver/Math/drv_math.cpp User/1_Middleware/1_Driver/DWT/drv_dwt.cpp
+ *           User/1_Middleware/2_Algorithm/PID/alg_pid.cpp
+ *           User/2_Device/Motor/dvc_motor.cpp Simulation/Stub/sim_hal.cpp
+ *           Simulation/Motor/sim_motor.cpp Simulation/Motor/sim_motor_main.cpp -o sim_motor
+ *
+ *       运行: ./sim_motor 参数名=值 ...
+ *       motor=c620|c610|gm6020  mode=omega|angle  driver=current|voltage(仅gm6020)
+ *       target=阶跃目标(rad/s或rad)  time=仿真时长(s)  step=阶跃时刻(s)  id=反馈ID(如0x201)
+ *       gear=减速比(拆减速箱填1)  load=负载惯量(kg·m²)  torque=负载转矩(N·m)  csv=波形输出文件
+ *       ak_p ak_i ak_d a_i_max a_out_max ak_b a_ci    角度环
+ *       ok_p ok_i ok_d o_i_max o_out_max ok_b o_ci    速度环
+ *       ck_p ck_i ck_d c_i_max c_out_max ck_b c_ci    电流环(仅gm6020电压控制)
+ *       k_b为反算抗饱和增益, _ci非0时启用条件积分
+ *       任意一个数值参数可写成 起:止:步长 进行扫描, 如 ok_p=0.2:2:0.2, 每组输出一行指标
+ *
+ *       例: ./sim_motor motor=c620 mode=omega target=20 load=2e-3 ok_p=0.2:1.4:0.2
+ *
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "dvc_motor.h"
+#include "sim_motor.h"
+
+/* Private macros ------------------------------------------------------------*/
+
+// 控制周期, s
+#define SIM_DT 0.001f
+// 每个控制周期内物理模型的细分步数
+#define SIM_SUB_STEP_NUM 10
+// 可配置的数值参数个数
+#define SIM_PARAMETER_NUM 28
+
+/* Private types -------------------------------------------------------------*/
+
+/**
+ * @brief 可由命令行配置的数值参数
+ *
+ */
+struct Struct_Sim_Parameter
+{
+    const char *Name;
+    float Value;
+};
+
+/**
+ * @brief 一次阶跃响应的指标
+ *
+ */
+struct Struct_Sim_Step_Result
+{
+    // 10%到90%的上升时间, s, 未达到90%时为-1
+    float Rise_Time;
+    // 超调量, %
+    float Overshoot;
+    // 进入并保持在2%误差带内的时间, s, 仿真结束时仍在误差带外为-1
+    float Settling_Time;
+    // 最后10%时间内的平均误差
+    float Steady_State_Error;
+    // 阶跃后误差绝对值积分
+    float IAE;
+    // 电机相电流绝对值最大值, A
+    float Peak_Current;
+};
+
+/* Private variables ---------------------------------------------------------*/
+
+bool init_finished = false;
+
+static const char *Sim_Motor_Name = "c620";
+static const char *Sim_Mode_Name = "omega";
+static const char *Sim_Driver_Name = "current";
+static const char *Sim_CSV_Name = NULL;
+
+static Struct_Sim_Parameter Sim_Parameter[SIM_PARAMETER_NUM] = {
+    {"target", 0.0f}, {"time", 1.0f}, {"step", 0.1f}, {"id", 0.0f}, {"gear", 0.0f}, {"load", 0.0f}, {"torque", 0.0f},
+    {"ak_p", 0.0f}, {"ak_i", 0.0f}, {"ak_d", 0.0f}, {"a_i_max", 0.0f}, {"a_out_max", 0.0f}, {"ak_b", 0.0f}, {"a_ci", 0.0f},
+    {"ok_p", 0.0f}, {"ok_i", 0.0f}, {"ok_d", 0.0f}, {"o_i_max", 0.0f}, {"o_out_max", 0.0f}, {"ok_b", 0.0f}, {"o_ci", 0.0f},
+    {"ck_p", 0.0f}, {"ck_i", 0.0f}, {"ck_d", 0.0f}, {"c_i_max", 0.0f}, {"c_out_max", 0.0f}, {"ck_b", 0.0f}, {"c_ci", 0.0f},
+};
+
+// 参数是否被命令行显式设置
+static bool Sim_Parameter_Set_Flag[SIM_PARAMETER_NUM];
+
+// 正在仿真的电机反馈ID
+static uint16_t Sim_Feedback_ID = 0;
+
+/* Private function declarations ---------------------------------------------*/
+
+static float *Parameter(const char *Name);
+
+/* Function prototypes -------------------------------------------------------*/
+
+/**
+ * @brief 按参数名查找数值参数
+ *
+ * @param Name 参数名
+ * @return float* 参数值指针, 不存在返回NULL
+ */
+static float *Parameter(const char *Name)
+{
+    for (int i = 0; i < SIM_PARAMETER_NUM; i++)
+    {
+        if (strcmp(Sim_Parameter[i].Name, Name) == 0)
+        {
+            return (&Sim_Parameter[i].Value);
+        }
+    }
+    return (NULL);
+}
+
+/**
+ * @brief 参数未被命令行设置时填入默认值
+ *
+ * @param Name 参数名
+ * @param Value 默认值
+ */
+static void Parameter_Default(const char *Name, float Value)
+{
+    for (int i = 0; i < SIM_PARAMETER_NUM; i++)
+    {
+        if (strcmp(Sim_Parameter[i].Name, Name) == 0 && !Sim_Parameter_Set_Flag[i])
+        {
+            Sim_Parameter[i].Value = Value;
+        }
+    }
+}
+
+/**
+ * @brief 控制报文ID对应的CAN1发送缓冲区
+ *
+ * @param ID 控制报文ID
+ * @return uint8_t* 发送缓冲区
+ */
+static uint8_t *CAN1_Tx_Data(uint16_t ID)
+{
+    switch (ID)
+    {
+    case (0x1ff):
+        return (CAN1_0x1ff_Tx_Data);
+    case (0x200):
+        return (CAN1_0x200_Tx_Data);
+    case (0x2ff):
+        return (CAN1_0x2ff_Tx_Data);
+    case (0x1fe):
+        return (CAN1_0x1fe_Tx_Data);
+    case (0x2fe):
+        return (CAN1_0x2fe_Tx_Data);
+    default:
+        return (CAN1_0x200_Tx_Data);
+    }
+}
+
+/**
+ * @brief 秒级单调时钟
+ *
+ * @return double 当前时间, s
+ */
+static double Wall_Time()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec + now.tv_nsec * 1e-9);
+}
+
+/**
+ * @brief 跑一次阶跃响应
+ *
+ * @tparam Type_Motor 固件电机类
+ * @param Motor 已初始化的固件电机
+ * @param Plant 已初始化的仿真电机
+ * @param CSV 波形输出文件, NULL表示不输出
+ * @return Struct_Sim_Step_Result 阶跃指标
+ */
+template <typename Type_Motor>
+static Struct_Sim_Step_Result Run_Step(Type_Motor &Motor, Class_Sim_Motor &Plant, FILE *CSV)
+{
+    Struct_Sim_Step_Result result = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+    bool angle_mode = strcmp(Sim_Mode_Name, "angle") == 0;
+    float target = *Parameter("target");
+    float step_time = *Parameter("step");
+    uint32_t tick_num = (uint32_t) (*Parameter("time") / SIM_DT);
+    uint32_t step_tick = (uint32_t) (step_time / SIM_DT);
+    uint32_t tail_tick = step_tick + (tick_num - step_tick) * 9 / 10;
+    float band = fabsf(target) * 0.02f;
+    float time_10 = -1.0f, time_90 = -1.0f, last_outside = step_time;
+    bool settled = false;
+    float peak_ratio = 0.0f, tail_error_sum = 0.0f;
+    uint32_t tail_num = 0;
+
+    // 电机Init时已按反馈ID登记接收处理函数
+    CAN_Init(&hcan1, NULL);
+    init_finished = true;
+
+    for (uint32_t tick = 0; tick < tick_num; tick++)
+    {
+        float now_time = tick * SIM_DT;
+        float now_target = tick >= step_tick ? target : 0.0f;
+
+        // 电机反馈进入CAN接收中断
+        Sim_Motor_Send_Feedback_All();
+        CAN_Rx_Dispatch(&hcan1);
+
+        if (angle_mode)
+        {
+            Motor.Set_Target_Angle(now_target);
+        }
+        else
+        {
+            Motor.Set_Target_Omega(now_target);
+        }
+        Motor.TIM_Calculate_PeriodElapsedCallback();
+        CAN_Send_Data(&hcan1, Plant.Get_Control_ID(), CAN1_Tx_Data(Plant.Get_Control_ID()), 8);
+
+        Sim_Motor_Step_All(SIM_DT, SIM_SUB_STEP_NUM);
+        Sim_HAL_Tick_Increment(1);
+
+        float now = angle_mode ? Motor.Get_Now_Angle() : Motor.Get_Now_Omega();
+        float error = now_target - now;
+
+        if (CSV != NULL)
+        {
+            fprintf(CSV, "%.4f,%.5f,%.5f,%.5f,%.5f\n", now_time, now_target, now, Plant.Get_Command(), Plant.Get_Current());
+        }
+        if (fabsf(Plant.Get_Current()) > result.Peak_Current)
+        {
+            result.Peak_Current = fabsf(Plant.Get_Current());
+        }
+        if (tick < step_tick || target == 0.0f)
+        {
+            continue;
+        }
+
+        float ratio = now / target;
+        if (time_10 < 0.0f && ratio >= 0.1f)
+        {
+            time_10 = now_time;
+        }
+        if (time_90 < 0.0f && ratio >= 0.9f)
+        {
+            time_90 = now_time;
+        }
+        if (ratio > peak_ratio)
+        {
+            peak_ratio = ratio;
+        }
+        if (fabsf(error) > band)
+        {
+            last_outside = now_time + SIM_DT;
+            settled = false;
+        }
+        else
+        {
+            settled = true;
+        }
+        if (tick >= tail_tick)
+        {
+            tail_error_sum += error;
+            tail_num++;
+        }
+        result.IAE += fabsf(error) * SIM_DT;
+    }
+
+    result.Rise_Time = (time_10 >= 0.0f && time_90 >= 0.0f) ? time_90 - time_10 : -1.0f;
+    result.Overshoot = peak_ratio > 1.0f ? (peak_ratio - 1.0f) * 100.0f : 0.0f;
+    result.Settling_Time = settled ? last_outside - step_time : -1.0f;
+    result.Steady_State_Error = tail_num > 0 ? tail_error_sum / tail_num : 0.0f;
+
+    init_finished = false;
+    CAN_Unregister_Rx_Handler(&hcan1, Sim_Feedback_ID);
+    return (result);
+}
+
+/**
+ * @brief 按当前参数初始化一个PID
+ *
+ * @param PID 被初始化的PID
+ * @param Prefix 参数名前缀, 如"o"
+ */
+static void PID_Init(Class_PID &PID, const char *Prefix)
+{
+    char name[16];
+    float value[7];
+    const char *suffix[7] = {"k_p", "k_i", "k_d", "_i_max", "_out_max", "k_b", "_ci"};
+
+    for (int i = 0; i < 7; i++)
+    {
+        snprintf(name, sizeof(name), "%s%s", Prefix, suffix[i]);
+        value[i] = *Parameter(name);
+    }
+    PID.Init(value[0], value[1], value[2], 0.0f, value[3], 0.0f, value[4]);
+    PID.Set_K_Back_Calculation(value[5]);
+    PID.Set_Conditional_Integration(value[6] != 0.0f ? PID_Conditional_Integration_ENABLE : PID_Conditional_Integration_DISABLE);
+}
+
+/**
+ * @brief 按当前参数完成一次仿真
+ *
+ * @param CSV 波形输出文件, NULL表示不输出
+ * @return Struct_Sim_Step_Result 阶跃指标
+ */
+static Struct_Sim_Step_Result Run_Once(FILE *CSV)
+{
+    Enum_Motor_Control_Method method = strcmp(Sim_Mode_Name, "angle") == 0 ? Motor_Control_Method_ANGLE : Motor_Control_Method_OMEGA;
+    float gear = *Parameter("gear");
+    Class_Sim_Motor plant;
+
+    Sim_HAL_Reset();
+    Sim_Motor_Bus_Init();
+    memset(CAN1_0x1ff_Tx_Data, 0, 8);
+    memset(CAN1_0x200_Tx_Data, 0, 8);
+    memset(CAN1_0x2ff_Tx_Data, 0, 8);
+    memset(CAN1_0x1fe_Tx_Data, 0, 8);
+    memset(CAN1_0x2fe_Tx_Data, 0, 8);
+
+    Sim_Feedback_ID = (uint16_t) *Parameter("id");
+
+    if (strcmp(Sim_Motor_Name, "c610") == 0)
+    {
+        Class_Motor_C610 motor;
+        PID_Init(motor.PID_Angle, "a");
+        PID_Init(motor.PID_Omega, "o");
+        motor.Init(&hcan1, (Enum_Motor_ID) (Sim_Feedback_ID - 0x200), method, 0, gear > 0.0f ? gear : 36.0f);
+        plant.Init(&hcan1, Sim_Feedback_ID, Sim_Motor_Type_M2006, Sim_Motor_Driver_Mode_Current, *Parameter("load"), gear);
+        plant.Set_Load_Torque(*Parameter("torque"));
+        return (Run_Step(motor, plant, CSV));
+    }
+    else if (strcmp(Sim_Motor_Name, "gm6020") == 0)
+    {
+        bool voltage = strcmp(Sim_Driver_Name, "voltage") == 0;
+        Class_Motor_GM6020 motor;
+        PID_Init(motor.PID_Angle, "a");
+        PID_Init(motor.PID_Omega, "o");
+        PID_Init(motor.PID_Current, "c");
+        motor.Init(&hcan1, (Enum_Motor_ID) (Sim_Feedback_ID - 0x200), method, 0, voltage ? GM6020_Driver_Mode_Voltage : GM6020_Driver_Mode_Current);
+        plant.Init(&hcan1, Sim_Feedback_ID, Sim_Motor_Type_GM6020, voltage ? Sim_Motor_Driver_Mode_Voltage : Sim_Motor_Driver_Mode_Current, *Parameter("load"));
+        plant.Set_Load_Torque(*Parameter("torque"));
+        return (Run_Step(motor, plant, CSV));
+    }
+    else
+    {
+        Class_Motor_C620 motor;
+        PID_Init(motor.PID_Angle, "a");
+        PID_Init(motor.PID_Omega, "o");
+        motor.Init(&hcan1, (Enum_Motor_ID) (Sim_Feedback_ID - 0x200), method, gear > 0.0f ? gear : 3591.0f / 187.0f);
+        plant.Init(&hcan1, Sim_Feedback_ID, Sim_Motor_Type_M3508, Sim_Motor_Driver_Mode_Current, *Parameter("load"), gear);
+        plant.Set_Load_Torque(*Parameter("torque"));
+        return (Run_Step(motor, plant, CSV));
+    }
+}
+
+/**
+ * @brief 填入与机器人上相同的默认参数, 未在命令行给出的参数生效
+ *
+ */
+static void Parameter_Load_Default()
+{
+    bool angle_mode = strcmp(Sim_Mode_Name, "angle") == 0;
+
+    if (strcmp(Sim_Motor_Name, "c610") == 0)
+    {
+        // 与crt_booster中拨弹电机一致
+        Parameter_Default("id", 0x203);
+        Parameter_Default("target", angle_mode ? PI / 2.0f : 10.0f);
+        Parameter_Default("ak_p", 50.0f);
+        Parameter_Default("a_out_max", 20.0f);
+        Parameter_Default("ok_p", 3.40f);
+        Parameter_Default("ok_i", 200.0f);
+        Parameter_Default("o_i_max", 10.0f);
+        Parameter_Default("o_out_max", 10.0f);
+    }
+    else if (strcmp(Sim_Motor_Name, "gm6020") == 0)
+    {
+        // 与crt_gimbal中Pitch电机一致
+        Parameter_Default("id", 0x205);
+        Parameter_Default("target", angle_mode ? 0.3f : 10.0f);
+        Parameter_Default("ak_p", 11.2f);
+        Parameter_Default("a_i_max", 6.0f * PI);
+        Parameter_Default("a_out_max", 6.0f * PI);
+        Parameter_Default("ok_p", 0.35f);
+        Parameter_Default("o_i_max", 3.0f);
+        Parameter_Default("o_out_max", 3.0f);
+        Parameter_Default("ck_p", 5.0f);
+        Parameter_Default("ck_i", 500.0f);
+        Parameter_Default("c_i_max", 24.0f);
+        Parameter_Default("c_out_max", 24.0f);
+    }
+    else
+    {
+        // 与crt_chassis中底盘电机一致
+        Parameter_Default("id", 0x201);
+        Parameter_Default("target", angle_mode ? PI : 20.0f);
+        Parameter_Default("ak_p", 10.0f);
+        Parameter_Default("a_out_max", 20.0f);
+        Parameter_Default("ok_p", 0.73242f);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    int sweep_index = -1;
+    float sweep_from = 0.0f, sweep_to = 0.0f, sweep_step = 1.0f;
+
+    for (int i = 1; i < argc; i++)
+    {
+        char *equal = strchr(argv[i], '=');
+        if (equal == NULL)
+        {
+            fprintf(stderr, "unknown argument: %s\n", argv[i]);
+            return (1);
+        }
+        *equal = '\0';
+        const char *name = argv[i];
+        const char *value = equal + 1;
+
+        if (strcmp(name, "motor") == 0)
+        {
+            Sim_Motor_Name = value;
+            continue;
+        }
+        if (strcmp(name, "mode") == 0)
+        {
+            Sim_Mode_Name = value;
+            continue;
+        }
+        if (strcmp(name, "driver") == 0)
+        {
+            Sim_Driver_Name = value;
+            continue;
+        }
+        if (strcmp(name, "csv") == 0)
+        {
+            Sim_CSV_Name = value;
+            continue;
+        }
+
+        float *parameter = Parameter(name);
+        if (parameter == NULL)
+        {
+            fprintf(stderr, "unknown parameter: %s\n", name);
+            return (1);
+        }
+        int index = 0;
+        for (int j = 0; j < SIM_PARAMETER_NUM; j++)
+        {
+            if (&Sim_Parameter[j].Value == parameter)
+            {
+                index = j;
+            }
+        }
+        Sim_Parameter_Set_Flag[index] = true;
+
+        if (strchr(value, ':') != NULL)
+        {
+            sweep_index = index;
+            sscanf(value, "%f:%f:%f", &sweep_from, &sweep_to, &sweep_step);
+            if (sweep_step <= 0.0f)
+            {
+                sweep_step = 1.0f;
+            }
+            *parameter = sweep_from;
+        }
+        else
+        {
+            *parameter = strtof(value, NULL);
+        }
+    }
+
+    Parameter_Load_Default();
+
+    FILE *csv = NULL;
+    if (Sim_CSV_Name != NULL)
+    {
+        csv = fopen(Sim_CSV_Name, "w");
+        if (csv != NULL)
+        {
+            fprintf(csv, "time,target,now,command,current\n");
+        }
+    }
+
+    printf("%-12s %10s %10s %10s %10s %10s %10s\n", sweep_index >= 0 ? Sim_Parameter[sweep_index].Name : "run", "rise_s", "overshoot%", "settle_s", "sse", "iae", "peak_A");
+
+    double sim_time = 0.0;
+    double begin = Wall_Time();
+    float value = sweep_from;
+    do
+    {
+        if (sweep_index >= 0)
+        {
+            Sim_Parameter[sweep_index].Value = value;
+        }
+        Struct_Sim_Step_Result result = Run_Once(csv);
+        sim_time += *Parameter("time");
+
+        printf("%-12g %10.4f %10.2f %10.4f %10.4f %10.4f %10.3f\n", sweep_index >= 0 ? value : 0.0f, result.Rise_Time, result.Overshoot, result.Settling_Time, result.Steady_State_Error, result.IAE, result.Peak_Current);
+
+        // 扫描时只保存第一组波形
+        if (csv != NULL)
+        {
+            fclose(csv);
+            csv = NULL;
+        }
+        value += sweep_step;
+    } while (sweep_index >= 0 && value <= sweep_to + sweep_step * 0.5f);
+
+    double wall = Wall_Time() - begin;
+    printf("simulated %.3f s in %.4f s, real time factor %.0fx\n", sim_time, wall, wall > 0.0 ? sim_time / wall : 0.0);
+
+    return (0);
+}
+
+/*****************************************************************************/
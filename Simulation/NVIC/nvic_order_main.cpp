@@ -0,0 +1,341 @@
+/**
+ * @file nvic_order_main.cpp
+ * @author WFZ
+ * @brief 两级中断结构的顺序检查: drv_swi原样编译, 在仿真NVIC上验证短中断与PendSV控制线程之间的抢占、咬尾与关中断延迟
+ * @version 0.0
+ * @date 2026-1-28
+ *
+ * @note 编译(在仓库根目录, 主机g++):
+ *       g++ -std=c++11 -O2 -ISimulation/Stub -IUser/1_Middleware/1_Driver/SWI
+ *           User/1_Middleware/1_Driver/SWI/drv_swi.cpp Simulation/Stub/sim_hal.cpp
+ *           Simulation/NVIC/nvic_order_main.cpp -o nvic_order
+ *
+ *       运行: ./nvic_order, 逐项输出中断进出顺序, 全部通过时返回0
+ *       顺序记号: T TIM4, C CAN1接收, U USART1接收, P PendSV控制线程, <进入, >退出
+ *
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <string.h>
+#include "sim_hal.h"
+#include "drv_swi.h"
+
+/* Private macros ------------------------------------------------------------*/
+
+// 顺序记录的最大长度
+#define NVIC_ORDER_TRACE_LENGTH 128
+
+/* Private types -------------------------------------------------------------*/
+
+/**
+ * @brief 控制线程中注入的激励, 在控制线程第一次运行时执行
+ *
+ */
+typedef void (*Nvic_Order_Stimulus)();
+
+/* Private variables ---------------------------------------------------------*/
+
+// 中断进出顺序
+static char Trace[NVIC_ORDER_TRACE_LENGTH];
+static uint8_t Trace_Length = 0;
+
+// 当前用例的激励
+static Nvic_Order_Stimulus Stimulus = NULL;
+// 各中断内观察到的执行优先级
+static int16_t CAN_Active_Priority = 0;
+static int16_t PendSV_Active_Priority = 0;
+// PendSV嵌套深度与最大深度
+static uint8_t PendSV_Depth = 0;
+static uint8_t PendSV_Max_Depth = 0;
+// 最近一次UART空闲事件的长度
+static uint16_t UART_Event_Size = 0;
+static uint8_t UART_Event_Num = 0;
+
+static uint8_t UART_Rx_Buffer[64];
+
+static uint32_t Fail_Num = 0;
+
+/* Private function declarations ---------------------------------------------*/
+
+/* Function prototypes -------------------------------------------------------*/
+
+/**
+ * @brief 记录一次进出
+ *
+ * @param Name 中断记号
+ * @param Enter true进入, false退出
+ */
+static void Trace_Mark(char Name, bool Enter)
+{
+    if (Trace_Length + 2 < NVIC_ORDER_TRACE_LENGTH)
+    {
+        Trace[Trace_Length++] = Name;
+        Trace[Trace_Length++] = Enter ? '<' : '>';
+        Trace[Trace_Length] = 0;
+    }
+}
+
+/**
+ * @brief TIM4短中断, 与固件相同只挂起控制线程
+ *
+ */
+void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
+{
+    Trace_Mark('T', true);
+    SWI_Trigger();
+    Trace_Mark('T', false);
+}
+
+/**
+ * @brief CAN接收短中断, 取走报文
+ *
+ */
+void HAL_CAN_RxFifo0MsgPendingCallback(CAN_HandleTypeDef *hcan)
+{
+    CAN_RxHeaderTypeDef header;
+    uint8_t data[8];
+
+    Trace_Mark('C', true);
+    CAN_Active_Priority = Sim_NVIC_Get_Active_Priority();
+    HAL_CAN_GetRxMessage(hcan, CAN_RX_FIFO0, &header, data);
+    // CAN中断中到达的节拍只能挂起, 等CAN中断返回
+    if (Stimulus == NULL && data[0] == 0xAA)
+    {
+        Sim_TIM_Period_Elapsed(&htim4);
+    }
+    Trace_Mark('C', false);
+}
+
+/**
+ * @brief UART接收短中断
+ *
+ */
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size)
+{
+    Trace_Mark('U', true);
+    UART_Event_Size = Size;
+    UART_Event_Num++;
+    Trace_Mark('U', false);
+}
+
+/**
+ * @brief 控制线程
+ *
+ */
+static void Control_Thread()
+{
+    Trace_Mark('P', true);
+    PendSV_Depth++;
+    if (PendSV_Depth > PendSV_Max_Depth)
+    {
+        PendSV_Max_Depth = PendSV_Depth;
+    }
+    PendSV_Active_Priority = Sim_NVIC_Get_Active_Priority();
+
+    if (Stimulus != NULL)
+    {
+        Nvic_Order_Stimulus stimulus = Stimulus;
+        Stimulus = NULL;
+        stimulus();
+    }
+
+    PendSV_Depth--;
+    Trace_Mark('P', false);
+}
+
+/**
+ * @brief 注入一帧CAN1报文
+ *
+ * @param First 第一个字节
+ */
+static void Inject_CAN(uint8_t First)
+{
+    uint8_t data[8] = {First};
+    Sim_CAN_Receive(&hcan1, 0x201, data, 8);
+}
+
+/**
+ * @brief 注入一段UART1数据
+ *
+ * @param Length 字节数
+ */
+static void Inject_UART(uint16_t Length)
+{
+    uint8_t data[16];
+    memset(data, 0x55, sizeof(data));
+    Sim_UART_Receive(&huart1, data, Length);
+}
+
+/**
+ * @brief 复位仿真外设与记录, 按固件的优先级分配重新配置
+ *
+ * @param __Stimulus 本用例在控制线程中注入的激励
+ */
+static void Case_Reset(Nvic_Order_Stimulus __Stimulus)
+{
+    CAN_FilterTypeDef filter;
+
+    Sim_HAL_Reset();
+    SWI_Init(Control_Thread);
+
+    // 接收全部报文到FIFO0
+    memset(&filter, 0, sizeof(filter));
+    filter.FilterBank = 0;
+    filter.FilterMode = CAN_FILTERMODE_IDMASK;
+    filter.FilterScale = CAN_FILTERSCALE_32BIT;
+    filter.FilterFIFOAssignment = CAN_RX_FIFO0;
+    filter.FilterActivation = ENABLE;
+    filter.SlaveStartFilterBank = 14;
+    HAL_CAN_ConfigFilter(&hcan1, &filter);
+    HAL_CAN_Start(&hcan1);
+    HAL_CAN_ActivateNotification(&hcan1, CAN_IT_RX_FIFO0_MSG_PENDING);
+    HAL_UARTEx_ReceiveToIdle_DMA(&huart1, UART_Rx_Buffer, sizeof(UART_Rx_Buffer));
+    HAL_TIM_Base_Start_IT(&htim4);
+
+    Trace_Length = 0;
+    Trace[0] = 0;
+    Stimulus = __Stimulus;
+    CAN_Active_Priority = -1;
+    PendSV_Active_Priority = -1;
+    PendSV_Depth = 0;
+    PendSV_Max_Depth = 0;
+    UART_Event_Size = 0;
+    UART_Event_Num = 0;
+}
+
+/**
+ * @brief 检查一项
+ *
+ * @param Name 检查项名称
+ * @param Pass 是否通过
+ */
+static void Check(const char *Name, bool Pass)
+{
+    printf("  %-44s %s\n", Name, Pass ? "ok" : "FAIL");
+    if (!Pass)
+    {
+        Fail_Num++;
+    }
+}
+
+/**
+ * @brief 检查顺序记录
+ *
+ * @param Expect 期望的顺序
+ */
+static void Check_Trace(const char *Expect)
+{
+    printf("  trace %s\n", Trace);
+    Check("order", strcmp(Trace, Expect) == 0);
+}
+
+/**
+ * @brief 控制线程中到达CAN报文
+ *
+ */
+static void Stimulus_CAN()
+{
+    Inject_CAN(0);
+}
+
+/**
+ * @brief 控制线程中到达UART数据
+ *
+ */
+static void Stimulus_UART()
+{
+    Inject_UART(8);
+}
+
+/**
+ * @brief 控制线程中到达下一个节拍
+ *
+ */
+static void Stimulus_TIM4()
+{
+    Sim_TIM_Period_Elapsed(&htim4);
+}
+
+/**
+ * @brief 控制线程中再次挂起自身
+ *
+ */
+static void Stimulus_Self()
+{
+    SWI_Trigger();
+    Check("PendSV pending while running", Sim_NVIC_Get_Pending(PendSV_IRQn));
+}
+
+/**
+ * @brief 控制线程关中断期间到达UART、CAN与节拍
+ *
+ */
+static void Stimulus_PRIMASK()
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    Inject_UART(5);
+    Inject_UART(3);
+    Inject_CAN(0);
+    Sim_TIM_Period_Elapsed(&htim4);
+    Check("nothing runs with PRIMASK set", strcmp(Trace, "T<T>P<") == 0);
+    Check("USART1, CAN1_RX0, TIM4 pending", Sim_NVIC_Get_Pending(USART1_IRQn) && Sim_NVIC_Get_Pending(CAN1_RX0_IRQn) && Sim_NVIC_Get_Pending(TIM4_IRQn));
+    __set_PRIMASK(primask);
+}
+
+int main()
+{
+    printf("priority map\n");
+    Case_Reset(NULL);
+    printf("  CAN1_RX0 %u  USART1 %u  TIM4 %u  SysTick %u  PendSV %u\n", Sim_NVIC_Get_Priority(CAN1_RX0_IRQn), Sim_NVIC_Get_Priority(USART1_IRQn), Sim_NVIC_Get_Priority(TIM4_IRQn), Sim_NVIC_Get_Priority(SysTick_IRQn), Sim_NVIC_Get_Priority(PendSV_IRQn));
+    Check("PendSV is the lowest priority", Sim_NVIC_Get_Priority(PendSV_IRQn) == SWI_PRIORITY && Sim_NVIC_Get_Priority(SysTick_IRQn) < SWI_PRIORITY);
+
+    printf("tick from thread: control thread runs after TIM4 returns\n");
+    Case_Reset(NULL);
+    Sim_TIM_Period_Elapsed(&htim4);
+    Check_Trace("T<T>P<P>");
+    Check("control thread at PendSV priority", PendSV_Active_Priority == SWI_PRIORITY);
+    Check("back in thread mode", Sim_NVIC_Get_Active_Priority() == SIM_NVIC_THREAD_PRIORITY);
+
+    printf("CAN frame during control thread: preempts\n");
+    Case_Reset(Stimulus_CAN);
+    Sim_TIM_Period_Elapsed(&htim4);
+    Check_Trace("T<T>P<C<C>P>");
+    Check("CAN ISR at priority 0", CAN_Active_Priority == 0);
+
+    printf("UART data during control thread: preempts\n");
+    Case_Reset(Stimulus_UART);
+    Sim_TIM_Period_Elapsed(&htim4);
+    Check_Trace("T<T>P<U<U>P>");
+    Check("one idle event of 8 bytes", UART_Event_Num == 1 && UART_Event_Size == 8);
+
+    printf("next tick during control thread: TIM4 preempts, PendSV tail-chains\n");
+    Case_Reset(Stimulus_TIM4);
+    Sim_TIM_Period_Elapsed(&htim4);
+    Check_Trace("T<T>P<T<T>P>P<P>");
+    Check("PendSV never nests", PendSV_Max_Depth == 1);
+
+    printf("control thread pends itself: runs again only after return\n");
+    Case_Reset(Stimulus_Self);
+    Sim_TIM_Period_Elapsed(&htim4);
+    Check_Trace("T<T>P<P>P<P>");
+    Check("PendSV never nests", PendSV_Max_Depth == 1);
+
+    printf("tick during CAN ISR: TIM4 waits for CAN, then PendSV\n");
+    Case_Reset(NULL);
+    Inject_CAN(0xAA);
+    Check_Trace("C<C>T<T>P<P>");
+
+    printf("PRIMASK in control thread: ISRs deferred to __set_PRIMASK, same priority by IRQ number\n");
+    Case_Reset(Stimulus_PRIMASK);
+    Sim_TIM_Period_Elapsed(&htim4);
+    Check_Trace("T<T>P<C<C>U<U>T<T>P>P<P>");
+    Check("deferred UART bytes merged into one event", UART_Event_Num == 1 && UART_Event_Size == 8);
+
+    printf("%s, %u failed\n", Fail_Num == 0 ? "PASS" : "FAIL", (unsigned) Fail_Num);
+    return (Fail_Num == 0 ? 0 : 1);
+}
+
+/*****************************************************************************/
@@ -0,0 +1,224 @@
+/**
+ * @file pid_bank_check_main.cpp
+ * @author WFZ
+ * @brief Class_PID_Bank的主机检查: 各功能组合下组内批量计算与独立的Class_PID逐位比较
+ * @version 0.0
+ * @date 2026-2-1
+ *
+ * @note 编译(在仓库根目录, 主机g++):
+ *       g++ -std=c++11 -O2 -IUser/1_Middleware/1_Driver/Math -IUser/1_Middleware/2_Algorithm/PID
+ *           User/1_Middleware/1_Driver/Math/drv_math.cpp User/1_Middleware/2_Algorithm/PID/alg_pid.cpp
+ *           Simulation/PID/pid_bank_check_main.cpp -o pid_bank_check
+ *
+ *       运行: ./pid_bank_check, 逐项输出不一致的次数, 全部通过时返回0
+ *       每组8个控制器, 功能组合与方向各不相同, 期间修改参数、清零积分、无扰切换、轮流关闭槽位, 检查运行中绑定与逐个调用
+ *
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include "alg_pid.h"
+
+/* Private macros ------------------------------------------------------------*/
+
+// 组内控制器个数
+#define PID_BANK_CHECK_NUM 8
+// 每种组合的计算周期数
+#define PID_BANK_CHECK_TICK 4000
+
+/* Private types -------------------------------------------------------------*/
+
+// 绑定到组内的控制器需启用PID_Feature_BANK
+typedef Class_PID_T<PID_Feature_ALL> Class_PID_Bank_View;
+
+/* Private variables ---------------------------------------------------------*/
+
+static uint32_t Fail_Num = 0;
+static uint32_t Random_State = 0x6A09E667U;
+
+/* Private function declarations ---------------------------------------------*/
+
+/* Function prototypes -------------------------------------------------------*/
+
+/**
+ * @brief [-1, 1) 均匀随机数
+ *
+ * @return float 随机数
+ */
+static float Random()
+{
+    Random_State ^= Random_State << 13;
+    Random_State ^= Random_State >> 17;
+    Random_State ^= Random_State << 5;
+    return ((float) (Random_State >> 8) / 8388608.0f - 1.0f);
+}
+
+/**
+ * @brief 逐位比较两个浮点数
+ *
+ */
+static bool Same(float a, float b)
+{
+    return (memcmp(&a, &b, sizeof(float)) == 0);
+}
+
+/**
+ * @brief 按功能位初始化一个控制器, 与Simulation/Benchmark中PID用例的组合一致
+ *
+ * @tparam Type_PID 控制器类型
+ * @param PID 控制器
+ * @param Feature 功能位: 死区, 变速积分, 积分分离, 微分先行, D项滤波, 零位积分泄放, 反向, 抗饱和
+ */
+template <typename Type_PID>
+static void PID_Init(Type_PID *PID, uint32_t Feature)
+{
+    PID->Init(1.0f, 10.0f, 0.01f, 0.002f,
+              5.0f, (Feature & 0x01) ? 3.0f : 0.0f, (Feature & 0x80) ? 2.5f : 10.0f,
+              0.001f,
+              (Feature & 0x01) ? 0.05f : 0.0f,
+              (Feature & 0x02) ? 0.5f : 0.0f, (Feature & 0x02) ? 1.0f : 0.0f, (Feature & 0x04) ? 1.0f : 0.0f, (Feature & 0x08) ? PID_D_First_ENABLE : PID_D_First_DISABLE,
+              (Feature & 0x40) ? PID_REVERSE : PID_DIRECT,
+              (Feature & 0x10) ? 0.3f : 0.0f,
+              (Feature & 0x20) ? PID_ZPIB_ENABLE : PID_ZPIB_DISABLE);
+    // 抗饱和时输出限幅较小, 阶跃时输出饱和
+    PID->Set_K_Back_Calculation((Feature & 0x80) ? 20.0f : 0.0f);
+    PID->Set_Conditional_Integration((Feature & 0x80) ? PID_Conditional_Integration_ENABLE : PID_Conditional_Integration_DISABLE);
+}
+
+/**
+ * @brief 一组功能组合: 组内批量计算、绑定后逐个调用与独立控制器比较
+ *
+ * @param Feature_Base 第一个控制器的功能位, 其余控制器依次错开
+ * @return uint32_t 不一致的次数
+ */
+static uint32_t Check_Feature(uint32_t Feature_Base)
+{
+    Class_PID_Bank<PID_BANK_CHECK_NUM> bank;
+    Class_PID_Bank_View view[PID_BANK_CHECK_NUM];
+    Class_PID reference[PID_BANK_CHECK_NUM];
+    float now[PID_BANK_CHECK_NUM] = {};
+    uint32_t mismatch = 0;
+
+    bank.Init();
+    for (uint32_t i = 0; i < PID_BANK_CHECK_NUM; i++)
+    {
+        uint32_t feature = (Feature_Base + i * 37) & 0xff;
+        PID_Init(&reference[i], feature);
+        // 一半先绑定再初始化, 一半先初始化再绑定
+        if (i & 1)
+        {
+            view[i].Bind_Bank(&bank, i);
+            PID_Init(&view[i], feature);
+        }
+        else
+        {
+            PID_Init(&view[i], feature);
+            view[i].Bind_Bank(&bank, i);
+        }
+    }
+
+    for (uint32_t tick = 0; tick < PID_BANK_CHECK_TICK; tick++)
+    {
+        for (uint32_t i = 0; i < PID_BANK_CHECK_NUM; i++)
+        {
+            // 每500个周期在0与2之间切换的阶跃目标, 零目标段覆盖零位积分泄放
+            float target = ((tick / 500 + i) % 2 == 0) ? 2.0f : 0.0f;
+            now[i] += (target - now[i]) * 0.02f;
+            float feedback = now[i] + 0.02f * Random();
+
+            reference[i].Set_Target(target);
+            reference[i].Set_Now(feedback);
+            view[i].Set_Target(target);
+            view[i].Set_Now(feedback);
+        }
+
+        // 运行中修改参数与清零积分
+        if (tick == 1500)
+        {
+            reference[3].Set_K_P(2.5f);
+            view[3].Set_K_P(2.5f);
+            reference[5].Set_Integral_Error(0.0f);
+            view[5].Set_Integral_Error(0.0f);
+            reference[6].Set_D_Filter_Alpha(0.7f);
+            view[6].Set_D_Filter_Alpha(0.7f);
+            reference[2].Set_K_Back_Calculation(5.0f);
+            view[2].Set_K_Back_Calculation(5.0f);
+        }
+        // 无扰切换, 起始输出各不相同
+        if (tick == 2300)
+        {
+            for (uint32_t i = 1; i < PID_BANK_CHECK_NUM; i += 2)
+            {
+                reference[i].Set_Bumpless_Out(1.5f - 0.5f * i);
+                view[i].Set_Bumpless_Out(1.5f - 0.5f * i);
+            }
+        }
+
+        // 各槽位轮流关闭一段, 关闭期间独立控制器也不计算, 状态与输出应保持不变
+        for (uint32_t i = 0; i < PID_BANK_CHECK_NUM; i++)
+        {
+            bank.Set_Slot_Enable(i, (tick / 300 + i) % 5 != 0);
+        }
+
+        for (uint32_t i = 0; i < PID_BANK_CHECK_NUM; i++)
+        {
+            if (bank.Get_Slot_Enable(i))
+            {
+                reference[i].TIM_Adjust_PeriodElapsedCallback();
+            }
+        }
+        // 每隔一段改为逐个调用绑定后的控制器
+        if ((tick / 700) % 2 == 0)
+        {
+            bank.TIM_Adjust_PeriodElapsedCallback();
+        }
+        else
+        {
+            for (uint32_t i = 0; i < PID_BANK_CHECK_NUM; i++)
+            {
+                if (bank.Get_Slot_Enable(i))
+                {
+                    view[i].TIM_Adjust_PeriodElapsedCallback();
+                }
+            }
+        }
+
+        for (uint32_t i = 0; i < PID_BANK_CHECK_NUM; i++)
+        {
+            bool same = Same(view[i].Get_Out(), reference[i].Get_Out()) && Same(bank.Get_Out(i), reference[i].Get_Out()) &&
+                        Same(view[i].Get_P_Out(), reference[i].Get_P_Out()) && Same(view[i].Get_I_Out(), reference[i].Get_I_Out()) &&
+                        Same(view[i].Get_D_Out(), reference[i].Get_D_Out()) && Same(view[i].Get_F_Out(), reference[i].Get_F_Out()) &&
+                        Same(view[i].Get_Error(), reference[i].Get_Error()) &&
+                        Same(view[i].Get_Integral_Error(), reference[i].Get_Integral_Error());
+            mismatch += same ? 0 : 1;
+        }
+    }
+
+    return (mismatch);
+}
+
+/**
+ * @brief 主函数
+ *
+ * @return int 全部通过返回0
+ */
+int main()
+{
+    uint32_t mismatch = 0;
+
+    printf("bank vs independent Class_PID, %u controllers, %u ticks per combination\n", (unsigned) PID_BANK_CHECK_NUM, (unsigned) PID_BANK_CHECK_TICK);
+    for (uint32_t feature = 0; feature < 256; feature++)
+    {
+        mismatch += Check_Feature(feature);
+    }
+    printf("  %-40s %u  %s\n", "bitwise mismatches, 256 combinations", (unsigned) mismatch, mismatch == 0 ? "ok" : "FAIL");
+    Fail_Num += mismatch == 0 ? 0 : 1;
+
+    printf("%s, %u failed\n", Fail_Num == 0 ? "PASS" : "FAIL", (unsigned) Fail_Num);
+    return (Fail_Num == 0 ? 0 : 1);
+}
+
+/*****************************************************************************/
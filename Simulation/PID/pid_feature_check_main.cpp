@@ -0,0 +1,215 @@
+/**
+ * @file pid_feature_check_main.cpp
+ * @author WFZ
+ * @brief Class_PID_T的主机检查: 全功能的Class_PID与改为模板之前的实现逐位比较, 各功能子集与按同样参数配置的旧实现比较
+ * @version 0.0
+ * @date 2026-2-2
+ *
+ * @note 编译(在仓库根目录, 主机g++):
+ *       g++ -std=c++11 -O2 -IUser/1_Middleware/1_Driver/Math -IUser/1_Middleware/2_Algorithm/PID -ISimulation/PID
+ *           User/1_Middleware/1_Driver/Math/drv_math.cpp User/1_Middleware/2_Algorithm/PID/alg_pid.cpp
+ *           Simulation/PID/pid_reference.cpp Simulation/PID/pid_feature_check_main.cpp -o pid_feature_check
+ *
+ *       运行: ./pid_feature_check, 逐项输出不一致的次数, 全部通过时返回0
+ *       子集比较按数值相等, 关闭D项与前馈后不再加上 ±0, 输出为0时的符号可能与旧实现不同
+ *
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <type_traits>
+#include "alg_pid.h"
+#include "pid_reference.h"
+
+/* Private macros ------------------------------------------------------------*/
+
+// 每种组合的计算周期数
+#define PID_FEATURE_CHECK_TICK 4000
+
+/* Private types -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+
+static uint32_t Fail_Num = 0;
+static uint32_t Random_State = 0xBB67AE85U;
+
+/* Private function declarations ---------------------------------------------*/
+
+/* Function prototypes -------------------------------------------------------*/
+
+/**
+ * @brief [-1, 1) 均匀随机数
+ *
+ * @return float 随机数
+ */
+static float Random()
+{
+    Random_State ^= Random_State << 13;
+    Random_State ^= Random_State >> 17;
+    Random_State ^= Random_State << 5;
+    return ((float) (Random_State >> 8) / 8388608.0f - 1.0f);
+}
+
+/**
+ * @brief 比较两个浮点数
+ *
+ * @param Bitwise 逐位比较, 否则按数值相等
+ */
+static bool Same(float a, float b, bool Bitwise)
+{
+    if (Bitwise)
+    {
+        return (memcmp(&a, &b, sizeof(float)) == 0);
+    }
+    return (a == b);
+}
+
+/**
+ * @brief 按功能位初始化, 功能位含义见Enum_PID_Feature, 未启用的功能给出不起作用的参数
+ *
+ * @param PID 控制器
+ * @param Feature 功能位
+ */
+template <typename Type_PID>
+static void PID_Init(Type_PID *PID, uint32_t Feature)
+{
+    PID->Init(1.0f, 10.0f, (Feature & PID_Feature_D) ? 0.01f : 0.0f, (Feature & PID_Feature_F) ? 0.002f : 0.0f,
+              (Feature & PID_Feature_I_LIMIT) ? 5.0f : 0.0f, (Feature & PID_Feature_D_LIMIT) ? 3.0f : 0.0f, (Feature & PID_Feature_OUT_LIMIT) ? 10.0f : 0.0f,
+              0.001f,
+              (Feature & PID_Feature_DEAD_ZONE) ? 0.05f : 0.0f,
+              (Feature & PID_Feature_VARIABLE_SPEED_I) ? 0.5f : 0.0f, (Feature & PID_Feature_VARIABLE_SPEED_I) ? 1.0f : 0.0f, (Feature & PID_Feature_I_SEPARATE) ? 1.0f : 0.0f,
+              (Feature & PID_Feature_D_FIRST) ? PID_D_First_ENABLE : PID_D_First_DISABLE,
+              (Feature & PID_Feature_DIRECTION) ? PID_REVERSE : PID_DIRECT,
+              (Feature & PID_Feature_D_FILTER) ? 0.3f : 0.0f,
+              (Feature & PID_Feature_ZPIB) ? PID_ZPIB_ENABLE : PID_ZPIB_DISABLE);
+}
+
+/**
+ * @brief 写入反馈时间戳, 未启用实测周期的实例没有该设置函数
+ *
+ */
+template <typename Type_PID>
+static void Set_Timestamp(Type_PID *PID, uint32_t Timestamp_Us, std::true_type)
+{
+    PID->Set_Now_Timestamp_Us(Timestamp_Us);
+}
+
+template <typename Type_PID>
+static void Set_Timestamp(Type_PID *PID, uint32_t Timestamp_Us, std::false_type)
+{
+}
+
+/**
+ * @brief 一个控制器与旧实现逐周期比较, 输入为带噪声的阶跃跟随, 实测周期模式下反馈偶尔重复或间隔抖动
+ *
+ * @param PID 被测控制器, 已按Feature初始化
+ * @param Feature 功能位
+ * @param Bitwise 逐位比较
+ * @return uint32_t 不一致的周期数
+ */
+template <typename Type_PID>
+static uint32_t Check_Against_Reference(Type_PID *PID, uint32_t Feature, bool Bitwise)
+{
+    Class_PID_Reference reference;
+    uint32_t mismatch = 0;
+    uint32_t timestamp_us = 0;
+    float now = 0.0f;
+
+    PID_Init(&reference, Feature);
+    if (Feature & PID_Feature_MEASURED_D_T)
+    {
+        reference.Set_D_T_Mode(PID_D_T_Mode_MEASURED);
+    }
+
+    for (uint32_t tick = 0; tick < PID_FEATURE_CHECK_TICK; tick++)
+    {
+        // 每500个周期在0与2之间切换的阶跃目标, 零目标段覆盖零位积分泄放
+        float target = ((tick / 500) % 2 == 0) ? 2.0f : 0.0f;
+        now += (target - now) * 0.02f;
+        float feedback = now + 0.02f * Random();
+        // 约十分之一的周期反馈未更新, 其余间隔在0.6~1.4ms之间
+        if ((Random_State & 0x0f) != 0)
+        {
+            timestamp_us += 1000 + (int32_t) (400.0f * Random());
+        }
+
+        reference.Set_Target(target);
+        reference.Set_Now(feedback);
+        reference.Set_Now_Timestamp_Us(timestamp_us);
+        reference.TIM_Adjust_PeriodElapsedCallback();
+
+        PID->Set_Target(target);
+        PID->Set_Now(feedback);
+        Set_Timestamp(PID, timestamp_us, std::integral_constant<bool, (Type_PID::Feature_Mask & PID_Feature_MEASURED_D_T) != 0>());
+        PID->TIM_Adjust_PeriodElapsedCallback();
+
+        bool same = Same(PID->Get_Out(), reference.Get_Out(), Bitwise) && Same(PID->Get_P_Out(), reference.Get_P_Out(), Bitwise) &&
+                    Same(PID->Get_I_Out(), reference.Get_I_Out(), Bitwise) && Same(PID->Get_D_Out(), reference.Get_D_Out(), Bitwise) &&
+                    Same(PID->Get_F_Out(), reference.Get_F_Out(), Bitwise) && Same(PID->Get_Error(), reference.Get_Error(), Bitwise) &&
+                    Same(PID->Get_Integral_Error(), reference.Get_Integral_Error(), Bitwise);
+        mismatch += same ? 0 : 1;
+    }
+
+    return (mismatch);
+}
+
+/**
+ * @brief 功能子集实例与旧实现比较
+ *
+ * @tparam Type_PID 被测实例
+ * @param Name 名称
+ */
+template <typename Type_PID>
+static void Check_Subset(const char *Name)
+{
+    Type_PID pid;
+    PID_Init(&pid, Type_PID::Feature_Mask);
+    uint32_t mismatch = Check_Against_Reference(&pid, Type_PID::Feature_Mask, false);
+
+    printf("  %-52s %5u bytes  %u  %s\n", Name, (unsigned) sizeof(Type_PID), (unsigned) mismatch, mismatch == 0 ? "ok" : "FAIL");
+    Fail_Num += mismatch == 0 ? 0 : 1;
+}
+
+/**
+ * @brief 主函数
+ *
+ * @return int 全部通过返回0
+ */
+int main()
+{
+    printf("Class_PID vs previous implementation, bitwise, all combinations of the 12 algorithm features\n");
+    {
+        uint32_t mismatch = 0;
+        const uint32_t algorithm_feature = PID_Feature_ALL & ~(PID_Feature_MEASURED_D_T | PID_Feature_BANK);
+        for (uint32_t feature = 0; feature < (1u << 12); feature++)
+        {
+            // 功能位按Enum_PID_Feature的低12位, 加上实测周期模式的开关交替测试
+            uint32_t mask = (feature & algorithm_feature) | ((feature & 1) ? PID_Feature_MEASURED_D_T : 0);
+            Class_PID pid;
+            PID_Init(&pid, mask);
+            if (mask & PID_Feature_MEASURED_D_T)
+            {
+                pid.Set_D_T_Mode(PID_D_T_Mode_MEASURED);
+            }
+            mismatch += Check_Against_Reference(&pid, mask, true);
+        }
+        printf("  %-52s %5u bytes  %u  %s\n", "Class_PID", (unsigned) sizeof(Class_PID), (unsigned) mismatch, mismatch == 0 ? "ok" : "FAIL");
+        Fail_Num += mismatch == 0 ? 0 : 1;
+    }
+
+    printf("feature subsets vs previous implementation with the same features configured\n");
+    Check_Subset<Class_PID_T<>>("Class_PID_T<> (P+I)");
+    Check_Subset<Class_PID_T<PID_Feature_I_LIMIT, PID_Feature_OUT_LIMIT>>("Class_PID_T<I_LIMIT, OUT_LIMIT>");
+    Check_Subset<Class_PID_T<PID_Feature_D, PID_Feature_D_FIRST, PID_Feature_F, PID_Feature_DIRECTION>>("Class_PID_T<D, D_FIRST, F, DIRECTION>");
+    Check_Subset<Class_PID_T<PID_Feature_VARIABLE_SPEED_I, PID_Feature_I_SEPARATE, PID_Feature_I_LIMIT>>("Class_PID_T<VARIABLE_SPEED_I, I_SEPARATE, I_LIMIT>");
+    Check_Subset<Class_PID_T<PID_Feature_DEAD_ZONE, PID_Feature_ZPIB, PID_Feature_I_LIMIT, PID_Feature_D, PID_Feature_D_FILTER, PID_Feature_D_LIMIT, PID_Feature_OUT_LIMIT>>(
+        "Class_PID_T<yaw omega loop features>");
+
+    printf("%s, %u failed\n", Fail_Num == 0 ? "PASS" : "FAIL", (unsigned) Fail_Num);
+    return (Fail_Num == 0 ? 0 : 1);
+}
+
+/*****************************************************************************/
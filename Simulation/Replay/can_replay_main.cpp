@@ -0,0 +1,312 @@
+/**
+ * @file can_replay_main.cpp
+ * @author WFZ
+ * @brief CAN记录回放: 把CAN_Recorder导出的日志按原始时间戳送回固件, 固件的任务层原样编译运行
+ * @version 0.0
+ * @date 2026-1-22
+ *
+ * @note 日志中的报文通过仿真CAN接收中断进入drv_can.c, 再按ID分发到登记过的电机,
+ *       与实车的接收路径一致. TIM4每1ms产生一次中断运行Task1ms_TIM4_Callback, 第n次中断之前注入所有
+ *       时间戳不晚于n ms的报文, 因此同一份日志每次回放的结果完全一致, 与回放速度无关.
+ *       BMI088由仿真寄存器模型代替, 静止水平放置; 遥控器无输入, 与实车遥控器断连时一致.
+ *
+ *       编译(在仓库根目录, 主机g++):
+ *       g++ -std=c++11 -O2 -Wall $(find User -type d ! -path "*MPU6050*" -printf "-I%p ") -ISimulation/Stub -ISimulation/Device
+ *           -x c++ User/1_Middleware/1_Driver/CAN/drv_can.c User/1_Middleware/1_Driver/UART/drv_uart.c User/2_Device/Buzzer/dvc_buzzer.c
+ *           -x none $(find User -name "*.cpp" ! -path "*MPU6050*") Simulation/Stub/sim_hal.cpp Simulation/Device/sim_bmi088.cpp
+ *           Simulation/Replay/can_replay_main.cpp -o can_replay
+ *
+ *       运行: ./can_replay log=日志文件 参数名=值 ...
+ *       speed=回放速度, 1为实时, N为N倍速, 0为不限速(默认)
+ *       time=最长回放时长(s), 默认回放到日志结束
+ *       csv=固件发出的CAN报文输出文件, 每行 时间(us),总线,ID,DLC,数据
+ *
+ *       例: ./can_replay log=field_0312.canr csv=tx.csv
+ *
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "tsk_config_and_callback.h"
+#include "drv_can.h"
+#include "sim_bmi088.h"
+
+/* Private macros ------------------------------------------------------------*/
+
+// 任务周期, us
+#define REPLAY_TICK_US 1000
+
+/* Private types -------------------------------------------------------------*/
+
+/**
+ * @brief 解码后的一条日志记录
+ *
+ */
+struct Struct_Replay_Record
+{
+    // 扩展为64位的时间戳, us
+    uint64_t Timestamp_Us;
+    uint16_t StdId;
+    uint8_t DLC;
+    // 0为CAN1, 1为CAN2
+    uint8_t Bus;
+    uint8_t Data[8];
+};
+
+/* Private variables ---------------------------------------------------------*/
+
+// 仿真IMU
+static Class_Sim_BMI088 Sim_BMI088;
+
+// 当前仿真时间, us
+static uint64_t Replay_Now_Us = 0;
+// 固件发出的报文输出文件
+static FILE *Replay_Tx_File = NULL;
+// 固件发出的报文数
+static uint32_t Replay_Tx_Num = 0;
+
+/* Private function declarations ---------------------------------------------*/
+
+/* Function prototypes -------------------------------------------------------*/
+
+/**
+ * @brief 仿真CAN发送截获, 记录固件发出的报文
+ *
+ * @param hcan CAN编号
+ * @param Header 报文头
+ * @param Data 报文数据
+ */
+static void Replay_CAN_Tx_Call_Back(CAN_HandleTypeDef *hcan, const CAN_TxHeaderTypeDef *Header, const uint8_t *Data)
+{
+    Replay_Tx_Num++;
+    if (Replay_Tx_File == NULL)
+    {
+        return;
+    }
+
+    fprintf(Replay_Tx_File, "%llu,%d,0x%03x,%u,", (unsigned long long) Replay_Now_Us, hcan->Instance == CAN2 ? 2 : 1, (unsigned) Header->StdId, (unsigned) Header->DLC);
+    for (uint32_t i = 0; i < Header->DLC && i < 8; i++)
+    {
+        fprintf(Replay_Tx_File, "%02x", Data[i]);
+    }
+    fprintf(Replay_Tx_File, "\n");
+}
+
+/**
+ * @brief 读取并解码整个日志文件
+ *
+ * @param File_Name 文件名
+ * @param Record_Num 输出记录条数
+ * @return Struct_Replay_Record* 记录数组, 失败返回NULL
+ */
+static Struct_Replay_Record *Replay_Load(const char *File_Name, uint32_t *Record_Num)
+{
+    FILE *file = fopen(File_Name, "rb");
+    if (file == NULL)
+    {
+        fprintf(stderr, "cannot open %s\n", File_Name);
+        return (NULL);
+    }
+
+    uint8_t header[CAN_RECORDER_HEADER_SIZE];
+    if (fread(header, 1, CAN_RECORDER_HEADER_SIZE, file) != CAN_RECORDER_HEADER_SIZE || memcmp(header, "CANR", 4) != 0)
+    {
+        fprintf(stderr, "%s is not a CAN recorder log\n", File_Name);
+        fclose(file);
+        return (NULL);
+    }
+    if (header[4] != CAN_RECORDER_VERSION || header[5] != CAN_RECORDER_RECORD_SIZE)
+    {
+        fprintf(stderr, "unsupported log version %u, record size %u\n", header[4], header[5]);
+        fclose(file);
+        return (NULL);
+    }
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file) - CAN_RECORDER_HEADER_SIZE;
+    fseek(file, CAN_RECORDER_HEADER_SIZE, SEEK_SET);
+    if (size % CAN_RECORDER_RECORD_SIZE != 0)
+    {
+        fprintf(stderr, "warning: %ld trailing bytes ignored\n", size % CAN_RECORDER_RECORD_SIZE);
+    }
+
+    uint32_t num = size / CAN_RECORDER_RECORD_SIZE;
+    Struct_Replay_Record *record = (Struct_Replay_Record *) malloc(sizeof(Struct_Replay_Record) * (num > 0 ? num : 1));
+    uint8_t raw[CAN_RECORDER_RECORD_SIZE];
+    uint32_t last_timestamp = 0;
+    uint64_t wrap_offset = 0;
+
+    for (uint32_t i = 0; i < num; i++)
+    {
+        if (fread(raw, 1, CAN_RECORDER_RECORD_SIZE, file) != CAN_RECORDER_RECORD_SIZE)
+        {
+            num = i;
+            break;
+        }
+
+        uint32_t timestamp = raw[0] | (raw[1] << 8) | (raw[2] << 16) | ((uint32_t) raw[3] << 24);
+        uint16_t info = raw[4] | (raw[5] << 8);
+
+        // 32位时间戳回绕, 记录器按接收顺序写入, 时间戳只会向前走
+        if (timestamp < last_timestamp && last_timestamp - timestamp > 0x80000000U)
+        {
+            wrap_offset += 0x100000000ULL;
+        }
+        last_timestamp = timestamp;
+
+        record[i].Timestamp_Us = wrap_offset + timestamp;
+        record[i].StdId = info & 0x7ff;
+        record[i].DLC = (info >> 11) & 0x0f;
+        record[i].Bus = info >> 15;
+        memcpy(record[i].Data, &raw[6], 8);
+    }
+
+    fclose(file);
+    *Record_Num = num;
+    return (record);
+}
+
+/**
+ * @brief 按回放速度等待到指定的仿真时刻
+ *
+ * @param Start 回放开始的墙钟时刻
+ * @param Sim_Us 仿真时刻, us
+ * @param Speed 回放速度
+ */
+static void Replay_Wait(const struct timespec *Start, uint64_t Sim_Us, float Speed)
+{
+    uint64_t wall_ns = (uint64_t) (Sim_Us * 1000.0 / Speed);
+    struct timespec deadline;
+    deadline.tv_sec = Start->tv_sec + wall_ns / 1000000000ULL;
+    deadline.tv_nsec = Start->tv_nsec + wall_ns % 1000000000ULL;
+    if (deadline.tv_nsec >= 1000000000L)
+    {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+    clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL);
+}
+
+int main(int argc, char **argv)
+{
+    const char *log_name = NULL;
+    const char *csv_name = NULL;
+    float speed = 0.0f;
+    float time_limit = 0.0f;
+
+    for (int i = 1; i < argc; i++)
+    {
+        char *value = strchr(argv[i], '=');
+        if (value == NULL)
+        {
+            fprintf(stderr, "bad argument %s\n", argv[i]);
+            return (1);
+        }
+        *value++ = '\0';
+
+        if (strcmp(argv[i], "log") == 0)
+        {
+            log_name = value;
+        }
+        else if (strcmp(argv[i], "csv") == 0)
+        {
+            csv_name = value;
+        }
+        else if (strcmp(argv[i], "speed") == 0)
+        {
+            speed = strtof(value, NULL);
+        }
+        else if (strcmp(argv[i], "time") == 0)
+        {
+            time_limit = strtof(value, NULL);
+        }
+        else
+        {
+            fprintf(stderr, "unknown parameter %s\n", argv[i]);
+            return (1);
+        }
+    }
+    if (log_name == NULL)
+    {
+        fprintf(stderr, "usage: %s log=FILE [speed=0] [time=0] [csv=FILE]\n", argv[0]);
+        return (1);
+    }
+
+    uint32_t record_num;
+    Struct_Replay_Record *record = Replay_Load(log_name, &record_num);
+    if (record == NULL)
+    {
+        return (1);
+    }
+
+    if (csv_name != NULL)
+    {
+        Replay_Tx_File = fopen(csv_name, "w");
+        if (Replay_Tx_File == NULL)
+        {
+            fprintf(stderr, "cannot open %s\n", csv_name);
+            return (1);
+        }
+        fprintf(Replay_Tx_File, "time_us,bus,id,dlc,data\n");
+    }
+
+    // 固件上电初始化, 初始化期间的HAL_Delay只推进仿真时钟
+    Sim_HAL_Reset();
+    Sim_BMI088.Init(&hspi1);
+    Task_Init();
+    Sim_CAN_Set_Tx_Call_Back(Replay_CAN_Tx_Call_Back);
+
+    // 日志时间以第一条记录为零点
+    uint64_t time_origin = record_num > 0 ? record[0].Timestamp_Us : 0;
+    uint64_t end_us = record_num > 0 ? record[record_num - 1].Timestamp_Us - time_origin : 0;
+    if (time_limit > 0.0f && (uint64_t) (time_limit * 1e6f) < end_us)
+    {
+        end_us = (uint64_t) (time_limit * 1e6f);
+    }
+
+    struct timespec wall_start, wall_end;
+    clock_gettime(CLOCK_MONOTONIC, &wall_start);
+
+    uint32_t record_index = 0;
+    uint32_t tick_num = 0;
+    for (Replay_Now_Us = REPLAY_TICK_US; Replay_Now_Us <= end_us + REPLAY_TICK_US; Replay_Now_Us += REPLAY_TICK_US)
+    {
+        if (speed > 0.0f)
+        {
+            Replay_Wait(&wall_start, Replay_Now_Us, speed);
+        }
+
+        // 注入这1ms内收到的报文
+        while (record_index < record_num && record[record_index].Timestamp_Us - time_origin <= Replay_Now_Us)
+        {
+            Struct_Replay_Record *r = &record[record_index++];
+            Sim_CAN_Receive(r->Bus ? &hcan2 : &hcan1, r->StdId, r->Data, r->DLC);
+        }
+
+        Sim_HAL_Tick_Increment(1);
+        Sim_TIM_Period_Elapsed(&htim4);
+        tick_num++;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &wall_end);
+    double wall_s = (wall_end.tv_sec - wall_start.tv_sec) + (wall_end.tv_nsec - wall_start.tv_nsec) * 1e-9;
+
+    Struct_Sim_CAN_Statistic can1 = Sim_CAN_Get_Statistic(&hcan1);
+    Struct_Sim_CAN_Statistic can2 = Sim_CAN_Get_Statistic(&hcan2);
+    printf("log=%s records=%u injected=%u ticks=%u sim_s=%.3f wall_s=%.3f speedup=%.1f\n", log_name, record_num, record_index, tick_num, tick_num * REPLAY_TICK_US * 1e-6, wall_s, wall_s > 0.0 ? tick_num * REPLAY_TICK_US * 1e-6 / wall_s : 0.0);
+    printf("can1 rx=%u overrun=%u  can2 rx=%u overrun=%u  firmware_tx=%u\n", can1.Rx_Frame_Num, can1.Rx_Overrun_Num, can2.Rx_Frame_Num, can2.Rx_Overrun_Num, Replay_Tx_Num);
+
+    if (Replay_Tx_File != NULL)
+    {
+        fclose(Replay_Tx_File);
+    }
+    free(record);
+
+    return (0);
+}
+
+/*****************************************************************************/
@@ -0,0 +1,303 @@
+/**
+ * @file sim_robot.cpp
+ * @author WFZ
+ * @brief 整车物理模型: 麦轮底盘刚体, 两轴云台与云台IMU, 摩擦轮与拨弹盘供弹, 电机均为仿真CAN总线上的Class_Sim_Motor
+ * @version 0.0
+ * @date 2026-1-24
+ *
+ * @note 底盘: 轮子接地点速度按crt_chassis中的麦轮运动学 v_i = vx + s_i·vy + c_i·R·ω 计算,
+ *       轮地摩擦力正比于轮缘线速度与接地点速度之差并饱和于μ·m·g/4, 作为负载转矩反作用到电机,
+ *       经运动学矩阵的转置合成车体的力与力矩, 车体在底盘坐标系下按平面刚体积分.
+ *       云台: Yaw负载除自身惯量外还受底盘角加速度的牵连力矩, Pitch受重力矩并有机械限位,
+ *       IMU输出由世界系Yaw角速度, Pitch角速度, 车体加速度与重力投影到云台坐标系得到.
+ *       发射: 拨弹盘反转(供弹方向)每转过一格送入一发, 弹速取两摩擦轮轮缘线速度的平均,
+ *       两摩擦轮各承担一半弹丸动量对应的角动量损失.
+ *       所有参数为典型步兵机器人的量级, 用于回归对比, 不代表某一台车的实测值.
+ *
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "sim_robot.h"
+#include <math.h>
+
+/* Private macros ------------------------------------------------------------*/
+
+#define SIM_PI 3.14159265358979f
+
+/* Private types -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+
+/* Private function declarations ---------------------------------------------*/
+
+/* Function prototypes -------------------------------------------------------*/
+
+/**
+ * @brief 仿真底盘初始化, 车体静止于原点
+ *
+ * @param hcan 轮子电机所在的CAN, 反馈ID为0x201~0x204
+ */
+void Class_Sim_Chassis::Init(CAN_HandleTypeDef *hcan)
+{
+    for (int i = 0; i < 4; i++)
+    {
+        Motor[i].Init(hcan, 0x201 + i, Sim_Motor_Type_M3508, Sim_Motor_Driver_Mode_Current, Wheel_Inertia);
+    }
+
+    Velocity_X = 0.0f;
+    Velocity_Y = 0.0f;
+    Omega = 0.0f;
+    Acc_X = 0.0f;
+    Acc_Y = 0.0f;
+    Angular_Acc = 0.0f;
+    Position_X = 0.0;
+    Position_Y = 0.0;
+    Yaw = 0.0;
+}
+
+/**
+ * @brief 推进底盘与轮子电机
+ *
+ * @param DT 步长, s
+ */
+void Class_Sim_Chassis::Step(float DT)
+{
+    float radius = Half_Length + Half_Width;
+    float force_max = Friction_Coefficient * Mass * 9.80665f / 4.0f;
+    float force_x = -Rolling_Resistance * Velocity_X;
+    float force_y = -Rolling_Resistance * Velocity_Y;
+    float torque_z = -Rolling_Resistance * radius * radius * Omega;
+
+    for (int i = 0; i < 4; i++)
+    {
+        float wheel_velocity = Wheel_Direction[i] * Motor[i].Get_Omega() * Wheel_Radius;
+        float contact_velocity = Velocity_X + Wheel_Y_Factor[i] * Velocity_Y + Wheel_Omega_Factor[i] * radius * Omega;
+
+        float force = Slip_Stiffness * (wheel_velocity - contact_velocity);
+        if (force > force_max) force = force_max;
+        if (force < -force_max) force = -force_max;
+
+        Motor[i].Set_Load_Torque(-Wheel_Direction[i] * force * Wheel_Radius);
+        Motor[i].Step(DT);
+
+        force_x += force;
+        force_y += Wheel_Y_Factor[i] * force;
+        torque_z += Wheel_Omega_Factor[i] * radius * force;
+    }
+
+    Acc_X = force_x / Mass;
+    Acc_Y = force_y / Mass;
+    Angular_Acc = torque_z / Inertia_Z;
+
+    // 底盘坐标系随车体转动, 速度积分需扣除牵连项
+    float next_velocity_x = Velocity_X + (Acc_X + Omega * Velocity_Y) * DT;
+    float next_velocity_y = Velocity_Y + (Acc_Y - Omega * Velocity_X) * DT;
+    Velocity_X = next_velocity_x;
+    Velocity_Y = next_velocity_y;
+    Omega += Angular_Acc * DT;
+
+    Yaw += (double) Omega * DT;
+    Position_X += (Velocity_X * cos(Yaw) - Velocity_Y * sin(Yaw)) * DT;
+    Position_Y += (Velocity_X * sin(Yaw) + Velocity_Y * cos(Yaw)) * DT;
+}
+
+/**
+ * @brief 仿真云台初始化, 云台回中且水平
+ *
+ * @param hcan 云台电机所在的CAN
+ * @param hspi IMU所在的SPI
+ * @param Yaw_Feedback_ID Yaw电机反馈ID
+ * @param Yaw_Encoder_Offset 固件中Yaw电机的编码器偏移
+ * @param Pitch_Feedback_ID Pitch电机反馈ID
+ * @param Pitch_Encoder_Offset 固件中Pitch电机的编码器偏移
+ */
+void Class_Sim_Gimbal::Init(CAN_HandleTypeDef *hcan, SPI_HandleTypeDef *hspi, uint16_t Yaw_Feedback_ID, int32_t Yaw_Encoder_Offset, uint16_t Pitch_Feedback_ID, int32_t Pitch_Encoder_Offset)
+{
+    Yaw_Offset_Angle = Yaw_Encoder_Offset * 2.0f * SIM_PI / 8192.0f;
+    Pitch_Offset_Angle = Pitch_Encoder_Offset * 2.0f * SIM_PI / 8192.0f;
+
+    Motor_Yaw.Init(hcan, Yaw_Feedback_ID, Sim_Motor_Type_GM6020, Sim_Motor_Driver_Mode_Current, Yaw_Inertia);
+    Motor_Yaw.Set_Angle(-Yaw_Offset_Angle);
+
+    Motor_Pitch.Init(hcan, Pitch_Feedback_ID, Sim_Motor_Type_GM6020, Sim_Motor_Driver_Mode_Current, Pitch_Inertia);
+    Motor_Pitch.Set_Angle(-Pitch_Offset_Angle);
+
+    World_Yaw_Omega = 0.0f;
+
+    IMU.Init(hspi);
+    IMU.Set_Gyro(0.0f, 0.0f, 0.0f);
+    IMU.Set_Acc(0.0f, 0.0f, Gravity);
+}
+
+/**
+ * @brief 推进云台电机并刷新IMU
+ *
+ * @param DT 步长, s
+ * @param Chassis 云台所在的底盘
+ */
+void Class_Sim_Gimbal::Step(float DT, Class_Sim_Chassis *Chassis)
+{
+    // 底盘转动加速时云台因惯性相对底盘反向转动
+    Motor_Yaw.Set_Load_Torque(-Yaw_Inertia * Chassis->Get_Angular_Acc());
+    Motor_Pitch.Set_Load_Torque(-Pitch_Gravity_Torque * cosf(Get_Pitch_Angle()));
+
+    Motor_Yaw.Step(DT);
+    Motor_Pitch.Step(DT);
+
+    // Pitch机械限位, 撞限位后速度清零
+    float pitch = Get_Pitch_Angle();
+    if (pitch < Pitch_Angle_Min)
+    {
+        Motor_Pitch.Set_Angle(Pitch_Angle_Min - Pitch_Offset_Angle);
+        if (Motor_Pitch.Get_Omega() < 0.0f) Motor_Pitch.Set_Omega(0.0f);
+        pitch = Pitch_Angle_Min;
+    }
+    else if (pitch > Pitch_Angle_Max)
+    {
+        Motor_Pitch.Set_Angle(Pitch_Angle_Max - Pitch_Offset_Angle);
+        if (Motor_Pitch.Get_Omega() > 0.0f) Motor_Pitch.Set_Omega(0.0f);
+        pitch = Pitch_Angle_Max;
+    }
+
+    World_Yaw_Omega = Chassis->Get_Omega() + Motor_Yaw.Get_Omega();
+
+    float yaw = Get_Yaw_Angle();
+    float sin_pitch = sinf(pitch);
+    float cos_pitch = cosf(pitch);
+
+    // 车体加速度转到Yaw坐标系, 再叠加重力投影到随Pitch转动的IMU坐标系
+    float acc_x = Chassis->Get_Acc_X() * cosf(yaw) + Chassis->Get_Acc_Y() * sinf(yaw);
+    float acc_y = -Chassis->Get_Acc_X() * sinf(yaw) + Chassis->Get_Acc_Y() * cosf(yaw);
+
+    IMU.Set_Gyro(World_Yaw_Omega * sin_pitch, -Motor_Pitch.Get_Omega(), World_Yaw_Omega * cos_pitch);
+    IMU.Set_Acc(acc_x * cos_pitch + Gravity * sin_pitch, acc_y, -acc_x * sin_pitch + Gravity * cos_pitch);
+}
+
+/**
+ * @brief 仿真发射机构初始化
+ *
+ * @param hcan 发射机构电机所在的CAN, 左右摩擦轮0x201/0x202, 拨弹盘0x203
+ * @param Ammo_Num 弹仓内的弹丸数
+ */
+void Class_Sim_Booster::Init(CAN_HandleTypeDef *hcan, uint16_t Ammo_Num)
+{
+    Motor_Friction_Left.Init(hcan, 0x201, Sim_Motor_Type_M3508, Sim_Motor_Driver_Mode_Current, Friction_Wheel_Inertia, 1.0f);
+    Motor_Friction_Right.Init(hcan, 0x202, Sim_Motor_Type_M3508, Sim_Motor_Driver_Mode_Current, Friction_Wheel_Inertia, 1.0f);
+    Motor_Driver.Init(hcan, 0x203, Sim_Motor_Type_M2006, Sim_Motor_Driver_Mode_Current, Driver_Inertia);
+
+    Ammo_Remain = Ammo_Num;
+    if (Ammo_Remain > 0)
+    {
+        Motor_Driver.Get_Parameter()->Coulomb_Friction += Ammo_Friction_Torque;
+    }
+
+    Slot_Index = 0;
+    Shoot_Num = 0;
+    Jam_Num = 0;
+    Last_Shoot_Speed = 0.0f;
+    Shoot_Speed_Min = 0.0f;
+    Shoot_Speed_Max = 0.0f;
+    Shoot_Speed_Sum = 0.0;
+    Shoot_Speed_Square_Sum = 0.0;
+}
+
+/**
+ * @brief 获取平均弹速, m/s
+ *
+ * @return float 平均弹速
+ */
+float Class_Sim_Booster::Get_Shoot_Speed_Mean()
+{
+    if (Shoot_Num == 0)
+    {
+        return (0.0f);
+    }
+    return ((float) (Shoot_Speed_Sum / Shoot_Num));
+}
+
+/**
+ * @brief 获取弹速标准差, m/s
+ *
+ * @return float 弹速标准差
+ */
+float Class_Sim_Booster::Get_Shoot_Speed_Std()
+{
+    if (Shoot_Num < 2)
+    {
+        return (0.0f);
+    }
+    double mean = Shoot_Speed_Sum / Shoot_Num;
+    double variance = Shoot_Speed_Square_Sum / Shoot_Num - mean * mean;
+    return (variance > 0.0 ? (float) sqrt(variance) : 0.0f);
+}
+
+/**
+ * @brief 推进发射机构电机, 检测拨弹盘是否送出了新的一发
+ *
+ * @param DT 步长, s
+ */
+void Class_Sim_Booster::Step(float DT)
+{
+    Motor_Friction_Left.Step(DT);
+    Motor_Friction_Right.Step(DT);
+    Motor_Driver.Step(DT);
+
+    // 以半格为界, 拨弹盘单发转一格恰好越过一次
+    float step_angle = 2.0f * SIM_PI / Ammo_Num_Per_Round;
+    int32_t index = (int32_t) floorf(-Motor_Driver.Get_Angle() / step_angle + 0.5f);
+
+    while (index > Slot_Index)
+    {
+        Slot_Index++;
+        Shoot();
+    }
+    // 拨弹盘回退时弹丸留在原格, 不会重复送弹
+    if (index < Slot_Index)
+    {
+        Slot_Index = index;
+    }
+}
+
+/**
+ * @brief 送入一发弹丸
+ *
+ */
+void Class_Sim_Booster::Shoot()
+{
+    if (Ammo_Remain == 0)
+    {
+        return;
+    }
+    Ammo_Remain--;
+    if (Ammo_Remain == 0)
+    {
+        Motor_Driver.Get_Parameter()->Coulomb_Friction -= Ammo_Friction_Torque;
+    }
+
+    float omega_left = Motor_Friction_Left.Get_Omega();
+    float omega_right = Motor_Friction_Right.Get_Omega();
+    if (fabsf(omega_left) < Friction_Omega_Min || fabsf(omega_right) < Friction_Omega_Min)
+    {
+        Jam_Num++;
+        return;
+    }
+
+    float speed = Friction_Wheel_Radius * (fabsf(omega_left) + fabsf(omega_right)) / 2.0f;
+
+    // 每个摩擦轮承担一半的弹丸动量
+    float angular_impulse = Ammo_Mass * speed * Friction_Wheel_Radius / 2.0f;
+    float inertia_left = Motor_Friction_Left.Get_Parameter()->Inertia + Friction_Wheel_Inertia;
+    float inertia_right = Motor_Friction_Right.Get_Parameter()->Inertia + Friction_Wheel_Inertia;
+    Motor_Friction_Left.Set_Omega(omega_left - copysignf(angular_impulse / inertia_left, omega_left));
+    Motor_Friction_Right.Set_Omega(omega_right - copysignf(angular_impulse / inertia_right, omega_right));
+
+    if (Shoot_Num == 0 || speed < Shoot_Speed_Min) Shoot_Speed_Min = speed;
+    if (Shoot_Num == 0 || speed > Shoot_Speed_Max) Shoot_Speed_Max = speed;
+    Shoot_Num++;
+    Last_Shoot_Speed = speed;
+    Shoot_Speed_Sum += speed;
+    Shoot_Speed_Square_Sum += (double) speed * speed;
+}
+
+/*****************************************************************************/
@@ -0,0 +1,433 @@
+/**
+ * @file sim_robot.h
+ * @author WFZ
+ * @brief 整车物理模型: 麦轮底盘刚体, 两轴云台与云台IMU, 摩擦轮与拨弹盘供弹, 电机均为仿真CAN总线上的Class_Sim_Motor
+ * @version 0.0
+ * @date 2026-1-24
+ *
+ *
+ */
+
+#ifndef SIM_ROBOT_H
+#define SIM_ROBOT_H
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "sim_motor.h"
+#include "sim_bmi088.h"
+
+/* Exported macros -----------------------------------------------------------*/
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+ * @brief 仿真麦轮底盘, 平面刚体, 轮地之间按滑移率计算摩擦力
+ *
+ * 轮序与坐标系与crt_chassis.h一致: 0左后, 1左前, 2右前, 3右后; X前, Y左, Z上; 右侧电机安装方向相反
+ *
+ */
+class Class_Sim_Chassis
+{
+public:
+    // 四个轮子电机, M3508+C620
+    Class_Sim_Motor Motor[4];
+
+    void Init(CAN_HandleTypeDef *hcan);
+
+    inline float Get_Velocity_X();
+
+    inline float Get_Velocity_Y();
+
+    inline float Get_Omega();
+
+    inline float Get_Acc_X();
+
+    inline float Get_Acc_Y();
+
+    inline float Get_Angular_Acc();
+
+    inline float Get_Position_X();
+
+    inline float Get_Position_Y();
+
+    inline float Get_Yaw();
+
+    void Step(float DT);
+
+protected:
+    // 常量
+
+    // 整车质量, kg
+    float Mass = 15.0f;
+    // 整车绕Z轴转动惯量, kg·m²
+    float Inertia_Z = 0.6f;
+    // 底盘长度的一半, m
+    float Half_Length = 0.185f;
+    // 底盘宽度的一半, m
+    float Half_Width = 0.2f;
+    // 轮子半径, m
+    float Wheel_Radius = 0.075f;
+    // 单个麦轮转动惯量, kg·m²
+    float Wheel_Inertia = 2.0e-3f;
+    // 轮地摩擦系数
+    float Friction_Coefficient = 0.8f;
+    // 滑移速度为1m/s时的摩擦力, N/(m/s), 饱和于最大静摩擦力
+    float Slip_Stiffness = 400.0f;
+    // 滚动阻力, N/(m/s)
+    float Rolling_Resistance = 2.0f;
+
+    // 轮子线速度与电机转速的方向
+    const float Wheel_Direction[4] = {1.0f, 1.0f, -1.0f, -1.0f};
+    // 轮子线速度中vy的系数
+    const float Wheel_Y_Factor[4] = {1.0f, -1.0f, 1.0f, -1.0f};
+    // 轮子线速度中ω·R的系数
+    const float Wheel_Omega_Factor[4] = {-1.0f, -1.0f, 1.0f, 1.0f};
+
+    // 读变量
+
+    // 底盘坐标系下的速度, m/s
+    float Velocity_X = 0.0f;
+    float Velocity_Y = 0.0f;
+    // 角速度, rad/s
+    float Omega = 0.0f;
+    // 底盘坐标系下的加速度(含向心项), m/s²
+    float Acc_X = 0.0f;
+    float Acc_Y = 0.0f;
+    // 角加速度, rad/s²
+    float Angular_Acc = 0.0f;
+    // 世界坐标系下的位置, m, 与航向角, rad
+    double Position_X = 0.0;
+    double Position_Y = 0.0;
+    double Yaw = 0.0;
+};
+
+/**
+ * @brief 仿真两轴云台, Yaw装在底盘上, Pitch装在Yaw上, IMU装在Pitch上
+ *
+ * 方向与crt_gimbal.h一致: Yaw从上往下看逆时针为正, Pitch抬头为正.
+ * IMU坐标系X前, Y左, Z上, 随Pitch转动, 所以抬头时陀螺仪Y轴读数为负
+ *
+ */
+class Class_Sim_Gimbal
+{
+public:
+    // Yaw电机, GM6020
+    Class_Sim_Motor Motor_Yaw;
+    // Pitch电机, GM6020
+    Class_Sim_Motor Motor_Pitch;
+    // 云台IMU
+    Class_Sim_BMI088 IMU;
+
+    void Init(CAN_HandleTypeDef *hcan, SPI_HandleTypeDef *hspi, uint16_t Yaw_Feedback_ID, int32_t Yaw_Encoder_Offset, uint16_t Pitch_Feedback_ID, int32_t Pitch_Encoder_Offset);
+
+    inline float Get_Yaw_Angle();
+
+    inline float Get_World_Yaw_Omega();
+
+    inline float Get_Pitch_Angle();
+
+    inline float Get_Pitch_Omega();
+
+    void Step(float DT, Class_Sim_Chassis *Chassis);
+
+protected:
+    // 初始化相关常量
+
+    // 编码器偏移对应的角度, rad, 与固件中Init传入的Encoder_Offset一致
+    float Yaw_Offset_Angle;
+    float Pitch_Offset_Angle;
+
+    // 常量
+
+    // Yaw轴负载转动惯量(云台整体), kg·m²
+    float Yaw_Inertia = 0.04f;
+    // Pitch轴负载转动惯量, kg·m²
+    float Pitch_Inertia = 0.015f;
+    // Pitch轴水平时的重力矩, N·m, 正值表示低头方向
+    float Pitch_Gravity_Torque = 0.3f;
+    // Pitch轴机械限位, rad
+    float Pitch_Angle_Min = -0.5f;
+    float Pitch_Angle_Max = 0.85f;
+    // 重力加速度, m/s²
+    float Gravity = 9.80665f;
+
+    // 读变量
+
+    // 世界坐标系下的Yaw角速度, rad/s
+    float World_Yaw_Omega = 0.0f;
+};
+
+/**
+ * @brief 仿真发射机构, 拨弹盘每转过一格向摩擦轮送入一发弹丸
+ *
+ */
+class Class_Sim_Booster
+{
+public:
+    // 左摩擦轮电机, M3508拆减速箱
+    Class_Sim_Motor Motor_Friction_Left;
+    // 右摩擦轮电机, M3508拆减速箱
+    Class_Sim_Motor Motor_Friction_Right;
+    // 拨弹盘电机, M2006+C610
+    Class_Sim_Motor Motor_Driver;
+
+    void Init(CAN_HandleTypeDef *hcan, uint16_t Ammo_Num);
+
+    inline uint16_t Get_Ammo_Remain();
+
+    inline uint32_t Get_Shoot_Num();
+
+    inline uint32_t Get_Jam_Num();
+
+    inline float Get_Last_Shoot_Speed();
+
+    inline float Get_Shoot_Speed_Min();
+
+    inline float Get_Shoot_Speed_Max();
+
+    float Get_Shoot_Speed_Mean();
+
+    float Get_Shoot_Speed_Std();
+
+    void Step(float DT);
+
+protected:
+    // 常量
+
+    // 摩擦轮半径, m
+    float Friction_Wheel_Radius = 0.03f;
+    // 摩擦轮转动惯量, kg·m²
+    float Friction_Wheel_Inertia = 3.0e-5f;
+    // 拨弹盘与弹丸转动惯量, kg·m²
+    float Driver_Inertia = 2.0e-3f;
+    // 弹仓内弹丸对拨弹盘的摩擦力矩, N·m
+    float Ammo_Friction_Torque = 0.3f;
+    // 拨弹盘一圈弹丸数, 与固件一致
+    float Ammo_Num_Per_Round = 7.0f;
+    // 弹丸质量, kg
+    float Ammo_Mass = 3.2e-3f;
+    // 摩擦轮低于该转速时弹丸卡在摩擦轮之间, rad/s
+    float Friction_Omega_Min = 100.0f;
+
+    // 内部变量
+
+    // 已送出的格数, 拨弹盘反转为供弹方向
+    int32_t Slot_Index = 0;
+
+    // 读变量
+
+    // 剩余弹量
+    uint16_t Ammo_Remain = 0;
+    // 射出弹丸数
+    uint32_t Shoot_Num = 0;
+    // 卡弹数
+    uint32_t Jam_Num = 0;
+    // 弹速统计, m/s
+    float Last_Shoot_Speed = 0.0f;
+    float Shoot_Speed_Min = 0.0f;
+    float Shoot_Speed_Max = 0.0f;
+    double Shoot_Speed_Sum = 0.0;
+    double Shoot_Speed_Square_Sum = 0.0;
+
+    // 内部函数
+
+    void Shoot();
+};
+
+/* Exported variables --------------------------------------------------------*/
+
+/* Exported function declarations --------------------------------------------*/
+
+/**
+ * @brief 获取底盘坐标系下的X速度, m/s
+ *
+ * @return float X速度
+ */
+inline float Class_Sim_Chassis::Get_Velocity_X()
+{
+    return (Velocity_X);
+}
+
+/**
+ * @brief 获取底盘坐标系下的Y速度, m/s
+ *
+ * @return float Y速度
+ */
+inline float Class_Sim_Chassis::Get_Velocity_Y()
+{
+    return (Velocity_Y);
+}
+
+/**
+ * @brief 获取底盘角速度, rad/s
+ *
+ * @return float 角速度
+ */
+inline float Class_Sim_Chassis::Get_Omega()
+{
+    return (Omega);
+}
+
+/**
+ * @brief 获取底盘坐标系下的X加速度, m/s²
+ *
+ * @return float X加速度
+ */
+inline float Class_Sim_Chassis::Get_Acc_X()
+{
+    return (Acc_X);
+}
+
+/**
+ * @brief 获取底盘坐标系下的Y加速度, m/s²
+ *
+ * @return float Y加速度
+ */
+inline float Class_Sim_Chassis::Get_Acc_Y()
+{
+    return (Acc_Y);
+}
+
+/**
+ * @brief 获取底盘角加速度, rad/s²
+ *
+ * @return float 角加速度
+ */
+inline float Class_Sim_Chassis::Get_Angular_Acc()
+{
+    return (Angular_Acc);
+}
+
+/**
+ * @brief 获取世界坐标系下的X位置, m
+ *
+ * @return float X位置
+ */
+inline float Class_Sim_Chassis::Get_Position_X()
+{
+    return ((float) Position_X);
+}
+
+/**
+ * @brief 获取世界坐标系下的Y位置, m
+ *
+ * @return float Y位置
+ */
+inline float Class_Sim_Chassis::Get_Position_Y()
+{
+    return ((float) Position_Y);
+}
+
+/**
+ * @brief 获取世界坐标系下的航向角, rad
+ *
+ * @return float 航向角
+ */
+inline float Class_Sim_Chassis::Get_Yaw()
+{
+    return ((float) Yaw);
+}
+
+/**
+ * @brief 获取云台相对底盘的Yaw角, rad, 与固件Class_Gimbal::Get_Now_Yaw_Angle含义一致
+ *
+ * @return float Yaw角
+ */
+inline float Class_Sim_Gimbal::Get_Yaw_Angle()
+{
+    return (Motor_Yaw.Get_Angle() + Yaw_Offset_Angle);
+}
+
+/**
+ * @brief 获取世界坐标系下的Yaw角速度, rad/s
+ *
+ * @return float Yaw角速度
+ */
+inline float Class_Sim_Gimbal::Get_World_Yaw_Omega()
+{
+    return (World_Yaw_Omega);
+}
+
+/**
+ * @brief 获取Pitch角, rad, 与固件Class_Gimbal::Get_Now_Pitch_Angle含义一致
+ *
+ * @return float Pitch角
+ */
+inline float Class_Sim_Gimbal::Get_Pitch_Angle()
+{
+    return (Motor_Pitch.Get_Angle() + Pitch_Offset_Angle);
+}
+
+/**
+ * @brief 获取Pitch角速度, rad/s
+ *
+ * @return float Pitch角速度
+ */
+inline float Class_Sim_Gimbal::Get_Pitch_Omega()
+{
+    return (Motor_Pitch.Get_Omega());
+}
+
+/**
+ * @brief 获取剩余弹量
+ *
+ * @return uint16_t 剩余弹量
+ */
+inline uint16_t Class_Sim_Booster::Get_Ammo_Remain()
+{
+    return (Ammo_Remain);
+}
+
+/**
+ * @brief 获取射出弹丸数
+ *
+ * @return uint32_t 射出弹丸数
+ */
+inline uint32_t Class_Sim_Booster::Get_Shoot_Num()
+{
+    return (Shoot_Num);
+}
+
+/**
+ * @brief 获取卡弹数, 即摩擦轮未转起时送入的弹丸数
+ *
+ * @return uint32_t 卡弹数
+ */
+inline uint32_t Class_Sim_Booster::Get_Jam_Num()
+{
+    return (Jam_Num);
+}
+
+/**
+ * @brief 获取最近一发弹速, m/s
+ *
+ * @return float 弹速
+ */
+inline float Class_Sim_Booster::Get_Last_Shoot_Speed()
+{
+    return (Last_Shoot_Speed);
+}
+
+/**
+ * @brief 获取最低弹速, m/s
+ *
+ * @return float 最低弹速
+ */
+inline float Class_Sim_Booster::Get_Shoot_Speed_Min()
+{
+    return (Shoot_Speed_Min);
+}
+
+/**
+ * @brief 获取最高弹速, m/s
+ *
+ * @return float 最高弹速
+ */
+inline float Class_Sim_Booster::Get_Shoot_Speed_Max()
+{
+    return (Shoot_Speed_Max);
+}
+
+#endif
+
+/*****************************************************************************/
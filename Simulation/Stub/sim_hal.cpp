@@ -0,0 +1,1425 @@
+/**
+ * @file sim_hal.cpp
+ * @author WFZ
+ * @brief 主机仿真HAL替身的实现
+ * @version 0.0
+ * @date 2026-1-20
+ *
+ * @note 接收路径模拟bxCAN的3级FIFO, 报文注入后若对应FIFO中断已使能,
+ *       则直接调用HAL_CAN_RxFifoxMsgPendingCallback, 等效于进入CAN接收中断,
+ *       因此drv_can.c中的中断处理流程在主机上会被原样执行.
+ *       过滤器组按参考手册的寄存器语义实现, 28组由CAN1与CAN2按CAN2SB划分, 报文是否接收及进入哪个FIFO
+ *       由过滤器决定, 多组同时匹配时取编号最小的一组.
+ *       UART接收模拟循环DMA, 注入的数据逐字节写入ReceiveToIdle_DMA登记的环形缓冲区并递减NDTR,
+ *       写到一半/末尾时产生HT/TC事件, 写完产生空闲事件, 与HAL一样调用HAL_UARTEx_RxEventCallback;
+ *       定时器由仿真主循环调用Sim_TIM_Period_Elapsed触发, 只有HAL_TIM_Base_Start_IT之后才会进入回调.
+ *       TIM4、CAN接收、UART接收与PendSV经过仿真NVIC: 按HAL_NVIC_SetPriority设定的抢占优先级,
+ *       比当前执行优先级高且未关中断时立即嵌套进入, 否则挂起, 在返回到更低优先级或重新开中断时进入
+ *       (同优先级取中断号小的), 与Cortex-M4的抢占与咬尾一致. 挂起期间到达的UART数据照常由DMA写入,
+ *       进入中断时合并为一次空闲事件; CAN发送完成与错误回调不经过NVIC, 总是立即进入
+ *
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "sim_hal.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Private macros ------------------------------------------------------------*/
+
+/* Private types -------------------------------------------------------------*/
+
+/**
+ * @brief 经过仿真NVIC的中断, 按中断号升序
+ *
+ */
+enum Enum_Sim_NVIC_Line
+{
+    Sim_NVIC_Line_PENDSV = 0,
+    Sim_NVIC_Line_CAN1_RX0,
+    Sim_NVIC_Line_CAN1_RX1,
+    Sim_NVIC_Line_TIM4,
+    Sim_NVIC_Line_USART1,
+    Sim_NVIC_Line_USART3,
+    Sim_NVIC_Line_CAN2_RX0,
+    Sim_NVIC_Line_CAN2_RX1,
+    Sim_NVIC_Line_USART6,
+    Sim_NVIC_Line_NUM,
+};
+
+/**
+ * @brief 仿真CAN接收FIFO中的一帧
+ *
+ */
+struct Struct_Sim_CAN_Frame
+{
+    CAN_RxHeaderTypeDef Header;
+    uint8_t Data[8];
+};
+
+/**
+ * @brief 仿真CAN外设状态
+ *
+ */
+struct Struct_Sim_CAN
+{
+    Struct_Sim_CAN_Frame FIFO[2][SIM_CAN_FIFO_DEPTH];
+    uint8_t FIFO_Head[2];
+    uint8_t FIFO_Level[2];
+    // 占用中的发送邮箱, bit0~2对应邮箱0~2
+    uint8_t Tx_Mailbox_Busy;
+    // 报文进入邮箱后保持占用, 直到Sim_CAN_Tx_Complete
+    bool Tx_Hold;
+    bool Started;
+    Struct_Sim_CAN_Statistic Statistic;
+};
+
+/* Private variables ---------------------------------------------------------*/
+
+CAN_TypeDef Sim_CAN1_Instance;
+CAN_TypeDef Sim_CAN2_Instance;
+
+// 与CubeMX中CAN的配置一致: 42MHz/3分频, 1+10+3个时间量子即1Mbps, 开启自动离线管理
+CAN_HandleTypeDef hcan1 = {CAN1, {3, CAN_MODE_NORMAL, CAN_SJW_1TQ, CAN_BS1_10TQ, CAN_BS2_3TQ, DISABLE, ENABLE, DISABLE, DISABLE, DISABLE, DISABLE}};
+CAN_HandleTypeDef hcan2 = {CAN2, {3, CAN_MODE_NORMAL, CAN_SJW_1TQ, CAN_BS1_10TQ, CAN_BS2_3TQ, DISABLE, ENABLE, DISABLE, DISABLE, DISABLE, DISABLE}};
+
+GPIO_TypeDef Sim_GPIO_Instance[9];
+TIM_TypeDef Sim_TIM_Instance[14];
+USART_TypeDef Sim_USART_Instance[6];
+
+uint32_t Sim_PRIMASK = 0;
+SPI_TypeDef Sim_SPI_Instance[3];
+
+// UART接收DMA, NDTR为剩余传输数, 即DMA写指针 = RxXferSize - NDTR
+static DMA_Stream_TypeDef Sim_UART_DMA_Stream[3];
+static DMA_HandleTypeDef Sim_UART_DMA[3] = {{&Sim_UART_DMA_Stream[0]}, {&Sim_UART_DMA_Stream[1]}, {&Sim_UART_DMA_Stream[2]}};
+
+UART_HandleTypeDef huart1 = {USART1, {0}, NULL, 0, 0, &Sim_UART_DMA[0]};
+UART_HandleTypeDef huart3 = {USART3, {0}, NULL, 0, 0, &Sim_UART_DMA[1]};
+UART_HandleTypeDef huart6 = {USART6, {0}, NULL, 0, 0, &Sim_UART_DMA[2]};
+
+// 与CubeMX中TIM4的配置一致: 84MHz/84分频, 1000计数即1ms
+TIM_HandleTypeDef htim4 = {TIM4, {83, 0, 999, 0, 0, 0}};
+
+SPI_HandleTypeDef hspi1 = {SPI1};
+
+static Struct_Sim_CAN Sim_CAN[2];
+
+static Sim_CAN_Tx_Call_Back Sim_CAN_Tx_Callback_Function = NULL;
+static Sim_UART_Tx_Call_Back Sim_UART_Tx_Callback_Function = NULL;
+// 各UART的DMA发送是否保持占用直到Sim_UART_Tx_Complete, 按USART_TypeDef在Sim_USART_Instance中的下标
+static bool Sim_UART_Tx_Hold[6];
+static Sim_SPI_Call_Back Sim_SPI_Callback_Function = NULL;
+static Sim_GPIO_Write_Call_Back Sim_GPIO_Write_Callback_Function = NULL;
+
+static uint32_t Sim_Tick = 0;
+// 仿真时间, us, 32位回绕, 作为固件的微秒时钟
+static uint32_t Sim_Time_Us = 0;
+
+SCB_Type Sim_SCB;
+
+// 各中断的抢占优先级, 按中断号+16存放
+static uint8_t Sim_NVIC_Priority[16 + 82];
+// 挂起的中断, 按Enum_Sim_NVIC_Line的位
+static uint32_t Sim_NVIC_Pending = 0;
+// 当前执行优先级
+static int16_t Sim_NVIC_Active_Priority = SIM_NVIC_THREAD_PRIORITY;
+
+static const IRQn_Type Sim_NVIC_Line_IRQn[Sim_NVIC_Line_NUM] = {PendSV_IRQn, CAN1_RX0_IRQn, CAN1_RX1_IRQn, TIM4_IRQn, USART1_IRQn, USART3_IRQn, CAN2_RX0_IRQn, CAN2_RX1_IRQn, USART6_IRQn};
+
+/* Private function declarations ---------------------------------------------*/
+
+static bool Sim_NVIC_Enter(uint8_t Line, int16_t *Saved_Priority);
+
+static void Sim_NVIC_Exit(int16_t Saved_Priority);
+
+static void Sim_NVIC_Request(uint8_t Line);
+
+static void Sim_NVIC_Dispatch();
+
+static void Sim_NVIC_Line_Handler(uint8_t Line);
+
+static uint8_t Sim_UART_Get_NVIC_Line(UART_HandleTypeDef *huart);
+
+static Struct_Sim_CAN *Sim_CAN_Get(CAN_HandleTypeDef *hcan);
+
+static CAN_TypeDef *Sim_CAN_Get_Instance(uint8_t Bus);
+
+static void Sim_CAN_Update_Rx_Register(uint8_t Bus, uint32_t Rx_FIFO);
+
+static void Sim_CAN_Update_Tx_Register(uint8_t Bus);
+
+static void Sim_CAN_Release_Rx_FIFO(uint8_t Bus, uint32_t Rx_FIFO);
+
+static void Sim_CAN_Transmit(uint8_t Bus, uint8_t Mailbox, const CAN_TxHeaderTypeDef *Header, const uint8_t *Data);
+
+static int8_t Sim_CAN_Filter_Match(uint8_t Bus, uint32_t StdId);
+
+/* Function prototypes -------------------------------------------------------*/
+
+/**
+ * @brief 复位全部仿真外设状态
+ *
+ */
+void Sim_HAL_Reset()
+{
+    memset(&Sim_CAN1_Instance, 0, sizeof(CAN_TypeDef));
+    memset(&Sim_CAN2_Instance, 0, sizeof(CAN_TypeDef));
+    // 过滤器主控寄存器复位值, CAN2SB = 14
+    Sim_CAN1_Instance.FMR = 0x2A1C0E01;
+    memset(Sim_CAN, 0, sizeof(Sim_CAN));
+    Sim_CAN_Update_Tx_Register(0);
+    Sim_CAN_Update_Tx_Register(1);
+    memset(Sim_GPIO_Instance, 0, sizeof(Sim_GPIO_Instance));
+    memset(Sim_TIM_Instance, 0, sizeof(Sim_TIM_Instance));
+    memset(Sim_USART_Instance, 0, sizeof(Sim_USART_Instance));
+    memset(Sim_SPI_Instance, 0, sizeof(Sim_SPI_Instance));
+    memset(Sim_UART_DMA_Stream, 0, sizeof(Sim_UART_DMA_Stream));
+    huart1.pRxBuffPtr = NULL;
+    huart3.pRxBuffPtr = NULL;
+    huart6.pRxBuffPtr = NULL;
+    huart1.RxState = HAL_UART_STATE_READY;
+    huart3.RxState = HAL_UART_STATE_READY;
+    huart6.RxState = HAL_UART_STATE_READY;
+    huart1.gState = HAL_UART_STATE_READY;
+    huart3.gState = HAL_UART_STATE_READY;
+    huart6.gState = HAL_UART_STATE_READY;
+    memset(Sim_UART_Tx_Hold, 0, sizeof(Sim_UART_Tx_Hold));
+    Sim_PRIMASK = 0;
+    // 与CubeMX中NVIC的配置一致, PendSV保持复位值0, 由固件设定
+    memset(Sim_NVIC_Priority, 0, sizeof(Sim_NVIC_Priority));
+    Sim_NVIC_Priority[TIM4_IRQn + 16] = 2;
+    Sim_NVIC_Priority[SysTick_IRQn + 16] = 14;
+    Sim_NVIC_Pending = 0;
+    Sim_NVIC_Active_Priority = SIM_NVIC_THREAD_PRIORITY;
+    Sim_SCB.ICSR.Value = 0;
+    Sim_CAN_Tx_Callback_Function = NULL;
+    Sim_UART_Tx_Callback_Function = NULL;
+    Sim_SPI_Callback_Function = NULL;
+    Sim_GPIO_Write_Callback_Function = NULL;
+    Sim_Tick = 0;
+    Sim_Time_Us = 0;
+}
+
+/**
+ * @brief 推进HAL_GetTick的毫秒计数与微秒时钟, 仿真主循环每个控制周期调用一次
+ *
+ * @param Tick 推进的毫秒数
+ */
+void Sim_HAL_Tick_Increment(uint32_t Tick)
+{
+    Sim_Tick += Tick;
+    Sim_Time_Us += Tick * 1000U;
+}
+
+/**
+ * @brief 只推进微秒时钟, 用于在一个控制周期内模拟报文晚到、节拍抖动
+ *
+ * @param Us 推进的微秒数
+ */
+void Sim_HAL_Time_Advance_Us(uint32_t Us)
+{
+    Sim_Time_Us += Us;
+}
+
+/**
+ * @brief 获取仿真时间, 主机仿真时DWT_Get_Us返回该值
+ *
+ * @return uint32_t 仿真时间, us
+ */
+uint32_t Sim_HAL_Get_Time_Us(void)
+{
+    return (Sim_Time_Us);
+}
+
+/**
+ * @brief 设置仿真CAN发送截获回调函数
+ *
+ * @param Callback_Function 回调函数, 传NULL表示丢弃所有发送的报文
+ */
+void Sim_CAN_Set_Tx_Call_Back(Sim_CAN_Tx_Call_Back Callback_Function)
+{
+    Sim_CAN_Tx_Callback_Function = Callback_Function;
+}
+
+/**
+ * @brief 向仿真总线注入一帧标准数据帧, 等效于外部节点发出该报文
+ *
+ * @param hcan CAN编号
+ * @param StdId 标准ID
+ * @param Data 数据指针
+ * @param DLC 数据长度
+ * @return true 报文进入FIFO
+ * @return false 被过滤器拒收, FIFO溢出或CAN未启动, 报文丢失
+ */
+bool Sim_CAN_Receive(CAN_HandleTypeDef *hcan, uint32_t StdId, const uint8_t *Data, uint8_t DLC)
+{
+    Struct_Sim_CAN *can = Sim_CAN_Get(hcan);
+
+    if (can == NULL || !can->Started)
+    {
+        return (false);
+    }
+
+    int8_t fifo = Sim_CAN_Filter_Match(can - Sim_CAN, StdId);
+    if (fifo < 0)
+    {
+        can->Statistic.Rx_Filtered_Num++;
+        return (false);
+    }
+    uint32_t Rx_FIFO = (uint32_t) fifo;
+
+    if (can->FIFO_Level[Rx_FIFO] >= SIM_CAN_FIFO_DEPTH)
+    {
+        // FIFO非锁定模式下新报文覆盖最后一帧, 这里直接记为溢出
+        can->Statistic.Rx_Overrun_Num++;
+        return (false);
+    }
+
+    uint8_t index = (can->FIFO_Head[Rx_FIFO] + can->FIFO_Level[Rx_FIFO]) % SIM_CAN_FIFO_DEPTH;
+    Struct_Sim_CAN_Frame *frame = &can->FIFO[Rx_FIFO][index];
+
+    frame->Header.StdId = StdId;
+    frame->Header.ExtId = 0;
+    frame->Header.IDE = CAN_ID_STD;
+    frame->Header.RTR = CAN_RTR_DATA;
+    frame->Header.DLC = DLC > 8 ? 8 : DLC;
+    frame->Header.Timestamp = 0;
+    frame->Header.FilterMatchIndex = 0;
+    memset(frame->Data, 0, 8);
+    memcpy(frame->Data, Data, frame->Header.DLC);
+
+    can->FIFO_Level[Rx_FIFO]++;
+    can->Statistic.Rx_Frame_Num++;
+    Sim_CAN_Update_Rx_Register(can - Sim_CAN, Rx_FIFO);
+
+    // 模拟进入接收中断, 当前执行优先级更高时挂起
+    if (can == &Sim_CAN[0])
+    {
+        Sim_NVIC_Request(Rx_FIFO == CAN_RX_FIFO0 ? Sim_NVIC_Line_CAN1_RX0 : Sim_NVIC_Line_CAN1_RX1);
+    }
+    else
+    {
+        Sim_NVIC_Request(Rx_FIFO == CAN_RX_FIFO0 ? Sim_NVIC_Line_CAN2_RX0 : Sim_NVIC_Line_CAN2_RX1);
+    }
+
+    return (true);
+}
+
+/**
+ * @brief 获取仿真CAN总线统计
+ *
+ * @param hcan CAN编号
+ * @return Struct_Sim_CAN_Statistic 统计数据
+ */
+Struct_Sim_CAN_Statistic Sim_CAN_Get_Statistic(CAN_HandleTypeDef *hcan)
+{
+    Struct_Sim_CAN *can = Sim_CAN_Get(hcan);
+    Struct_Sim_CAN_Statistic empty = {0};
+
+    return (can == NULL ? empty : can->Statistic);
+}
+
+/**
+ * @brief 设置仿真CAN发送邮箱的占用方式, 用于模拟总线繁忙时邮箱被占满
+ *
+ * @param hcan CAN编号
+ * @param Hold true为报文进入邮箱后保持占用直到Sim_CAN_Tx_Complete, false为立即发完(默认)
+ */
+void Sim_CAN_Set_Tx_Hold(CAN_HandleTypeDef *hcan, bool Hold)
+{
+    Struct_Sim_CAN *can = Sim_CAN_Get(hcan);
+
+    if (can != NULL)
+    {
+        can->Tx_Hold = Hold;
+    }
+}
+
+/**
+ * @brief 发完所有占用中的发送邮箱, 若使能了发送邮箱空中断, 则按邮箱编号依次进入发送完成中断
+ *
+ * @param hcan CAN编号
+ * @return uint8_t 发完的邮箱数
+ */
+uint8_t Sim_CAN_Tx_Complete(CAN_HandleTypeDef *hcan)
+{
+    Struct_Sim_CAN *can = Sim_CAN_Get(hcan);
+    uint8_t num = 0;
+
+    if (can == NULL)
+    {
+        return (0);
+    }
+
+    uint8_t busy = can->Tx_Mailbox_Busy;
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        if (!(busy & (1U << i)))
+        {
+            continue;
+        }
+        can->Tx_Mailbox_Busy &= ~(1U << i);
+        Sim_CAN_Get_Instance(can - Sim_CAN)->sTxMailBox[i].TIR.Value &= ~CAN_TI0R_TXRQ;
+        Sim_CAN_Update_Tx_Register(can - Sim_CAN);
+        num++;
+
+        // 模拟进入发送中断, 回调中放入的新报文留到下一次调用再发完
+        if (hcan->Instance->IER & CAN_IT_TX_MAILBOX_EMPTY)
+        {
+            if (i == 0) HAL_CAN_TxMailbox0CompleteCallback(hcan);
+            else if (i == 1) HAL_CAN_TxMailbox1CompleteCallback(hcan);
+            else HAL_CAN_TxMailbox2CompleteCallback(hcan);
+        }
+    }
+    return (num);
+}
+
+/**
+ * @brief 设置仿真CAN的错误状态寄存器, 错误警告/被动/离线标志新置位且使能了对应中断时进入错误中断
+ *
+ * @param hcan CAN编号
+ * @param ESR 错误状态寄存器的新值, 清除CAN_ESR_BOFF即模拟硬件自动恢复
+ */
+void Sim_CAN_Set_Error_Status(CAN_HandleTypeDef *hcan, uint32_t ESR)
+{
+    uint32_t rise = ESR & ~hcan->Instance->ESR;
+    uint32_t ier = hcan->Instance->IER;
+    uint32_t error = HAL_CAN_ERROR_NONE;
+
+    hcan->Instance->ESR = ESR;
+
+    if (!(ier & CAN_IT_ERROR))
+    {
+        return;
+    }
+    if ((ier & CAN_IT_ERROR_WARNING) && (rise & CAN_ESR_EWGF))
+    {
+        error |= HAL_CAN_ERROR_EWG;
+    }
+    if ((ier & CAN_IT_ERROR_PASSIVE) && (rise & CAN_ESR_EPVF))
+    {
+        error |= HAL_CAN_ERROR_EPV;
+    }
+    if ((ier & CAN_IT_BUSOFF) && (rise & CAN_ESR_BOFF))
+    {
+        error |= HAL_CAN_ERROR_BOF;
+    }
+    if (error != HAL_CAN_ERROR_NONE)
+    {
+        hcan->ErrorCode |= error;
+        HAL_CAN_ErrorCallback(hcan);
+    }
+}
+
+/**
+ * @brief 设置仿真UART发送截获回调函数
+ *
+ * @param Callback_Function 回调函数, 传NULL表示丢弃所有发送的数据
+ */
+void Sim_UART_Set_Tx_Call_Back(Sim_UART_Tx_Call_Back Callback_Function)
+{
+    Sim_UART_Tx_Callback_Function = Callback_Function;
+}
+
+/**
+ * @brief 设置仿真UART的DMA发送方式, 用于模拟上一帧还没发完时又要发送
+ *
+ * @param huart UART编号
+ * @param Hold true为DMA发送保持占用直到Sim_UART_Tx_Complete, false为立即发完并进入发送完成回调(默认)
+ */
+void Sim_UART_Set_Tx_Hold(UART_HandleTypeDef *huart, bool Hold)
+{
+    Sim_UART_Tx_Hold[huart->Instance - Sim_USART_Instance] = Hold;
+}
+
+/**
+ * @brief 结束占用中的DMA发送并进入发送完成回调
+ *
+ * @param huart UART编号
+ * @return true 有发送被结束
+ * @return false 没有占用中的发送
+ */
+bool Sim_UART_Tx_Complete(UART_HandleTypeDef *huart)
+{
+    if (huart->gState != HAL_UART_STATE_BUSY_TX)
+    {
+        return (false);
+    }
+    huart->gState = HAL_UART_STATE_READY;
+    HAL_UART_TxCpltCallback(huart);
+    return (true);
+}
+
+/**
+ * @brief 向仿真UART注入一段数据并产生空闲中断, 等效于外部设备发完一帧
+ *
+ * 数据由仿真DMA逐字节写入环形缓冲区, 写指针越过一半和末尾时依次产生HT和TC事件,
+ * 末尾处回绕继续写入, 最后产生空闲事件; 与HAL一致, 写指针恰好回到起始处时不产生空闲事件
+ *
+ * @param huart UART编号
+ * @param Data 数据指针
+ * @param Length 数据长度
+ * @return true 数据进入接收缓冲区并触发了回调
+ * @return false 固件尚未开启接收, 数据丢失
+ */
+bool Sim_UART_Receive(UART_HandleTypeDef *huart, const uint8_t *Data, uint16_t Length)
+{
+    if (huart->pRxBuffPtr == NULL || huart->RxState != HAL_UART_STATE_BUSY_RX)
+    {
+        return (false);
+    }
+
+    DMA_Stream_TypeDef *stream = huart->hdmarx->Instance;
+    uint8_t line = Sim_UART_Get_NVIC_Line(huart);
+    int16_t saved_priority;
+
+    // 不能抢占时DMA照常写入, 进入中断时合并为一次空闲事件
+    if (!Sim_NVIC_Enter(line, &saved_priority))
+    {
+        for (uint16_t i = 0; i < Length; i++)
+        {
+            huart->pRxBuffPtr[huart->RxXferSize - stream->NDTR] = Data[i];
+            stream->NDTR = stream->NDTR == 1 ? huart->RxXferSize : stream->NDTR - 1;
+        }
+        Sim_NVIC_Pending |= 1U << line;
+        return (true);
+    }
+
+    for (uint16_t i = 0; i < Length; i++)
+    {
+        huart->pRxBuffPtr[huart->RxXferSize - stream->NDTR] = Data[i];
+        stream->NDTR--;
+
+        if (stream->NDTR == huart->RxXferSize - huart->RxXferSize / 2U)
+        {
+            huart->RxEventType = HAL_UART_RXEVENT_HT;
+            HAL_UARTEx_RxEventCallback(huart, huart->RxXferSize / 2U);
+        }
+        else if (stream->NDTR == 0)
+        {
+            stream->NDTR = huart->RxXferSize;
+            huart->RxEventType = HAL_UART_RXEVENT_TC;
+            HAL_UARTEx_RxEventCallback(huart, huart->RxXferSize);
+        }
+
+        // 回调中接收可能被停止
+        if (huart->RxState != HAL_UART_STATE_BUSY_RX)
+        {
+            Sim_NVIC_Exit(saved_priority);
+            return (true);
+        }
+    }
+
+    if (stream->NDTR > 0 && stream->NDTR < huart->RxXferSize)
+    {
+        huart->RxEventType = HAL_UART_RXEVENT_IDLE;
+        HAL_UARTEx_RxEventCallback(huart, huart->RxXferSize - stream->NDTR);
+    }
+
+    Sim_NVIC_Exit(saved_priority);
+    return (true);
+}
+
+/**
+ * @brief 使仿真UART产生接收错误, 与HAL处理溢出错误一致, 先停止DMA接收再调用HAL_UART_ErrorCallback
+ *
+ * @param huart UART编号
+ */
+void Sim_UART_Error(UART_HandleTypeDef *huart)
+{
+    huart->pRxBuffPtr = NULL;
+    huart->RxState = HAL_UART_STATE_READY;
+    HAL_UART_ErrorCallback(huart);
+}
+
+/**
+ * @brief 设置仿真SPI从机回调函数
+ *
+ * @param Callback_Function 回调函数, 传NULL表示总线上没有从机, 读回0
+ */
+void Sim_SPI_Set_Call_Back(Sim_SPI_Call_Back Callback_Function)
+{
+    Sim_SPI_Callback_Function = Callback_Function;
+}
+
+/**
+ * @brief 设置仿真GPIO输出回调函数
+ *
+ * @param Callback_Function 回调函数
+ */
+void Sim_GPIO_Set_Write_Call_Back(Sim_GPIO_Write_Call_Back Callback_Function)
+{
+    Sim_GPIO_Write_Callback_Function = Callback_Function;
+}
+
+/**
+ * @brief 产生一次定时器更新中断, 仿真主循环每个定时周期调用一次
+ *
+ * @param htim 定时器编号
+ * @return true 定时器已启动并进入了回调
+ * @return false 定时器未启动或未使能更新中断
+ */
+bool Sim_TIM_Period_Elapsed(TIM_HandleTypeDef *htim)
+{
+    if (!(htim->Instance->CR1 & 0x01U) || !(htim->Instance->DIER & 0x01U))
+    {
+        return (false);
+    }
+    // 只有TIM4经过仿真NVIC, 当前执行优先级更高时挂起
+    if (htim->Instance == TIM4)
+    {
+        Sim_NVIC_Request(Sim_NVIC_Line_TIM4);
+    }
+    else
+    {
+        HAL_TIM_PeriodElapsedCallback(htim);
+    }
+    return (true);
+}
+
+/**
+ * @brief 获取仿真NVIC的当前执行优先级
+ *
+ * @return int16_t 正在执行的中断的抢占优先级, 线程模式为SIM_NVIC_THREAD_PRIORITY
+ */
+int16_t Sim_NVIC_Get_Active_Priority()
+{
+    return (Sim_NVIC_Active_Priority);
+}
+
+/**
+ * @brief 获取中断的抢占优先级
+ *
+ * @param IRQn 中断号
+ * @return uint8_t 抢占优先级
+ */
+uint8_t Sim_NVIC_Get_Priority(IRQn_Type IRQn)
+{
+    return (Sim_NVIC_Priority[IRQn + 16]);
+}
+
+/**
+ * @brief 判断中断是否挂起
+ *
+ * @param IRQn 中断号
+ * @return true 已挂起尚未进入
+ * @return false 未挂起或不经过仿真NVIC
+ */
+bool Sim_NVIC_Get_Pending(IRQn_Type IRQn)
+{
+    for (uint8_t i = 0; i < Sim_NVIC_Line_NUM; i++)
+    {
+        if (Sim_NVIC_Line_IRQn[i] == IRQn)
+        {
+            return ((Sim_NVIC_Pending >> i) & 1U);
+        }
+    }
+    return (false);
+}
+
+void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority)
+{
+    // NVIC_PRIORITYGROUP_4下没有子优先级
+    UNUSED(SubPriority);
+    Sim_NVIC_Priority[IRQn + 16] = PreemptPriority & 0x0FU;
+}
+
+/**
+ * @brief 写PRIMASK, 重新开中断时进入关中断期间挂起的中断
+ *
+ * @param PRIMASK 写入值
+ */
+void Sim_NVIC_Set_PRIMASK(uint32_t PRIMASK)
+{
+    Sim_PRIMASK = PRIMASK;
+    Sim_NVIC_Dispatch();
+}
+
+/**
+ * @brief 读ICSR, PENDSVSET位反映PendSV是否挂起
+ *
+ * @return uint32_t 寄存器值
+ */
+Sim_SCB_Register::operator uint32_t() const
+{
+    return ((Value & ~SCB_ICSR_PENDSVSET_Msk) | (((Sim_NVIC_Pending >> Sim_NVIC_Line_PENDSV) & 1U) << SCB_ICSR_PENDSVSET_Pos));
+}
+
+/**
+ * @brief 写ICSR, 置位PENDSVSET挂起PendSV, 置位PENDSVCLR取消挂起
+ *
+ * @param __Value 写入值
+ * @return Sim_SCB_Register& 寄存器
+ */
+Sim_SCB_Register &Sim_SCB_Register::operator=(uint32_t __Value)
+{
+    Value = __Value & ~(SCB_ICSR_PENDSVSET_Msk | SCB_ICSR_PENDSVCLR_Msk);
+    if (__Value & SCB_ICSR_PENDSVCLR_Msk)
+    {
+        Sim_NVIC_Pending &= ~(1U << Sim_NVIC_Line_PENDSV);
+    }
+    if (__Value & SCB_ICSR_PENDSVSET_Msk)
+    {
+        Sim_NVIC_Request(Sim_NVIC_Line_PENDSV);
+    }
+    return (*this);
+}
+
+uint32_t HAL_GetTick(void)
+{
+    return (Sim_Tick);
+}
+
+uint32_t HAL_RCC_GetPCLK1Freq(void)
+{
+    // 与CubeMX中APB1的配置一致
+    return (42000000U);
+}
+
+void HAL_Delay(uint32_t Delay)
+{
+    // 仿真中不真正等待, 只推进时间
+    Sim_Tick += Delay;
+    Sim_Time_Us += Delay * 1000U;
+}
+
+void HAL_NVIC_SystemReset(void)
+{
+    fprintf(stderr, "HAL_NVIC_SystemReset at tick %u\n", Sim_Tick);
+    exit(2);
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState)
+{
+    if (PinState == GPIO_PIN_SET)
+    {
+        GPIOx->ODR |= GPIO_Pin;
+    }
+    else
+    {
+        GPIOx->ODR &= ~(uint32_t) GPIO_Pin;
+    }
+    if (Sim_GPIO_Write_Callback_Function != NULL)
+    {
+        Sim_GPIO_Write_Callback_Function(GPIOx, GPIO_Pin, PinState);
+    }
+}
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
+{
+    return ((GPIOx->IDR & GPIO_Pin) ? GPIO_PIN_SET : GPIO_PIN_RESET);
+}
+
+void HAL_GPIO_TogglePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
+{
+    HAL_GPIO_WritePin(GPIOx, GPIO_Pin, (GPIOx->ODR & GPIO_Pin) ? GPIO_PIN_RESET : GPIO_PIN_SET);
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef *htim)
+{
+    htim->Instance->PSC = htim->Init.Prescaler;
+    htim->Instance->ARR = htim->Init.Period;
+    htim->Instance->DIER |= 0x01U;
+    htim->Instance->CR1 |= 0x01U;
+    return (HAL_OK);
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Stop_IT(TIM_HandleTypeDef *htim)
+{
+    htim->Instance->DIER &= ~0x01U;
+    htim->Instance->CR1 &= ~0x01U;
+    return (HAL_OK);
+}
+
+HAL_StatusTypeDef HAL_TIM_PWM_Start(TIM_HandleTypeDef *htim, uint32_t Channel)
+{
+    htim->Instance->CCER |= 0x01U << Channel;
+    htim->Instance->CR1 |= 0x01U;
+    return (HAL_OK);
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+    UNUSED(Timeout);
+    if (Sim_UART_Tx_Callback_Function != NULL)
+    {
+        Sim_UART_Tx_Callback_Function(huart, pData, Size);
+    }
+    return (HAL_OK);
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size)
+{
+    if (huart->gState != HAL_UART_STATE_READY)
+    {
+        return (HAL_BUSY);
+    }
+
+    // 数据在发起时即交给截获回调, 非保持模式下DMA发送立即完成
+    huart->gState = HAL_UART_STATE_BUSY_TX;
+    HAL_UART_Transmit(huart, pData, Size, 0);
+    if (!Sim_UART_Tx_Hold[huart->Instance - Sim_USART_Instance])
+    {
+        Sim_UART_Tx_Complete(huart);
+    }
+    return (HAL_OK);
+}
+
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size)
+{
+    if (huart->RxState != HAL_UART_STATE_READY)
+    {
+        return (HAL_BUSY);
+    }
+    if (pData == NULL || Size == 0)
+    {
+        return (HAL_ERROR);
+    }
+    huart->pRxBuffPtr = pData;
+    huart->RxXferSize = Size;
+    huart->RxXferCount = Size;
+    huart->RxState = HAL_UART_STATE_BUSY_RX;
+    huart->hdmarx->Instance->NDTR = Size;
+    return (HAL_OK);
+}
+
+HAL_UART_RxEventTypeTypeDef HAL_UARTEx_GetRxEventType(UART_HandleTypeDef *huart)
+{
+    return (huart->RxEventType);
+}
+
+HAL_StatusTypeDef HAL_SPI_Transmit(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+    UNUSED(Timeout);
+    if (Sim_SPI_Callback_Function != NULL)
+    {
+        Sim_SPI_Callback_Function(hspi, pData, NULL, Size);
+    }
+    return (HAL_OK);
+}
+
+HAL_StatusTypeDef HAL_SPI_Receive(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+    UNUSED(Timeout);
+    memset(pData, 0, Size);
+    if (Sim_SPI_Callback_Function != NULL)
+    {
+        Sim_SPI_Callback_Function(hspi, NULL, pData, Size);
+    }
+    return (HAL_OK);
+}
+
+HAL_StatusTypeDef HAL_SPI_TransmitReceive(SPI_HandleTypeDef *hspi, uint8_t *pTxData, uint8_t *pRxData, uint16_t Size, uint32_t Timeout)
+{
+    UNUSED(Timeout);
+    memset(pRxData, 0, Size);
+    if (Sim_SPI_Callback_Function != NULL)
+    {
+        Sim_SPI_Callback_Function(hspi, pTxData, pRxData, Size);
+    }
+    return (HAL_OK);
+}
+
+HAL_StatusTypeDef HAL_CAN_Start(CAN_HandleTypeDef *hcan)
+{
+    Struct_Sim_CAN *can = Sim_CAN_Get(hcan);
+
+    if (can == NULL)
+    {
+        return (HAL_ERROR);
+    }
+    can->Started = true;
+    hcan->State = HAL_CAN_STATE_LISTENING;
+    return (HAL_OK);
+}
+
+HAL_StatusTypeDef HAL_CAN_Stop(CAN_HandleTypeDef *hcan)
+{
+    Struct_Sim_CAN *can = Sim_CAN_Get(hcan);
+
+    if (can == NULL)
+    {
+        return (HAL_ERROR);
+    }
+    can->Started = false;
+    hcan->State = HAL_CAN_STATE_READY;
+    return (HAL_OK);
+}
+
+HAL_StatusTypeDef HAL_CAN_ConfigFilter(CAN_HandleTypeDef *hcan, CAN_FilterTypeDef *sFilterConfig)
+{
+    // 与HAL库一致: 过滤器组寄存器只在CAN1上, CAN2的句柄同样写CAN1
+    CAN_TypeDef *can_ip = CAN1;
+    uint32_t filter_bit = 1U << (sFilterConfig->FilterBank & 0x1FU);
+
+    if (Sim_CAN_Get(hcan) == NULL || sFilterConfig->FilterBank > 27)
+    {
+        return (HAL_ERROR);
+    }
+
+    can_ip->FMR = (can_ip->FMR & ~0x3F00U) | (sFilterConfig->SlaveStartFilterBank << 8);
+    can_ip->FA1R &= ~filter_bit;
+
+    if (sFilterConfig->FilterScale == CAN_FILTERSCALE_16BIT)
+    {
+        can_ip->FS1R &= ~filter_bit;
+        can_ip->sFilterRegister[sFilterConfig->FilterBank].FR1 = ((0xFFFFU & sFilterConfig->FilterMaskIdLow) << 16) | (0xFFFFU & sFilterConfig->FilterIdLow);
+        can_ip->sFilterRegister[sFilterConfig->FilterBank].FR2 = ((0xFFFFU & sFilterConfig->FilterMaskIdHigh) << 16) | (0xFFFFU & sFilterConfig->FilterIdHigh);
+    }
+    else
+    {
+        can_ip->FS1R |= filter_bit;
+        can_ip->sFilterRegister[sFilterConfig->FilterBank].FR1 = ((0xFFFFU & sFilterConfig->FilterIdHigh) << 16) | (0xFFFFU & sFilterConfig->FilterIdLow);
+        can_ip->sFilterRegister[sFilterConfig->FilterBank].FR2 = ((0xFFFFU & sFilterConfig->FilterMaskIdHigh) << 16) | (0xFFFFU & sFilterConfig->FilterMaskIdLow);
+    }
+
+    if (sFilterConfig->FilterMode == CAN_FILTERMODE_IDMASK)
+    {
+        can_ip->FM1R &= ~filter_bit;
+    }
+    else
+    {
+        can_ip->FM1R |= filter_bit;
+    }
+
+    if (sFilterConfig->FilterFIFOAssignment == CAN_RX_FIFO0)
+    {
+        can_ip->FFA1R &= ~filter_bit;
+    }
+    else
+    {
+        can_ip->FFA1R |= filter_bit;
+    }
+
+    if (sFilterConfig->FilterActivation == ENABLE)
+    {
+        can_ip->FA1R |= filter_bit;
+    }
+
+    return (HAL_OK);
+}
+
+HAL_StatusTypeDef HAL_CAN_AddTxMessage(CAN_HandleTypeDef *hcan, CAN_TxHeaderTypeDef *pHeader, uint8_t aData[], uint32_t *pTxMailbox)
+{
+    Struct_Sim_CAN *can = Sim_CAN_Get(hcan);
+
+    if (can == NULL || !can->Started)
+    {
+        hcan->ErrorCode |= HAL_CAN_ERROR_PARAM;
+        return (HAL_ERROR);
+    }
+
+    if (can->Tx_Mailbox_Busy == 0x07)
+    {
+        hcan->ErrorCode |= HAL_CAN_ERROR_PARAM;
+        return (HAL_ERROR);
+    }
+
+    uint8_t mailbox = 0;
+    while (can->Tx_Mailbox_Busy & (1U << mailbox))
+    {
+        mailbox++;
+    }
+    if (pTxMailbox != NULL)
+    {
+        *pTxMailbox = CAN_TX_MAILBOX0 << mailbox;
+    }
+    Sim_CAN_Transmit(can - Sim_CAN, mailbox, pHeader, aData);
+    return (HAL_OK);
+}
+
+uint32_t HAL_CAN_GetTxMailboxesFreeLevel(CAN_HandleTypeDef *hcan)
+{
+    Struct_Sim_CAN *can = Sim_CAN_Get(hcan);
+
+    if (can == NULL)
+    {
+        return (0);
+    }
+    return (3 - ((can->Tx_Mailbox_Busy & 1U) + ((can->Tx_Mailbox_Busy >> 1) & 1U) + ((can->Tx_Mailbox_Busy >> 2) & 1U)));
+}
+
+HAL_StatusTypeDef HAL_CAN_GetRxMessage(CAN_HandleTypeDef *hcan, uint32_t RxFifo, CAN_RxHeaderTypeDef *pHeader, uint8_t aData[])
+{
+    Struct_Sim_CAN *can = Sim_CAN_Get(hcan);
+
+    if (can == NULL || RxFifo > CAN_RX_FIFO1 || can->FIFO_Level[RxFifo] == 0)
+    {
+        return (HAL_ERROR);
+    }
+
+    Struct_Sim_CAN_Frame *frame = &can->FIFO[RxFifo][can->FIFO_Head[RxFifo]];
+    *pHeader = frame->Header;
+    memcpy(aData, frame->Data, 8);
+
+    Sim_CAN_Release_Rx_FIFO(can - Sim_CAN, RxFifo);
+    return (HAL_OK);
+}
+
+uint32_t HAL_CAN_GetRxFifoFillLevel(CAN_HandleTypeDef *hcan, uint32_t RxFifo)
+{
+    Struct_Sim_CAN *can = Sim_CAN_Get(hcan);
+
+    if (can == NULL || RxFifo > CAN_RX_FIFO1)
+    {
+        return (0);
+    }
+    return (can->FIFO_Level[RxFifo]);
+}
+
+HAL_StatusTypeDef HAL_CAN_ActivateNotification(CAN_HandleTypeDef *hcan, uint32_t ActiveITs)
+{
+    __HAL_CAN_ENABLE_IT(hcan, ActiveITs);
+    return (HAL_OK);
+}
+
+uint32_t HAL_CAN_GetError(CAN_HandleTypeDef *hcan)
+{
+    return (hcan->ErrorCode);
+}
+
+HAL_StatusTypeDef HAL_CAN_ResetError(CAN_HandleTypeDef *hcan)
+{
+    hcan->ErrorCode = HAL_CAN_ERROR_NONE;
+    return (HAL_OK);
+}
+
+__attribute__((weak)) void HAL_CAN_TxMailbox0CompleteCallback(CAN_HandleTypeDef *hcan)
+{
+    UNUSED(hcan);
+}
+
+__attribute__((weak)) void HAL_CAN_TxMailbox1CompleteCallback(CAN_HandleTypeDef *hcan)
+{
+    UNUSED(hcan);
+}
+
+__attribute__((weak)) void HAL_CAN_TxMailbox2CompleteCallback(CAN_HandleTypeDef *hcan)
+{
+    UNUSED(hcan);
+}
+
+__attribute__((weak)) void HAL_CAN_ErrorCallback(CAN_HandleTypeDef *hcan)
+{
+    UNUSED(hcan);
+}
+
+__attribute__((weak)) void HAL_CAN_RxFifo0MsgPendingCallback(CAN_HandleTypeDef *hcan)
+{
+    UNUSED(hcan);
+}
+
+__attribute__((weak)) void HAL_CAN_RxFifo1MsgPendingCallback(CAN_HandleTypeDef *hcan)
+{
+    UNUSED(hcan);
+}
+
+__attribute__((weak)) void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
+{
+    UNUSED(htim);
+}
+
+__attribute__((weak)) void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size)
+{
+    UNUSED(huart);
+    UNUSED(Size);
+}
+
+__attribute__((weak)) void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
+{
+    UNUSED(huart);
+}
+
+__attribute__((weak)) void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
+{
+    UNUSED(huart);
+}
+
+__attribute__((weak)) void PendSV_Handler(void)
+{
+}
+
+/**
+ * @brief 中断能抢占当前执行优先级时进入, 提升执行优先级
+ *
+ * @param Line 中断
+ * @param Saved_Priority 进入前的执行优先级, 退出时恢复
+ * @return true 已进入
+ * @return false 关中断或优先级不够高, 未进入
+ */
+static bool Sim_NVIC_Enter(uint8_t Line, int16_t *Saved_Priority)
+{
+    int16_t priority = Sim_NVIC_Priority[Sim_NVIC_Line_IRQn[Line] + 16];
+
+    if (Sim_PRIMASK != 0 || priority >= Sim_NVIC_Active_Priority)
+    {
+        return (false);
+    }
+    *Saved_Priority = Sim_NVIC_Active_Priority;
+    Sim_NVIC_Active_Priority = priority;
+    return (true);
+}
+
+/**
+ * @brief 中断返回, 恢复执行优先级后进入能抢占的挂起中断(咬尾)
+ *
+ * @param Saved_Priority 进入前的执行优先级
+ */
+static void Sim_NVIC_Exit(int16_t Saved_Priority)
+{
+    Sim_NVIC_Active_Priority = Saved_Priority;
+    Sim_NVIC_Dispatch();
+}
+
+/**
+ * @brief 挂起中断, 能抢占时立即进入
+ *
+ * @param Line 中断
+ */
+static void Sim_NVIC_Request(uint8_t Line)
+{
+    Sim_NVIC_Pending |= 1U << Line;
+    Sim_NVIC_Dispatch();
+}
+
+/**
+ * @brief 依次进入能抢占当前执行优先级的挂起中断, 优先级最高的先进入, 同优先级取中断号小的
+ *
+ */
+static void Sim_NVIC_Dispatch()
+{
+    while (Sim_PRIMASK == 0 && Sim_NVIC_Pending != 0)
+    {
+        int8_t line = -1;
+        int16_t priority = Sim_NVIC_Active_Priority;
+
+        for (uint8_t i = 0; i < Sim_NVIC_Line_NUM; i++)
+        {
+            if (((Sim_NVIC_Pending >> i) & 1U) && Sim_NVIC_Priority[Sim_NVIC_Line_IRQn[i] + 16] < priority)
+            {
+                line = i;
+                priority = Sim_NVIC_Priority[Sim_NVIC_Line_IRQn[i] + 16];
+            }
+        }
+        if (line < 0)
+        {
+            return;
+        }
+
+        int16_t saved_priority = Sim_NVIC_Active_Priority;
+        Sim_NVIC_Pending &= ~(1U << line);
+        Sim_NVIC_Active_Priority = priority;
+        Sim_NVIC_Line_Handler(line);
+        Sim_NVIC_Active_Priority = saved_priority;
+    }
+}
+
+/**
+ * @brief 中断服务函数, 与stm32f4xx_it.c中经HAL进入回调的过程一致
+ *
+ * @param Line 中断
+ */
+static void Sim_NVIC_Line_Handler(uint8_t Line)
+{
+    switch (Line)
+    {
+    case (Sim_NVIC_Line_PENDSV):
+    {
+        PendSV_Handler();
+    }
+    break;
+    case (Sim_NVIC_Line_TIM4):
+    {
+        if ((htim4.Instance->CR1 & 0x01U) && (htim4.Instance->DIER & 0x01U))
+        {
+            HAL_TIM_PeriodElapsedCallback(&htim4);
+        }
+    }
+    break;
+    case (Sim_NVIC_Line_CAN1_RX0):
+    case (Sim_NVIC_Line_CAN2_RX0):
+    {
+        CAN_HandleTypeDef *hcan = Line == Sim_NVIC_Line_CAN1_RX0 ? &hcan1 : &hcan2;
+        if ((hcan->Instance->IER & CAN_IT_RX_FIFO0_MSG_PENDING) && Sim_CAN_Get(hcan)->FIFO_Level[CAN_RX_FIFO0] > 0)
+        {
+            HAL_CAN_RxFifo0MsgPendingCallback(hcan);
+        }
+    }
+    break;
+    case (Sim_NVIC_Line_CAN1_RX1):
+    case (Sim_NVIC_Line_CAN2_RX1):
+    {
+        CAN_HandleTypeDef *hcan = Line == Sim_NVIC_Line_CAN1_RX1 ? &hcan1 : &hcan2;
+        if ((hcan->Instance->IER & CAN_IT_RX_FIFO1_MSG_PENDING) && Sim_CAN_Get(hcan)->FIFO_Level[CAN_RX_FIFO1] > 0)
+        {
+            HAL_CAN_RxFifo1MsgPendingCallback(hcan);
+        }
+    }
+    break;
+    default:
+    {
+        // UART挂起期间收到的数据合并为一次空闲事件
+        UART_HandleTypeDef *huart = Line == Sim_NVIC_Line_USART1 ? &huart1 : (Line == Sim_NVIC_Line_USART3 ? &huart3 : &huart6);
+        if (huart->pRxBuffPtr != NULL && huart->RxState == HAL_UART_STATE_BUSY_RX)
+        {
+            huart->RxEventType = HAL_UART_RXEVENT_IDLE;
+            HAL_UARTEx_RxEventCallback(huart, huart->RxXferSize - huart->hdmarx->Instance->NDTR);
+        }
+    }
+    break;
+    }
+}
+
+/**
+ * @brief 由UART编号找到仿真NVIC中的中断
+ *
+ * @param huart UART编号
+ * @return uint8_t 中断
+ */
+static uint8_t Sim_UART_Get_NVIC_Line(UART_HandleTypeDef *huart)
+{
+    if (huart->Instance == USART1) return (Sim_NVIC_Line_USART1);
+    else if (huart->Instance == USART3) return (Sim_NVIC_Line_USART3);
+    else return (Sim_NVIC_Line_USART6);
+}
+
+/**
+ * @brief 由句柄找到仿真CAN外设状态
+ *
+ * @param hcan CAN编号
+ * @return Struct_Sim_CAN* 仿真外设状态, 未知实例返回NULL
+ */
+static Struct_Sim_CAN *Sim_CAN_Get(CAN_HandleTypeDef *hcan)
+{
+    if (hcan == NULL)
+    {
+        return (NULL);
+    }
+    if (hcan->Instance == CAN1)
+    {
+        return (&Sim_CAN[0]);
+    }
+    else if (hcan->Instance == CAN2)
+    {
+        return (&Sim_CAN[1]);
+    }
+    return (NULL);
+}
+
+/**
+ * @brief 由总线编号找到仿真CAN寄存器组
+ *
+ * @param Bus 0为CAN1, 1为CAN2
+ * @return CAN_TypeDef* 寄存器组
+ */
+static CAN_TypeDef *Sim_CAN_Get_Instance(uint8_t Bus)
+{
+    return (Bus == 0 ? CAN1 : CAN2);
+}
+
+/**
+ * @brief 按FIFO状态更新RFxR中的报文数和输出邮箱寄存器, 与硬件一致, 输出邮箱中是最早的一帧
+ *
+ * @param Bus 0为CAN1, 1为CAN2
+ * @param Rx_FIFO FIFO编号
+ */
+static void Sim_CAN_Update_Rx_Register(uint8_t Bus, uint32_t Rx_FIFO)
+{
+    Struct_Sim_CAN *can = &Sim_CAN[Bus];
+    CAN_TypeDef *can_ip = Sim_CAN_Get_Instance(Bus);
+    Sim_CAN_Register *rfr = Rx_FIFO == CAN_RX_FIFO0 ? &can_ip->RF0R : &can_ip->RF1R;
+
+    rfr->Value = (rfr->Value & ~(CAN_RF0R_FMP0 | CAN_RF0R_RFOM0)) | can->FIFO_Level[Rx_FIFO];
+
+    if (can->FIFO_Level[Rx_FIFO] == 0)
+    {
+        return;
+    }
+
+    const Struct_Sim_CAN_Frame *frame = &can->FIFO[Rx_FIFO][can->FIFO_Head[Rx_FIFO]];
+    CAN_FIFOMailBox_TypeDef *mailbox = &can_ip->sFIFOMailBox[Rx_FIFO];
+    uint32_t rdlr, rdhr;
+
+    memcpy(&rdlr, &frame->Data[0], 4);
+    memcpy(&rdhr, &frame->Data[4], 4);
+    mailbox->RIR = (frame->Header.StdId << CAN_RI0R_STID_Pos) | frame->Header.IDE | frame->Header.RTR;
+    mailbox->RDTR = frame->Header.DLC | (frame->Header.FilterMatchIndex << CAN_RDT0R_FMI_Pos) | (frame->Header.Timestamp << CAN_RDT0R_TIME_Pos);
+    mailbox->RDLR = rdlr;
+    mailbox->RDHR = rdhr;
+}
+
+/**
+ * @brief 按邮箱占用情况更新TSR中的邮箱空标志和下一个空邮箱编号
+ *
+ * @param Bus 0为CAN1, 1为CAN2
+ */
+static void Sim_CAN_Update_Tx_Register(uint8_t Bus)
+{
+    uint8_t busy = Sim_CAN[Bus].Tx_Mailbox_Busy;
+    uint32_t tsr = 0;
+
+    for (uint8_t i = 3; i > 0; i--)
+    {
+        if (!(busy & (1U << (i - 1))))
+        {
+            tsr |= CAN_TSR_TME0 << (i - 1);
+            tsr = (tsr & ~CAN_TSR_CODE) | ((uint32_t) (i - 1) << CAN_TSR_CODE_Pos);
+        }
+    }
+    Sim_CAN_Get_Instance(Bus)->TSR = tsr;
+}
+
+/**
+ * @brief 释放FIFO输出邮箱, 下一帧进入输出邮箱
+ *
+ * @param Bus 0为CAN1, 1为CAN2
+ * @param Rx_FIFO FIFO编号
+ */
+static void Sim_CAN_Release_Rx_FIFO(uint8_t Bus, uint32_t Rx_FIFO)
+{
+    Struct_Sim_CAN *can = &Sim_CAN[Bus];
+
+    if (can->FIFO_Level[Rx_FIFO] > 0)
+    {
+        can->FIFO_Head[Rx_FIFO] = (can->FIFO_Head[Rx_FIFO] + 1) % SIM_CAN_FIFO_DEPTH;
+        can->FIFO_Level[Rx_FIFO]--;
+    }
+    Sim_CAN_Update_Rx_Register(Bus, Rx_FIFO);
+}
+
+/**
+ * @brief 从邮箱发出一帧, 仿真总线没有仲裁延迟, 报文立即送达; 非保持模式下邮箱随即空闲
+ *
+ * @param Bus 0为CAN1, 1为CAN2
+ * @param Mailbox 邮箱编号
+ * @param Header 报文头
+ * @param Data 数据
+ */
+static void Sim_CAN_Transmit(uint8_t Bus, uint8_t Mailbox, const CAN_TxHeaderTypeDef *Header, const uint8_t *Data)
+{
+    Struct_Sim_CAN *can = &Sim_CAN[Bus];
+
+    if (can->Tx_Hold)
+    {
+        can->Tx_Mailbox_Busy |= 1U << Mailbox;
+        Sim_CAN_Update_Tx_Register(Bus);
+    }
+    can->Statistic.Tx_Frame_Num++;
+    if (Sim_CAN_Tx_Callback_Function != NULL)
+    {
+        Sim_CAN_Tx_Callback_Function(Bus == 0 ? &hcan1 : &hcan2, Header, Data);
+    }
+}
+
+/**
+ * @brief 寄存器写入, 置位RFOM时释放FIFO输出邮箱, 置位TXRQ时发出邮箱中的报文
+ *
+ * @param __Value 写入值
+ * @return Sim_CAN_Register& 寄存器
+ */
+Sim_CAN_Register &Sim_CAN_Register::operator=(uint32_t __Value)
+{
+    Value = __Value;
+
+    for (uint8_t bus = 0; bus < 2; bus++)
+    {
+        CAN_TypeDef *can_ip = Sim_CAN_Get_Instance(bus);
+        Struct_Sim_CAN *can = &Sim_CAN[bus];
+
+        if ((this == &can_ip->RF0R || this == &can_ip->RF1R) && (Value & CAN_RF0R_RFOM0))
+        {
+            Sim_CAN_Release_Rx_FIFO(bus, this == &can_ip->RF0R ? CAN_RX_FIFO0 : CAN_RX_FIFO1);
+            return (*this);
+        }
+
+        for (uint8_t i = 0; i < 3; i++)
+        {
+            CAN_TxMailBox_TypeDef *mailbox = &can_ip->sTxMailBox[i];
+
+            if (this != &mailbox->TIR || !(Value & CAN_TI0R_TXRQ) || !can->Started || (can->Tx_Mailbox_Busy & (1U << i)))
+            {
+                continue;
+            }
+
+            CAN_TxHeaderTypeDef header;
+            uint8_t data[8];
+            uint32_t tdlr = mailbox->TDLR;
+            uint32_t tdhr = mailbox->TDHR;
+
+            header.IDE = Value & CAN_TI0R_IDE;
+            header.StdId = Value >> CAN_TI0R_STID_Pos;
+            header.ExtId = Value >> CAN_TI0R_EXID_Pos;
+            header.RTR = Value & CAN_TI0R_RTR;
+            header.DLC = mailbox->TDTR & 0x0FU;
+            header.TransmitGlobalTime = DISABLE;
+            memcpy(&data[0], &tdlr, 4);
+            memcpy(&data[4], &tdhr, 4);
+
+            Sim_CAN_Transmit(bus, i, &header, data);
+            if (!can->Tx_Hold)
+            {
+                Value &= ~CAN_TI0R_TXRQ;
+            }
+            return (*this);
+        }
+    }
+
+    return (*this);
+}
+
+/**
+ * @brief 按过滤器组配置判断一帧标准数据帧是否被接收
+ *
+ * @param Bus 0为CAN1, 1为CAN2
+ * @param StdId 标准ID
+ * @return int8_t 进入的FIFO, -1表示被拒收
+ */
+static int8_t Sim_CAN_Filter_Match(uint8_t Bus, uint32_t StdId)
+{
+    CAN_TypeDef *can_ip = CAN1;
+    uint8_t slave_start = (can_ip->FMR >> 8) & 0x3FU;
+    uint8_t first = Bus == 0 ? 0 : slave_start;
+    uint8_t last = Bus == 0 ? slave_start : 28;
+    // 32位格式: STID在31~21位, IDE与RTR为0
+    uint32_t frame_32 = (StdId & 0x7FFU) << 21;
+    // 16位格式: STID在15~5位, IDE与RTR为0
+    uint32_t frame_16 = (StdId & 0x7FFU) << 5;
+
+    for (uint8_t bank = first; bank < last && bank < 28; bank++)
+    {
+        uint32_t filter_bit = 1U << bank;
+        if (!(can_ip->FA1R & filter_bit))
+        {
+            continue;
+        }
+
+        uint32_t fr1 = can_ip->sFilterRegister[bank].FR1;
+        uint32_t fr2 = can_ip->sFilterRegister[bank].FR2;
+        bool list_mode = (can_ip->FM1R & filter_bit) != 0;
+        bool match;
+
+        if (can_ip->FS1R & filter_bit)
+        {
+            match = list_mode ? (frame_32 == fr1 || frame_32 == fr2) : ((frame_32 ^ fr1) & fr2) == 0;
+        }
+        else if (list_mode)
+        {
+            match = frame_16 == (fr1 & 0xFFFFU) || frame_16 == (fr1 >> 16) || frame_16 == (fr2 & 0xFFFFU) || frame_16 == (fr2 >> 16);
+        }
+        else
+        {
+            match = ((frame_16 ^ fr1) & (fr1 >> 16) & 0xFFFFU) == 0 || ((frame_16 ^ fr2) & (fr2 >> 16) & 0xFFFFU) == 0;
+        }
+
+        if (match)
+        {
+            return ((can_ip->FFA1R & filter_bit) ? CAN_RX_FIFO1 : CAN_RX_FIFO0);
+        }
+    }
+
+    return (-1);
+}
+
+/*****************************************************************************/
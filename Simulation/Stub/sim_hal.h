@@ -0,0 +1,124 @@
+/**
+ * @file sim_hal.h
+ * @author WFZ
+ * @brief 主机仿真HAL替身的仿真侧接口, 用于向"总线"注入报文和截获发送的报文
+ * @version 0.0
+ * @date 2026-1-20
+ *
+ *
+ */
+
+#ifndef SIM_HAL_H
+#define SIM_HAL_H
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "stm32f4xx_hal.h"
+
+/* Exported macros -----------------------------------------------------------*/
+
+// bxCAN每个接收FIFO的深度
+#define SIM_CAN_FIFO_DEPTH 3
+
+// 仿真NVIC中线程模式的执行优先级, 低于任何中断
+#define SIM_NVIC_THREAD_PRIORITY 256
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+ * @brief 仿真CAN发送截获回调函数数据类型, 固件调用HAL_CAN_AddTxMessage时触发
+ *
+ */
+typedef void (*Sim_CAN_Tx_Call_Back)(CAN_HandleTypeDef *hcan, const CAN_TxHeaderTypeDef *Header, const uint8_t *Data);
+
+/**
+ * @brief 仿真UART发送截获回调函数数据类型, 固件调用HAL_UART_Transmit/HAL_UART_Transmit_DMA时触发
+ *
+ */
+typedef void (*Sim_UART_Tx_Call_Back)(UART_HandleTypeDef *huart, const uint8_t *Data, uint16_t Length);
+
+/**
+ * @brief 仿真SPI从机回调函数数据类型, 每次SPI收发触发一次
+ *
+ * Tx_Data为NULL表示HAL_SPI_Receive(主机发送0xff), Rx_Data为NULL表示HAL_SPI_Transmit(丢弃接收)
+ *
+ */
+typedef void (*Sim_SPI_Call_Back)(SPI_HandleTypeDef *hspi, const uint8_t *Tx_Data, uint8_t *Rx_Data, uint16_t Length);
+
+/**
+ * @brief 仿真GPIO输出回调函数数据类型, 固件写引脚时触发, 用于模拟片选等
+ *
+ */
+typedef void (*Sim_GPIO_Write_Call_Back)(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState);
+
+/**
+ * @brief 仿真CAN总线统计
+ *
+ */
+typedef struct
+{
+    uint32_t Tx_Frame_Num;
+    uint32_t Rx_Frame_Num;
+    uint32_t Rx_Overrun_Num;
+    // 被硬件过滤器拒收的报文数
+    uint32_t Rx_Filtered_Num;
+} Struct_Sim_CAN_Statistic;
+
+/* Exported variables --------------------------------------------------------*/
+
+extern CAN_HandleTypeDef hcan1;
+extern CAN_HandleTypeDef hcan2;
+
+extern UART_HandleTypeDef huart1;
+extern UART_HandleTypeDef huart3;
+extern UART_HandleTypeDef huart6;
+
+extern TIM_HandleTypeDef htim4;
+
+extern SPI_HandleTypeDef hspi1;
+
+/* Exported function declarations --------------------------------------------*/
+
+void Sim_HAL_Reset();
+
+void Sim_HAL_Tick_Increment(uint32_t Tick);
+
+void Sim_HAL_Time_Advance_Us(uint32_t Us);
+
+void Sim_CAN_Set_Tx_Call_Back(Sim_CAN_Tx_Call_Back Callback_Function);
+
+bool Sim_CAN_Receive(CAN_HandleTypeDef *hcan, uint32_t StdId, const uint8_t *Data, uint8_t DLC);
+
+Struct_Sim_CAN_Statistic Sim_CAN_Get_Statistic(CAN_HandleTypeDef *hcan);
+
+void Sim_CAN_Set_Tx_Hold(CAN_HandleTypeDef *hcan, bool Hold);
+
+uint8_t Sim_CAN_Tx_Complete(CAN_HandleTypeDef *hcan);
+
+void Sim_CAN_Set_Error_Status(CAN_HandleTypeDef *hcan, uint32_t ESR);
+
+void Sim_UART_Set_Tx_Call_Back(Sim_UART_Tx_Call_Back Callback_Function);
+
+void Sim_UART_Set_Tx_Hold(UART_HandleTypeDef *huart, bool Hold);
+
+bool Sim_UART_Tx_Complete(UART_HandleTypeDef *huart);
+
+bool Sim_UART_Receive(UART_HandleTypeDef *huart, const uint8_t *Data, uint16_t Length);
+
+void Sim_UART_Error(UART_HandleTypeDef *huart);
+
+void Sim_SPI_Set_Call_Back(Sim_SPI_Call_Back Callback_Function);
+
+void Sim_GPIO_Set_Write_Call_Back(Sim_GPIO_Write_Call_Back Callback_Function);
+
+bool Sim_TIM_Period_Elapsed(TIM_HandleTypeDef *htim);
+
+int16_t Sim_NVIC_Get_Active_Priority();
+
+uint8_t Sim_NVIC_Get_Priority(IRQn_Type IRQn);
+
+bool Sim_NVIC_Get_Pending(IRQn_Type IRQn);
+
+#endif
+
+/*****************************************************************************/
@@ -0,0 +1,658 @@
+/**
+ * @file stm32f4xx_hal.h
+ * @author WFZ
+ * @brief 主机仿真用的HAL库替身, 只保留User层用到的类型与接口
+ * @version 0.0
+ * @date 2026-1-20
+ *
+ * @note 仅用于Simulation目录下的主机程序, Keil工程中不包含本目录,
+ *       固件编译时使用的仍然是Drivers下真正的HAL库
+ *
+ */
+
+#ifndef STM32F4XX_HAL_H
+#define STM32F4XX_HAL_H
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+/* Exported macros -----------------------------------------------------------*/
+
+// 主机仿真编译标志, 固件中可用于区分目标板与主机
+#ifndef HOST_SIMULATION
+#define HOST_SIMULATION
+#endif
+
+#define __IO volatile
+
+#define UNUSED(X) (void)(X)
+
+#define assert_param(expr) ((void)0U)
+
+#define SET_BIT(REG, BIT) ((REG) |= (BIT))
+#define CLEAR_BIT(REG, BIT) ((REG) &= ~(BIT))
+
+// 主机仿真为单线程, 内存屏障只需阻止编译器重排
+#define __DMB() __asm__ volatile("" ::: "memory")
+
+// 主机仿真中断不会真正抢占, 关中断只需保存/恢复标志; 重新开中断时进入关中断期间挂起的中断
+#define __get_PRIMASK() (Sim_PRIMASK)
+#define __set_PRIMASK(PRIMASK) Sim_NVIC_Set_PRIMASK(PRIMASK)
+#define __disable_irq() (Sim_PRIMASK = 1U)
+#define __enable_irq() Sim_NVIC_Set_PRIMASK(0U)
+
+// 中断优先级分组, 与CubeMX的配置一致, 4位全部为抢占优先级
+#define NVIC_PRIORITYGROUP_4 (0x00000003U)
+
+// SCB中断控制与状态寄存器中的PendSV挂起位, 与core_cm4.h一致
+#define SCB_ICSR_PENDSVSET_Pos (28U)
+#define SCB_ICSR_PENDSVSET_Msk (1UL << SCB_ICSR_PENDSVSET_Pos)
+#define SCB_ICSR_PENDSVCLR_Pos (27U)
+#define SCB_ICSR_PENDSVCLR_Msk (1UL << SCB_ICSR_PENDSVCLR_Pos)
+
+// CAN中断使能位, 与stm32f407xx.h中CAN_IER的定义一致
+#define CAN_IT_TX_MAILBOX_EMPTY (0x00000001U)
+#define CAN_IT_RX_FIFO0_MSG_PENDING (0x00000002U)
+#define CAN_IT_RX_FIFO0_FULL (0x00000004U)
+#define CAN_IT_RX_FIFO0_OVERRUN (0x00000008U)
+#define CAN_IT_RX_FIFO1_MSG_PENDING (0x00000010U)
+#define CAN_IT_RX_FIFO1_FULL (0x00000020U)
+#define CAN_IT_RX_FIFO1_OVERRUN (0x00000040U)
+#define CAN_IT_ERROR_WARNING (0x00000100U)
+#define CAN_IT_ERROR_PASSIVE (0x00000200U)
+#define CAN_IT_BUSOFF (0x00000400U)
+#define CAN_IT_LAST_ERROR_CODE (0x00000800U)
+#define CAN_IT_ERROR (0x00008000U)
+
+#define CAN_FILTERMODE_IDMASK (0x00000000U)
+#define CAN_FILTERMODE_IDLIST (0x00000001U)
+
+#define CAN_FILTERSCALE_16BIT (0x00000000U)
+#define CAN_FILTERSCALE_32BIT (0x00000001U)
+
+#define CAN_ID_STD (0x00000000U)
+#define CAN_ID_EXT (0x00000004U)
+
+#define CAN_RTR_DATA (0x00000000U)
+#define CAN_RTR_REMOTE (0x00000002U)
+
+#define CAN_RX_FIFO0 (0x00000000U)
+#define CAN_RX_FIFO1 (0x00000001U)
+
+#define CAN_TX_MAILBOX0 (0x00000001U)
+#define CAN_TX_MAILBOX1 (0x00000002U)
+#define CAN_TX_MAILBOX2 (0x00000004U)
+
+#define HAL_CAN_ERROR_NONE (0x00000000U)
+#define HAL_CAN_ERROR_EWG (0x00000001U)
+#define HAL_CAN_ERROR_EPV (0x00000002U)
+#define HAL_CAN_ERROR_BOF (0x00000004U)
+#define HAL_CAN_ERROR_TX_ALST0 (0x00000800U)
+#define HAL_CAN_ERROR_TX_TERR0 (0x00001000U)
+#define HAL_CAN_ERROR_TX_ALST1 (0x00002000U)
+#define HAL_CAN_ERROR_TX_TERR1 (0x00004000U)
+#define HAL_CAN_ERROR_TX_ALST2 (0x00008000U)
+#define HAL_CAN_ERROR_TX_TERR2 (0x00010000U)
+#define HAL_CAN_ERROR_PARAM (0x00200000U)
+
+// CAN寄存器位, 与stm32f407xx.h一致
+#define CAN_MCR_INRQ (0x00000001U)
+#define CAN_MSR_INAK (0x00000001U)
+#define CAN_TSR_CODE_Pos (24U)
+#define CAN_TSR_CODE (0x03000000U)
+#define CAN_TSR_TME (0x1C000000U)
+#define CAN_TSR_TME0 (0x04000000U)
+#define CAN_TSR_TME1 (0x08000000U)
+#define CAN_TSR_TME2 (0x10000000U)
+#define CAN_RF0R_FMP0 (0x00000003U)
+#define CAN_RF0R_RFOM0 (0x00000020U)
+#define CAN_RF1R_FMP1 (0x00000003U)
+#define CAN_RF1R_RFOM1 (0x00000020U)
+#define CAN_TI0R_TXRQ (0x00000001U)
+#define CAN_TI0R_RTR (0x00000002U)
+#define CAN_TI0R_IDE (0x00000004U)
+#define CAN_TI0R_EXID_Pos (3U)
+#define CAN_TI0R_STID_Pos (21U)
+#define CAN_RI0R_RTR (0x00000002U)
+#define CAN_RI0R_IDE (0x00000004U)
+#define CAN_RI0R_EXID_Pos (3U)
+#define CAN_RI0R_EXID (0x1FFFFFF8U)
+#define CAN_RI0R_STID_Pos (21U)
+#define CAN_RI0R_STID (0xFFE00000U)
+#define CAN_RDT0R_DLC_Pos (0U)
+#define CAN_RDT0R_DLC (0x0000000FU)
+#define CAN_RDT0R_FMI_Pos (8U)
+#define CAN_RDT0R_FMI (0x0000FF00U)
+#define CAN_RDT0R_TIME_Pos (16U)
+#define CAN_RDT0R_TIME (0xFFFF0000U)
+#define CAN_ESR_EWGF (0x00000001U)
+#define CAN_ESR_EPVF (0x00000002U)
+#define CAN_ESR_BOFF (0x00000004U)
+#define CAN_ESR_LEC_Pos (4U)
+#define CAN_ESR_LEC (0x00000070U)
+#define CAN_ESR_TEC_Pos (16U)
+#define CAN_ESR_TEC (0x00FF0000U)
+#define CAN_ESR_REC_Pos (24U)
+#define CAN_ESR_REC (0xFF000000U)
+#define CAN_BTR_TS1_Pos (16U)
+#define CAN_BTR_TS2_Pos (20U)
+
+#define CAN_MODE_NORMAL (0x00000000U)
+#define CAN_SJW_1TQ (0x00000000U)
+#define CAN_BS1_10TQ (0x00090000U)
+#define CAN_BS2_3TQ (0x00200000U)
+
+#define __HAL_CAN_ENABLE_IT(__HANDLE__, __INTERRUPT__) (((__HANDLE__)->Instance->IER) |= (__INTERRUPT__))
+#define __HAL_CAN_DISABLE_IT(__HANDLE__, __INTERRUPT__) (((__HANDLE__)->Instance->IER) &= ~(__INTERRUPT__))
+
+#define HAL_MAX_DELAY 0xFFFFFFFFU
+
+#define GPIO_PIN_0 ((uint16_t) 0x0001)
+#define GPIO_PIN_1 ((uint16_t) 0x0002)
+#define GPIO_PIN_2 ((uint16_t) 0x0004)
+#define GPIO_PIN_3 ((uint16_t) 0x0008)
+#define GPIO_PIN_4 ((uint16_t) 0x0010)
+#define GPIO_PIN_5 ((uint16_t) 0x0020)
+#define GPIO_PIN_6 ((uint16_t) 0x0040)
+#define GPIO_PIN_7 ((uint16_t) 0x0080)
+#define GPIO_PIN_8 ((uint16_t) 0x0100)
+#define GPIO_PIN_9 ((uint16_t) 0x0200)
+#define GPIO_PIN_10 ((uint16_t) 0x0400)
+#define GPIO_PIN_11 ((uint16_t) 0x0800)
+#define GPIO_PIN_12 ((uint16_t) 0x1000)
+#define GPIO_PIN_13 ((uint16_t) 0x2000)
+#define GPIO_PIN_14 ((uint16_t) 0x4000)
+#define GPIO_PIN_15 ((uint16_t) 0x8000)
+
+#define TIM_CHANNEL_1 (0x00000000U)
+#define TIM_CHANNEL_2 (0x00000004U)
+#define TIM_CHANNEL_3 (0x00000008U)
+#define TIM_CHANNEL_4 (0x0000000CU)
+
+#define __HAL_TIM_SET_COMPARE(__HANDLE__, __CHANNEL__, __COMPARE__) (*(&((__HANDLE__)->Instance->CCR1) + ((__CHANNEL__) >> 2U)) = (__COMPARE__))
+#define __HAL_TIM_GET_COMPARE(__HANDLE__, __CHANNEL__) (*(&((__HANDLE__)->Instance->CCR1) + ((__CHANNEL__) >> 2U)))
+#define __HAL_TIM_SetCompare __HAL_TIM_SET_COMPARE
+#define __HAL_TIM_GET_COUNTER(__HANDLE__) ((__HANDLE__)->Instance->CNT)
+#define __HAL_TIM_GET_AUTORELOAD(__HANDLE__) ((__HANDLE__)->Instance->ARR)
+
+#define __HAL_DMA_GET_COUNTER(__HANDLE__) ((__HANDLE__)->Instance->NDTR)
+
+// UART接收状态与接收事件类型, 与stm32f4xx_hal_uart.h的定义一致
+#define HAL_UART_STATE_READY (0x20U)
+#define HAL_UART_STATE_BUSY_TX (0x21U)
+#define HAL_UART_STATE_BUSY_RX (0x22U)
+#define HAL_UART_RXEVENT_TC (0x00U)
+#define HAL_UART_RXEVENT_HT (0x01U)
+#define HAL_UART_RXEVENT_IDLE (0x02U)
+
+/* Exported types ------------------------------------------------------------*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum
+{
+    HAL_OK = 0x00U,
+    HAL_ERROR = 0x01U,
+    HAL_BUSY = 0x02U,
+    HAL_TIMEOUT = 0x03U
+} HAL_StatusTypeDef;
+
+typedef enum
+{
+    DISABLE = 0U,
+    ENABLE = !DISABLE
+} FunctionalState;
+
+/**
+ * @brief 中断号, 与stm32f407xx.h一致, 只列出工程中用到的
+ *
+ */
+typedef enum
+{
+    PendSV_IRQn = -2,
+    SysTick_IRQn = -1,
+    DMA1_Stream1_IRQn = 12,
+    CAN1_TX_IRQn = 19,
+    CAN1_RX0_IRQn = 20,
+    CAN1_RX1_IRQn = 21,
+    CAN1_SCE_IRQn = 22,
+    TIM4_IRQn = 30,
+    USART1_IRQn = 37,
+    USART3_IRQn = 39,
+    DMA2_Stream2_IRQn = 58,
+    CAN2_TX_IRQn = 63,
+    CAN2_RX0_IRQn = 64,
+    CAN2_RX1_IRQn = 65,
+    CAN2_SCE_IRQn = 66,
+    DMA2_Stream7_IRQn = 70,
+    USART6_IRQn = 71,
+} IRQn_Type;
+
+/**
+ * @brief 有写入副作用的仿真SCB寄存器, 置位PENDSVSET时挂起PendSV, 由仿真NVIC按优先级进入
+ *
+ */
+struct Sim_SCB_Register
+{
+    uint32_t Value;
+
+    operator uint32_t() const;
+
+    Sim_SCB_Register &operator=(uint32_t __Value);
+};
+
+/**
+ * @brief 系统控制块, 仿真中只用到ICSR
+ *
+ */
+typedef struct
+{
+    Sim_SCB_Register ICSR;
+} SCB_Type;
+
+/**
+ * @brief 有写入副作用的仿真CAN寄存器, 写入后由替身更新仿真外设状态
+ *
+ * 用于驱动直接读写寄存器的快速路径(CAN_FAST_PATH): 置位RFOM释放FIFO输出邮箱, 置位TXRQ发出邮箱中的报文
+ *
+ */
+struct Sim_CAN_Register
+{
+    uint32_t Value;
+
+    operator uint32_t() const
+    {
+        return (Value);
+    }
+
+    Sim_CAN_Register &operator=(uint32_t __Value);
+
+    Sim_CAN_Register &operator|=(uint32_t __Value)
+    {
+        return (*this = Value | __Value);
+    }
+
+    Sim_CAN_Register &operator&=(uint32_t __Value)
+    {
+        return (*this = Value & __Value);
+    }
+};
+
+/**
+ * @brief CAN寄存器组, 字段与stm32f407xx.h保持一致, 仿真中只用到其中一部分
+ *
+ */
+typedef struct
+{
+    Sim_CAN_Register TIR;
+    __IO uint32_t TDTR;
+    __IO uint32_t TDLR;
+    __IO uint32_t TDHR;
+} CAN_TxMailBox_TypeDef;
+
+typedef struct
+{
+    __IO uint32_t RIR;
+    __IO uint32_t RDTR;
+    __IO uint32_t RDLR;
+    __IO uint32_t RDHR;
+} CAN_FIFOMailBox_TypeDef;
+
+typedef struct
+{
+    __IO uint32_t FR1;
+    __IO uint32_t FR2;
+} CAN_FilterRegister_TypeDef;
+
+typedef struct
+{
+    __IO uint32_t MCR;
+    __IO uint32_t MSR;
+    __IO uint32_t TSR;
+    Sim_CAN_Register RF0R;
+    Sim_CAN_Register RF1R;
+    __IO uint32_t IER;
+    __IO uint32_t ESR;
+    __IO uint32_t BTR;
+    uint32_t RESERVED0[88];
+    CAN_TxMailBox_TypeDef sTxMailBox[3];
+    CAN_FIFOMailBox_TypeDef sFIFOMailBox[2];
+    uint32_t RESERVED1[12];
+    __IO uint32_t FMR;
+    __IO uint32_t FM1R;
+    uint32_t RESERVED2;
+    __IO uint32_t FS1R;
+    uint32_t RESERVED3;
+    __IO uint32_t FFA1R;
+    uint32_t RESERVED4;
+    __IO uint32_t FA1R;
+    uint32_t RESERVED5[8];
+    CAN_FilterRegister_TypeDef sFilterRegister[28];
+} CAN_TypeDef;
+
+typedef struct
+{
+    uint32_t Prescaler;
+    uint32_t Mode;
+    uint32_t SyncJumpWidth;
+    uint32_t TimeSeg1;
+    uint32_t TimeSeg2;
+    FunctionalState TimeTriggeredMode;
+    FunctionalState AutoBusOff;
+    FunctionalState AutoWakeUp;
+    FunctionalState AutoRetransmission;
+    FunctionalState ReceiveFifoLocked;
+    FunctionalState TransmitFifoPriority;
+} CAN_InitTypeDef;
+
+typedef struct
+{
+    uint32_t FilterIdHigh;
+    uint32_t FilterIdLow;
+    uint32_t FilterMaskIdHigh;
+    uint32_t FilterMaskIdLow;
+    uint32_t FilterFIFOAssignment;
+    uint32_t FilterBank;
+    uint32_t FilterMode;
+    uint32_t FilterScale;
+    uint32_t FilterActivation;
+    uint32_t SlaveStartFilterBank;
+} CAN_FilterTypeDef;
+
+typedef struct
+{
+    uint32_t StdId;
+    uint32_t ExtId;
+    uint32_t IDE;
+    uint32_t RTR;
+    uint32_t DLC;
+    FunctionalState TransmitGlobalTime;
+} CAN_TxHeaderTypeDef;
+
+typedef struct
+{
+    uint32_t StdId;
+    uint32_t ExtId;
+    uint32_t IDE;
+    uint32_t RTR;
+    uint32_t DLC;
+    uint32_t Timestamp;
+    uint32_t FilterMatchIndex;
+} CAN_RxHeaderTypeDef;
+
+typedef enum
+{
+    HAL_CAN_STATE_RESET = 0x00U,
+    HAL_CAN_STATE_READY = 0x01U,
+    HAL_CAN_STATE_LISTENING = 0x02U,
+    HAL_CAN_STATE_SLEEP_PENDING = 0x03U,
+    HAL_CAN_STATE_SLEEP_ACTIVE = 0x04U,
+    HAL_CAN_STATE_ERROR = 0x05U
+} HAL_CAN_StateTypeDef;
+
+typedef struct __CAN_HandleTypeDef
+{
+    CAN_TypeDef *Instance;
+    CAN_InitTypeDef Init;
+    __IO HAL_CAN_StateTypeDef State;
+    __IO uint32_t ErrorCode;
+} CAN_HandleTypeDef;
+
+typedef enum
+{
+    GPIO_PIN_RESET = 0,
+    GPIO_PIN_SET
+} GPIO_PinState;
+
+typedef struct
+{
+    __IO uint32_t MODER;
+    __IO uint32_t OTYPER;
+    __IO uint32_t OSPEEDR;
+    __IO uint32_t PUPDR;
+    __IO uint32_t IDR;
+    __IO uint32_t ODR;
+    __IO uint32_t BSRR;
+    __IO uint32_t LCKR;
+    __IO uint32_t AFR[2];
+} GPIO_TypeDef;
+
+typedef struct
+{
+    __IO uint32_t CR1;
+    __IO uint32_t CR2;
+    __IO uint32_t SMCR;
+    __IO uint32_t DIER;
+    __IO uint32_t SR;
+    __IO uint32_t EGR;
+    __IO uint32_t CCMR1;
+    __IO uint32_t CCMR2;
+    __IO uint32_t CCER;
+    __IO uint32_t CNT;
+    __IO uint32_t PSC;
+    __IO uint32_t ARR;
+    __IO uint32_t RCR;
+    __IO uint32_t CCR1;
+    __IO uint32_t CCR2;
+    __IO uint32_t CCR3;
+    __IO uint32_t CCR4;
+    __IO uint32_t BDTR;
+    __IO uint32_t DCR;
+    __IO uint32_t DMAR;
+    __IO uint32_t OR;
+} TIM_TypeDef;
+
+typedef struct
+{
+    uint32_t Prescaler;
+    uint32_t CounterMode;
+    uint32_t Period;
+    uint32_t ClockDivision;
+    uint32_t RepetitionCounter;
+    uint32_t AutoReloadPreload;
+} TIM_Base_InitTypeDef;
+
+typedef struct
+{
+    TIM_TypeDef *Instance;
+    TIM_Base_InitTypeDef Init;
+} TIM_HandleTypeDef;
+
+typedef struct
+{
+    __IO uint32_t SR;
+    __IO uint32_t DR;
+    __IO uint32_t BRR;
+    __IO uint32_t CR1;
+    __IO uint32_t CR2;
+    __IO uint32_t CR3;
+    __IO uint32_t GTPR;
+} USART_TypeDef;
+
+typedef struct
+{
+    uint32_t BaudRate;
+    uint32_t WordLength;
+    uint32_t StopBits;
+    uint32_t Parity;
+    uint32_t Mode;
+    uint32_t HwFlowCtl;
+    uint32_t OverSampling;
+} UART_InitTypeDef;
+
+typedef struct
+{
+    __IO uint32_t CR;
+    __IO uint32_t NDTR;
+    __IO uint32_t PAR;
+    __IO uint32_t M0AR;
+    __IO uint32_t M1AR;
+    __IO uint32_t FCR;
+} DMA_Stream_TypeDef;
+
+typedef struct
+{
+    DMA_Stream_TypeDef *Instance;
+} DMA_HandleTypeDef;
+
+typedef uint32_t HAL_UART_RxEventTypeTypeDef;
+
+typedef struct __UART_HandleTypeDef
+{
+    USART_TypeDef *Instance;
+    UART_InitTypeDef Init;
+    uint8_t *pRxBuffPtr;
+    uint16_t RxXferSize;
+    __IO uint16_t RxXferCount;
+    DMA_HandleTypeDef *hdmarx;
+    __IO uint32_t gState;
+    __IO uint32_t RxState;
+    __IO HAL_UART_RxEventTypeTypeDef RxEventType;
+} UART_HandleTypeDef;
+
+typedef struct
+{
+    __IO uint32_t CR1;
+    __IO uint32_t CR2;
+    __IO uint32_t SR;
+    __IO uint32_t DR;
+    __IO uint32_t CRCPR;
+    __IO uint32_t RXCRCR;
+    __IO uint32_t TXCRCR;
+    __IO uint32_t I2SCFGR;
+    __IO uint32_t I2SPR;
+} SPI_TypeDef;
+
+typedef struct __SPI_HandleTypeDef
+{
+    SPI_TypeDef *Instance;
+    __IO uint32_t ErrorCode;
+} SPI_HandleTypeDef;
+
+/* Exported variables --------------------------------------------------------*/
+
+// 仿真的外设寄存器块, 地址只用于区分实例
+extern CAN_TypeDef Sim_CAN1_Instance;
+extern CAN_TypeDef Sim_CAN2_Instance;
+
+#define CAN1 (&Sim_CAN1_Instance)
+#define CAN2 (&Sim_CAN2_Instance)
+
+extern GPIO_TypeDef Sim_GPIO_Instance[9];
+
+#define GPIOA (&Sim_GPIO_Instance[0])
+#define GPIOB (&Sim_GPIO_Instance[1])
+#define GPIOC (&Sim_GPIO_Instance[2])
+#define GPIOD (&Sim_GPIO_Instance[3])
+#define GPIOE (&Sim_GPIO_Instance[4])
+#define GPIOF (&Sim_GPIO_Instance[5])
+#define GPIOG (&Sim_GPIO_Instance[6])
+#define GPIOH (&Sim_GPIO_Instance[7])
+#define GPIOI (&Sim_GPIO_Instance[8])
+
+extern TIM_TypeDef Sim_TIM_Instance[14];
+
+#define TIM1 (&Sim_TIM_Instance[0])
+#define TIM2 (&Sim_TIM_Instance[1])
+#define TIM3 (&Sim_TIM_Instance[2])
+#define TIM4 (&Sim_TIM_Instance[3])
+#define TIM5 (&Sim_TIM_Instance[4])
+#define TIM6 (&Sim_TIM_Instance[5])
+#define TIM7 (&Sim_TIM_Instance[6])
+#define TIM8 (&Sim_TIM_Instance[7])
+#define TIM9 (&Sim_TIM_Instance[8])
+#define TIM10 (&Sim_TIM_Instance[9])
+#define TIM11 (&Sim_TIM_Instance[10])
+#define TIM12 (&Sim_TIM_Instance[11])
+#define TIM13 (&Sim_TIM_Instance[12])
+#define TIM14 (&Sim_TIM_Instance[13])
+
+extern USART_TypeDef Sim_USART_Instance[6];
+
+extern uint32_t Sim_PRIMASK;
+
+#define USART1 (&Sim_USART_Instance[0])
+#define USART2 (&Sim_USART_Instance[1])
+#define USART3 (&Sim_USART_Instance[2])
+#define UART4 (&Sim_USART_Instance[3])
+#define UART5 (&Sim_USART_Instance[4])
+#define USART6 (&Sim_USART_Instance[5])
+
+extern SPI_TypeDef Sim_SPI_Instance[3];
+
+extern SCB_Type Sim_SCB;
+
+#define SCB (&Sim_SCB)
+
+#define SPI1 (&Sim_SPI_Instance[0])
+#define SPI2 (&Sim_SPI_Instance[1])
+#define SPI3 (&Sim_SPI_Instance[2])
+
+/* Exported function declarations --------------------------------------------*/
+
+uint32_t HAL_GetTick(void);
+uint32_t HAL_RCC_GetPCLK1Freq(void);
+void HAL_Delay(uint32_t Delay);
+void HAL_NVIC_SystemReset(void);
+void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority);
+
+void Sim_NVIC_Set_PRIMASK(uint32_t PRIMASK);
+
+uint32_t Sim_HAL_Get_Time_Us(void);
+
+void PendSV_Handler(void);
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState);
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+void HAL_GPIO_TogglePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+
+HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_Base_Stop_IT(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_PWM_Start(TIM_HandleTypeDef *htim, uint32_t Channel);
+void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim);
+
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size);
+HAL_UART_RxEventTypeTypeDef HAL_UARTEx_GetRxEventType(UART_HandleTypeDef *huart);
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size);
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart);
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart);
+
+HAL_StatusTypeDef HAL_SPI_Transmit(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_SPI_Receive(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_SPI_TransmitReceive(SPI_HandleTypeDef *hspi, uint8_t *pTxData, uint8_t *pRxData, uint16_t Size, uint32_t Timeout);
+
+HAL_StatusTypeDef HAL_CAN_Start(CAN_HandleTypeDef *hcan);
+HAL_StatusTypeDef HAL_CAN_Stop(CAN_HandleTypeDef *hcan);
+HAL_StatusTypeDef HAL_CAN_ConfigFilter(CAN_HandleTypeDef *hcan, CAN_FilterTypeDef *sFilterConfig);
+HAL_StatusTypeDef HAL_CAN_AddTxMessage(CAN_HandleTypeDef *hcan, CAN_TxHeaderTypeDef *pHeader, uint8_t aData[], uint32_t *pTxMailbox);
+uint32_t HAL_CAN_GetTxMailboxesFreeLevel(CAN_HandleTypeDef *hcan);
+HAL_StatusTypeDef HAL_CAN_GetRxMessage(CAN_HandleTypeDef *hcan, uint32_t RxFifo, CAN_RxHeaderTypeDef *pHeader, uint8_t aData[]);
+uint32_t HAL_CAN_GetRxFifoFillLevel(CAN_HandleTypeDef *hcan, uint32_t RxFifo);
+HAL_StatusTypeDef HAL_CAN_ActivateNotification(CAN_HandleTypeDef *hcan, uint32_t ActiveITs);
+uint32_t HAL_CAN_GetError(CAN_HandleTypeDef *hcan);
+HAL_StatusTypeDef HAL_CAN_ResetError(CAN_HandleTypeDef *hcan);
+
+void HAL_CAN_TxMailbox0CompleteCallback(CAN_HandleTypeDef *hcan);
+void HAL_CAN_TxMailbox1CompleteCallback(CAN_HandleTypeDef *hcan);
+void HAL_CAN_TxMailbox2CompleteCallback(CAN_HandleTypeDef *hcan);
+void HAL_CAN_TxMailbox0AbortCallback(CAN_HandleTypeDef *hcan);
+void HAL_CAN_TxMailbox1AbortCallback(CAN_HandleTypeDef *hcan);
+void HAL_CAN_TxMailbox2AbortCallback(CAN_HandleTypeDef *hcan);
+void HAL_CAN_ErrorCallback(CAN_HandleTypeDef *hcan);
+void HAL_CAN_RxFifo0MsgPendingCallback(CAN_HandleTypeDef *hcan);
+void HAL_CAN_RxFifo1MsgPendingCallback(CAN_HandleTypeDef *hcan);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+/*****************************************************************************/
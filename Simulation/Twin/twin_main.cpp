@@ -0,0 +1,776 @@
+/**
+ * @file twin_main.cpp
+ * @author WFZ
+ * @brief 整车软件在环仿真: 固件任务层原样编译, 底盘/云台/发射机构由物理模型代替, 遥控器由脚本驱动
+ * @version 0.0
+ * @date 2026-1-24
+ *
+ * @note 每1ms依次: 按14ms周期发送DR16帧 -> 仿真电机回送反馈 -> TIM4中断运行Task1ms_TIM4_Callback
+ *       -> 物理模型推进1ms. 全程不读墙钟, 同一脚本每次运行结果完全一致.
+ *       跟踪误差 = 固件给出的目标值 - 物理模型中的真实值, 每条脚本指令开始一个新的区段,
+ *       调节时间为区段开始到误差最后一次超出容差的时间, 区段结束时仍超差记为未收敛.
+ *
+ *       编译(在仓库根目录, 主机g++):
+ *       g++ -std=c++11 -O2 -Wall $(find User -type d ! -path "*MPU6050*" -printf "-I%p ") -ISimulation/Stub -ISimulation/Device
+ *           -ISimulation/Motor -ISimulation/Robot
+ *           -x c++ User/1_Middleware/1_Driver/CAN/drv_can.c User/1_Middleware/1_Driver/UART/drv_uart.c User/2_Device/Buzzer/dvc_buzzer.c
+ *           -x none $(find User -name "*.cpp" ! -path "*MPU6050*") Simulation/Stub/sim_hal.cpp Simulation/Device/sim_bmi088.cpp
+ *           Simulation/Device/sim_dr16.cpp Simulation/Motor/sim_motor.cpp Simulation/Robot/sim_robot.cpp
+ *           Simulation/Twin/twin_main.cpp -o twin
+ *
+ *       运行: ./twin 参数名=值 ...
+ *       script=遥控器脚本文件, 不指定时使用内置的回归脚本
+ *       time=仿真时长(s), 默认到脚本的end指令  ammo=弹仓弹丸数(默认200)
+ *       json=指标输出文件(默认标准输出)  csv=逐毫秒波形输出文件
+ *       baseline=旧的指标文件, 误差/调节时间类指标变差超过tolerance(默认0.1即10%)时返回值为3
+ *
+ *       脚本每行为 "时刻(s) 键=值 ...", #之后为注释, 未写的键保持上一次的值:
+ *       rx ry lx ly yaw  摇杆与拨轮, -1~1       s1 s2  左右开关, up/middle/down
+ *       mx my mz         鼠标移动, -1~1         ml mr  鼠标左右键, 0/1
+ *       key              键盘位图               end    仿真在该时刻结束
+ *
+ *       例: ./twin json=new.json baseline=Simulation/Twin/baseline.json
+ *
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "tsk_config_and_callback.h"
+#include "crt_chassis.h"
+#include "crt_gimbal.h"
+#include "crt_booster.h"
+#include "sim_robot.h"
+#include "sim_dr16.h"
+
+/* Private macros ------------------------------------------------------------*/
+
+// 控制周期, s
+#define TWIN_DT 0.001f
+// 每个控制周期内物理模型的细分步数
+#define TWIN_SUB_STEP_NUM 10
+// 脚本指令数上限
+#define TWIN_EVENT_NUM_MAX 256
+// 单条脚本指令的长度上限
+#define TWIN_EVENT_LENGTH_MAX 256
+// 指标通道数
+#define TWIN_CHANNEL_NUM 8
+// 基线文件中的指标数上限
+#define TWIN_BASELINE_NUM_MAX 128
+
+/* Private types -------------------------------------------------------------*/
+
+/**
+ * @brief 一条脚本指令
+ *
+ */
+struct Struct_Twin_Event
+{
+    float Time;
+    char Text[TWIN_EVENT_LENGTH_MAX];
+};
+
+/**
+ * @brief 一个跟踪误差统计通道
+ *
+ */
+struct Struct_Twin_Channel
+{
+    const char *Name;
+    // 判断收敛的误差容差
+    float Tolerance;
+    // 本周期的目标值与真实值
+    float Target;
+    float Now;
+    // 全程统计
+    double Square_Sum;
+    float Max_Abs_Error;
+    uint32_t Settle_Ms_Max;
+    uint32_t Unsettled_Num;
+    // 当前区段
+    uint32_t Segment_Start_Ms;
+    uint32_t Segment_Last_Violation_Ms;
+    bool Segment_Violated;
+    bool Last_Violated;
+};
+
+/**
+ * @brief 基线文件中的一项指标
+ *
+ */
+struct Struct_Twin_Baseline
+{
+    char Name[64];
+    double Value;
+};
+
+/* Private variables ---------------------------------------------------------*/
+
+// 固件中的整车对象, 定义在tsk_config_and_callback.cpp
+extern Class_Chassis Chassis;
+extern Class_Gimbal Gimbal;
+extern Class_Booster Booster;
+
+// 物理模型
+static Class_Sim_Chassis Sim_Chassis;
+static Class_Sim_Gimbal Sim_Gimbal;
+static Class_Sim_Booster Sim_Booster;
+static Class_Sim_DR16 Sim_DR16;
+
+/**
+ * @brief 内置回归脚本: 遥控器模式下底盘前进/平移/自转, 鼠标转Yaw/抬Pitch, 单发与连发
+ *
+ */
+static const char *Twin_Default_Script[] = {
+    "0.0 s1=middle s2=middle",
+    "0.5 ly=0.5",
+    "1.5 ly=0 lx=0.5",
+    "2.5 lx=0 yaw=0.5",
+    "3.5 yaw=0 mx=0.002",
+    "4.5 mx=0 my=-0.001",
+    "5.5 my=0",
+    "6.0 s2=up",
+    "6.3 s2=middle",
+    "6.6 s2=down",
+    "7.6 s2=middle",
+    "8.0 end",
+};
+
+static Struct_Twin_Event Twin_Event[TWIN_EVENT_NUM_MAX];
+static uint16_t Twin_Event_Num = 0;
+static float Twin_End_Time = -1.0f;
+
+// 当前遥控器状态, 脚本只改动其中一部分
+static float Twin_Rocker[5] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+static uint8_t Twin_Switch[2] = {SWITCH_UP, SWITCH_UP};
+static float Twin_Mouse[3] = {0.0f, 0.0f, 0.0f};
+static uint8_t Twin_Mouse_Key[2] = {KEY_FREE, KEY_FREE};
+static uint16_t Twin_Keyboard = 0;
+
+static Struct_Twin_Channel Twin_Channel[TWIN_CHANNEL_NUM] = {
+    {"chassis_vx", 0.05f},
+    {"chassis_vy", 0.05f},
+    {"chassis_omega", 0.1f},
+    {"yaw_omega", 0.1f},
+    {"pitch_angle", 0.02f},
+    {"friction_left", 20.0f},
+    {"friction_right", 20.0f},
+    {"driver_omega", 1.0f},
+};
+
+/* Private function declarations ---------------------------------------------*/
+
+/* Function prototypes -------------------------------------------------------*/
+
+/**
+ * @brief 执行一条脚本指令中的键值对
+ *
+ * @param Text 指令文本, 不含时刻
+ * @param Is_End 输出是否含有end指令
+ * @return true 指令合法
+ * @return false 含有未知的键或非法的值
+ */
+static bool Twin_Apply(const char *Text, bool *Is_End)
+{
+    char buffer[TWIN_EVENT_LENGTH_MAX];
+    strncpy(buffer, Text, sizeof(buffer) - 1);
+    buffer[sizeof(buffer) - 1] = '\0';
+    *Is_End = false;
+
+    for (char *token = strtok(buffer, " \t\r\n"); token != NULL; token = strtok(NULL, " \t\r\n"))
+    {
+        if (strcmp(token, "end") == 0)
+        {
+            *Is_End = true;
+            continue;
+        }
+
+        char *value = strchr(token, '=');
+        if (value == NULL)
+        {
+            return (false);
+        }
+        *value++ = '\0';
+
+        static const char *rocker_name[5] = {"rx", "ry", "lx", "ly", "yaw"};
+        static const char *mouse_name[3] = {"mx", "my", "mz"};
+        bool matched = false;
+
+        for (int i = 0; i < 5 && !matched; i++)
+        {
+            if (strcmp(token, rocker_name[i]) == 0)
+            {
+                Twin_Rocker[i] = strtof(value, NULL);
+                matched = true;
+            }
+        }
+        for (int i = 0; i < 3 && !matched; i++)
+        {
+            if (strcmp(token, mouse_name[i]) == 0)
+            {
+                Twin_Mouse[i] = strtof(value, NULL);
+                matched = true;
+            }
+        }
+        if (matched)
+        {
+            continue;
+        }
+
+        if (strcmp(token, "s1") == 0 || strcmp(token, "s2") == 0)
+        {
+            uint8_t status;
+            if (strcmp(value, "up") == 0)
+            {
+                status = SWITCH_UP;
+            }
+            else if (strcmp(value, "middle") == 0)
+            {
+                status = SWITCH_MIDDLE;
+            }
+            else if (strcmp(value, "down") == 0)
+            {
+                status = SWITCH_DOWN;
+            }
+            else
+            {
+                return (false);
+            }
+            Twin_Switch[token[1] - '1'] = status;
+        }
+        else if (strcmp(token, "ml") == 0)
+        {
+            Twin_Mouse_Key[0] = atoi(value) ? KEY_PRESSED : KEY_FREE;
+        }
+        else if (strcmp(token, "mr") == 0)
+        {
+            Twin_Mouse_Key[1] = atoi(value) ? KEY_PRESSED : KEY_FREE;
+        }
+        else if (strcmp(token, "key") == 0)
+        {
+            Twin_Keyboard = (uint16_t) strtoul(value, NULL, 0);
+        }
+        else
+        {
+            return (false);
+        }
+    }
+
+    return (true);
+}
+
+/**
+ * @brief 添加一条脚本指令并检查其合法性
+ *
+ * @param Line 脚本行
+ * @param Line_Index 行号, 用于报错
+ * @return true 添加成功或为空行
+ * @return false 脚本错误
+ */
+static bool Twin_Add_Event(const char *Line, int Line_Index)
+{
+    char buffer[TWIN_EVENT_LENGTH_MAX];
+    strncpy(buffer, Line, sizeof(buffer) - 1);
+    buffer[sizeof(buffer) - 1] = '\0';
+
+    char *comment = strchr(buffer, '#');
+    if (comment != NULL)
+    {
+        *comment = '\0';
+    }
+
+    char *text;
+    float time = strtof(buffer, &text);
+    if (text == buffer)
+    {
+        // 空行
+        for (char *c = buffer; *c != '\0'; c++)
+        {
+            if (*c != ' ' && *c != '\t' && *c != '\r' && *c != '\n')
+            {
+                fprintf(stderr, "script line %d: missing time\n", Line_Index);
+                return (false);
+            }
+        }
+        return (true);
+    }
+
+    if (Twin_Event_Num >= TWIN_EVENT_NUM_MAX || (Twin_Event_Num > 0 && time < Twin_Event[Twin_Event_Num - 1].Time))
+    {
+        fprintf(stderr, "script line %d: too many events or time goes backwards\n", Line_Index);
+        return (false);
+    }
+
+    bool is_end;
+    if (!Twin_Apply(text, &is_end))
+    {
+        fprintf(stderr, "script line %d: bad command \"%s\"\n", Line_Index, text);
+        return (false);
+    }
+    if (is_end)
+    {
+        Twin_End_Time = time;
+    }
+
+    Twin_Event[Twin_Event_Num].Time = time;
+    strcpy(Twin_Event[Twin_Event_Num].Text, text);
+    Twin_Event_Num++;
+    return (true);
+}
+
+/**
+ * @brief 读取脚本, 文件名为NULL时使用内置脚本
+ *
+ * @param File_Name 文件名
+ * @return true 读取成功
+ * @return false 读取失败
+ */
+static bool Twin_Load_Script(const char *File_Name)
+{
+    if (File_Name == NULL)
+    {
+        for (uint16_t i = 0; i < sizeof(Twin_Default_Script) / sizeof(Twin_Default_Script[0]); i++)
+        {
+            if (!Twin_Add_Event(Twin_Default_Script[i], i + 1))
+            {
+                return (false);
+            }
+        }
+    }
+    else
+    {
+        FILE *file = fopen(File_Name, "r");
+        if (file == NULL)
+        {
+            fprintf(stderr, "cannot open %s\n", File_Name);
+            return (false);
+        }
+        char line[TWIN_EVENT_LENGTH_MAX];
+        int line_index = 0;
+        while (fgets(line, sizeof(line), file) != NULL)
+        {
+            if (!Twin_Add_Event(line, ++line_index))
+            {
+                fclose(file);
+                return (false);
+            }
+        }
+        fclose(file);
+    }
+
+    // 检查时执行过的指令不能影响正式运行
+    for (int i = 0; i < 5; i++) Twin_Rocker[i] = 0.0f;
+    for (int i = 0; i < 3; i++) Twin_Mouse[i] = 0.0f;
+    Twin_Switch[0] = Twin_Switch[1] = SWITCH_UP;
+    Twin_Mouse_Key[0] = Twin_Mouse_Key[1] = KEY_FREE;
+    Twin_Keyboard = 0;
+
+    if (Twin_End_Time < 0.0f)
+    {
+        Twin_End_Time = Twin_Event_Num > 0 ? Twin_Event[Twin_Event_Num - 1].Time + 1.0f : 1.0f;
+    }
+    return (true);
+}
+
+/**
+ * @brief 把当前遥控器状态写入仿真DR16
+ *
+ */
+static void Twin_Update_DR16()
+{
+    Sim_DR16.Set_Rocker(Twin_Rocker[0], Twin_Rocker[1], Twin_Rocker[2], Twin_Rocker[3]);
+    Sim_DR16.Set_Yaw(Twin_Rocker[4]);
+    Sim_DR16.Set_Switch(Twin_Switch[0], Twin_Switch[1]);
+    Sim_DR16.Set_Mouse(Twin_Mouse[0], Twin_Mouse[1], Twin_Mouse[2]);
+    Sim_DR16.Set_Mouse_Key(Twin_Mouse_Key[0], Twin_Mouse_Key[1]);
+    Sim_DR16.Set_Keyboard(Twin_Keyboard);
+}
+
+/**
+ * @brief 采样各通道的目标值与真实值, 目标值取自固件, 真实值取自物理模型
+ *
+ */
+static void Twin_Sample()
+{
+    Twin_Channel[0].Target = Chassis.Get_Target_Velocity_X();
+    Twin_Channel[0].Now = Sim_Chassis.Get_Velocity_X();
+    Twin_Channel[1].Target = Chassis.Get_Target_Velocity_Y();
+    Twin_Channel[1].Now = Sim_Chassis.Get_Velocity_Y();
+    Twin_Channel[2].Target = Chassis.Get_Target_Omega();
+    Twin_Channel[2].Now = Sim_Chassis.Get_Omega();
+    Twin_Channel[3].Target = Gimbal.Get_Target_Yaw_Omega();
+    Twin_Channel[3].Now = Sim_Gimbal.Get_World_Yaw_Omega();
+    Twin_Channel[4].Target = Gimbal.Get_Target_Pitch_Angle();
+    Twin_Channel[4].Now = Sim_Gimbal.Get_Pitch_Angle();
+    Twin_Channel[5].Target = Booster.Motor_Friction_Left.Get_Target_Omega();
+    Twin_Channel[5].Now = Sim_Booster.Motor_Friction_Left.Get_Omega();
+    Twin_Channel[6].Target = Booster.Motor_Friction_Right.Get_Target_Omega();
+    Twin_Channel[6].Now = Sim_Booster.Motor_Friction_Right.Get_Omega();
+    // 拨弹盘只在速度控制时统计, 位置控制(单发)与失能时目标速度无意义
+    if (Booster.Motor_Driver.Get_Control_Method() == Motor_Control_Method_OMEGA)
+    {
+        Twin_Channel[7].Target = Booster.Motor_Driver.Get_Target_Omega();
+    }
+    else
+    {
+        Twin_Channel[7].Target = Sim_Booster.Motor_Driver.Get_Omega();
+    }
+    Twin_Channel[7].Now = Sim_Booster.Motor_Driver.Get_Omega();
+}
+
+/**
+ * @brief 结束当前区段, 统计调节时间
+ *
+ * @param Now_Ms 当前时刻, ms
+ */
+static void Twin_Close_Segment(uint32_t Now_Ms)
+{
+    for (int i = 0; i < TWIN_CHANNEL_NUM; i++)
+    {
+        Struct_Twin_Channel *channel = &Twin_Channel[i];
+        if (channel->Segment_Violated)
+        {
+            uint32_t settle_ms = channel->Segment_Last_Violation_Ms + 1 - channel->Segment_Start_Ms;
+            if (settle_ms > channel->Settle_Ms_Max)
+            {
+                channel->Settle_Ms_Max = settle_ms;
+            }
+            if (channel->Last_Violated)
+            {
+                channel->Unsettled_Num++;
+            }
+        }
+        channel->Segment_Start_Ms = Now_Ms;
+        channel->Segment_Violated = false;
+        channel->Last_Violated = false;
+    }
+}
+
+/**
+ * @brief 累计本周期的误差
+ *
+ * @param Now_Ms 当前时刻, ms
+ */
+static void Twin_Accumulate(uint32_t Now_Ms)
+{
+    for (int i = 0; i < TWIN_CHANNEL_NUM; i++)
+    {
+        Struct_Twin_Channel *channel = &Twin_Channel[i];
+        float error = fabsf(channel->Target - channel->Now);
+
+        channel->Square_Sum += (double) error * error;
+        if (error > channel->Max_Abs_Error)
+        {
+            channel->Max_Abs_Error = error;
+        }
+
+        channel->Last_Violated = error > channel->Tolerance;
+        if (channel->Last_Violated)
+        {
+            channel->Segment_Violated = true;
+            channel->Segment_Last_Violation_Ms = Now_Ms;
+        }
+    }
+}
+
+/**
+ * @brief 读取基线指标文件, 只识别本程序输出的 "名称": 数值 格式
+ *
+ * @param File_Name 文件名
+ * @param Baseline 输出
+ * @return int 读到的指标数, 失败返回-1
+ */
+static int Twin_Load_Baseline(const char *File_Name, Struct_Twin_Baseline *Baseline)
+{
+    FILE *file = fopen(File_Name, "r");
+    if (file == NULL)
+    {
+        fprintf(stderr, "cannot open %s\n", File_Name);
+        return (-1);
+    }
+
+    char line[256];
+    int num = 0;
+    while (fgets(line, sizeof(line), file) != NULL && num < TWIN_BASELINE_NUM_MAX)
+    {
+        if (sscanf(line, " \"%63[^\"]\": %lf", Baseline[num].Name, &Baseline[num].Value) == 2)
+        {
+            num++;
+        }
+    }
+    fclose(file);
+    return (num);
+}
+
+/**
+ * @brief 与基线对比, 越小越好的指标变差超过容差时报告
+ *
+ * @param Baseline 基线
+ * @param Baseline_Num 基线指标数
+ * @param Name 指标名
+ * @param Value 本次的值
+ * @param Tolerance 相对容差
+ * @return true 发生退化
+ */
+static bool Twin_Check_Regression(const Struct_Twin_Baseline *Baseline, int Baseline_Num, const char *Name, double Value, double Tolerance)
+{
+    for (int i = 0; i < Baseline_Num; i++)
+    {
+        if (strcmp(Baseline[i].Name, Name) == 0)
+        {
+            // 绝对裕量避免基线接近0时的误报
+            if (Value > Baseline[i].Value * (1.0 + Tolerance) + 1e-4)
+            {
+                fprintf(stderr, "regression: %s %.6g -> %.6g\n", Name, Baseline[i].Value, Value);
+                return (true);
+            }
+            return (false);
+        }
+    }
+    return (false);
+}
+
+int main(int argc, char **argv)
+{
+    const char *script_name = NULL;
+    const char *json_name = NULL;
+    const char *csv_name = NULL;
+    const char *baseline_name = NULL;
+    float time_limit = 0.0f;
+    float tolerance = 0.1f;
+    int ammo = 200;
+
+    for (int i = 1; i < argc; i++)
+    {
+        char *value = strchr(argv[i], '=');
+        if (value == NULL)
+        {
+            fprintf(stderr, "bad argument %s\n", argv[i]);
+            return (1);
+        }
+        *value++ = '\0';
+
+        if (strcmp(argv[i], "script") == 0)
+        {
+            script_name = value;
+        }
+        else if (strcmp(argv[i], "json") == 0)
+        {
+            json_name = value;
+        }
+        else if (strcmp(argv[i], "csv") == 0)
+        {
+            csv_name = value;
+        }
+        else if (strcmp(argv[i], "baseline") == 0)
+        {
+            baseline_name = value;
+        }
+        else if (strcmp(argv[i], "time") == 0)
+        {
+            time_limit = strtof(value, NULL);
+        }
+        else if (strcmp(argv[i], "tolerance") == 0)
+        {
+            tolerance = strtof(value, NULL);
+        }
+        else if (strcmp(argv[i], "ammo") == 0)
+        {
+            ammo = atoi(value);
+        }
+        else
+        {
+            fprintf(stderr, "unknown parameter %s\n", argv[i]);
+            return (1);
+        }
+    }
+
+    if (!Twin_Load_Script(script_name))
+    {
+        return (1);
+    }
+    if (time_limit > 0.0f)
+    {
+        Twin_End_Time = time_limit;
+    }
+
+    FILE *csv_file = NULL;
+    if (csv_name != NULL)
+    {
+        csv_file = fopen(csv_name, "w");
+        if (csv_file == NULL)
+        {
+            fprintf(stderr, "cannot open %s\n", csv_name);
+            return (1);
+        }
+        fprintf(csv_file, "time");
+        for (int i = 0; i < TWIN_CHANNEL_NUM; i++)
+        {
+            fprintf(csv_file, ",%s_target,%s_now", Twin_Channel[i].Name, Twin_Channel[i].Name);
+        }
+        fprintf(csv_file, ",position_x,position_y,chassis_yaw,shoot_num\n");
+    }
+
+    // 物理模型先挂上总线, 固件初始化时IMU自检与电机上线才能通过
+    Sim_HAL_Reset();
+    Sim_Motor_Bus_Init();
+    Sim_Chassis.Init(&hcan1);
+    Sim_Gimbal.Init(&hcan1, &hspi1, 0x208, -3128, 0x205, 204);
+    Sim_Booster.Init(&hcan2, (uint16_t) ammo);
+    Task_Init();
+    Sim_DR16.Init(&huart3);
+
+    struct timespec wall_start, wall_end;
+    clock_gettime(CLOCK_MONOTONIC, &wall_start);
+
+    uint32_t end_ms = (uint32_t) lroundf(Twin_End_Time * 1000.0f);
+    uint16_t event_index = 0;
+    bool diverged = false;
+    uint32_t now_ms;
+
+    for (now_ms = 0; now_ms < end_ms; now_ms++)
+    {
+        // 执行到期的脚本指令, 每条指令开始一个新的统计区段
+        bool event_fired = false;
+        while (event_index < Twin_Event_Num && (uint32_t) lroundf(Twin_Event[event_index].Time * 1000.0f) <= now_ms)
+        {
+            bool is_end;
+            Twin_Apply(Twin_Event[event_index].Text, &is_end);
+            event_index++;
+            event_fired = true;
+        }
+        if (event_fired)
+        {
+            Twin_Close_Segment(now_ms);
+            Twin_Update_DR16();
+        }
+
+        if (now_ms % SIM_DR16_PERIOD_MS == 0)
+        {
+            Sim_DR16.Send();
+        }
+
+        Sim_Motor_Send_Feedback_All();
+        Sim_HAL_Tick_Increment(1);
+        Sim_TIM_Period_Elapsed(&htim4);
+
+        for (int step = 0; step < TWIN_SUB_STEP_NUM; step++)
+        {
+            Sim_Chassis.Step(TWIN_DT / TWIN_SUB_STEP_NUM);
+            Sim_Gimbal.Step(TWIN_DT / TWIN_SUB_STEP_NUM, &Sim_Chassis);
+            Sim_Booster.Step(TWIN_DT / TWIN_SUB_STEP_NUM);
+        }
+
+        Twin_Sample();
+        Twin_Accumulate(now_ms);
+
+        if (csv_file != NULL)
+        {
+            fprintf(csv_file, "%.3f", (now_ms + 1) * TWIN_DT);
+            for (int i = 0; i < TWIN_CHANNEL_NUM; i++)
+            {
+                fprintf(csv_file, ",%.5f,%.5f", Twin_Channel[i].Target, Twin_Channel[i].Now);
+            }
+            fprintf(csv_file, ",%.4f,%.4f,%.4f,%u\n", Sim_Chassis.Get_Position_X(), Sim_Chassis.Get_Position_Y(), Sim_Chassis.Get_Yaw(), Sim_Booster.Get_Shoot_Num());
+        }
+
+        // 发散时立即停止, 后面的数据没有意义
+        if (!isfinite(Sim_Chassis.Get_Velocity_X()) || !isfinite(Sim_Gimbal.Get_World_Yaw_Omega()) || fabsf(Sim_Chassis.Get_Omega()) > 100.0f || fabsf(Sim_Gimbal.Get_World_Yaw_Omega()) > 100.0f)
+        {
+            diverged = true;
+            now_ms++;
+            break;
+        }
+    }
+    Twin_Close_Segment(now_ms);
+
+    clock_gettime(CLOCK_MONOTONIC, &wall_end);
+    double wall_s = (wall_end.tv_sec - wall_start.tv_sec) + (wall_end.tv_nsec - wall_start.tv_nsec) * 1e-9;
+
+    if (csv_file != NULL)
+    {
+        fclose(csv_file);
+    }
+
+    FILE *json_file = stdout;
+    if (json_name != NULL)
+    {
+        json_file = fopen(json_name, "w");
+        if (json_file == NULL)
+        {
+            fprintf(stderr, "cannot open %s\n", json_name);
+            return (1);
+        }
+    }
+
+    fprintf(json_file, "{\n");
+    fprintf(json_file, "  \"script\": \"%s\",\n", script_name != NULL ? script_name : "builtin");
+    fprintf(json_file, "  \"diverged\": %s,\n", diverged ? "true" : "false");
+    fprintf(json_file, "  \"sim_s\": %.3f,\n", now_ms * TWIN_DT);
+    fprintf(json_file, "  \"wall_s\": %.4f,\n", wall_s);
+    fprintf(json_file, "  \"realtime_factor\": %.1f,\n", wall_s > 0.0 ? now_ms * TWIN_DT / wall_s : 0.0);
+    for (int i = 0; i < TWIN_CHANNEL_NUM; i++)
+    {
+        Struct_Twin_Channel *channel = &Twin_Channel[i];
+        fprintf(json_file, "  \"%s.rms\": %.6f,\n", channel->Name, now_ms > 0 ? sqrt(channel->Square_Sum / now_ms) : 0.0);
+        fprintf(json_file, "  \"%s.max_abs\": %.6f,\n", channel->Name, channel->Max_Abs_Error);
+        fprintf(json_file, "  \"%s.settle_ms\": %u,\n", channel->Name, channel->Settle_Ms_Max);
+        fprintf(json_file, "  \"%s.unsettled\": %u,\n", channel->Name, channel->Unsettled_Num);
+    }
+    fprintf(json_file, "  \"booster.shoot_num\": %u,\n", Sim_Booster.Get_Shoot_Num());
+    fprintf(json_file, "  \"booster.jam_num\": %u,\n", Sim_Booster.Get_Jam_Num());
+    fprintf(json_file, "  \"booster.speed_mean\": %.4f,\n", Sim_Booster.Get_Shoot_Speed_Mean());
+    fprintf(json_file, "  \"booster.speed_std\": %.4f,\n", Sim_Booster.Get_Shoot_Speed_Std());
+    fprintf(json_file, "  \"booster.speed_min\": %.4f,\n", Sim_Booster.Get_Shoot_Speed_Min());
+    fprintf(json_file, "  \"booster.speed_max\": %.4f,\n", Sim_Booster.Get_Shoot_Speed_Max());
+    fprintf(json_file, "  \"chassis.position_x\": %.4f,\n", Sim_Chassis.Get_Position_X());
+    fprintf(json_file, "  \"chassis.position_y\": %.4f,\n", Sim_Chassis.Get_Position_Y());
+    fprintf(json_file, "  \"chassis.yaw\": %.4f\n", Sim_Chassis.Get_Yaw());
+    fprintf(json_file, "}\n");
+    if (json_file != stdout)
+    {
+        fclose(json_file);
+    }
+
+    int result = diverged ? 2 : 0;
+
+    if (baseline_name != NULL)
+    {
+        static Struct_Twin_Baseline baseline[TWIN_BASELINE_NUM_MAX];
+        int baseline_num = Twin_Load_Baseline(baseline_name, baseline);
+        if (baseline_num < 0)
+        {
+            return (1);
+        }
+
+        bool regression = false;
+        char name[64];
+        for (int i = 0; i < TWIN_CHANNEL_NUM; i++)
+        {
+            Struct_Twin_Channel *channel = &Twin_Channel[i];
+            snprintf(name, sizeof(name), "%s.rms", channel->Name);
+            regression |= Twin_Check_Regression(baseline, baseline_num, name, now_ms > 0 ? sqrt(channel->Square_Sum / now_ms) : 0.0, tolerance);
+            snprintf(name, sizeof(name), "%s.max_abs", channel->Name);
+            regression |= Twin_Check_Regression(baseline, baseline_num, name, channel->Max_Abs_Error, tolerance);
+            snprintf(name, sizeof(name), "%s.settle_ms", channel->Name);
+            regression |= Twin_Check_Regression(baseline, baseline_num, name, channel->Settle_Ms_Max, tolerance);
+            snprintf(name, sizeof(name), "%s.unsettled", channel->Name);
+            regression |= Twin_Check_Regression(baseline, baseline_num, name, channel->Unsettled_Num, 0.0);
+        }
+        regression |= Twin_Check_Regression(baseline, baseline_num, "booster.jam_num", Sim_Booster.Get_Jam_Num(), 0.0);
+        regression |= Twin_Check_Regression(baseline, baseline_num, "booster.speed_std", Sim_Booster.Get_Shoot_Speed_Std(), tolerance);
+
+        if (regression && result == 0)
+        {
+            result = 3;
+        }
+    }
+
+    return (result);
+}
+
+/*****************************************************************************/
@@ -0,0 +1,306 @@
+/**
+ * @file uart_rx_check_main.cpp
+ * @author WFZ
+ * @brief UART循环DMA接收的主机检查: 仿真DMA写指针(NDTR)向USART3送入DR16帧, 核对交付的帧、环形缓冲区分段与覆盖/错误计数
+ * @version 0.0
+ * @date 2026-2-8
+ *
+ * @note 编译(在仓库根目录, 主机g++):
+ *       g++ -std=c++11 -O2 -Wall -ISimulation/Stub -IUser/1_Middleware/1_Driver/UART -IUser/1_Middleware/1_Driver/DWT
+ *           -x c++ User/1_Middleware/1_Driver/UART/drv_uart.c -x none User/1_Middleware/1_Driver/DWT/drv_dwt.cpp
+ *           Simulation/Stub/sim_hal.cpp Simulation/UART/uart_rx_check_main.cpp -o uart_rx_check
+ *
+ *       运行: ./uart_rx_check, 逐项输出不一致的次数, 全部通过时返回0
+ *       USART3接收缓冲区128字节, 不是DR16帧长18字节的整数倍, 帧起点逐帧移动, 反复跨过缓冲区末尾.
+ *       依次检查: 逐帧发送1000帧; 多帧首尾相接一次送入, 由半传输/传输完成事件与单帧最大长度分帧;
+ *       回调处理期间DMA继续写入, 未写到当前帧与写到当前帧两种情况; 半帧时出现接收错误, 重新开启后从缓冲区起始处接收
+ *
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <string.h>
+#include "drv_uart.h"
+#include "sim_hal.h"
+
+/* Private macros ------------------------------------------------------------*/
+
+// DR16帧长, 字节
+#define UART_RX_CHECK_FRAME_LENGTH 18
+
+/* Private types -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+
+static uint32_t Fail_Num = 0;
+
+// 被测UART的处理结构体
+static Struct_UART_Manage_Object *UART3_Manage_Object = NULL;
+
+// 下一帧的序号与预期在环形缓冲区中的起点
+static uint32_t Expect_Sequence = 0;
+static uint16_t Expect_Start = 0;
+// 帧内容或分段与预期不一致的次数
+static uint32_t Frame_Mismatch = 0;
+// 交付的帧中跨过缓冲区末尾的帧数
+static uint32_t Wrap_Num = 0;
+
+// 回调处理第Inject_Sequence帧期间再送入的帧数, 模拟回调执行期间DMA继续写入
+static uint32_t Inject_Sequence = 0xffffffff;
+static uint8_t Inject_Num = 0;
+// 下一个待送入的帧序号
+static uint32_t Send_Sequence = 0;
+
+/* Private function declarations ---------------------------------------------*/
+
+/* Function prototypes -------------------------------------------------------*/
+
+/**
+ * @brief 输出一项检查结果并累计失败数
+ *
+ * @param Mismatch 不一致的次数
+ * @param Name 检查项
+ */
+static void Report(uint32_t Mismatch, const char *Name)
+{
+    printf("%-40s %s (%u)\n", Name, Mismatch == 0 ? "ok" : "FAIL", (unsigned) Mismatch);
+    Fail_Num += Mismatch;
+}
+
+/**
+ * @brief 按序号生成一帧, 前两字节为序号, 其余字节由序号散列得到, 相邻帧各字节都不同
+ *
+ * @param Sequence 帧序号
+ * @param Frame 输出的帧
+ */
+static void Make_Frame(uint32_t Sequence, uint8_t *Frame)
+{
+    uint32_t state = Sequence * 0x9E3779B9U + 0x7F4A7C15U;
+
+    Frame[0] = (uint8_t) Sequence;
+    Frame[1] = (uint8_t) (Sequence >> 8);
+    for (uint8_t i = 2; i < UART_RX_CHECK_FRAME_LENGTH; i++)
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        Frame[i] = (uint8_t) (state >> 24) ^ (uint8_t) Sequence;
+    }
+}
+
+/**
+ * @brief 把接下来的Num帧首尾相接送入USART3
+ *
+ * @param Num 帧数
+ * @return bool DMA正在接收
+ */
+static bool Send_Frame(uint8_t Num)
+{
+    uint8_t data[UART_RX_CHECK_FRAME_LENGTH * 16];
+
+    for (uint8_t i = 0; i < Num; i++)
+    {
+        Make_Frame(Send_Sequence++, &data[i * UART_RX_CHECK_FRAME_LENGTH]);
+    }
+    return (Sim_UART_Receive(&huart3, data, Num * UART_RX_CHECK_FRAME_LENGTH));
+}
+
+/**
+ * @brief USART3接收回调, 核对帧内容与分段位置
+ *
+ * @param Rx_Span 收到的帧
+ */
+static void UART3_Rx_Call_Back(const Struct_UART_Rx_Span *Rx_Span)
+{
+    uint8_t expect[UART_RX_CHECK_FRAME_LENGTH];
+    uint8_t buffer[UART_RX_CHECK_FRAME_LENGTH];
+    uint16_t buffer_size = UART3_Manage_Object->Rx_Buffer_Size;
+    uint16_t tail_length = buffer_size - Expect_Start;
+    uint16_t expect_length = UART_RX_CHECK_FRAME_LENGTH < tail_length ? UART_RX_CHECK_FRAME_LENGTH : tail_length;
+    bool same = true;
+
+    // 分段: 第一段从预期起点开始到帧尾或缓冲区末尾, 回绕部分从缓冲区起始处开始
+    same = same && Rx_Span->Data == &UART3_Manage_Object->Rx_Buffer[Expect_Start] && Rx_Span->Length == expect_length;
+    same = same && Rx_Span->Wrap_Data == UART3_Manage_Object->Rx_Buffer && Rx_Span->Wrap_Length == UART_RX_CHECK_FRAME_LENGTH - expect_length;
+    same = same && UART_Rx_Span_Get_Length(Rx_Span) == UART_RX_CHECK_FRAME_LENGTH;
+
+    // 内容: 逐字节读取与线性化两种方式都与送入的帧一致
+    if (same)
+    {
+        Make_Frame(Expect_Sequence, expect);
+        same = memcmp(UART_Rx_Span_Linearize(Rx_Span, buffer), expect, UART_RX_CHECK_FRAME_LENGTH) == 0;
+        for (uint8_t i = 0; i < UART_RX_CHECK_FRAME_LENGTH; i++)
+        {
+            same = same && UART_Rx_Span_Get_Byte(Rx_Span, i) == expect[i];
+        }
+    }
+
+    Frame_Mismatch += same ? 0 : 1;
+    Wrap_Num += Rx_Span->Wrap_Length > 0 ? 1 : 0;
+    Expect_Start = (Expect_Start + UART_RX_CHECK_FRAME_LENGTH) % buffer_size;
+
+    // 处理完本帧后再送入数据, 此时接收中断正在执行, DMA照常写入, 新数据在回调返回后交付
+    if (Expect_Sequence++ == Inject_Sequence)
+    {
+        Send_Frame(Inject_Num);
+    }
+}
+
+/**
+ * @brief 逐帧发送, 每帧之后空闲
+ *
+ * @return uint32_t 不一致的次数
+ */
+static uint32_t Check_Single()
+{
+    uint32_t frame_start = UART3_Manage_Object->Rx_Frame_Num;
+    uint32_t mismatch_start = Frame_Mismatch;
+    uint32_t wrap_start = Wrap_Num;
+    uint32_t wrap_expect = 0;
+    uint32_t mismatch = 0;
+
+    // 起点在缓冲区末尾18字节以内(不含恰好对齐末尾)的帧跨过末尾
+    for (uint32_t i = 0, start = Expect_Start; i < 1000; i++, start = (start + UART_RX_CHECK_FRAME_LENGTH) % 128)
+    {
+        wrap_expect += start + UART_RX_CHECK_FRAME_LENGTH > 128 ? 1 : 0;
+    }
+
+    for (uint32_t i = 0; i < 1000; i++)
+    {
+        mismatch += Send_Frame(1) ? 0 : 1;
+        mismatch += Expect_Sequence != Send_Sequence ? 1 : 0;
+    }
+    mismatch += UART3_Manage_Object->Rx_Frame_Num - frame_start != 1000 ? 1 : 0;
+    mismatch += Frame_Mismatch - mismatch_start;
+    mismatch += Wrap_Num - wrap_start != wrap_expect || wrap_expect == 0 ? 1 : 0;
+    printf("  %u frames, %u wrapped\n", (unsigned) (UART3_Manage_Object->Rx_Frame_Num - frame_start), (unsigned) (Wrap_Num - wrap_start));
+    return (mismatch);
+}
+
+/**
+ * @brief 多帧首尾相接一次送入, 帧间没有空闲
+ *
+ * @return uint32_t 不一致的次数
+ */
+static uint32_t Check_Burst()
+{
+    uint32_t frame_start = UART3_Manage_Object->Rx_Frame_Num;
+    uint32_t mismatch_start = Frame_Mismatch;
+    uint32_t frame_num = 0;
+    uint32_t mismatch = 0;
+
+    for (uint32_t i = 0; i < 200; i++)
+    {
+        // 1至16帧, 长的超过整个缓冲区
+        uint8_t num = 1 + (i * 7) % 16;
+        mismatch += Send_Frame(num) ? 0 : 1;
+        mismatch += Expect_Sequence != Send_Sequence ? 1 : 0;
+        frame_num += num;
+    }
+    mismatch += UART3_Manage_Object->Rx_Frame_Num - frame_start != frame_num ? 1 : 0;
+    mismatch += Frame_Mismatch - mismatch_start;
+    printf("  %u frames in 200 bursts\n", (unsigned) frame_num);
+    return (mismatch);
+}
+
+/**
+ * @brief 回调处理期间DMA继续写入: 未写到当前帧时不计覆盖, 写到当前帧时计一次覆盖, 之后的帧照常交付
+ *
+ * @return uint32_t 不一致的次数
+ */
+static uint32_t Check_Slow_Call_Back()
+{
+    uint32_t overwrite_start = UART3_Manage_Object->Rx_Overwrite_Num;
+    uint32_t mismatch_start = Frame_Mismatch;
+    uint32_t mismatch = 0;
+
+    // 6帧108字节, 加上当前帧共126字节, 不超过缓冲区
+    Inject_Sequence = Send_Sequence;
+    Inject_Num = 6;
+    mismatch += Send_Frame(1) ? 0 : 1;
+    mismatch += Expect_Sequence != Send_Sequence ? 1 : 0;
+    mismatch += UART3_Manage_Object->Rx_Overwrite_Num != overwrite_start ? 1 : 0;
+
+    // 7帧126字节, 加上当前帧共144字节, 当前帧开头被覆盖; 新送入的7帧互不重叠, 内容完整
+    Inject_Sequence = Send_Sequence;
+    Inject_Num = 7;
+    mismatch += Send_Frame(1) ? 0 : 1;
+    mismatch += Expect_Sequence != Send_Sequence ? 1 : 0;
+    mismatch += UART3_Manage_Object->Rx_Overwrite_Num != overwrite_start + 1 ? 1 : 0;
+
+    Inject_Sequence = 0xffffffff;
+    for (uint32_t i = 0; i < 50; i++)
+    {
+        mismatch += Send_Frame(1) ? 0 : 1;
+    }
+    mismatch += Expect_Sequence != Send_Sequence ? 1 : 0;
+    mismatch += UART3_Manage_Object->Rx_Overwrite_Num != overwrite_start + 1 ? 1 : 0;
+    mismatch += Frame_Mismatch - mismatch_start;
+    return (mismatch);
+}
+
+/**
+ * @brief 半帧时出现接收错误: 未交付的半帧丢弃, 重新开启后从缓冲区起始处接收, 之后的帧照常交付
+ *
+ * @return uint32_t 不一致的次数
+ */
+static uint32_t Check_Error_Restart()
+{
+    uint32_t error_start = UART3_Manage_Object->Rx_Error_Num;
+    uint32_t frame_start = UART3_Manage_Object->Rx_Frame_Num;
+    uint32_t mismatch_start = Frame_Mismatch;
+    uint32_t mismatch = 0;
+    uint8_t frame[UART_RX_CHECK_FRAME_LENGTH];
+
+    // 关中断期间DMA写入半帧, 接收中断挂起; 随后溢出错误停止DMA, 错误回调重新开启接收
+    Make_Frame(0xffff, frame);
+    __disable_irq();
+    mismatch += Sim_UART_Receive(&huart3, frame, UART_RX_CHECK_FRAME_LENGTH / 2) ? 0 : 1;
+    Sim_UART_Error(&huart3);
+    __enable_irq();
+
+    mismatch += UART3_Manage_Object->Rx_Error_Num != error_start + 1 ? 1 : 0;
+    mismatch += UART3_Manage_Object->Rx_Frame_Num != frame_start ? 1 : 0;
+    mismatch += UART3_Manage_Object->Rx_Frame_Length != 0 || UART3_Manage_Object->Rx_Frame_Start != 0 ? 1 : 0;
+
+    Expect_Start = 0;
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        mismatch += Send_Frame(1) ? 0 : 1;
+    }
+    mismatch += Expect_Sequence != Send_Sequence ? 1 : 0;
+    mismatch += UART3_Manage_Object->Rx_Frame_Num - frame_start != 100 ? 1 : 0;
+    mismatch += UART3_Manage_Object->Rx_Error_Num != error_start + 1 ? 1 : 0;
+    mismatch += Frame_Mismatch - mismatch_start;
+    return (mismatch);
+}
+
+/**
+ * @brief 主函数
+ *
+ * @return int 全部通过返回0
+ */
+int main()
+{
+    Sim_HAL_Reset();
+    UART_Init(&huart3, UART3_Rx_Call_Back, UART_RX_CHECK_FRAME_LENGTH);
+    UART3_Manage_Object = UART_Get_Manage_Object(&huart3);
+    if (UART3_Manage_Object == NULL || UART3_Manage_Object->Rx_Buffer_Size != 128)
+    {
+        printf("FAIL, USART3 not initialized with a 128-byte ring\n");
+        return (1);
+    }
+
+    Report(Check_Single(), "1000 single frames");
+    Report(Check_Burst(), "back-to-back bursts");
+    Report(Check_Slow_Call_Back(), "slow callback overwrite");
+    Report(Check_Error_Restart(), "error restart");
+    Report(UART3_Manage_Object->Rx_Overwrite_Num != 1 ? 1 : 0, "Rx_Overwrite_Num total");
+    Report(UART3_Manage_Object->Rx_Error_Num != 1 ? 1 : 0, "Rx_Error_Num total");
+
+    printf("%s, %u failed\n", Fail_Num == 0 ? "PASS" : "FAIL", (unsigned) Fail_Num);
+    return (Fail_Num == 0 ? 0 : 1);
+}
+
+/*****************************************************************************/
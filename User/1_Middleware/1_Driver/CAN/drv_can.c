@@ -10,11 +10,38 @@
 /* Includes ------------------------------------------------------------------*/
 
 #include "drv_can.h"
+#include <string.h>
 
 /* Private macros ------------------------------------------------------------*/
 
+// 每微秒的CPU周期数
+#define CAN_CYCLE_PER_US (DWT_CPU_FREQUENCY / 1000000U)
+
+// 过滤器规划时每一级合并最多保留的ID组数
+#define CAN_FILTER_CUBE_NUM 64
+
 /* Private types -------------------------------------------------------------*/
 
+/**
+ * @brief 接收注册表中的一项
+ *
+ */
+typedef struct
+{
+    CAN_Rx_Handler Handler;
+    void *Object;
+} Struct_CAN_Registry_Entry;
+
+/**
+ * @brief 过滤器规划中的一组ID, 即Dont_Care位任取、其余位等于Value的全部ID
+ *
+ */
+typedef struct
+{
+    uint16_t Value;
+    uint16_t Dont_Care;
+} Struct_CAN_Filter_Cube;
+
 /* Private variables ---------------------------------------------------------*/
 
 Struct_CAN_Manage_Object CAN1_Manage_Object = {0};
@@ -33,8 +60,74 @@ uint8_t CAN2_0x2ff_Tx_Data[8];//GM6020(电压控制)
 uint8_t CAN2_0x1fe_Tx_Data[8];//GM6020(电流控制)
 uint8_t CAN2_0x2fe_Tx_Data[8];//GM6020(电流控制)
 
+// 定时发送的控制报文ID, 与Tx_Frame下标对应, 按ID从小到大即优先级从高到低排列
+static const uint16_t CAN_Tx_Frame_ID[CAN_TX_FRAME_NUM] = {0x1fe, 0x1ff, 0x200, 0x2fe, 0x2ff};
+// 两路CAN各控制报文的发送缓冲区
+static uint8_t *const CAN_Tx_Frame_Data[2][CAN_TX_FRAME_NUM] = {
+    {CAN1_0x1fe_Tx_Data, CAN1_0x1ff_Tx_Data, CAN1_0x200_Tx_Data, CAN1_0x2fe_Tx_Data, CAN1_0x2ff_Tx_Data},
+    {CAN2_0x1fe_Tx_Data, CAN2_0x1ff_Tx_Data, CAN2_0x200_Tx_Data, CAN2_0x2fe_Tx_Data, CAN2_0x2ff_Tx_Data},
+};
+
+// 接收注册表, Handler为NULL的项空闲
+static Struct_CAN_Registry_Entry CAN_Registry[CAN_REGISTRY_NUM];
+// 各登记项的报文到达间隔统计, 与注册表下标对应
+static Struct_CAN_Rx_Jitter CAN_Rx_Jitter[CAN_REGISTRY_NUM];
+// 到达间隔直方图前CAN_RX_JITTER_BIN_NUM - 1格的上界, us, 最后一格收纳所有更长的间隔, 大疆电机反馈周期为1ms
+static const uint32_t CAN_Rx_Jitter_Bin_Edge_Us[CAN_RX_JITTER_BIN_NUM - 1] = {250, 500, 750, 900, 950, 1050, 1100, 1250, 1500, 2000, 3000};
+// 每路CAN的StdId到注册表下标+1的索引, 0表示未登记, 分发时一次查表
+static uint8_t CAN_Registry_Index[2][0x800];
+// 登记失败次数
+static uint16_t CAN_Registry_Error_Num = 0;
+// CAN_Rx_Dispatch正在处理的报文的到达时刻, us
+static uint32_t CAN_Rx_Timestamp_Us = 0;
+
+// 接收记录器环形缓冲区, 由接收中断写入, 由CAN_Recorder_Drain读出
+static Struct_CAN_Recorder_Record CAN_Recorder_Buffer[CAN_RECORDER_RECORD_NUM];
+// 写指针, 仅接收中断修改
+static volatile uint16_t CAN_Recorder_Head = 0;
+// 读指针, 仅CAN_Recorder_Drain修改
+static volatile uint16_t CAN_Recorder_Tail = 0;
+// 记录器使能
+static volatile bool CAN_Recorder_Enable = false;
+// 缓冲区满而丢弃的记录数
+static volatile uint32_t CAN_Recorder_Lost_Num = 0;
+// 下一次导出时需要先写文件头
+static bool CAN_Recorder_Header_Pending = false;
+// 开始记录时的微秒时钟, 记录中的时间戳从0开始
+static uint32_t CAN_Recorder_Start_Us = 0;
+
 /* Private function declarations ---------------------------------------------*/
 
+static Struct_CAN_Manage_Object *CAN_Get_Manage_Object(CAN_HandleTypeDef *hcan);
+
+static int8_t CAN_Get_Bus_Index(CAN_HandleTypeDef *hcan);
+
+static uint8_t CAN_Filter_Cube_Count(const Struct_CAN_Filter_Cube *Cube, const uint16_t *ID, uint8_t ID_Num, uint32_t Covered);
+
+static void CAN_Filter_Bank_Config(CAN_HandleTypeDef *hcan, const Struct_CAN_Filter_Bank *Bank, uint8_t Activation);
+
+static inline uint32_t CAN_Get_Rx_Fifo_Fill_Level(CAN_HandleTypeDef *hcan, uint32_t Rx_Fifo);
+
+static inline void CAN_Get_Rx_Message(CAN_HandleTypeDef *hcan, uint32_t Rx_Fifo, Struct_CAN_Rx_Buffer *Rx_Buffer);
+
+static inline uint32_t CAN_Get_Tx_Mailbox_Free_Level(CAN_HandleTypeDef *hcan);
+
+static uint32_t CAN_Get_Frame_Bit_Num(uint32_t DLC);
+
+static void CAN_Statistic_Update(CAN_HandleTypeDef *hcan);
+
+static void CAN_Statistic_Rx(CAN_HandleTypeDef *hcan, Struct_CAN_Rx_Buffer *Rx_Buffer);
+
+static void CAN_Bus_Off_Recover(CAN_HandleTypeDef *hcan);
+
+static void CAN_Tx_Schedule(CAN_HandleTypeDef *hcan);
+
+static void CAN_Tx_Refill(CAN_HandleTypeDef *hcan);
+
+static void CAN_Rx_Fifo_Process(CAN_HandleTypeDef *hcan, uint32_t Rx_Fifo);
+
+static void CAN_Recorder_Push(CAN_HandleTypeDef *hcan, Struct_CAN_Rx_Buffer *Rx_Buffer);
+
 /* function prototypes -------------------------------------------------------*/
 
 /**
@@ -45,9 +138,37 @@ uint8_t CAN2_0x2fe_Tx_Data[8];//GM6020(电流控制)
  */
 void CAN_Init(CAN_HandleTypeDef *hcan, CAN_Call_Back Callback_Function)
 {
+    Struct_CAN_Manage_Object *obj = CAN_Get_Manage_Object(hcan);
+    if (obj != NULL)
+    {
+        // 清空接收队列, 此时接收中断尚未使能
+        obj->Rx_Queue.Head = 0;
+        obj->Rx_Queue.Tail = 0;
+        obj->Rx_Queue.Overflow_Num = 0;
+        obj->Rx_Queue.High_Water = 0;
+
+        // 清空发送队列与统计, 已登记的报文保持登记
+        for (int i = 0; i < CAN_TX_FRAME_NUM; i++)
+        {
+            bool registered = obj->Tx_Frame[i].Registered;
+            memset(&obj->Tx_Frame[i], 0, sizeof(Struct_CAN_Tx_Frame));
+            obj->Tx_Frame[i].Registered = registered;
+        }
+
+        // 清空总线统计, 按CubeMX配置计算波特率用于估算利用率
+        memset(&obj->Statistic, 0, sizeof(Struct_CAN_Statistic));
+        uint32_t time_quanta = 1 + ((hcan->Init.TimeSeg1 >> CAN_BTR_TS1_Pos) + 1) + ((hcan->Init.TimeSeg2 >> CAN_BTR_TS2_Pos) + 1);
+        if (hcan->Init.Prescaler != 0)
+        {
+            obj->Statistic.Bit_Rate = HAL_RCC_GetPCLK1Freq() / (hcan->Init.Prescaler * time_quanta);
+        }
+    }
+
     HAL_CAN_Start(hcan);
     __HAL_CAN_ENABLE_IT(hcan, CAN_IT_RX_FIFO0_MSG_PENDING);//使能hcan的FIFO0接收中断
     __HAL_CAN_ENABLE_IT(hcan, CAN_IT_RX_FIFO1_MSG_PENDING);//使能hcan的FIFO1接收中断
+    __HAL_CAN_ENABLE_IT(hcan, CAN_IT_TX_MAILBOX_EMPTY);//使能hcan的发送邮箱空中断, 用于补发排队的报文
+    __HAL_CAN_ENABLE_IT(hcan, CAN_IT_ERROR_WARNING | CAN_IT_ERROR_PASSIVE | CAN_IT_BUSOFF | CAN_IT_ERROR);//使能hcan的错误状态变化中断, 不使能逐帧的错误码中断以免断线时中断风暴
 
     if (hcan->Instance == CAN1)
     {
@@ -129,12 +250,34 @@ void CAN_Filter_Mask_Config(CAN_HandleTypeDef *hcan, uint8_t Object_Para, uint32
  */
 uint8_t CAN_Send_Data(CAN_HandleTypeDef *hcan, uint16_t ID, uint8_t *Data, uint16_t Length)
 {
-    CAN_TxHeaderTypeDef tx_header;
-    uint32_t used_mailbox;
-
     //检测传参是否正确
     assert_param(hcan != NULL);
 
+#if CAN_FAST_PATH
+    uint32_t tsr = hcan->Instance->TSR;
+
+    if (!(tsr & (CAN_TSR_TME0 | CAN_TSR_TME1 | CAN_TSR_TME2)))
+    {
+        hcan->ErrorCode |= HAL_CAN_ERROR_PARAM;
+        return (HAL_ERROR);
+    }
+
+    // CODE为下一个空邮箱, 数据写完后最后写TIR置位TXRQ请求发送
+    CAN_TxMailBox_TypeDef *tx_mailbox = &hcan->Instance->sTxMailBox[(tsr & CAN_TSR_CODE) >> CAN_TSR_CODE_Pos];
+    uint32_t tdlr, tdhr;
+
+    memcpy(&tdlr, &Data[0], 4);
+    memcpy(&tdhr, &Data[4], 4);
+    tx_mailbox->TDTR = Length;
+    tx_mailbox->TDLR = tdlr;
+    tx_mailbox->TDHR = tdhr;
+    tx_mailbox->TIR = ((uint32_t) ID << CAN_TI0R_STID_Pos) | CAN_TI0R_TXRQ;
+
+    return (HAL_OK);
+#else
+    CAN_TxHeaderTypeDef tx_header;
+    uint32_t used_mailbox;
+
     tx_header.StdId = ID;
     tx_header.ExtId = 0;
     tx_header.IDE = 0;
@@ -142,79 +285,1277 @@ uint8_t CAN_Send_Data(CAN_HandleTypeDef *hcan, uint16_t ID, uint8_t *Data, uint1
     tx_header.DLC = Length;
 
     return (HAL_CAN_AddTxMessage(hcan, &tx_header, Data, &used_mailbox));
+#endif
 }
 
 /**
- * @brief CAN的TIM定时器中断发送回调函数
+ * @brief CAN的TIM定时器中断发送回调函数, 发送两路CAN上所有登记过的控制报文
  *
  */
 void TIM_CAN_PeriodElapsedCallback()
 {
-    // CAN1电机
-//    CAN_Send_Data(&hcan1, 0x1ff, CAN1_0x1ff_Tx_Data, 8);
-    CAN_Send_Data(&hcan1, 0x200, CAN1_0x200_Tx_Data, 8);
-//     CAN_Send_Data(&hcan1, 0x2ff, CAN1_0x2ff_Tx_Data, 8);
-     CAN_Send_Data(&hcan1, 0x1fe, CAN1_0x1fe_Tx_Data, 8);//GM6020(电流控制)
-//     CAN_Send_Data(&hcan1, 0x2fe, CAN1_0x2fe_Tx_Data, 8);//GM6020(电流控制)
+    CAN_Tx_Schedule(&hcan1);
+    CAN_Tx_Schedule(&hcan2);
+}
+
+/**
+ * @brief 登记发送缓冲区, 其所属的控制报文此后由TIM_CAN_PeriodElapsedCallback定时发送, 在初始化阶段调用
+ *
+ * @param hcan CAN编号
+ * @param Tx_Data 发送缓冲区或其中任一字节的地址
+ */
+void CAN_Register_Tx_Data(CAN_HandleTypeDef *hcan, uint8_t *Tx_Data)
+{
+    Struct_CAN_Manage_Object *obj = CAN_Get_Manage_Object(hcan);
+    int8_t bus = CAN_Get_Bus_Index(hcan);
+
+    if (obj == NULL || bus < 0 || Tx_Data == NULL)
+    {
+        return;
+    }
 
-    // CAN2电机
-//     CAN_Send_Data(&hcan2, 0x1ff, CAN2_0x1ff_Tx_Data, 8);
-     CAN_Send_Data(&hcan2, 0x200, CAN2_0x200_Tx_Data, 8);
-//     CAN_Send_Data(&hcan2, 0x2ff, CAN2_0x2ff_Tx_Data, 8);
-//     CAN_Send_Data(&hcan2, 0x1fe, CAN2_0x1fe_Tx_Data, 8);//GM6020(电流控制)
-//     CAN_Send_Data(&hcan2, 0x2fe, CAN2_0x2fe_Tx_Data, 8);//GM6020(电流控制)
+    for (int i = 0; i < CAN_TX_FRAME_NUM; i++)
+    {
+        if (Tx_Data >= CAN_Tx_Frame_Data[bus][i] && Tx_Data < CAN_Tx_Frame_Data[bus][i] + 8)
+        {
+            obj->Tx_Frame[i].Registered = true;
+            return;
+        }
+    }
 }
 
 /**
- * @brief HAL库CAN接收FIFO0中断
+ * @brief 获取定时发送的控制报文的调度状态与统计
  *
  * @param hcan CAN编号
+ * @param StdId 控制报文ID
+ * @return const Struct_CAN_Tx_Frame* 调度状态与统计, 不是定时发送的报文返回NULL
  */
-void HAL_CAN_RxFifo0MsgPendingCallback(CAN_HandleTypeDef *hcan)
+const Struct_CAN_Tx_Frame *CAN_Get_Tx_Frame(CAN_HandleTypeDef *hcan, uint16_t StdId)
 {
-    Struct_CAN_Manage_Object *obj = NULL;
+    Struct_CAN_Manage_Object *obj = CAN_Get_Manage_Object(hcan);
 
-    if (hcan->Instance == CAN1) obj = &CAN1_Manage_Object;
-    else if (hcan->Instance == CAN2) obj = &CAN2_Manage_Object;
-    else return;
+    if (obj == NULL)
+    {
+        return (NULL);
+    }
 
-    // 关键：无论 init_finished 是否完成，都要把 FIFO 读走，否则会中断风暴
-    while (HAL_CAN_GetRxFifoFillLevel(hcan, CAN_RX_FIFO0) > 0)
+    for (int i = 0; i < CAN_TX_FRAME_NUM; i++)
     {
-        HAL_CAN_GetRxMessage(hcan, CAN_RX_FIFO0,
-                             &obj->Rx_Buffer.Header,
-                             obj->Rx_Buffer.Data);
+        if (CAN_Tx_Frame_ID[i] == StdId)
+        {
+            return (&obj->Tx_Frame[i]);
+        }
+    }
+    return (NULL);
+}
 
-        // 初始化没完成：丢弃消息
-        if (!init_finished) continue;
+/**
+ * @brief CAN总线统计的定时回调函数, 每CAN_STATISTIC_PERIOD_MS调用一次
+ *
+ */
+void TIM_100ms_CAN_Statistic_PeriodElapsedCallback()
+{
+    CAN_Statistic_Update(&hcan1);
+    CAN_Statistic_Update(&hcan2);
+}
+
+/**
+ * @brief 清空两路CAN的总线统计与到达间隔统计, 波特率与离线状态保留
+ *
+ */
+void CAN_Statistic_Reset()
+{
+    Struct_CAN_Manage_Object *obj[2] = {&CAN1_Manage_Object, &CAN2_Manage_Object};
+
+    for (int i = 0; i < 2; i++)
+    {
+        Struct_CAN_Statistic *statistic = &obj[i]->Statistic;
+        uint32_t bit_rate = statistic->Bit_Rate;
+        bool bus_off = statistic->Bus_Off;
+
+        memset(statistic, 0, sizeof(Struct_CAN_Statistic));
+        statistic->Bit_Rate = bit_rate;
+        statistic->Bus_Off = bus_off;
+    }
+
+    for (int i = 0; i < CAN_REGISTRY_NUM; i++)
+    {
+        Struct_CAN_Rx_Jitter *jitter = &CAN_Rx_Jitter[i];
+        uint8_t bus = jitter->Bus;
+        uint16_t std_id = jitter->StdId;
 
-        // 初始化完成：才交给上层
-        if (obj->Callback_Function) obj->Callback_Function(&obj->Rx_Buffer);
+        memset(jitter, 0, sizeof(Struct_CAN_Rx_Jitter));
+        jitter->Bus = bus;
+        jitter->StdId = std_id;
     }
 }
 
 /**
- * @brief HAL库CAN接收FIFO1中断
+ * @brief 获取总线统计
  *
  * @param hcan CAN编号
+ * @return const Struct_CAN_Statistic* 总线统计, 未知的CAN返回NULL
  */
-void HAL_CAN_RxFifo1MsgPendingCallback(CAN_HandleTypeDef *hcan)
+const Struct_CAN_Statistic *CAN_Get_Statistic(CAN_HandleTypeDef *hcan)
 {
-    Struct_CAN_Manage_Object *obj = NULL;
+    Struct_CAN_Manage_Object *obj = CAN_Get_Manage_Object(hcan);
+    return (obj != NULL ? &obj->Statistic : NULL);
+}
 
-    if (hcan->Instance == CAN1) obj = &CAN1_Manage_Object;
-    else if (hcan->Instance == CAN2) obj = &CAN2_Manage_Object;
-    else return;
+/**
+ * @brief 获取登记ID的报文到达间隔统计
+ *
+ * @param hcan CAN编号
+ * @param StdId 标准帧ID
+ * @return const Struct_CAN_Rx_Jitter* 到达间隔统计, 未登记的ID返回NULL
+ */
+const Struct_CAN_Rx_Jitter *CAN_Get_Rx_Jitter(CAN_HandleTypeDef *hcan, uint16_t StdId)
+{
+    int8_t bus = CAN_Get_Bus_Index(hcan);
 
-    while (HAL_CAN_GetRxFifoFillLevel(hcan, CAN_RX_FIFO1) > 0)
+    if (bus < 0 || StdId > 0x7ff || CAN_Registry_Index[bus][StdId] == 0)
     {
-        HAL_CAN_GetRxMessage(hcan, CAN_RX_FIFO1,
-                             &obj->Rx_Buffer.Header,
-                             obj->Rx_Buffer.Data);
+        return (NULL);
+    }
+    return (&CAN_Rx_Jitter[CAN_Registry_Index[bus][StdId] - 1]);
+}
 
-        if (!init_finished) continue;
-        if (obj->Callback_Function) obj->Callback_Function(&obj->Rx_Buffer);
+/**
+ * @brief 导出一路CAN的总线统计, 依次为接收帧/s, 发送帧/s, 利用率%, TEC, REC, 最近错误码,
+ *        错误警告次数, 错误被动次数, 离线次数, 离线恢复次数, 发送错误次数, 接收队列溢出数, 发送丢弃数,
+ *        每帧读出周期数, 每帧写入周期数
+ *
+ * @param hcan CAN编号
+ * @param Buffer 输出缓冲区
+ * @param Buffer_Length 缓冲区长度
+ * @return uint8_t 写入的数据个数, 缓冲区不足时为0
+ */
+uint8_t CAN_Statistic_Export_Summary(CAN_HandleTypeDef *hcan, float *Buffer, uint8_t Buffer_Length)
+{
+    Struct_CAN_Manage_Object *obj = CAN_Get_Manage_Object(hcan);
+    uint8_t length = 0;
+
+    if (obj == NULL || Buffer_Length < 15)
+    {
+        return (0);
+    }
+
+    const Struct_CAN_Statistic *statistic = &obj->Statistic;
+    uint32_t drop_num = 0;
+    for (int i = 0; i < CAN_TX_FRAME_NUM; i++)
+    {
+        drop_num += obj->Tx_Frame[i].Drop_Num;
+    }
+
+    Buffer[length++] = statistic->Rx_Frame_Per_Second;
+    Buffer[length++] = statistic->Tx_Frame_Per_Second;
+    Buffer[length++] = statistic->Utilization * 100.0f;
+    Buffer[length++] = (float) statistic->Tx_Error_Counter;
+    Buffer[length++] = (float) statistic->Rx_Error_Counter;
+    Buffer[length++] = (float) statistic->Last_Error_Code;
+    Buffer[length++] = (float) statistic->Error_Warning_Num;
+    Buffer[length++] = (float) statistic->Error_Passive_Num;
+    Buffer[length++] = (float) statistic->Bus_Off_Num;
+    Buffer[length++] = (float) statistic->Bus_Off_Recovery_Num;
+    Buffer[length++] = (float) statistic->Tx_Error_Num;
+    Buffer[length++] = (float) obj->Rx_Queue.Overflow_Num;
+    Buffer[length++] = (float) drop_num;
+    Buffer[length++] = statistic->Rx_Read_Cycle_Per_Frame;
+    Buffer[length++] = statistic->Tx_Write_Cycle_Per_Frame;
+
+    return (length);
+}
+
+/**
+ * @brief 导出注册表第Index项的报文到达间隔统计, 依次为CAN编号(1或2), StdId, 各格计数, 最小间隔us, 平均间隔us, 最大间隔us
+ *
+ * @param Index 注册表下标, 按登记顺序
+ * @param Buffer 输出缓冲区
+ * @param Buffer_Length 缓冲区长度
+ * @return uint8_t 写入的数据个数, 该项未登记时为0
+ */
+uint8_t CAN_Statistic_Export_Jitter(uint8_t Index, float *Buffer, uint8_t Buffer_Length)
+{
+    uint8_t length = 0;
+
+    if (Index >= CAN_REGISTRY_NUM || CAN_Registry[Index].Handler == NULL || Buffer_Length < 2)
+    {
+        return (0);
+    }
+
+    const Struct_CAN_Rx_Jitter *jitter = &CAN_Rx_Jitter[Index];
+    uint32_t interval_num = jitter->Frame_Num > 1 ? jitter->Frame_Num - 1 : 0;
+
+    Buffer[length++] = (float) (jitter->Bus + 1);
+    Buffer[length++] = (float) jitter->StdId;
+    for (uint8_t i = 0; i < CAN_RX_JITTER_BIN_NUM && length < Buffer_Length; i++)
+    {
+        Buffer[length++] = (float) jitter->Histogram[i];
+    }
+    if (length + 3 <= Buffer_Length)
+    {
+        Buffer[length++] = (float) jitter->Min_Cycle / CAN_CYCLE_PER_US;
+        Buffer[length++] = interval_num > 0 ? (float) jitter->Sum_Cycle / interval_num / CAN_CYCLE_PER_US : 0.0f;
+        Buffer[length++] = (float) jitter->Max_Cycle / CAN_CYCLE_PER_US;
+    }
+
+    return (length);
+}
+
+/**
+ * @brief 登记报文ID的接收处理函数, 在初始化阶段调用
+ *
+ * @note 同一设备重复登记视为重新初始化; 已被其他设备登记的ID不会被覆盖, 并计入登记失败次数
+ *
+ * @param hcan CAN编号
+ * @param StdId 标准帧ID
+ * @param Handler 处理函数
+ * @param Object 设备对象, 调用Handler时原样传回
+ * @return Enum_CAN_Register_Status 登记结果
+ */
+Enum_CAN_Register_Status CAN_Register_Rx_Handler(CAN_HandleTypeDef *hcan, uint16_t StdId, CAN_Rx_Handler Handler, void *Object)
+{
+    int8_t bus = CAN_Get_Bus_Index(hcan);
+    if (bus < 0 || StdId > 0x7ff || Handler == NULL)
+    {
+        CAN_Registry_Error_Num++;
+        return (CAN_Register_Status_INVALID);
+    }
+
+    uint8_t index = CAN_Registry_Index[bus][StdId];
+    if (index != 0)
+    {
+        Struct_CAN_Registry_Entry *entry = &CAN_Registry[index - 1];
+        if (entry->Object != Object)
+        {
+            CAN_Registry_Error_Num++;
+            return (CAN_Register_Status_DUPLICATE);
+        }
+        entry->Handler = Handler;
+        return (CAN_Register_Status_OK);
+    }
+
+    for (uint8_t i = 0; i < CAN_REGISTRY_NUM; i++)
+    {
+        if (CAN_Registry[i].Handler == NULL)
+        {
+            CAN_Registry[i].Handler = Handler;
+            CAN_Registry[i].Object = Object;
+            memset(&CAN_Rx_Jitter[i], 0, sizeof(Struct_CAN_Rx_Jitter));
+            CAN_Rx_Jitter[i].Bus = bus;
+            CAN_Rx_Jitter[i].StdId = StdId;
+            CAN_Registry_Index[bus][StdId] = i + 1;
+            return (CAN_Register_Status_OK);
+        }
+    }
+
+    CAN_Registry_Error_Num++;
+    return (CAN_Register_Status_FULL);
+}
+
+/**
+ * @brief 注销报文ID的接收处理函数, 之后该ID的报文交给CAN_Init中的回调函数
+ *
+ * @param hcan CAN编号
+ * @param StdId 标准帧ID
+ */
+void CAN_Unregister_Rx_Handler(CAN_HandleTypeDef *hcan, uint16_t StdId)
+{
+    int8_t bus = CAN_Get_Bus_Index(hcan);
+    if (bus < 0 || StdId > 0x7ff)
+    {
+        return;
+    }
+
+    uint8_t index = CAN_Registry_Index[bus][StdId];
+    if (index != 0)
+    {
+        CAN_Registry_Index[bus][StdId] = 0;
+        CAN_Registry[index - 1].Handler = NULL;
+        CAN_Registry[index - 1].Object = NULL;
+    }
+}
+
+/**
+ * @brief 获取登记失败次数, 非0说明有ID冲突或注册表容量不足
+ *
+ * @return uint16_t 登记失败次数
+ */
+uint16_t CAN_Get_Register_Error_Num()
+{
+    return (CAN_Registry_Error_Num);
+}
+
+/**
+ * @brief 由ID集合规划最少的32位过滤器组, 只接收集合中的ID, 并把各组分配到两个FIFO使中断负载均衡
+ *
+ * @note 先用逐位合并找出完全由集合内ID构成的2^k个ID的组, 能新覆盖3个及以上ID的用掩码模式,
+ *       剩下的ID两个一组用列表模式; 再按各组ID数从大到小依次分给当前负载较小的FIFO.
+ *       只在初始化时调用, 与具体硬件无关, 可在主机上验证
+ *
+ * @param ID 需要接收的标准帧ID, 不可重复
+ * @param ID_Num ID个数, 不超过32
+ * @param First_Bank 可用的第一个过滤器组编号
+ * @param Bank_Num 可用的过滤器组数
+ * @param Bank 输出的过滤器组, 至少Bank_Num个
+ * @return uint8_t 使用的过滤器组数, 组数不够或参数非法时返回CAN_FILTER_PLAN_FAIL
+ */
+uint8_t CAN_Filter_Plan(const uint16_t *ID, uint8_t ID_Num, uint8_t First_Bank, uint8_t Bank_Num, Struct_CAN_Filter_Bank *Bank)
+{
+    static Struct_CAN_Filter_Cube level[2][CAN_FILTER_CUBE_NUM];
+    static Struct_CAN_Filter_Cube candidate[CAN_FILTER_CUBE_NUM];
+    uint8_t level_num[2] = {0, 0};
+    uint8_t candidate_num = 0;
+    uint8_t bank_num = 0;
+    uint32_t covered = 0;
+
+    if (ID_Num > 32)
+    {
+        return (CAN_FILTER_PLAN_FAIL);
+    }
+
+    // 逐位合并, 第k级的每组含2^k个ID, 4个及以上的作为掩码模式的候选
+    for (uint8_t i = 0; i < ID_Num && i < CAN_FILTER_CUBE_NUM; i++)
+    {
+        level[0][i].Value = ID[i] & 0x7ff;
+        level[0][i].Dont_Care = 0;
+        level_num[0]++;
+    }
+    for (uint8_t k = 0; level_num[k & 1] > 1; k++)
+    {
+        Struct_CAN_Filter_Cube *now = level[k & 1];
+        Struct_CAN_Filter_Cube *next = level[(k + 1) & 1];
+        uint8_t now_num = level_num[k & 1];
+        uint8_t next_num = 0;
+
+        for (uint8_t i = 0; i < now_num; i++)
+        {
+            for (uint8_t j = i + 1; j < now_num; j++)
+            {
+                uint16_t diff = now[i].Value ^ now[j].Value;
+                if (now[i].Dont_Care != now[j].Dont_Care || diff == 0 || (diff & (diff - 1)) != 0)
+                {
+                    continue;
+                }
+
+                Struct_CAN_Filter_Cube cube = {(uint16_t) (now[i].Value & ~diff), (uint16_t) (now[i].Dont_Care | diff)};
+                bool exist = false;
+                for (uint8_t n = 0; n < next_num && !exist; n++)
+                {
+                    exist = next[n].Value == cube.Value && next[n].Dont_Care == cube.Dont_Care;
+                }
+                if (exist || next_num >= CAN_FILTER_CUBE_NUM)
+                {
+                    continue;
+                }
+                next[next_num++] = cube;
+                if (k >= 1 && candidate_num < CAN_FILTER_CUBE_NUM)
+                {
+                    candidate[candidate_num++] = cube;
+                }
+            }
+        }
+        level_num[(k + 1) & 1] = next_num;
+    }
+
+    // 贪心选取新覆盖ID最多的掩码组, 新覆盖不足3个时不如用列表模式
+    while (true)
+    {
+        uint8_t best = 0, best_count = 0;
+        for (uint8_t i = 0; i < candidate_num; i++)
+        {
+            uint8_t count = CAN_Filter_Cube_Count(&candidate[i], ID, ID_Num, covered);
+            if (count > best_count)
+            {
+                best = i;
+                best_count = count;
+            }
+        }
+        if (best_count < 3)
+        {
+            break;
+        }
+        if (bank_num >= Bank_Num)
+        {
+            return (CAN_FILTER_PLAN_FAIL);
+        }
+
+        for (uint8_t i = 0; i < ID_Num; i++)
+        {
+            if ((ID[i] & ~candidate[best].Dont_Care) == candidate[best].Value)
+            {
+                covered |= 1UL << i;
+            }
+        }
+        Bank[bank_num].Mode = CAN_FILTERMODE_IDMASK;
+        Bank[bank_num].ID_Num = best_count;
+        Bank[bank_num].ID[0] = candidate[best].Value;
+        Bank[bank_num].ID[1] = ~candidate[best].Dont_Care & 0x7ff;
+        bank_num++;
+    }
+
+    // 剩余ID两个一组, 单独一个时两个位置填同一ID
+    for (uint8_t i = 0; i < ID_Num; i++)
+    {
+        if (covered & (1UL << i))
+        {
+            continue;
+        }
+        covered |= 1UL << i;
+
+        uint8_t pair = i;
+        for (uint8_t j = i + 1; j < ID_Num; j++)
+        {
+            if (!(covered & (1UL << j)))
+            {
+                pair = j;
+                covered |= 1UL << j;
+                break;
+            }
+        }
+        if (bank_num >= Bank_Num)
+        {
+            return (CAN_FILTER_PLAN_FAIL);
+        }
+
+        Bank[bank_num].Mode = CAN_FILTERMODE_IDLIST;
+        Bank[bank_num].ID_Num = pair == i ? 1 : 2;
+        Bank[bank_num].ID[0] = ID[i] & 0x7ff;
+        Bank[bank_num].ID[1] = ID[pair] & 0x7ff;
+        bank_num++;
+    }
+
+    // 按负载从大到小排序后分给负载较小的FIFO
+    for (uint8_t i = 1; i < bank_num; i++)
+    {
+        Struct_CAN_Filter_Bank tmp = Bank[i];
+        uint8_t j = i;
+        for (; j > 0 && Bank[j - 1].ID_Num < tmp.ID_Num; j--)
+        {
+            Bank[j] = Bank[j - 1];
+        }
+        Bank[j] = tmp;
+    }
+    uint8_t fifo_load[2] = {0, 0};
+    for (uint8_t i = 0; i < bank_num; i++)
+    {
+        uint8_t fifo = fifo_load[1] < fifo_load[0] ? 1 : 0;
+        Bank[i].Bank = First_Bank + i;
+        Bank[i].FIFO = fifo == 0 ? CAN_RX_FIFO0 : CAN_RX_FIFO1;
+        fifo_load[fifo] += Bank[i].ID_Num;
+    }
+
+    return (bank_num);
+}
+
+/**
+ * @brief 按两路CAN登记的ID重新配置硬件过滤器, 在所有设备登记完成之后调用
+ *
+ * @note CAN_Init传入了回调函数的总线保留全通过滤器; 规划失败时同样保留全通, 不影响接收
+ *
+ */
+void CAN_Filter_Apply()
+{
+    Struct_CAN_Filter_Bank bank[CAN_FILTER_SLAVE_START_BANK];
+    uint16_t id[CAN_REGISTRY_NUM];
+
+    for (uint8_t bus = 0; bus < 2; bus++)
+    {
+        Struct_CAN_Manage_Object *obj = bus == 0 ? &CAN1_Manage_Object : &CAN2_Manage_Object;
+        uint8_t first_bank = bus == 0 ? 0 : CAN_FILTER_SLAVE_START_BANK;
+        uint8_t bank_limit = bus == 0 ? CAN_FILTER_SLAVE_START_BANK : CAN_FILTER_BANK_NUM - CAN_FILTER_SLAVE_START_BANK;
+
+        if (obj->CAN_Handler == NULL || obj->Callback_Function != NULL)
+        {
+            continue;
+        }
+
+        uint8_t id_num = 0;
+        for (uint16_t std_id = 0; std_id < 0x800 && id_num < CAN_REGISTRY_NUM; std_id++)
+        {
+            if (CAN_Registry_Index[bus][std_id] != 0)
+            {
+                id[id_num++] = std_id;
+            }
+        }
+
+        uint8_t bank_num = CAN_Filter_Plan(id, id_num, first_bank, bank_limit, bank);
+        if (bank_num == CAN_FILTER_PLAN_FAIL)
+        {
+            continue;
+        }
+
+        for (uint8_t i = 0; i < bank_num; i++)
+        {
+            CAN_Filter_Bank_Config(obj->CAN_Handler, &bank[i], ENABLE);
+        }
+        if (bank_num == 0)
+        {
+            // 没有登记任何ID, 关掉CAN_Init配置的全通过滤器
+            Struct_CAN_Filter_Bank empty = {first_bank, CAN_FILTERMODE_IDMASK, CAN_RX_FIFO0, 0, {0, 0}};
+            CAN_Filter_Bank_Config(obj->CAN_Handler, &empty, DISABLE);
+        }
+    }
+}
+
+/**
+ * @brief 取出接收队列中的报文并逐帧处理, 在控制周期中选定的位置调用
+ *
+ * @note 已登记的ID直接查表调用处理函数, 其余报文交给CAN_Init中的回调函数.
+ *       只处理进入时已在队列中的报文, 处理期间新到的报文留到下一次, 单次耗时有界
+ *
+ * @param hcan CAN编号
+ */
+void CAN_Rx_Dispatch(CAN_HandleTypeDef *hcan)
+{
+    Struct_CAN_Manage_Object *obj = CAN_Get_Manage_Object(hcan);
+    if (obj == NULL)
+    {
+        return;
+    }
+
+    Struct_CAN_Rx_Queue *queue = &obj->Rx_Queue;
+    uint8_t *registry_index = CAN_Registry_Index[CAN_Get_Bus_Index(hcan)];
+    uint16_t tail = queue->Tail;
+    uint16_t head = queue->Head;
+
+    while (tail != head)
+    {
+        Struct_CAN_Rx_Buffer *rx_buffer = &queue->Buffer[tail];
+        uint8_t index = rx_buffer->Header.IDE == CAN_ID_STD ? registry_index[rx_buffer->Header.StdId & 0x7ff] : 0;
+
+        CAN_Rx_Timestamp_Us = rx_buffer->Timestamp_Us;
+        if (index != 0)
+        {
+            CAN_Registry[index - 1].Handler(CAN_Registry[index - 1].Object, rx_buffer->Data);
+        }
+        else if (obj->Callback_Function)
+        {
+            obj->Callback_Function(rx_buffer);
+        }
+
+        // 回调处理完再释放, 中断不会覆盖正在处理的报文
+        tail = (tail + 1) & (CAN_RX_QUEUE_NUM - 1);
+        __DMB();
+        queue->Tail = tail;
     }
 }
 
+/**
+ * @brief 获取CAN_Rx_Dispatch正在处理的报文的到达时刻, 在按ID登记的处理函数中调用
+ *
+ * @return uint32_t 接收中断读出该报文时的微秒时钟
+ */
+uint32_t CAN_Get_Rx_Timestamp_Us()
+{
+    return (CAN_Rx_Timestamp_Us);
+}
+
+/**
+ * @brief 获取接收队列满而丢弃的报文数
+ *
+ * @param hcan CAN编号
+ * @return uint32_t 丢弃的报文数
+ */
+uint32_t CAN_Get_Rx_Overflow_Num(CAN_HandleTypeDef *hcan)
+{
+    Struct_CAN_Manage_Object *obj = CAN_Get_Manage_Object(hcan);
+    return (obj != NULL ? obj->Rx_Queue.Overflow_Num : 0);
+}
+
+/**
+ * @brief 获取接收队列中曾同时存放的最多报文数, 用于评估队列深度是否足够
+ *
+ * @param hcan CAN编号
+ * @return uint16_t 最多报文数
+ */
+uint16_t CAN_Get_Rx_High_Water(CAN_HandleTypeDef *hcan)
+{
+    Struct_CAN_Manage_Object *obj = CAN_Get_Manage_Object(hcan);
+    return (obj != NULL ? obj->Rx_Queue.High_Water : 0);
+}
+
+/**
+ * @brief HAL库CAN发送邮箱0完成中断
+ *
+ * @param hcan CAN编号
+ */
+void HAL_CAN_TxMailbox0CompleteCallback(CAN_HandleTypeDef *hcan)
+{
+    CAN_Tx_Refill(hcan);
+}
+
+/**
+ * @brief HAL库CAN发送邮箱1完成中断
+ *
+ * @param hcan CAN编号
+ */
+void HAL_CAN_TxMailbox1CompleteCallback(CAN_HandleTypeDef *hcan)
+{
+    CAN_Tx_Refill(hcan);
+}
+
+/**
+ * @brief HAL库CAN发送邮箱2完成中断
+ *
+ * @param hcan CAN编号
+ */
+void HAL_CAN_TxMailbox2CompleteCallback(CAN_HandleTypeDef *hcan)
+{
+    CAN_Tx_Refill(hcan);
+}
+
+/**
+ * @brief HAL库CAN发送邮箱0中止中断, 邮箱同样被空出
+ *
+ * @param hcan CAN编号
+ */
+void HAL_CAN_TxMailbox0AbortCallback(CAN_HandleTypeDef *hcan)
+{
+    CAN_Tx_Refill(hcan);
+}
+
+/**
+ * @brief HAL库CAN发送邮箱1中止中断, 邮箱同样被空出
+ *
+ * @param hcan CAN编号
+ */
+void HAL_CAN_TxMailbox1AbortCallback(CAN_HandleTypeDef *hcan)
+{
+    CAN_Tx_Refill(hcan);
+}
+
+/**
+ * @brief HAL库CAN发送邮箱2中止中断, 邮箱同样被空出
+ *
+ * @param hcan CAN编号
+ */
+void HAL_CAN_TxMailbox2AbortCallback(CAN_HandleTypeDef *hcan)
+{
+    CAN_Tx_Refill(hcan);
+}
+
+/**
+ * @brief HAL库CAN错误中断, 统计错误状态变化, 发送失败时补发
+ *
+ * @param hcan CAN编号
+ */
+void HAL_CAN_ErrorCallback(CAN_HandleTypeDef *hcan)
+{
+    Struct_CAN_Manage_Object *obj = CAN_Get_Manage_Object(hcan);
+    uint32_t error = HAL_CAN_GetError(hcan);
+
+    HAL_CAN_ResetError(hcan);
+
+    if (obj == NULL)
+    {
+        return;
+    }
+
+    Struct_CAN_Statistic *statistic = &obj->Statistic;
+    if (error & HAL_CAN_ERROR_EWG)
+    {
+        statistic->Error_Warning_Num++;
+    }
+    if (error & HAL_CAN_ERROR_EPV)
+    {
+        statistic->Error_Passive_Num++;
+    }
+    if (error & HAL_CAN_ERROR_BOF)
+    {
+        statistic->Bus_Off_Num++;
+        statistic->Bus_Off = true;
+    }
+
+    // 仲裁丢失或发送错误时HAL库只报错误, 不进入完成或中止回调, 但邮箱同样被空出
+    if (error & (HAL_CAN_ERROR_TX_ALST0 | HAL_CAN_ERROR_TX_TERR0 | HAL_CAN_ERROR_TX_ALST1 | HAL_CAN_ERROR_TX_TERR1 | HAL_CAN_ERROR_TX_ALST2 | HAL_CAN_ERROR_TX_TERR2))
+    {
+        statistic->Tx_Error_Num++;
+        CAN_Tx_Refill(hcan);
+    }
+}
+
+/**
+ * @brief HAL库CAN接收FIFO0中断
+ *
+ * @param hcan CAN编号
+ */
+void HAL_CAN_RxFifo0MsgPendingCallback(CAN_HandleTypeDef *hcan)
+{
+    CAN_Rx_Fifo_Process(hcan, CAN_RX_FIFO0);
+}
+
+/**
+ * @brief HAL库CAN接收FIFO1中断
+ *
+ * @param hcan CAN编号
+ */
+void HAL_CAN_RxFifo1MsgPendingCallback(CAN_HandleTypeDef *hcan)
+{
+    CAN_Rx_Fifo_Process(hcan, CAN_RX_FIFO1);
+}
+
+/**
+ * @brief 开始记录两路CAN接收的标准帧, 清空缓冲区并从0开始计时, 需先调用DWT_Init
+ *
+ */
+void CAN_Recorder_Start()
+{
+    CAN_Recorder_Enable = false;
+
+    CAN_Recorder_Head = 0;
+    CAN_Recorder_Tail = 0;
+    CAN_Recorder_Lost_Num = 0;
+    CAN_Recorder_Header_Pending = true;
+
+    CAN_Recorder_Start_Us = DWT_Get_Us();
+
+    CAN_Recorder_Enable = true;
+}
+
+/**
+ * @brief 停止记录, 缓冲区中剩余的记录仍可导出
+ *
+ */
+void CAN_Recorder_Stop()
+{
+    CAN_Recorder_Enable = false;
+}
+
+/**
+ * @brief 按紧凑二进制格式导出记录, 在前台循环中调用. 开始记录后的第一次导出先写文件头
+ *
+ * @param Buffer 导出缓冲区
+ * @param Length 缓冲区字节数
+ * @return uint16_t 导出的字节数, 只导出完整的记录
+ */
+uint16_t CAN_Recorder_Drain(uint8_t *Buffer, uint16_t Length)
+{
+    uint16_t index = 0;
+
+    if (CAN_Recorder_Header_Pending)
+    {
+        if (Length < CAN_RECORDER_HEADER_SIZE)
+        {
+            return (0);
+        }
+        Buffer[0] = 'C';
+        Buffer[1] = 'A';
+        Buffer[2] = 'N';
+        Buffer[3] = 'R';
+        Buffer[4] = CAN_RECORDER_VERSION;
+        Buffer[5] = CAN_RECORDER_RECORD_SIZE;
+        Buffer[6] = 0;
+        Buffer[7] = 0;
+        index = CAN_RECORDER_HEADER_SIZE;
+        CAN_Recorder_Header_Pending = false;
+    }
+
+    uint16_t tail = CAN_Recorder_Tail;
+    while (tail != CAN_Recorder_Head && index + CAN_RECORDER_RECORD_SIZE <= Length)
+    {
+        Struct_CAN_Recorder_Record *record = &CAN_Recorder_Buffer[tail];
+
+        Buffer[index + 0] = record->Timestamp_Us;
+        Buffer[index + 1] = record->Timestamp_Us >> 8;
+        Buffer[index + 2] = record->Timestamp_Us >> 16;
+        Buffer[index + 3] = record->Timestamp_Us >> 24;
+        Buffer[index + 4] = record->Info;
+        Buffer[index + 5] = record->Info >> 8;
+        memcpy(&Buffer[index + 6], record->Data, 8);
+        index += CAN_RECORDER_RECORD_SIZE;
+
+        tail = (tail + 1) & (CAN_RECORDER_RECORD_NUM - 1);
+    }
+    // 先复制再释放, 中断不会覆盖正在导出的记录
+    CAN_Recorder_Tail = tail;
+
+    return (index);
+}
+
+/**
+ * @brief 获取因缓冲区满而丢弃的记录数
+ *
+ * @return uint32_t 丢弃的记录数
+ */
+uint32_t CAN_Recorder_Get_Lost_Num()
+{
+    return (CAN_Recorder_Lost_Num);
+}
+
+/**
+ * @brief 获取CAN对应的管理对象
+ *
+ * @param hcan CAN编号
+ * @return Struct_CAN_Manage_Object* 管理对象, 未知的CAN返回NULL
+ */
+static Struct_CAN_Manage_Object *CAN_Get_Manage_Object(CAN_HandleTypeDef *hcan)
+{
+    if (hcan->Instance == CAN1) return (&CAN1_Manage_Object);
+    else if (hcan->Instance == CAN2) return (&CAN2_Manage_Object);
+    else return (NULL);
+}
+
+/**
+ * @brief 获取CAN在注册表索引中的编号
+ *
+ * @param hcan CAN编号
+ * @return int8_t CAN1为0, CAN2为1, 未知的CAN返回-1
+ */
+static int8_t CAN_Get_Bus_Index(CAN_HandleTypeDef *hcan)
+{
+    if (hcan->Instance == CAN1) return (0);
+    else if (hcan->Instance == CAN2) return (1);
+    else return (-1);
+}
+
+/**
+ * @brief 获取接收FIFO中的报文数
+ *
+ * @param hcan CAN编号
+ * @param Rx_Fifo CAN_RX_FIFO0或CAN_RX_FIFO1
+ * @return uint32_t 报文数
+ */
+static inline uint32_t CAN_Get_Rx_Fifo_Fill_Level(CAN_HandleTypeDef *hcan, uint32_t Rx_Fifo)
+{
+#if CAN_FAST_PATH
+    return (Rx_Fifo == CAN_RX_FIFO0 ? hcan->Instance->RF0R & CAN_RF0R_FMP0 : hcan->Instance->RF1R & CAN_RF1R_FMP1);
+#else
+    return (HAL_CAN_GetRxFifoFillLevel(hcan, Rx_Fifo));
+#endif
+}
+
+/**
+ * @brief 从接收FIFO的输出邮箱读出一帧并释放, 调用前需确认FIFO非空
+ *
+ * @param hcan CAN编号
+ * @param Rx_Fifo CAN_RX_FIFO0或CAN_RX_FIFO1
+ * @param Rx_Buffer 报文写入的位置
+ */
+static inline void CAN_Get_Rx_Message(CAN_HandleTypeDef *hcan, uint32_t Rx_Fifo, Struct_CAN_Rx_Buffer *Rx_Buffer)
+{
+#if CAN_FAST_PATH
+    CAN_FIFOMailBox_TypeDef *rx_mailbox = &hcan->Instance->sFIFOMailBox[Rx_Fifo];
+    uint32_t rir = rx_mailbox->RIR;
+    uint32_t rdtr = rx_mailbox->RDTR;
+    uint32_t rdlr = rx_mailbox->RDLR;
+    uint32_t rdhr = rx_mailbox->RDHR;
+
+    // 与HAL_CAN_GetRxMessage填写相同的报文头字段
+    Rx_Buffer->Header.IDE = rir & CAN_RI0R_IDE;
+    Rx_Buffer->Header.StdId = (rir & CAN_RI0R_STID) >> CAN_RI0R_STID_Pos;
+    Rx_Buffer->Header.ExtId = (rir & (CAN_RI0R_EXID | CAN_RI0R_STID)) >> CAN_RI0R_EXID_Pos;
+    Rx_Buffer->Header.RTR = rir & CAN_RI0R_RTR;
+    Rx_Buffer->Header.DLC = (rdtr & CAN_RDT0R_DLC) >> CAN_RDT0R_DLC_Pos;
+    Rx_Buffer->Header.FilterMatchIndex = (rdtr & CAN_RDT0R_FMI) >> CAN_RDT0R_FMI_Pos;
+    Rx_Buffer->Header.Timestamp = (rdtr & CAN_RDT0R_TIME) >> CAN_RDT0R_TIME_Pos;
+    memcpy(&Rx_Buffer->Data[0], &rdlr, 4);
+    memcpy(&Rx_Buffer->Data[4], &rdhr, 4);
+
+    if (Rx_Fifo == CAN_RX_FIFO0)
+    {
+        SET_BIT(hcan->Instance->RF0R, CAN_RF0R_RFOM0);
+    }
+    else
+    {
+        SET_BIT(hcan->Instance->RF1R, CAN_RF1R_RFOM1);
+    }
+#else
+    HAL_CAN_GetRxMessage(hcan, Rx_Fifo, &Rx_Buffer->Header, Rx_Buffer->Data);
+#endif
+}
+
+/**
+ * @brief 获取空闲发送邮箱数
+ *
+ * @param hcan CAN编号
+ * @return uint32_t 空闲发送邮箱数
+ */
+static inline uint32_t CAN_Get_Tx_Mailbox_Free_Level(CAN_HandleTypeDef *hcan)
+{
+#if CAN_FAST_PATH
+    uint32_t tsr = hcan->Instance->TSR;
+
+    return (((tsr & CAN_TSR_TME0) != 0) + ((tsr & CAN_TSR_TME1) != 0) + ((tsr & CAN_TSR_TME2) != 0));
+#else
+    return (HAL_CAN_GetTxMailboxesFreeLevel(hcan));
+#endif
+}
+
+/**
+ * @brief 标准数据帧按最坏位填充计算的位数, 含3位帧间隔
+ *
+ * @param DLC 数据长度
+ * @return uint32_t 位数, 8字节时为135
+ */
+static uint32_t CAN_Get_Frame_Bit_Num(uint32_t DLC)
+{
+    uint32_t data_bit = 8 * (DLC > 8 ? 8 : DLC);
+
+    // 参与位填充的34 + 8×DLC位最多每4位插入1位, 其余47位固定
+    return (47 + data_bit + (34 + data_bit - 1) / 4);
+}
+
+/**
+ * @brief 刷新一路CAN的报文速率、利用率和错误计数器, 离线且未开自动恢复时请求恢复
+ *
+ * @param hcan CAN编号
+ */
+static void CAN_Statistic_Update(CAN_HandleTypeDef *hcan)
+{
+    Struct_CAN_Manage_Object *obj = CAN_Get_Manage_Object(hcan);
+
+    if (obj == NULL || obj->CAN_Handler == NULL)
+    {
+        return;
+    }
+
+    Struct_CAN_Statistic *statistic = &obj->Statistic;
+    const float frequency = 1000.0f / CAN_STATISTIC_PERIOD_MS;
+
+    uint32_t rx_frame_num = statistic->Rx_Frame_Num;
+    uint32_t rx_bit_num = statistic->Rx_Bit_Num;
+    uint32_t tx_frame_num = statistic->Tx_Frame_Num;
+    uint32_t tx_bit_num = statistic->Tx_Bit_Num;
+    uint32_t rx_read_cycle = statistic->Rx_Read_Cycle;
+    uint32_t tx_write_cycle = statistic->Tx_Write_Cycle;
+
+    if (rx_frame_num != statistic->Last_Rx_Frame_Num)
+    {
+        statistic->Rx_Read_Cycle_Per_Frame = (float) (rx_read_cycle - statistic->Last_Rx_Read_Cycle) / (float) (rx_frame_num - statistic->Last_Rx_Frame_Num);
+    }
+    if (tx_frame_num != statistic->Last_Tx_Frame_Num)
+    {
+        statistic->Tx_Write_Cycle_Per_Frame = (float) (tx_write_cycle - statistic->Last_Tx_Write_Cycle) / (float) (tx_frame_num - statistic->Last_Tx_Frame_Num);
+    }
+    statistic->Rx_Frame_Per_Second = (float) (rx_frame_num - statistic->Last_Rx_Frame_Num) * frequency;
+    statistic->Tx_Frame_Per_Second = (float) (tx_frame_num - statistic->Last_Tx_Frame_Num) * frequency;
+    if (statistic->Bit_Rate != 0)
+    {
+        statistic->Utilization = (float) ((rx_bit_num - statistic->Last_Rx_Bit_Num) + (tx_bit_num - statistic->Last_Tx_Bit_Num)) * frequency / (float) statistic->Bit_Rate;
+    }
+    statistic->Last_Rx_Frame_Num = rx_frame_num;
+    statistic->Last_Rx_Bit_Num = rx_bit_num;
+    statistic->Last_Tx_Frame_Num = tx_frame_num;
+    statistic->Last_Tx_Bit_Num = tx_bit_num;
+    statistic->Last_Rx_Read_Cycle = rx_read_cycle;
+    statistic->Last_Tx_Write_Cycle = tx_write_cycle;
+
+    uint32_t esr = hcan->Instance->ESR;
+    statistic->Tx_Error_Counter = (esr & CAN_ESR_TEC) >> CAN_ESR_TEC_Pos;
+    statistic->Rx_Error_Counter = (esr & CAN_ESR_REC) >> CAN_ESR_REC_Pos;
+    statistic->Last_Error_Code = (esr & CAN_ESR_LEC) >> CAN_ESR_LEC_Pos;
+
+    if (statistic->Bus_Off)
+    {
+        if (!(esr & CAN_ESR_BOFF))
+        {
+            statistic->Bus_Off = false;
+            statistic->Bus_Off_Recovery_Num++;
+        }
+        else if (hcan->Init.AutoBusOff != ENABLE)
+        {
+            CAN_Bus_Off_Recover(hcan);
+        }
+    }
+}
+
+/**
+ * @brief 在接收中断中统计一帧报文, 登记过的ID同时记录到达间隔
+ *
+ * @param hcan CAN编号
+ * @param Rx_Buffer 收到的报文
+ */
+static void CAN_Statistic_Rx(CAN_HandleTypeDef *hcan, Struct_CAN_Rx_Buffer *Rx_Buffer)
+{
+    Struct_CAN_Manage_Object *obj = CAN_Get_Manage_Object(hcan);
+    int8_t bus = CAN_Get_Bus_Index(hcan);
+
+    obj->Statistic.Rx_Frame_Num++;
+    obj->Statistic.Rx_Bit_Num += CAN_Get_Frame_Bit_Num(Rx_Buffer->Header.DLC);
+
+    if (!init_finished || Rx_Buffer->Header.IDE != CAN_ID_STD)
+    {
+        return;
+    }
+    uint8_t index = CAN_Registry_Index[bus][Rx_Buffer->Header.StdId & 0x7ff];
+    if (index == 0)
+    {
+        return;
+    }
+
+    Struct_CAN_Rx_Jitter *jitter = &CAN_Rx_Jitter[index - 1];
+    uint32_t now_cycle = DWT_Get_Cycle();
+    uint32_t interval = now_cycle - jitter->Last_Cycle;
+
+    jitter->Last_Cycle = now_cycle;
+    if (jitter->Frame_Num++ == 0)
+    {
+        return;
+    }
+
+    if (jitter->Frame_Num == 2 || interval < jitter->Min_Cycle)
+    {
+        jitter->Min_Cycle = interval;
+    }
+    if (interval > jitter->Max_Cycle)
+    {
+        jitter->Max_Cycle = interval;
+    }
+    jitter->Sum_Cycle += interval;
+
+    uint8_t bin = 0;
+    while (bin < CAN_RX_JITTER_BIN_NUM - 1 && interval >= CAN_Rx_Jitter_Bin_Edge_Us[bin] * CAN_CYCLE_PER_US)
+    {
+        bin++;
+    }
+    jitter->Histogram[bin]++;
+}
+
+/**
+ * @brief 未开自动离线管理(ABOM)时由软件请求恢复: 进入再退出初始化模式, 之后硬件检测到128×11个隐性位即恢复
+ *
+ * @param hcan CAN编号
+ */
+static void CAN_Bus_Off_Recover(CAN_HandleTypeDef *hcan)
+{
+    uint32_t start_cycle = DWT_Get_Cycle();
+
+    SET_BIT(hcan->Instance->MCR, CAN_MCR_INRQ);
+    // 离线时总线上没有本节点的活动, 很快即可进入初始化模式, 最多等待100us
+    while (!(hcan->Instance->MSR & CAN_MSR_INAK) && DWT_Get_Cycle() - start_cycle < 100 * CAN_CYCLE_PER_US)
+    {
+    }
+    CLEAR_BIT(hcan->Instance->MCR, CAN_MCR_INRQ);
+}
+
+/**
+ * @brief 把登记过的控制报文放入发送队列, 并尽量填满空闲邮箱
+ *
+ * @note 上一周期仍未进入邮箱的报文被本周期的数据覆盖, 计入丢弃次数
+ *
+ * @param hcan CAN编号
+ */
+static void CAN_Tx_Schedule(CAN_HandleTypeDef *hcan)
+{
+    Struct_CAN_Manage_Object *obj = CAN_Get_Manage_Object(hcan);
+    int8_t bus = CAN_Get_Bus_Index(hcan);
+
+    if (obj == NULL || bus < 0 || obj->CAN_Handler == NULL)
+    {
+        return;
+    }
+
+    uint32_t cycle = DWT_Get_Cycle();
+
+    // 与发送完成中断中的补发互斥, 期间完成的邮箱在重新使能后再进入中断
+    __HAL_CAN_DISABLE_IT(hcan, CAN_IT_TX_MAILBOX_EMPTY);
+
+    for (int i = 0; i < CAN_TX_FRAME_NUM; i++)
+    {
+        Struct_CAN_Tx_Frame *frame = &obj->Tx_Frame[i];
+
+        if (!frame->Registered)
+        {
+            continue;
+        }
+        if (frame->Dirty)
+        {
+            frame->Drop_Num++;
+        }
+        memcpy(frame->Data, CAN_Tx_Frame_Data[bus][i], 8);
+        frame->Queue_Cycle = cycle;
+        frame->Dirty = true;
+    }
+
+    CAN_Tx_Refill(hcan);
+
+    __HAL_CAN_ENABLE_IT(hcan, CAN_IT_TX_MAILBOX_EMPTY);
+}
+
+/**
+ * @brief 按ID从小到大的优先级把队列中的报文放入空闲邮箱, 邮箱满时剩余报文留待发送完成中断补发
+ *
+ * @note bxCAN默认按ID决定邮箱的发送顺序(TXFP = 0), 与此处的优先级一致
+ *
+ * @param hcan CAN编号
+ */
+static void CAN_Tx_Refill(CAN_HandleTypeDef *hcan)
+{
+    Struct_CAN_Manage_Object *obj = CAN_Get_Manage_Object(hcan);
+
+    if (obj == NULL)
+    {
+        return;
+    }
+
+    for (int i = 0; i < CAN_TX_FRAME_NUM && CAN_Get_Tx_Mailbox_Free_Level(hcan) > 0; i++)
+    {
+        Struct_CAN_Tx_Frame *frame = &obj->Tx_Frame[i];
+
+        if (!frame->Dirty)
+        {
+            continue;
+        }
+
+        uint32_t start_cycle = DWT_Get_Cycle();
+        if (CAN_Send_Data(hcan, CAN_Tx_Frame_ID[i], frame->Data, 8) != HAL_OK)
+        {
+            break;
+        }
+        uint32_t end_cycle = DWT_Get_Cycle();
+
+        uint32_t latency = end_cycle - frame->Queue_Cycle;
+        obj->Statistic.Tx_Write_Cycle += end_cycle - start_cycle;
+        obj->Statistic.Tx_Frame_Num++;
+        obj->Statistic.Tx_Bit_Num += CAN_Get_Frame_Bit_Num(8);
+        frame->Dirty = false;
+        frame->Send_Num++;
+        frame->Latency_Last_Cycle = latency;
+        if (latency > frame->Latency_Max_Cycle)
+        {
+            frame->Latency_Max_Cycle = latency;
+        }
+    }
+}
+
+/**
+ * @brief 统计一组ID中尚未被覆盖的登记ID个数
+ *
+ * @param Cube ID组
+ * @param ID 登记的ID
+ * @param ID_Num ID个数
+ * @param Covered 已覆盖的ID位图
+ * @return uint8_t 新覆盖的ID个数
+ */
+static uint8_t CAN_Filter_Cube_Count(const Struct_CAN_Filter_Cube *Cube, const uint16_t *ID, uint8_t ID_Num, uint32_t Covered)
+{
+    uint8_t count = 0;
+
+    for (uint8_t i = 0; i < ID_Num; i++)
+    {
+        if (!(Covered & (1UL << i)) && (ID[i] & ~Cube->Dont_Care) == Cube->Value)
+        {
+            count++;
+        }
+    }
+    return (count);
+}
+
+/**
+ * @brief 写入一组32位过滤器, IDE与RTR位必须为0, 只接收标准数据帧
+ *
+ * @param hcan CAN编号
+ * @param Bank 过滤器组规划
+ * @param Activation ENABLE或DISABLE
+ */
+static void CAN_Filter_Bank_Config(CAN_HandleTypeDef *hcan, const Struct_CAN_Filter_Bank *Bank, uint8_t Activation)
+{
+    CAN_FilterTypeDef can_filter_init_structure;
+
+    // 列表模式FR1与FR2各为一个ID, 掩码模式FR1为ID, FR2为掩码
+    can_filter_init_structure.FilterIdHigh = Bank->ID[0] << 5;
+    can_filter_init_structure.FilterIdLow = 0;
+    can_filter_init_structure.FilterMaskIdHigh = Bank->ID[1] << 5;
+    can_filter_init_structure.FilterMaskIdLow = Bank->Mode == CAN_FILTERMODE_IDMASK ? 0x0006 : 0;
+    can_filter_init_structure.FilterBank = Bank->Bank;
+    can_filter_init_structure.FilterFIFOAssignment = Bank->FIFO;
+    can_filter_init_structure.FilterActivation = Activation;
+    can_filter_init_structure.FilterMode = Bank->Mode;
+    can_filter_init_structure.FilterScale = CAN_FILTERSCALE_32BIT;
+    can_filter_init_structure.SlaveStartFilterBank = CAN_FILTER_SLAVE_START_BANK;
+
+    HAL_CAN_ConfigFilter(hcan, &can_filter_init_structure);
+}
+
+/**
+ * @brief 接收中断中读空FIFO, 报文只复制进接收队列, 回调函数由CAN_Rx_Dispatch执行
+ *
+ * @param hcan CAN编号
+ * @param Rx_Fifo CAN_RX_FIFO0或CAN_RX_FIFO1
+ */
+static void CAN_Rx_Fifo_Process(CAN_HandleTypeDef *hcan, uint32_t Rx_Fifo)
+{
+    Struct_CAN_Manage_Object *obj = CAN_Get_Manage_Object(hcan);
+    if (obj == NULL)
+    {
+        return;
+    }
+
+    Struct_CAN_Rx_Queue *queue = &obj->Rx_Queue;
+    Struct_CAN_Rx_Buffer discard_buffer;
+    // 同一次中断读出的报文都在进入中断之前到达, 共用一个时间戳
+    uint32_t timestamp_us = DWT_Get_Us();
+
+    // 关键：无论 init_finished 是否完成，都要把 FIFO 读走，否则会中断风暴
+    while (CAN_Get_Rx_Fifo_Fill_Level(hcan, Rx_Fifo) > 0)
+    {
+        uint16_t head = queue->Head;
+        uint16_t next_head = (head + 1) & (CAN_RX_QUEUE_NUM - 1);
+        // 初始化没完成或队列满时读进临时缓冲区丢弃, 否则直接读进队列
+        bool enqueue = init_finished && next_head != queue->Tail;
+        Struct_CAN_Rx_Buffer *rx_buffer = enqueue ? &queue->Buffer[head] : &discard_buffer;
+
+        uint32_t start_cycle = DWT_Get_Cycle();
+        CAN_Get_Rx_Message(hcan, Rx_Fifo, rx_buffer);
+        obj->Statistic.Rx_Read_Cycle += DWT_Get_Cycle() - start_cycle;
+        rx_buffer->Timestamp_Us = timestamp_us;
+
+        CAN_Statistic_Rx(hcan, rx_buffer);
+
+        if (CAN_Recorder_Enable) CAN_Recorder_Push(hcan, rx_buffer);
+
+        if (!init_finished) continue;
+
+        if (!enqueue)
+        {
+            // 队列满, 保留旧报文, 丢弃新报文
+            queue->Overflow_Num++;
+            continue;
+        }
+
+        // 报文写完再发布
+        __DMB();
+        queue->Head = next_head;
+
+        uint16_t num = (next_head - queue->Tail) & (CAN_RX_QUEUE_NUM - 1);
+        if (num > queue->High_Water)
+        {
+            queue->High_Water = num;
+        }
+    }
+}
+
+/**
+ * @brief 在接收中断中记录一帧, 扩展帧不记录
+ *
+ * @param hcan CAN编号
+ * @param Rx_Buffer 收到的报文
+ */
+static void CAN_Recorder_Push(CAN_HandleTypeDef *hcan, Struct_CAN_Rx_Buffer *Rx_Buffer)
+{
+    if (Rx_Buffer->Header.IDE != CAN_ID_STD)
+    {
+        return;
+    }
+
+    uint16_t next_head = (CAN_Recorder_Head + 1) & (CAN_RECORDER_RECORD_NUM - 1);
+    if (next_head == CAN_Recorder_Tail)
+    {
+        // 缓冲区满, 保留旧记录, 丢弃新记录
+        CAN_Recorder_Lost_Num++;
+        return;
+    }
+
+    Struct_CAN_Recorder_Record *record = &CAN_Recorder_Buffer[CAN_Recorder_Head];
+    uint8_t dlc = Rx_Buffer->Header.DLC > 8 ? 8 : Rx_Buffer->Header.DLC;
+
+    record->Timestamp_Us = Rx_Buffer->Timestamp_Us - CAN_Recorder_Start_Us;
+    record->Info = (Rx_Buffer->Header.StdId & 0x7ff) | (dlc << 11) | ((hcan->Instance == CAN2 ? 1 : 0) << 15);
+    memcpy(record->Data, Rx_Buffer->Data, 8);
+
+    CAN_Recorder_Head = next_head;
+}
+
 /******************************************************************/
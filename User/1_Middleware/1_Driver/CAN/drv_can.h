@@ -13,6 +13,7 @@
 /* Includes ------------------------------------------------------------------*/
 
 #include "stm32f4xx_hal.h"
+#include "drv_dwt.h"
 
 /* Exported macros -----------------------------------------------------------*/
 
@@ -31,6 +32,42 @@
 #define CAN_DATA_TYPE (0 << 0)
 #define CAN_REMOTE_TYPE (1 << 0)
 
+// 每路CAN接收队列的报文数, 需为2的幂, 实际可存放CAN_RX_QUEUE_NUM - 1帧
+#define CAN_RX_QUEUE_NUM 32
+
+// 每路CAN由定时发送调度的控制报文数, 依次为0x1fe, 0x1ff, 0x200, 0x2fe, 0x2ff, ID越小仲裁优先级越高
+#define CAN_TX_FRAME_NUM 5
+
+// 每个登记ID的报文到达间隔直方图格数, 各格上界见drv_can.c中的CAN_Rx_Jitter_Bin_Edge_Us
+#define CAN_RX_JITTER_BIN_NUM 12
+
+// 总线统计的刷新周期, ms, 即TIM_100ms_CAN_Statistic_PeriodElapsedCallback的调用周期
+#define CAN_STATISTIC_PERIOD_MS 100
+
+// 收发是否绕过HAL直接读写邮箱寄存器, 0为HAL_CAN_GetRxMessage/HAL_CAN_AddTxMessage, 1为寄存器快速路径
+// 两种路径每帧的CPU周期数见总线统计中的Rx_Read_Cycle_Per_Frame/Tx_Write_Cycle_Per_Frame
+#ifndef CAN_FAST_PATH
+#define CAN_FAST_PATH 0
+#endif
+
+// 接收注册表可登记的设备数, 两路CAN共用, 不超过32
+#define CAN_REGISTRY_NUM 24
+
+// 两路CAN共用的过滤器组数, CAN1使用[0, 14), CAN2使用[14, 28)
+#define CAN_FILTER_BANK_NUM 28
+#define CAN_FILTER_SLAVE_START_BANK 14
+// 过滤器规划失败
+#define CAN_FILTER_PLAN_FAIL 0xff
+
+// 接收记录器环形缓冲区的记录条数, 需为2的幂, 1kHz×8个电机约可缓存60ms
+#define CAN_RECORDER_RECORD_NUM 512
+// 记录文件头字节数: "CANR" + 版本 + 单条记录字节数 + 2字节保留
+#define CAN_RECORDER_HEADER_SIZE 8
+// 单条记录字节数: 时间戳4 + 信息2 + 数据8, 小端序
+#define CAN_RECORDER_RECORD_SIZE 14
+// 记录格式版本
+#define CAN_RECORDER_VERSION 1
+
 /* Exported types ------------------------------------------------------------*/
 
 /**
@@ -41,14 +78,191 @@ typedef struct
 {
     CAN_RxHeaderTypeDef Header;
     uint8_t Data[8];
+    // 接收中断读出该报文时的微秒时钟
+    uint32_t Timestamp_Us;
 } Struct_CAN_Rx_Buffer;
 
+/**
+ * @brief CAN接收队列, 单生产者(接收中断)单消费者(CAN_Rx_Dispatch)无锁环形缓冲区
+ *
+ * 两个FIFO的接收中断优先级相同, 不会互相抢占, 对同一路CAN仍是单生产者
+ *
+ */
+typedef struct
+{
+    Struct_CAN_Rx_Buffer Buffer[CAN_RX_QUEUE_NUM];
+    // 写指针, 仅接收中断修改
+    volatile uint16_t Head;
+    // 读指针, 仅CAN_Rx_Dispatch修改
+    volatile uint16_t Tail;
+    // 队列满而丢弃的报文数
+    volatile uint32_t Overflow_Num;
+    // 队列中曾同时存放的最多报文数
+    volatile uint16_t High_Water;
+} Struct_CAN_Rx_Queue;
+
+/**
+ * @brief 一帧定时发送的控制报文的调度状态与统计
+ *
+ * 邮箱满时报文留在队列中, 由发送完成中断按优先级补发; 下一周期仍未发出则被新数据覆盖, 计为丢弃
+ *
+ */
+typedef struct
+{
+    // 有设备登记了该报文的发送缓冲区, 只发送登记过的报文
+    bool Registered;
+    // 已放入发送队列, 尚未进入邮箱
+    volatile bool Dirty;
+    // 放入发送队列时的数据快照, 补发时不会读到控制周期中写了一半的发送缓冲区
+    uint8_t Data[8];
+    // 放入发送队列时的周期计数
+    uint32_t Queue_Cycle;
+    // 进入邮箱的报文数
+    uint32_t Send_Num;
+    // 未能进入邮箱、被下一周期覆盖的报文数
+    uint32_t Drop_Num;
+    // 从放入队列到进入邮箱的延迟, CPU周期
+    uint32_t Latency_Last_Cycle;
+    uint32_t Latency_Max_Cycle;
+} Struct_CAN_Tx_Frame;
+
+/**
+ * @brief 一路CAN的总线统计
+ *
+ * 计数由中断累加, 速率与利用率每CAN_STATISTIC_PERIOD_MS刷新一次;
+ * 位数按标准数据帧最坏位填充估算, 因此利用率为上界
+ *
+ */
+typedef struct
+{
+    // 累计值
+    volatile uint32_t Rx_Frame_Num;
+    volatile uint32_t Rx_Bit_Num;
+    volatile uint32_t Tx_Frame_Num;
+    volatile uint32_t Tx_Bit_Num;
+    // 进入错误警告(TEC或REC >= 96)的次数
+    volatile uint32_t Error_Warning_Num;
+    // 进入错误被动(TEC或REC >= 128)的次数
+    volatile uint32_t Error_Passive_Num;
+    // 进入离线(TEC > 255)的次数
+    volatile uint32_t Bus_Off_Num;
+    // 从离线恢复的次数
+    uint32_t Bus_Off_Recovery_Num;
+    // 仲裁丢失或发送错误的次数, 未开自动重传, 该帧被放弃
+    volatile uint32_t Tx_Error_Num;
+    // 当前处于离线状态
+    volatile bool Bus_Off;
+    // 从FIFO读出报文/向邮箱写入报文累计耗费的CPU周期
+    volatile uint32_t Rx_Read_Cycle;
+    volatile uint32_t Tx_Write_Cycle;
+
+    // 上一次刷新时的累计值
+    uint32_t Last_Rx_Frame_Num;
+    uint32_t Last_Rx_Bit_Num;
+    uint32_t Last_Tx_Frame_Num;
+    uint32_t Last_Tx_Bit_Num;
+    uint32_t Last_Rx_Read_Cycle;
+    uint32_t Last_Tx_Write_Cycle;
+
+    // 按CubeMX配置计算的波特率, bit/s
+    uint32_t Bit_Rate;
+    // 每秒接收/发送的报文数
+    float Rx_Frame_Per_Second;
+    float Tx_Frame_Per_Second;
+    // 总线利用率, 0~1
+    float Utilization;
+    // 上一个刷新周期内读出/写入每帧报文的平均CPU周期, 用于比较CAN_FAST_PATH两种路径
+    float Rx_Read_Cycle_Per_Frame;
+    float Tx_Write_Cycle_Per_Frame;
+    // 发送/接收错误计数器
+    uint8_t Tx_Error_Counter;
+    uint8_t Rx_Error_Counter;
+    // 最近一次的错误码, 0为无错误, 1~6依次为填充/格式/应答/隐性位/显性位/CRC错误
+    uint8_t Last_Error_Code;
+} Struct_CAN_Statistic;
+
+/**
+ * @brief 一个登记ID的报文到达间隔统计, 在接收中断中记录
+ *
+ */
+typedef struct
+{
+    // 所在的CAN, 0为CAN1, 1为CAN2
+    uint8_t Bus;
+    uint16_t StdId;
+    // 收到的报文数
+    uint32_t Frame_Num;
+    // 上一帧的接收时刻, 周期计数
+    uint32_t Last_Cycle;
+    // 到达间隔, CPU周期
+    uint32_t Min_Cycle;
+    uint32_t Max_Cycle;
+    uint64_t Sum_Cycle;
+    // 到达间隔分布直方图
+    uint32_t Histogram[CAN_RX_JITTER_BIN_NUM];
+} Struct_CAN_Rx_Jitter;
+
+/**
+ * @brief 一组32位过滤器的规划结果, 只接收标准数据帧
+ *
+ */
+typedef struct
+{
+    // 过滤器组编号
+    uint8_t Bank;
+    // CAN_FILTERMODE_IDLIST或CAN_FILTERMODE_IDMASK
+    uint8_t Mode;
+    // CAN_RX_FIFO0或CAN_RX_FIFO1
+    uint8_t FIFO;
+    // 该组负责接收的登记ID数, 作为该组的中断负载
+    uint8_t ID_Num;
+    // 列表模式为两个ID, 掩码模式为ID与掩码(掩码为1的位必须匹配)
+    uint16_t ID[2];
+} Struct_CAN_Filter_Bank;
+
+/**
+ * @brief CAN接收记录器中的一条记录
+ *
+ * 导出时按小端序紧凑排列为14字节:
+ *  Timestamp_Us: 接收时刻, us, 32位回绕(约71分钟)
+ *  Info: bit0~10为StdId, bit11~14为DLC, bit15为总线(0为CAN1, 1为CAN2)
+ *  Data: 8字节数据
+ *
+ */
+typedef struct
+{
+    uint32_t Timestamp_Us;
+    uint16_t Info;
+    uint8_t Data[8];
+} Struct_CAN_Recorder_Record;
+
 /**
  * @brief CAN通信接收回调函数数据类型
  *
  */
 typedef void (*CAN_Call_Back)(Struct_CAN_Rx_Buffer *);
 
+/**
+ * @brief 按报文ID登记的接收处理函数数据类型, Object为登记时传入的设备对象
+ *
+ */
+typedef void (*CAN_Rx_Handler)(void *Object, uint8_t *Rx_Data);
+
+/**
+ * @brief 接收注册结果
+ *
+ */
+typedef enum
+{
+    CAN_Register_Status_OK = 0,
+    // 该ID已被其他设备登记
+    CAN_Register_Status_DUPLICATE,
+    // 注册表已满
+    CAN_Register_Status_FULL,
+    // CAN编号或ID非法
+    CAN_Register_Status_INVALID,
+} Enum_CAN_Register_Status;
+
 /**
  * @brief CAN通信处理结构体
  *
@@ -56,8 +270,11 @@ typedef void (*CAN_Call_Back)(Struct_CAN_Rx_Buffer *);
 typedef struct
 {
     CAN_HandleTypeDef *CAN_Handler;
-    Struct_CAN_Rx_Buffer Rx_Buffer;
+    Struct_CAN_Rx_Queue Rx_Queue;
     CAN_Call_Back Callback_Function;
+    // 下标与发送报文ID的对应关系见CAN_TX_FRAME_NUM
+    Struct_CAN_Tx_Frame Tx_Frame[CAN_TX_FRAME_NUM];
+    Struct_CAN_Statistic Statistic;
 } Struct_CAN_Manage_Object;
 
 /* Exported variables ---------------------------------------------------------*/
@@ -92,6 +309,48 @@ uint8_t CAN_Send_Data(CAN_HandleTypeDef *hcan, uint16_t ID, uint8_t *Data, uint1
 
 void TIM_CAN_PeriodElapsedCallback();
 
+void CAN_Register_Tx_Data(CAN_HandleTypeDef *hcan, uint8_t *Tx_Data);
+
+const Struct_CAN_Tx_Frame *CAN_Get_Tx_Frame(CAN_HandleTypeDef *hcan, uint16_t StdId);
+
+void CAN_Rx_Dispatch(CAN_HandleTypeDef *hcan);
+
+uint32_t CAN_Get_Rx_Timestamp_Us();
+
+uint32_t CAN_Get_Rx_Overflow_Num(CAN_HandleTypeDef *hcan);
+
+uint16_t CAN_Get_Rx_High_Water(CAN_HandleTypeDef *hcan);
+
+Enum_CAN_Register_Status CAN_Register_Rx_Handler(CAN_HandleTypeDef *hcan, uint16_t StdId, CAN_Rx_Handler Handler, void *Object);
+
+void CAN_Unregister_Rx_Handler(CAN_HandleTypeDef *hcan, uint16_t StdId);
+
+uint16_t CAN_Get_Register_Error_Num();
+
+void TIM_100ms_CAN_Statistic_PeriodElapsedCallback();
+
+void CAN_Statistic_Reset();
+
+const Struct_CAN_Statistic *CAN_Get_Statistic(CAN_HandleTypeDef *hcan);
+
+const Struct_CAN_Rx_Jitter *CAN_Get_Rx_Jitter(CAN_HandleTypeDef *hcan, uint16_t StdId);
+
+uint8_t CAN_Statistic_Export_Summary(CAN_HandleTypeDef *hcan, float *Buffer, uint8_t Buffer_Length);
+
+uint8_t CAN_Statistic_Export_Jitter(uint8_t Index, float *Buffer, uint8_t Buffer_Length);
+
+uint8_t CAN_Filter_Plan(const uint16_t *ID, uint8_t ID_Num, uint8_t First_Bank, uint8_t Bank_Num, Struct_CAN_Filter_Bank *Bank);
+
+void CAN_Filter_Apply();
+
+void CAN_Recorder_Start();
+
+void CAN_Recorder_Stop();
+
+uint16_t CAN_Recorder_Drain(uint8_t *Buffer, uint16_t Length);
+
+uint32_t CAN_Recorder_Get_Lost_Num();
+
 #endif
 
 /*
@@ -115,10 +374,48 @@ void CAN_Motor_Call_Back(Struct_CAN_Rx_Buffer *Rx_Buffer)//你就可以用这个
 
 CAN_Init(&hcan1,CAN_Motor_Call_Back);
 
+也可以按ID登记处理函数, 登记过的ID直接查表调用, 不再进入CAN_Motor_Call_Back:
+void Motor_Rx_Handler(void *Object, uint8_t *Rx_Data)
+{
+    ((Class_Motor_C620 *) Object)->CAN_RxCpltCallback(Rx_Data);
+}
+CAN_Register_Rx_Handler(&hcan1, 0x201, Motor_Rx_Handler, &motor);//大疆电机在Init中已自动登记
+处理函数中CAN_Get_Rx_Timestamp_Us()为该报文到达时的微秒时钟, 回调函数中为Rx_Buffer->Timestamp_Us
+初始化结束后检查CAN_Get_Register_Error_Num(), 非0说明有ID冲突或注册表不够用
+所有设备登记完后调用CAN_Filter_Apply(), 按登记的ID重新配置硬件过滤器, 其他节点的报文不再进入中断
+(CAN_Init传入了回调函数的总线保留全通过滤器, 因为无法得知回调函数需要哪些ID)
+
+接收中断只把报文放入队列, 回调函数在CAN_Rx_Dispatch中执行:
 假设这是一个定时调用的函数{
+	CAN_Rx_Dispatch(&hcan1);//在控制计算之前取出本周期收到的所有报文, 逐帧调用CAN_Motor_Call_Back
 	//记得把CAN1_0x1ff_Tx_Data的值改成你想发的数据
-	TIM_CAN_PeriodElapsedCallback()；//你就可以定时的发送CAN报文了，假设你要发送报文为0x1ff的报文，你就要到这个函数里把该行取消注释掉。
+	TIM_CAN_PeriodElapsedCallback()；//你就可以定时的发送CAN报文了
+}
+只发送登记过的报文, 大疆电机在Init中分配发送缓冲区时自动登记, 自己使用的发送缓冲区需要手动登记:
+CAN_Register_Tx_Data(&hcan1, CAN1_0x1ff_Tx_Data);
+邮箱满时剩余报文按ID从小到大的优先级在发送完成中断中补发, 需在CubeMX中打开CAN的TX中断
+CAN_Get_Tx_Frame(&hcan1, 0x1ff)可查看该报文的丢弃次数和排队延迟
+
+总线统计:
+每100ms调用一次TIM_100ms_CAN_Statistic_PeriodElapsedCallback(), 刷新报文速率、利用率和错误计数器
+CAN_Get_Statistic(&hcan1)查看总线统计, CAN_Get_Rx_Jitter(&hcan1, 0x201)查看该反馈报文的到达间隔
+CAN_Statistic_Export_Summary/CAN_Statistic_Export_Jitter导出给串口绘图
+错误中断需在CubeMX中打开CAN的SCE中断; 离线后由硬件自动恢复(ABOM), 关闭ABOM时由统计回调请求恢复
+编译时定义CAN_FAST_PATH=1可绕过HAL直接读写邮箱寄存器, 分别编译两种路径后比较Rx_Read_Cycle_Per_Frame/Tx_Write_Cycle_Per_Frame
+
+接收记录器：
+DWT_Init();
+CAN_Recorder_Start();//开始记录两路CAN收到的所有标准帧
+
+假设这是前台循环{
+	uint8_t log_buffer[CAN_RECORDER_HEADER_SIZE + 64 * CAN_RECORDER_RECORD_SIZE];
+	uint16_t length = CAN_Recorder_Drain(log_buffer, sizeof(log_buffer));//取出的字节流直接拼接保存即为日志文件
+	if (length > 0)
+	{
+		//通过串口/SD卡等保存log_buffer中的length字节
+	}
 }
+日志文件可用Simulation/Replay中的回放工具送回固件的CAN接收处理
 
 
 */
@@ -0,0 +1,121 @@
+/**
+ * @file drv_dwt.cpp
+ * @author WFZ
+ * @brief DWT周期计数器, 用于测量代码段耗时
+ * @version 0.0
+ * @date 2026-1-22
+ *
+ *
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "drv_dwt.h"
+
+/* Private macros ------------------------------------------------------------*/
+
+/* Private types -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+
+#ifndef HOST_SIMULATION
+// 微秒时钟: 已计入的周期计数, 累计微秒数
+static uint32_t DWT_Us_Last_Cycle = 0;
+static uint32_t DWT_Us = 0;
+#endif
+
+/* Private function declarations ---------------------------------------------*/
+
+/* function prototypes -------------------------------------------------------*/
+
+/**
+ * @brief 使能DWT周期计数器
+ *
+ */
+void DWT_Init()
+{
+#ifndef HOST_SIMULATION
+    // 打开跟踪模块后DWT才会计数
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    DWT_Us_Last_Cycle = 0;
+    DWT_Us = 0;
+#endif
+}
+
+/**
+ * @brief 周期数转换为微秒
+ *
+ * @param Cycle 周期数
+ * @return float 微秒
+ */
+float DWT_Cycle_To_Us(uint32_t Cycle)
+{
+    return ((float) Cycle / (float) (DWT_CPU_FREQUENCY / 1000000U));
+}
+
+/**
+ * @brief 微秒转换为周期数
+ *
+ * @param Us 微秒
+ * @return uint32_t 周期数
+ */
+uint32_t DWT_Us_To_Cycle(float Us)
+{
+    return ((uint32_t) (Us * (float) (DWT_CPU_FREQUENCY / 1000000U)));
+}
+
+/**
+ * @brief 获取微秒时钟, 32位回绕(约71分钟), 两次读数之差即为经过的微秒数, 可在任意中断中调用
+ *
+ * @note 由周期计数扩展而来, 两次调用的间隔不能超过周期计数器的回绕时间(168MHz下约25s),
+ *       控制线程每个节拍都会调用, 满足该条件
+ *
+ * @return uint32_t 微秒时钟
+ */
+uint32_t DWT_Get_Us()
+{
+#ifdef HOST_SIMULATION
+    return (Sim_HAL_Get_Time_Us());
+#else
+    // 各优先级的中断都可能调用, 关中断保证扩展过程不被打断
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint32_t us = (DWT->CYCCNT - DWT_Us_Last_Cycle) / DWT_CYCLE_PER_US;
+    // 不足1us的周期留到下一次计入
+    DWT_Us_Last_Cycle += us * DWT_CYCLE_PER_US;
+    DWT_Us += us;
+    us = DWT_Us;
+    __set_PRIMASK(primask);
+    return (us);
+#endif
+}
+
+/**
+ * @brief 两个微秒时间戳之差, 回绕后仍正确
+ *
+ * @param Now_Us 当前时间戳
+ * @param Last_Us 上一次的时间戳
+ * @return float 经过的时间, s
+ */
+float DWT_Us_Diff_To_s(uint32_t Now_Us, uint32_t Last_Us)
+{
+    return ((float) (Now_Us - Last_Us) / 1000000.0f);
+}
+
+/**
+ * @brief 测量距上一次调用经过的时间, 用于按实际周期积分
+ *
+ * @param Last_Us 上一次调用的时间戳, 调用后更新为当前时间戳
+ * @return float 经过的时间, s
+ */
+float DWT_Get_Dt_s(uint32_t *Last_Us)
+{
+    uint32_t now_us = DWT_Get_Us();
+    float dt = DWT_Us_Diff_To_s(now_us, *Last_Us);
+    *Last_Us = now_us;
+    return (dt);
+}
+
+/*******************************************************************/
@@ -0,0 +1,68 @@
+/**
+ * @file drv_dwt.h
+ * @author WFZ
+ * @brief DWT周期计数器, 用于测量代码段耗时; 由其扩展的32位微秒时钟, 用于给报文、采样打时间戳与测量控制周期
+ * @version 0.0
+ * @date 2026-1-22
+ *
+ * @note 主机仿真(HOST_SIMULATION)时没有DWT, 周期计数改用clock_gettime换算成等效的CPU周期数,
+ *       微秒时钟改用仿真时间, 与仿真中的报文、节拍保持一致
+ *
+ */
+
+#ifndef DRV_DWT_H
+#define DRV_DWT_H
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "stm32f4xx_hal.h"
+
+#ifdef HOST_SIMULATION
+#include <time.h>
+#endif
+
+/* Exported macros -----------------------------------------------------------*/
+
+// CPU主频, Hz
+#define DWT_CPU_FREQUENCY (168000000U)
+// 每微秒的周期数
+#define DWT_CYCLE_PER_US (DWT_CPU_FREQUENCY / 1000000U)
+
+/* Exported types ------------------------------------------------------------*/
+
+/* Exported variables --------------------------------------------------------*/
+
+/* Exported function declarations --------------------------------------------*/
+
+void DWT_Init();
+
+float DWT_Cycle_To_Us(uint32_t Cycle);
+
+uint32_t DWT_Us_To_Cycle(float Us);
+
+uint32_t DWT_Get_Us();
+
+float DWT_Get_Dt_s(uint32_t *Last_Us);
+
+float DWT_Us_Diff_To_s(uint32_t Now_Us, uint32_t Last_Us);
+
+/**
+ * @brief 获取当前周期计数, 32位回绕, 两次读数之差即为经过的周期数
+ *
+ * @return uint32_t 当前周期计数
+ */
+static inline uint32_t DWT_Get_Cycle()
+{
+#ifdef HOST_SIMULATION
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    uint64_t ns = (uint64_t) now.tv_sec * 1000000000ULL + (uint64_t) now.tv_nsec;
+    return ((uint32_t) (ns * (DWT_CPU_FREQUENCY / 1000000U) / 1000U));
+#else
+    return (DWT->CYCCNT);
+#endif
+}
+
+#endif
+
+/*******************************************************************/
@@ -13,12 +13,29 @@
 
 /* Private macros ------------------------------------------------------------*/
 
+// 2/PI, 用于按象限取整
+#define MATH_2_DIV_PI (0.636619772f)
+// 1/(2PI)
+#define MATH_1_DIV_2PI (0.159154943f)
+// PI/2分三段表示, 高位段的尾数足够短, 与象限号相乘没有舍入误差
+#define MATH_PI_DIV_2_A (1.5703125f)
+#define MATH_PI_DIV_2_B (4.83751296997070312e-4f)
+#define MATH_PI_DIV_2_C (7.54978995489188216e-8f)
+// tan(PI/8), atan多项式的分段点
+#define MATH_TAN_PI_DIV_8 (0.414213562f)
+
 /* Private types -------------------------------------------------------------*/
 
 /* Private variables ---------------------------------------------------------*/
 
 /* Private function declarations ---------------------------------------------*/
 
+static inline int32_t Math_Round_To_Int(float x);
+static inline float Math_Quadrant_Reduce(float x, int32_t *Quadrant);
+static inline float Math_Sin_Kernel(float r);
+static inline float Math_Cos_Kernel(float r);
+static inline float Math_Atan_Kernel(float t);
+
 /* Function prototypes -------------------------------------------------------*/
 
 /**
@@ -89,7 +106,7 @@ void Math_Endian_Reverse_32(void *Source, void *Destination)
 uint8_t Math_Sum_8(uint8_t *Address, uint32_t Length)
 {
     uint8_t sum = 0;
-    for (int i = 0; i < Length; i++)
+    for (uint32_t i = 0; i < Length; i++)
     {
         sum += Address[i];
     }
@@ -106,7 +123,7 @@ uint8_t Math_Sum_8(uint8_t *Address, uint32_t Length)
 uint16_t Math_Sum_16(uint16_t *Address, uint32_t Length)
 {
     uint16_t sum = 0;
-    for (int i = 0; i < Length; i++)
+    for (uint32_t i = 0; i < Length; i++)
     {
         sum += Address[i];
     }
@@ -123,7 +140,7 @@ uint16_t Math_Sum_16(uint16_t *Address, uint32_t Length)
 uint32_t Math_Sum_32(uint32_t *Address, uint32_t Length)
 {
     uint32_t sum = 0;
-    for (int i = 0; i < Length; i++)
+    for (uint32_t i = 0; i < Length; i++)
     {
         sum += Address[i];
     }
@@ -144,7 +161,257 @@ float Math_Sinc(float x)
         return (1.0f);
     }
 
-    return (sin(x) / x);
+    return (Math_Sin(x) / x);
+}
+
+/**
+ * @brief 四舍五入取整, 不经过lroundf/双精度
+ *
+ * @param x 输入, 绝对值小于2^31
+ * @return int32_t 最近的整数
+ */
+static inline int32_t Math_Round_To_Int(float x)
+{
+    return ((int32_t) (x + ((x >= 0.0f) ? 0.5f : -0.5f)));
+}
+
+/**
+ * @brief 按PI/2做区间约简, 得到 [-PI/4, PI/4] 内的余量
+ *
+ * @param x 输入, rad
+ * @param Quadrant 象限号, 只用低两位
+ * @return float 余量, rad
+ */
+static inline float Math_Quadrant_Reduce(float x, int32_t *Quadrant)
+{
+    int32_t k = Math_Round_To_Int(x * MATH_2_DIV_PI);
+    float fk = (float) k;
+
+    *Quadrant = k;
+    return (((x - fk * MATH_PI_DIV_2_A) - fk * MATH_PI_DIV_2_B) - fk * MATH_PI_DIV_2_C);
+}
+
+/**
+ * @brief [-PI/4, PI/4] 上的sin极小极大多项式
+ *
+ * @param r 余量, rad
+ * @return float sin(r)
+ */
+static inline float Math_Sin_Kernel(float r)
+{
+    float z = r * r;
+
+    return (((-1.9515295891e-4f * z + 8.3321608736e-3f) * z - 1.6666654611e-1f) * z * r + r);
+}
+
+/**
+ * @brief [-PI/4, PI/4] 上的cos极小极大多项式
+ *
+ * @param r 余量, rad
+ * @return float cos(r)
+ */
+static inline float Math_Cos_Kernel(float r)
+{
+    float z = r * r;
+
+    return (((2.443315711809948e-5f * z - 1.388731625493765e-3f) * z + 4.166664568298827e-2f) * z * z - 0.5f * z + 1.0f);
+}
+
+/**
+ * @brief [0, 1] 上的atan, 分段点tan(PI/8)以上换元到 [-0.414, 0.414]
+ *
+ * @param t 输入, 0 <= t <= 1
+ * @return float atan(t), rad
+ */
+static inline float Math_Atan_Kernel(float t)
+{
+    float offset = 0.0f;
+
+    if (t > MATH_TAN_PI_DIV_8)
+    {
+        offset = PI / 4.0f;
+        t = (t - 1.0f) / (t + 1.0f);
+    }
+
+    float z = t * t;
+
+    return ((((8.05374449538e-2f * z - 1.38776856032e-1f) * z + 1.99777106478e-1f) * z - 3.33329491539e-1f) * z * t + t + offset);
+}
+
+/**
+ * @brief 角度归化到 [-PI, PI)
+ *
+ * @param x 输入, rad
+ * @return float 归化后的角度, rad
+ * @note |x| <= 1e4时与双精度参考的最大绝对误差不超过3.5e-7, 见Simulation/Math
+ */
+float Math_Wrap_Pi(float x)
+{
+    float k = (float) Math_Round_To_Int(x * MATH_1_DIV_2PI);
+    float tmp = ((x - k * (4.0f * MATH_PI_DIV_2_A)) - k * (4.0f * MATH_PI_DIV_2_B)) - k * (4.0f * MATH_PI_DIV_2_C);
+
+    if (tmp >= PI)
+    {
+        tmp -= 2.0f * PI;
+    }
+    else if (tmp < -PI)
+    {
+        tmp += 2.0f * PI;
+    }
+
+    return (tmp);
+}
+
+/**
+ * @brief 单精度sin
+ *
+ * @param x 输入, rad
+ * @return float 输出
+ * @note |x| <= 1e4时最大绝对误差不超过1.0e-7, 不调用libm
+ */
+float Math_Sin(float x)
+{
+    int32_t quadrant;
+    float r = Math_Quadrant_Reduce(x, &quadrant);
+
+    switch (quadrant & 3)
+    {
+    case (0):
+        return (Math_Sin_Kernel(r));
+    case (1):
+        return (Math_Cos_Kernel(r));
+    case (2):
+        return (-Math_Sin_Kernel(r));
+    default:
+        return (-Math_Cos_Kernel(r));
+    }
+}
+
+/**
+ * @brief 单精度cos
+ *
+ * @param x 输入, rad
+ * @return float 输出
+ * @note |x| <= 1e4时最大绝对误差不超过1.0e-7, 不调用libm
+ */
+float Math_Cos(float x)
+{
+    int32_t quadrant;
+    float r = Math_Quadrant_Reduce(x, &quadrant);
+
+    switch (quadrant & 3)
+    {
+    case (0):
+        return (Math_Cos_Kernel(r));
+    case (1):
+        return (-Math_Sin_Kernel(r));
+    case (2):
+        return (-Math_Cos_Kernel(r));
+    default:
+        return (Math_Sin_Kernel(r));
+    }
+}
+
+/**
+ * @brief 同时求sin与cos, 共用一次区间约简, 用于旋转矩阵
+ *
+ * @param x 输入, rad
+ * @param Sin sin(x)
+ * @param Cos cos(x)
+ */
+void Math_Sin_Cos(float x, float *Sin, float *Cos)
+{
+    int32_t quadrant;
+    float r = Math_Quadrant_Reduce(x, &quadrant);
+    float s = Math_Sin_Kernel(r);
+    float c = Math_Cos_Kernel(r);
+
+    switch (quadrant & 3)
+    {
+    case (0):
+        *Sin = s;
+        *Cos = c;
+        break;
+    case (1):
+        *Sin = c;
+        *Cos = -s;
+        break;
+    case (2):
+        *Sin = -s;
+        *Cos = -c;
+        break;
+    default:
+        *Sin = -c;
+        *Cos = s;
+        break;
+    }
+}
+
+/**
+ * @brief 单精度atan2
+ *
+ * @param y 纵坐标
+ * @param x 横坐标
+ * @return float 角度, rad, 介于 [-PI, PI]
+ * @note 最大绝对误差不超过3.0e-7, x与y同为0时返回0
+ */
+float Math_Atan2(float y, float x)
+{
+    float abs_x = Math_Abs(x);
+    float abs_y = Math_Abs(y);
+    float max_xy = (abs_x > abs_y) ? abs_x : abs_y;
+    float min_xy = (abs_x > abs_y) ? abs_y : abs_x;
+
+    if (max_xy == 0.0f)
+    {
+        return (0.0f);
+    }
+
+    float angle = Math_Atan_Kernel(min_xy / max_xy);
+
+    if (abs_y > abs_x)
+    {
+        angle = PI / 2.0f - angle;
+    }
+    if (x < 0.0f)
+    {
+        angle = PI - angle;
+    }
+    if (y < 0.0f)
+    {
+        angle = -angle;
+    }
+
+    return (angle);
+}
+
+/**
+ * @brief 快速平方根倒数, 位运算初值加两次牛顿迭代
+ *
+ * @param x 输入, 应大于0
+ * @return float 1/sqrt(x), x <= 0时返回0
+ * @note 最大相对误差不超过4.8e-6, 适合向量归一化; 需要满精度时直接用sqrtf
+ */
+float Math_Inv_Sqrt(float x)
+{
+    if (x <= 0.0f)
+    {
+        return (0.0f);
+    }
+
+    union
+    {
+        float f;
+        uint32_t i;
+    } conv;
+    float half_x = 0.5f * x;
+
+    conv.f = x;
+    conv.i = 0x5f375a86U - (conv.i >> 1);
+    conv.f *= 1.5f - half_x * conv.f * conv.f;
+    conv.f *= 1.5f - half_x * conv.f * conv.f;
+
+    return (conv.f);
 }
 
 /******************************************************************/
@@ -40,6 +40,13 @@ uint32_t Math_Sum_32(uint32_t *Address, uint32_t Length);
 
 float Math_Sinc(float x);
 
+float Math_Wrap_Pi(float x);
+float Math_Sin(float x);
+float Math_Cos(float x);
+void Math_Sin_Cos(float x, float *Sin, float *Cos);
+float Math_Atan2(float y, float x);
+float Math_Inv_Sqrt(float x);
+
 /**
  * @brief 限幅函数
  *
@@ -81,18 +88,25 @@ Type Math_Abs(Type x)
  * @param x 传入数据
  * @param modulus 模数
  * @return Type 返回的归化数, 介于 ±modulus / 2 之间
+ * @note 全程单精度, 不调用双精度fmod, 输入已在范围内时结果与原值逐位相同
  */
 template<typename Type>
 Type Math_Modulus_Normalization(Type x, Type modulus)
 {
     float tmp;
 
-    tmp = fmod(x + modulus / 2.0f, modulus);
+    tmp = x + modulus / 2.0f;
+    tmp -= modulus * floorf(tmp / modulus);
 
+    //舍入可能落到区间端点之外, 修正一次即可
     if (tmp < 0.0f)
     {
         tmp += modulus;
     }
+    else if (tmp >= modulus)
+    {
+        tmp -= modulus;
+    }
 
     return (tmp - modulus / 2.0f);
 }
@@ -0,0 +1,521 @@
+/**
+ * @file drv_matrix.h
+ * @author WFZ
+ * @brief 定长矩阵与向量模板, 维度在编译期检查, 目标板可选CMSIS-DSP后端
+ * @version 0.0
+ * @date 2026-1-30
+ *
+ * @note 维度是模板参数, 维度不匹配的运算无法通过编译; 循环次数均为编译期常量, 小尺寸下编译器完全展开.
+ *       Class_Matrix是聚合类型, 可用constexpr直接构造几何矩阵, 例如
+ *           static constexpr Class_Matrix<2, 2> Rotate_90 = {{{0.0f, -1.0f}, {1.0f, 0.0f}}};
+ *       目标板定义ARM_MATH_CM4并链接CMSIS-DSP时, 元素数不少于MATRIX_CMSIS_DSP_MIN_SIZE的单精度乘法与求逆
+ *       交给arm_mat_*, 其余情况与主机仿真均使用本文件中的可移植实现.
+ *
+ */
+
+#ifndef DRV_MATRIX_H
+#define DRV_MATRIX_H
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "drv_math.h"
+
+#if defined(ARM_MATH_CM4) && !defined(HOST_SIMULATION)
+#include "arm_math.h"
+#define MATRIX_USE_CMSIS_DSP
+#endif
+
+/* Exported macros -----------------------------------------------------------*/
+
+// 单精度矩阵元素数不少于该值时乘法与求逆交给CMSIS-DSP, 更小的尺寸展开后比函数调用更快
+#define MATRIX_CMSIS_DSP_MIN_SIZE (16U)
+// 求逆时主元绝对值小于该值视为奇异
+#define MATRIX_SINGULAR_EPSILON (1.0e-12f)
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+ * @brief 定长矩阵, 按行存储, 与arm_matrix_instance_f32的内存布局一致
+ *
+ * @tparam Row 行数
+ * @tparam Column 列数
+ * @tparam Type 元素类型
+ */
+template <uint32_t Row, uint32_t Column, typename Type = float>
+class Class_Matrix
+{
+public:
+    static_assert(Row > 0 && Column > 0, "matrix dimension must be positive");
+
+    // 元素, 公开以保持聚合类型, 支持constexpr初始化
+    Type Data[Row][Column];
+
+    static Class_Matrix Zero();
+
+    static Class_Matrix Identity();
+
+    inline Type &operator()(uint32_t i, uint32_t j);
+
+    constexpr const Type &operator()(uint32_t i, uint32_t j) const;
+
+    inline Type &operator[](uint32_t i);
+
+    constexpr const Type &operator[](uint32_t i) const;
+
+    Class_Matrix<Column, Row, Type> Transpose() const;
+
+    bool Inverse(Class_Matrix *Result) const;
+
+    Class_Matrix &operator+=(const Class_Matrix &Other);
+
+    Class_Matrix &operator-=(const Class_Matrix &Other);
+
+    Class_Matrix &operator*=(Type Scale);
+};
+
+/**
+ * @brief 列向量
+ *
+ * @tparam N 维数
+ * @tparam Type 元素类型
+ */
+template <uint32_t N, typename Type = float>
+using Class_Vector = Class_Matrix<N, 1, Type>;
+
+/* Exported variables --------------------------------------------------------*/
+
+/* Exported function declarations --------------------------------------------*/
+
+/**
+ * @brief 零矩阵
+ *
+ * @return Class_Matrix 零矩阵
+ */
+template <uint32_t Row, uint32_t Column, typename Type>
+Class_Matrix<Row, Column, Type> Class_Matrix<Row, Column, Type>::Zero()
+{
+    Class_Matrix result;
+    for (uint32_t i = 0; i < Row; i++)
+    {
+        for (uint32_t j = 0; j < Column; j++)
+        {
+            result.Data[i][j] = (Type) 0;
+        }
+    }
+    return (result);
+}
+
+/**
+ * @brief 单位矩阵
+ *
+ * @return Class_Matrix 单位矩阵
+ */
+template <uint32_t Row, uint32_t Column, typename Type>
+Class_Matrix<Row, Column, Type> Class_Matrix<Row, Column, Type>::Identity()
+{
+    static_assert(Row == Column, "identity matrix must be square");
+
+    Class_Matrix result = Zero();
+    for (uint32_t i = 0; i < Row; i++)
+    {
+        result.Data[i][i] = (Type) 1;
+    }
+    return (result);
+}
+
+/**
+ * @brief 取元素
+ *
+ * @param i 行
+ * @param j 列
+ * @return Type& 元素
+ */
+template <uint32_t Row, uint32_t Column, typename Type>
+inline Type &Class_Matrix<Row, Column, Type>::operator()(uint32_t i, uint32_t j)
+{
+    return (Data[i][j]);
+}
+
+/**
+ * @brief 取元素
+ *
+ * @param i 行
+ * @param j 列
+ * @return const Type& 元素
+ */
+template <uint32_t Row, uint32_t Column, typename Type>
+constexpr const Type &Class_Matrix<Row, Column, Type>::operator()(uint32_t i, uint32_t j) const
+{
+    return (Data[i][j]);
+}
+
+/**
+ * @brief 取向量元素, 只对列向量可用
+ *
+ * @param i 下标
+ * @return Type& 元素
+ */
+template <uint32_t Row, uint32_t Column, typename Type>
+inline Type &Class_Matrix<Row, Column, Type>::operator[](uint32_t i)
+{
+    static_assert(Column == 1, "operator[] is only for column vectors");
+
+    return (Data[i][0]);
+}
+
+/**
+ * @brief 取向量元素, 只对列向量可用
+ *
+ * @param i 下标
+ * @return const Type& 元素
+ */
+template <uint32_t Row, uint32_t Column, typename Type>
+constexpr const Type &Class_Matrix<Row, Column, Type>::operator[](uint32_t i) const
+{
+    static_assert(Column == 1, "operator[] is only for column vectors");
+
+    return (Data[i][0]);
+}
+
+/**
+ * @brief 转置
+ *
+ * @return Class_Matrix<Column, Row, Type> 转置矩阵
+ */
+template <uint32_t Row, uint32_t Column, typename Type>
+Class_Matrix<Column, Row, Type> Class_Matrix<Row, Column, Type>::Transpose() const
+{
+    Class_Matrix<Column, Row, Type> result;
+    for (uint32_t i = 0; i < Row; i++)
+    {
+        for (uint32_t j = 0; j < Column; j++)
+        {
+            result.Data[j][i] = Data[i][j];
+        }
+    }
+    return (result);
+}
+
+/**
+ * @brief 矩阵加法
+ *
+ * @param Other 加数
+ * @return Class_Matrix& 自身
+ */
+template <uint32_t Row, uint32_t Column, typename Type>
+Class_Matrix<Row, Column, Type> &Class_Matrix<Row, Column, Type>::operator+=(const Class_Matrix &Other)
+{
+    for (uint32_t i = 0; i < Row; i++)
+    {
+        for (uint32_t j = 0; j < Column; j++)
+        {
+            Data[i][j] += Other.Data[i][j];
+        }
+    }
+    return (*this);
+}
+
+/**
+ * @brief 矩阵减法
+ *
+ * @param Other 减数
+ * @return Class_Matrix& 自身
+ */
+template <uint32_t Row, uint32_t Column, typename Type>
+Class_Matrix<Row, Column, Type> &Class_Matrix<Row, Column, Type>::operator-=(const Class_Matrix &Other)
+{
+    for (uint32_t i = 0; i < Row; i++)
+    {
+        for (uint32_t j = 0; j < Column; j++)
+        {
+            Data[i][j] -= Other.Data[i][j];
+        }
+    }
+    return (*this);
+}
+
+/**
+ * @brief 数乘
+ *
+ * @param Scale 系数
+ * @return Class_Matrix& 自身
+ */
+template <uint32_t Row, uint32_t Column, typename Type>
+Class_Matrix<Row, Column, Type> &Class_Matrix<Row, Column, Type>::operator*=(Type Scale)
+{
+    for (uint32_t i = 0; i < Row; i++)
+    {
+        for (uint32_t j = 0; j < Column; j++)
+        {
+            Data[i][j] *= Scale;
+        }
+    }
+    return (*this);
+}
+
+/**
+ * @brief 矩阵加法
+ *
+ */
+template <uint32_t Row, uint32_t Column, typename Type>
+Class_Matrix<Row, Column, Type> operator+(Class_Matrix<Row, Column, Type> A, const Class_Matrix<Row, Column, Type> &B)
+{
+    return (A += B);
+}
+
+/**
+ * @brief 矩阵减法
+ *
+ */
+template <uint32_t Row, uint32_t Column, typename Type>
+Class_Matrix<Row, Column, Type> operator-(Class_Matrix<Row, Column, Type> A, const Class_Matrix<Row, Column, Type> &B)
+{
+    return (A -= B);
+}
+
+/**
+ * @brief 取负
+ *
+ */
+template <uint32_t Row, uint32_t Column, typename Type>
+Class_Matrix<Row, Column, Type> operator-(Class_Matrix<Row, Column, Type> A)
+{
+    return (A *= (Type) -1);
+}
+
+/**
+ * @brief 数乘
+ *
+ */
+template <uint32_t Row, uint32_t Column, typename Type>
+Class_Matrix<Row, Column, Type> operator*(Class_Matrix<Row, Column, Type> A, Type Scale)
+{
+    return (A *= Scale);
+}
+
+/**
+ * @brief 数乘
+ *
+ */
+template <uint32_t Row, uint32_t Column, typename Type>
+Class_Matrix<Row, Column, Type> operator*(Type Scale, Class_Matrix<Row, Column, Type> A)
+{
+    return (A *= Scale);
+}
+
+/**
+ * @brief 矩阵乘法的可移植实现
+ *
+ * @param A 左矩阵
+ * @param B 右矩阵
+ * @param Result 结果, 不能与A或B重叠
+ */
+template <uint32_t Row, uint32_t Inner, uint32_t Column, typename Type>
+inline void Matrix_Multiply_Portable(const Class_Matrix<Row, Inner, Type> &A, const Class_Matrix<Inner, Column, Type> &B, Class_Matrix<Row, Column, Type> *Result)
+{
+    for (uint32_t i = 0; i < Row; i++)
+    {
+        for (uint32_t j = 0; j < Column; j++)
+        {
+            Type sum = A.Data[i][0] * B.Data[0][j];
+            for (uint32_t k = 1; k < Inner; k++)
+            {
+                sum += A.Data[i][k] * B.Data[k][j];
+            }
+            Result->Data[i][j] = sum;
+        }
+    }
+}
+
+/**
+ * @brief 矩阵乘法
+ *
+ * @param A 左矩阵
+ * @param B 右矩阵
+ * @param Result 结果, 不能与A或B重叠
+ */
+template <uint32_t Row, uint32_t Inner, uint32_t Column, typename Type>
+inline void Matrix_Multiply(const Class_Matrix<Row, Inner, Type> &A, const Class_Matrix<Inner, Column, Type> &B, Class_Matrix<Row, Column, Type> *Result)
+{
+    Matrix_Multiply_Portable(A, B, Result);
+}
+
+#ifdef MATRIX_USE_CMSIS_DSP
+
+/**
+ * @brief 单精度矩阵乘法, 尺寸较大时交给arm_mat_mult_f32
+ *
+ * @param A 左矩阵
+ * @param B 右矩阵
+ * @param Result 结果, 不能与A或B重叠
+ */
+template <uint32_t Row, uint32_t Inner, uint32_t Column>
+inline void Matrix_Multiply(const Class_Matrix<Row, Inner, float> &A, const Class_Matrix<Inner, Column, float> &B, Class_Matrix<Row, Column, float> *Result)
+{
+    if (Row * Inner < MATRIX_CMSIS_DSP_MIN_SIZE && Inner * Column < MATRIX_CMSIS_DSP_MIN_SIZE)
+    {
+        Matrix_Multiply_Portable(A, B, Result);
+        return;
+    }
+
+    arm_matrix_instance_f32 a, b, result;
+    arm_mat_init_f32(&a, Row, Inner, (float32_t *) &A.Data[0][0]);
+    arm_mat_init_f32(&b, Inner, Column, (float32_t *) &B.Data[0][0]);
+    arm_mat_init_f32(&result, Row, Column, &Result->Data[0][0]);
+    arm_mat_mult_f32(&a, &b, &result);
+}
+
+#endif
+
+/**
+ * @brief 矩阵乘法, 内维不匹配时无法通过编译
+ *
+ */
+template <uint32_t Row, uint32_t Inner, uint32_t Column, typename Type>
+Class_Matrix<Row, Column, Type> operator*(const Class_Matrix<Row, Inner, Type> &A, const Class_Matrix<Inner, Column, Type> &B)
+{
+    Class_Matrix<Row, Column, Type> result;
+    Matrix_Multiply(A, B, &result);
+    return (result);
+}
+
+/**
+ * @brief 向量点积
+ *
+ * @param A 向量
+ * @param B 向量
+ * @return Type 点积
+ */
+template <uint32_t N, typename Type>
+Type Matrix_Dot(const Class_Vector<N, Type> &A, const Class_Vector<N, Type> &B)
+{
+    Type sum = A.Data[0][0] * B.Data[0][0];
+    for (uint32_t i = 1; i < N; i++)
+    {
+        sum += A.Data[i][0] * B.Data[i][0];
+    }
+    return (sum);
+}
+
+/**
+ * @brief 求逆的可移植实现, 列主元高斯-约当消元
+ *
+ * @param A 方阵
+ * @param Result 逆矩阵, 奇异时内容无意义
+ * @return bool 是否可逆
+ */
+template <uint32_t N, typename Type>
+bool Matrix_Inverse_Portable(Class_Matrix<N, N, Type> A, Class_Matrix<N, N, Type> *Result)
+{
+    *Result = Class_Matrix<N, N, Type>::Identity();
+
+    for (uint32_t column = 0; column < N; column++)
+    {
+        // 选本列绝对值最大的元素为主元
+        uint32_t pivot = column;
+        for (uint32_t i = column + 1; i < N; i++)
+        {
+            if (Math_Abs(A.Data[i][column]) > Math_Abs(A.Data[pivot][column]))
+            {
+                pivot = i;
+            }
+        }
+        if (Math_Abs(A.Data[pivot][column]) < (Type) MATRIX_SINGULAR_EPSILON)
+        {
+            return (false);
+        }
+        if (pivot != column)
+        {
+            for (uint32_t j = 0; j < N; j++)
+            {
+                Type tmp = A.Data[pivot][j];
+                A.Data[pivot][j] = A.Data[column][j];
+                A.Data[column][j] = tmp;
+                tmp = Result->Data[pivot][j];
+                Result->Data[pivot][j] = Result->Data[column][j];
+                Result->Data[column][j] = tmp;
+            }
+        }
+
+        Type scale = (Type) 1 / A.Data[column][column];
+        for (uint32_t j = 0; j < N; j++)
+        {
+            A.Data[column][j] *= scale;
+            Result->Data[column][j] *= scale;
+        }
+
+        for (uint32_t i = 0; i < N; i++)
+        {
+            if (i == column)
+            {
+                continue;
+            }
+            Type factor = A.Data[i][column];
+            for (uint32_t j = 0; j < N; j++)
+            {
+                A.Data[i][j] -= factor * A.Data[column][j];
+                Result->Data[i][j] -= factor * Result->Data[column][j];
+            }
+        }
+    }
+
+    return (true);
+}
+
+/**
+ * @brief 求逆
+ *
+ * @param A 方阵
+ * @param Result 逆矩阵, 奇异时内容无意义
+ * @return bool 是否可逆
+ */
+template <uint32_t N, typename Type>
+inline bool Matrix_Inverse(const Class_Matrix<N, N, Type> &A, Class_Matrix<N, N, Type> *Result)
+{
+    return (Matrix_Inverse_Portable(A, Result));
+}
+
+#ifdef MATRIX_USE_CMSIS_DSP
+
+/**
+ * @brief 单精度求逆, 尺寸较大时交给arm_mat_inverse_f32
+ *
+ * @param A 方阵
+ * @param Result 逆矩阵, 奇异时内容无意义
+ * @return bool 是否可逆
+ */
+template <uint32_t N>
+inline bool Matrix_Inverse(const Class_Matrix<N, N, float> &A, Class_Matrix<N, N, float> *Result)
+{
+    if (N * N < MATRIX_CMSIS_DSP_MIN_SIZE)
+    {
+        return (Matrix_Inverse_Portable(A, Result));
+    }
+
+    // arm_mat_inverse_f32会改写源矩阵, 先复制一份
+    Class_Matrix<N, N, float> source = A;
+    arm_matrix_instance_f32 a, result;
+    arm_mat_init_f32(&a, N, N, &source.Data[0][0]);
+    arm_mat_init_f32(&result, N, N, &Result->Data[0][0]);
+    return (arm_mat_inverse_f32(&a, &result) == ARM_MATH_SUCCESS);
+}
+
+#endif
+
+/**
+ * @brief 求逆
+ *
+ * @param Result 逆矩阵, 奇异时内容无意义
+ * @return bool 是否可逆
+ */
+template <uint32_t Row, uint32_t Column, typename Type>
+bool Class_Matrix<Row, Column, Type>::Inverse(Class_Matrix *Result) const
+{
+    static_assert(Row == Column, "only square matrices have an inverse");
+
+    return (Matrix_Inverse(*this, Result));
+}
+
+#endif
+
+/******************************************************************/
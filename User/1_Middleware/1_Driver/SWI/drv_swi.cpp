@@ -0,0 +1,64 @@
+/**
+ * @file drv_swi.cpp
+ * @author WFZ
+ * @brief 软件中断, 用PendSV运行控制线程, 硬件中断只记录时间戳、入队后挂起控制线程
+ * @version 0.0
+ * @date 2026-1-28
+ *
+ *
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "drv_swi.h"
+
+/* Private macros ------------------------------------------------------------*/
+
+/* Private types -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+
+// 控制线程
+static SWI_Call_Back SWI_Callback_Function = NULL;
+
+/* Private function declarations ---------------------------------------------*/
+
+/* function prototypes -------------------------------------------------------*/
+
+/**
+ * @brief 初始化软件中断, 设定PendSV为最低优先级, 需在开启定时中断之前调用
+ *
+ * @param Callback_Function 控制线程
+ */
+void SWI_Init(SWI_Call_Back Callback_Function)
+{
+    SWI_Callback_Function = Callback_Function;
+    HAL_NVIC_SetPriority(PendSV_IRQn, SWI_PRIORITY, 0);
+}
+
+/**
+ * @brief 软件中断处理函数, 在PendSV_Handler中调用
+ *
+ */
+void SWI_IRQHandler(void)
+{
+    if (SWI_Callback_Function != NULL)
+    {
+        SWI_Callback_Function();
+    }
+}
+
+#ifdef HOST_SIMULATION
+
+/**
+ * @brief 主机仿真时没有stm32f4xx_it.c, 由仿真NVIC直接进入
+ *
+ */
+void PendSV_Handler(void)
+{
+    SWI_IRQHandler();
+}
+
+#endif
+
+/*******************************************************************/
@@ -0,0 +1,64 @@
+/**
+ * @file drv_swi.h
+ * @author WFZ
+ * @brief 软件中断, 用PendSV运行控制线程, 硬件中断只记录时间戳、入队后挂起控制线程
+ * @version 0.0
+ * @date 2026-1-28
+ *
+ * @note 中断优先级分配(NVIC_PRIORITYGROUP_4, 数值越小越优先):
+ *       0  CAN、USART与其DMA, 只记录时间戳并把数据放入邮箱或队列
+ *       2  TIM4, 1ms节拍, 只记录DWT周期数并挂起PendSV
+ *       14 SysTick, HAL_Delay与超时
+ *       15 PendSV, 控制线程, 运行调度器中的全部任务, 可被以上所有中断抢占
+ *       控制线程与中断共享的数据在控制线程中关中断拷贝, 中断中不访问控制线程的数据
+ *
+ */
+
+#ifndef DRV_SWI_H
+#define DRV_SWI_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "stm32f4xx_hal.h"
+
+/* Exported macros -----------------------------------------------------------*/
+
+// 控制线程的抢占优先级, 最低
+#define SWI_PRIORITY (15U)
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+ * @brief 软件中断回调函数数据类型
+ *
+ */
+typedef void (*SWI_Call_Back)(void);
+
+/* Exported variables --------------------------------------------------------*/
+
+/* Exported function declarations --------------------------------------------*/
+
+void SWI_Init(SWI_Call_Back Callback_Function);
+
+void SWI_IRQHandler(void);
+
+/**
+ * @brief 挂起软件中断, 在所有更高优先级的中断返回后进入
+ *
+ */
+static inline void SWI_Trigger(void)
+{
+    SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;
+}
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif
+
+/*******************************************************************/
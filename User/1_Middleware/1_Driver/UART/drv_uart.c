@@ -10,62 +10,225 @@
 /* Includes ------------------------------------------------------------------*/
 
 #include "drv_uart.h"
+#include <string.h>
 
 /* Private macros ------------------------------------------------------------*/
 
+// 每路UART占用的缓冲区字节数, 接收环形缓冲区加发送暂存区与两块乒乓缓冲区
+#define UART_PORT_BUFFER_SIZE(__Rx_Size, __Tx_Size) ((__Rx_Size) + 3 * (__Tx_Size))
+
+#define UART_BUFFER_POOL_SIZE (UART_PORT_BUFFER_SIZE(UART_USART1_RX_BUFFER_SIZE, UART_USART1_TX_BUFFER_SIZE) + \
+                               UART_PORT_BUFFER_SIZE(UART_USART2_RX_BUFFER_SIZE, UART_USART2_TX_BUFFER_SIZE) + \
+                               UART_PORT_BUFFER_SIZE(UART_USART3_RX_BUFFER_SIZE, UART_USART3_TX_BUFFER_SIZE) + \
+                               UART_PORT_BUFFER_SIZE(UART_UART4_RX_BUFFER_SIZE, UART_UART4_TX_BUFFER_SIZE) + \
+                               UART_PORT_BUFFER_SIZE(UART_UART5_RX_BUFFER_SIZE, UART_UART5_TX_BUFFER_SIZE) + \
+                               UART_PORT_BUFFER_SIZE(UART_USART6_RX_BUFFER_SIZE, UART_USART6_TX_BUFFER_SIZE))
+
+// 由UART外设地址得到登记表下标, 片上各UART基地址的第10~14位互不相同
+// 主机仿真时外设为Sim_USART_Instance数组中的元素, 用数组下标
+#ifdef HOST_SIMULATION
+#define UART_REGISTRY_KEY(__Instance) ((uint32_t) ((__Instance) - Sim_USART_Instance))
+#else
+#define UART_REGISTRY_KEY(__Instance) (((uint32_t) (__Instance) >> 10) & 0x1F)
+#endif
+
+#define UART_REGISTRY_SIZE 32
+
 /* Private types -------------------------------------------------------------*/
 
+/**
+ * @brief 每路UART的缓冲区配置
+ *
+ */
+typedef struct
+{
+    USART_TypeDef *Instance;
+    uint16_t Rx_Buffer_Size;
+    uint16_t Tx_Buffer_Size;
+} Struct_UART_Port_Config;
+
 /* Private variables ---------------------------------------------------------*/
-Struct_UART_Manage_Object UART1_Manage_Object = {0};   //丝印UART1 --> 实际USART6外设
-Struct_UART_Manage_Object UART2_Manage_Object = {0};  //丝印UART2 --> 实际USART1外设
-Struct_UART_Manage_Object DBUS_Manage_Object = {0};  //丝印DBUS --> 实际USART3外设
+
+// 各UART的缓冲区配置, 顺序与缓冲区池中的存放顺序一致
+static const Struct_UART_Port_Config UART_Port_Config[UART_PORT_NUM] =
+{
+    {USART1, UART_USART1_RX_BUFFER_SIZE, UART_USART1_TX_BUFFER_SIZE}, //丝印UART2
+    {USART2, UART_USART2_RX_BUFFER_SIZE, UART_USART2_TX_BUFFER_SIZE},
+    {USART3, UART_USART3_RX_BUFFER_SIZE, UART_USART3_TX_BUFFER_SIZE}, //丝印DBUS
+    {UART4, UART_UART4_RX_BUFFER_SIZE, UART_UART4_TX_BUFFER_SIZE},
+    {UART5, UART_UART5_RX_BUFFER_SIZE, UART_UART5_TX_BUFFER_SIZE},
+    {USART6, UART_USART6_RX_BUFFER_SIZE, UART_USART6_TX_BUFFER_SIZE}, //丝印UART1
+};
+
+// 所有UART的缓冲区, 只包含配置了缓冲区的UART
+static uint8_t UART_Buffer_Pool[UART_BUFFER_POOL_SIZE > 0 ? UART_BUFFER_POOL_SIZE : 1];
+
+static Struct_UART_Manage_Object UART_Manage_Object[UART_PORT_NUM] = {0};
+
+// 按UART外设登记的处理结构体, 未初始化的UART为NULL
+static Struct_UART_Manage_Object *UART_Registry[UART_REGISTRY_SIZE] = {0};
 
 /* Private function declarations ---------------------------------------------*/
 
+static void UART_Rx_Start(Struct_UART_Manage_Object *UART_Manage_Object);
+
+static void UART_Rx_Deliver(Struct_UART_Manage_Object *UART_Manage_Object, uint16_t Length);
+
+static void UART_Tx_Start(UART_HandleTypeDef *huart, Struct_UART_Manage_Object *UART_Manage_Object);
+
 /* function prototypes -------------------------------------------------------*/
 
 /**
- * @brief 初始化UART. 优化思路：回调函数还可优化为DMA空闲中断接收
+ * @brief 初始化UART, 按该UART的配置分配缓冲区并登记; 配置了接收缓冲区时以循环DMA接收,
+ *        空闲、半传输、传输完成事件中把收到的帧交给回调函数
  *
  * @param huart UART编号
  * @param Callback_Function 处理回调函数
+ * @param Rx_Buffer_Length 单帧最大长度, 超过接收缓冲区的一半时按一半处理
  */
 void UART_Init(UART_HandleTypeDef *huart, UART_Call_Back Callback_Function, uint16_t Rx_Buffer_Length)
 {
-    if (huart->Instance == USART6)
+    uint32_t key = UART_REGISTRY_KEY(huart->Instance);
+    uint8_t *buffer = UART_Buffer_Pool;
+    uint8_t index;
+
+    // 各UART的缓冲区在池中依次存放, 前面UART的缓冲区之后即为该UART的缓冲区
+    for (index = 0; index < UART_PORT_NUM; index++)
     {
-        UART1_Manage_Object.UART_Handler = huart;
-        UART1_Manage_Object.Callback_Function = Callback_Function;
-        UART1_Manage_Object.Rx_Buffer_Length = Rx_Buffer_Length;
-		HAL_UARTEx_ReceiveToIdle_IT(huart, UART1_Manage_Object.Rx_Buffer, UART1_Manage_Object.Rx_Buffer_Length);
+        if (UART_Port_Config[index].Instance == huart->Instance)
+        {
+            break;
+        }
+        buffer += UART_PORT_BUFFER_SIZE(UART_Port_Config[index].Rx_Buffer_Size, UART_Port_Config[index].Tx_Buffer_Size);
     }
-    else if (huart->Instance == USART1)
+
+    if (index == UART_PORT_NUM || key >= UART_REGISTRY_SIZE)
     {
-        UART2_Manage_Object.UART_Handler = huart;
-        UART2_Manage_Object.Callback_Function = Callback_Function;
-        UART2_Manage_Object.Rx_Buffer_Length = Rx_Buffer_Length;
-        HAL_UARTEx_ReceiveToIdle_IT(huart, UART2_Manage_Object.Rx_Buffer, UART2_Manage_Object.Rx_Buffer_Length);
+        return;
     }
-    else if (huart->Instance == USART3)
+
+    const Struct_UART_Port_Config *config = &UART_Port_Config[index];
+    Struct_UART_Manage_Object *obj = &UART_Manage_Object[index];
+
+    // 未处理的数据不超过半个缓冲区, DMA写另一半时不会覆盖
+    if (Rx_Buffer_Length == 0 || Rx_Buffer_Length > config->Rx_Buffer_Size / 2)
+    {
+        Rx_Buffer_Length = config->Rx_Buffer_Size / 2;
+    }
+
+    obj->UART_Handler = huart;
+    obj->Callback_Function = Callback_Function;
+    obj->Rx_Buffer_Length = Rx_Buffer_Length;
+    obj->Rx_Buffer = buffer;
+    obj->Rx_Buffer_Size = config->Rx_Buffer_Size;
+    obj->Tx_Buffer = buffer + config->Rx_Buffer_Size;
+    obj->Tx_DMA_Buffer[0] = obj->Tx_Buffer + config->Tx_Buffer_Size;
+    obj->Tx_DMA_Buffer[1] = obj->Tx_DMA_Buffer[0] + config->Tx_Buffer_Size;
+    obj->Tx_Buffer_Size = config->Tx_Buffer_Size;
+    UART_Registry[key] = obj;
+
+    if (obj->Rx_Buffer_Size > 0)
+    {
+        UART_Rx_Start(obj);
+    }
+}
+
+/**
+ * @brief 由UART编号找到处理结构体
+ *
+ * @param huart UART编号
+ * @return Struct_UART_Manage_Object* 处理结构体, 未初始化的UART返回NULL
+ */
+Struct_UART_Manage_Object *UART_Get_Manage_Object(UART_HandleTypeDef *huart)
+{
+    uint32_t key = UART_REGISTRY_KEY(huart->Instance);
+
+    return (key < UART_REGISTRY_SIZE ? UART_Registry[key] : NULL);
+}
+
+/**
+ * @brief 获取一帧的总长度
+ *
+ * @param Rx_Span 接收到的帧
+ * @return uint16_t 长度
+ */
+uint16_t UART_Rx_Span_Get_Length(const Struct_UART_Rx_Span *Rx_Span)
+{
+    return (Rx_Span->Length + Rx_Span->Wrap_Length);
+}
+
+/**
+ * @brief 读取一帧中的第Index个字节, 自动处理回绕
+ *
+ * @param Rx_Span 接收到的帧
+ * @param Index 下标, 需小于帧长度
+ * @return uint8_t 该字节
+ */
+uint8_t UART_Rx_Span_Get_Byte(const Struct_UART_Rx_Span *Rx_Span, uint16_t Index)
+{
+    return (Index < Rx_Span->Length ? Rx_Span->Data[Index] : Rx_Span->Wrap_Data[Index - Rx_Span->Length]);
+}
+
+/**
+ * @brief 获取一帧的连续内存, 未回绕时直接返回环形缓冲区中的地址, 回绕时拼接到Buffer
+ *
+ * @param Rx_Span 接收到的帧
+ * @param Buffer 拼接用的缓冲区, 长度不小于帧长度
+ * @return uint8_t* 连续存放该帧的地址
+ */
+uint8_t *UART_Rx_Span_Linearize(const Struct_UART_Rx_Span *Rx_Span, uint8_t *Buffer)
+{
+    if (Rx_Span->Wrap_Length == 0)
     {
-        DBUS_Manage_Object.UART_Handler = huart;
-        DBUS_Manage_Object.Callback_Function = Callback_Function;
-        DBUS_Manage_Object.Rx_Buffer_Length = Rx_Buffer_Length;
-        HAL_UARTEx_ReceiveToIdle_IT(huart, DBUS_Manage_Object.Rx_Buffer, DBUS_Manage_Object.Rx_Buffer_Length);
+        return (Rx_Span->Data);
     }
+
+    memcpy(Buffer, Rx_Span->Data, Rx_Span->Length);
+    memcpy(Buffer + Rx_Span->Length, Rx_Span->Wrap_Data, Rx_Span->Wrap_Length);
+    return (Buffer);
 }
 
 /**
- * @brief 发送数据帧. 优化思路：不再手动传入UART_HandleTypeDef *huart，传入Struct_UART_Manage_Object后自动选择UART_Handler,uint8_t *Data同理,最后只需传入要发送的字节数即可
+ * @brief 发送数据帧, 不阻塞. 数据被复制进乒乓缓冲区中不属于DMA的一块, 返回后Data可立即改写;
+ *        DMA空闲时立即发送, 否则排队到上一次发送完成
  *
  * @param huart UART编号
  * @param Data 被发送的数据指针
  * @param Length 长度
- * @return uint8_t 执行状态
+ * @return uint8_t 执行状态, HAL_BUSY为队列满或放不下, 该帧被丢弃
  */
 uint8_t UART_Send_Data(UART_HandleTypeDef *huart, uint8_t *Data, uint16_t Length)
 {
-    return (HAL_UART_Transmit_DMA(huart, Data, Length));
+    Struct_UART_Manage_Object *obj = UART_Get_Manage_Object(huart);
+
+    if (obj == NULL)
+    {
+        return (HAL_ERROR);
+    }
+
+    // 发送完成中断优先级高于调用者, 排队与切换缓冲区期间关中断
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    if (obj->Tx_Queue_Num >= UART_TX_QUEUE_NUM || obj->Tx_Queue_Length + Length > obj->Tx_Buffer_Size)
+    {
+        obj->Tx_Drop_Num++;
+        __set_PRIMASK(primask);
+        return (HAL_BUSY);
+    }
+
+    memcpy(&obj->Tx_DMA_Buffer[obj->Tx_Fill_Index][obj->Tx_Queue_Length], Data, Length);
+    obj->Tx_Queue_Length += Length;
+    obj->Tx_Queue_Num++;
+
+    // 上一次发送被中止而没有完成回调时HAL已空闲, 同样立即发送
+    if (!obj->Tx_Busy || huart->gState == HAL_UART_STATE_READY)
+    {
+        UART_Tx_Start(huart, obj);
+    }
+
+    __set_PRIMASK(primask);
+    return (HAL_OK);
 }
 
 /**
@@ -74,34 +237,180 @@ uint8_t UART_Send_Data(UART_HandleTypeDef *huart, uint8_t *Data, uint16_t Length
  */
 void TIM_UART_PeriodElapsedCallback()
 {
+    Struct_UART_Manage_Object *obj = UART_Get_Manage_Object(&huart1);
+
+    if (obj == NULL)
+    {
+        return;
+    }
+
     // huart1绑定串口绘图功能,专门向serialplot发送数据或者接收serialplot的数据,且一次发送的数据为1+20*4字节,绑定serialplot为20个float类型数据的通道
-    UART_Send_Data(&huart1, UART2_Manage_Object.Tx_Buffer, 1 + 20 * sizeof(float));
+    UART_Send_Data(&huart1, obj->Tx_Buffer, 1 + 20 * sizeof(float));
 }
 
 /**
- * @brief HAL库UART接收空闲中断. 优化思路：回调函数还可优化为DMA空闲中断接收
+ * @brief HAL库UART接收事件回调, 循环DMA下半传输、传输完成和空闲时都会进入
+ *
+ * 收到的数据先累积, 空闲时作为一帧交付; 收满单帧最大长度仍未空闲时按最大长度分帧,
+ * 因此帧恰好结束在缓冲区末尾而HAL不产生空闲事件时, 定长帧也能及时交付
  *
  * @param huart UART编号
- * @param Size 长度
+ * @param Size DMA写指针, 即本轮缓冲区中已写入的字节数
  */
 void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size)
 {
-    //选择回调函数
-    if (huart->Instance == USART6)
+    Struct_UART_Manage_Object *obj = UART_Get_Manage_Object(huart);
+
+    if (obj == NULL || obj->Rx_Buffer_Size == 0)
+    {
+        return;
+    }
+
+    // 两次事件之间DMA最多写半个缓冲区, 写指针之差即为新收到的字节数
+    uint16_t write_index = Size % obj->Rx_Buffer_Size;
+    obj->Rx_Frame_Length += (uint16_t) (write_index + obj->Rx_Buffer_Size - obj->Rx_Write_Index) % obj->Rx_Buffer_Size;
+    obj->Rx_Write_Index = write_index;
+
+    while (obj->Rx_Frame_Length >= obj->Rx_Buffer_Length)
+    {
+        UART_Rx_Deliver(obj, obj->Rx_Buffer_Length);
+    }
+    if (HAL_UARTEx_GetRxEventType(huart) == HAL_UART_RXEVENT_IDLE && obj->Rx_Frame_Length > 0)
+    {
+        UART_Rx_Deliver(obj, obj->Rx_Frame_Length);
+    }
+}
+
+/**
+ * @brief HAL库UART发送完成回调, 发送排队的帧
+ *
+ * @param huart UART编号
+ */
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
+{
+    Struct_UART_Manage_Object *obj = UART_Get_Manage_Object(huart);
+
+    if (obj == NULL)
+    {
+        return;
+    }
+
+    obj->Tx_Busy = false;
+    UART_Tx_Start(huart, obj);
+}
+
+/**
+ * @brief HAL库UART错误回调, 溢出等错误会停止DMA接收, 在此重新开启; DMA发送出错被中止时发送排队的帧
+ *
+ * @param huart UART编号
+ */
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
+{
+    Struct_UART_Manage_Object *obj = UART_Get_Manage_Object(huart);
+
+    if (obj == NULL)
+    {
+        return;
+    }
+
+    if (obj->Tx_Busy && huart->gState == HAL_UART_STATE_READY)
+    {
+        obj->Tx_Busy = false;
+        UART_Tx_Start(huart, obj);
+    }
+
+    // 只出现发送错误时接收仍在进行, 不重启
+    if (obj->Rx_Buffer_Size > 0 && huart->RxState == HAL_UART_STATE_READY)
+    {
+        obj->Rx_Error_Num++;
+        UART_Rx_Start(obj);
+    }
+}
+
+/**
+ * @brief 从缓冲区起始处开启循环DMA接收, 未交付的数据丢弃
+ *
+ * @param UART_Manage_Object 处理结构体
+ */
+static void UART_Rx_Start(Struct_UART_Manage_Object *UART_Manage_Object)
+{
+    UART_Manage_Object->Rx_Frame_Start = 0;
+    UART_Manage_Object->Rx_Frame_Length = 0;
+    UART_Manage_Object->Rx_Write_Index = 0;
+    HAL_UARTEx_ReceiveToIdle_DMA(UART_Manage_Object->UART_Handler, UART_Manage_Object->Rx_Buffer, UART_Manage_Object->Rx_Buffer_Size);
+}
+
+/**
+ * @brief 把未交付数据的前Length字节作为一帧交给回调函数, 回调返回后释放这段缓冲区
+ *
+ * @param UART_Manage_Object 处理结构体
+ * @param Length 帧长度
+ */
+static void UART_Rx_Deliver(Struct_UART_Manage_Object *UART_Manage_Object, uint16_t Length)
+{
+    Struct_UART_Rx_Span rx_span;
+    uint16_t buffer_size = UART_Manage_Object->Rx_Buffer_Size;
+    uint16_t tail_length = buffer_size - UART_Manage_Object->Rx_Frame_Start;
+
+    rx_span.Data = &UART_Manage_Object->Rx_Buffer[UART_Manage_Object->Rx_Frame_Start];
+    rx_span.Length = Length < tail_length ? Length : tail_length;
+    rx_span.Wrap_Data = UART_Manage_Object->Rx_Buffer;
+    rx_span.Wrap_Length = Length - rx_span.Length;
+    rx_span.Timestamp_Us = DWT_Get_Us();
+
+    UART_Manage_Object->Rx_Frame_Num++;
+    if (UART_Manage_Object->Callback_Function != NULL)
     {
-        UART1_Manage_Object.Callback_Function(UART1_Manage_Object.Rx_Buffer, Size);
-        HAL_UARTEx_ReceiveToIdle_IT(huart, UART1_Manage_Object.Rx_Buffer, UART1_Manage_Object.Rx_Buffer_Length);
+        UART_Manage_Object->Callback_Function(&rx_span);
     }
-    else if (huart->Instance == USART1)
+
+    // 回调期间DMA继续写入, 写过的字节数超过空闲空间说明该帧已被覆盖
+    uint16_t dma_index = (buffer_size - __HAL_DMA_GET_COUNTER(UART_Manage_Object->UART_Handler->hdmarx)) % buffer_size;
+    uint16_t new_length = (uint16_t) (dma_index + buffer_size - UART_Manage_Object->Rx_Write_Index) % buffer_size;
+    if (new_length + UART_Manage_Object->Rx_Frame_Length > buffer_size)
     {
-        UART2_Manage_Object.Callback_Function(UART2_Manage_Object.Rx_Buffer, Size);
-        HAL_UARTEx_ReceiveToIdle_IT(huart, UART2_Manage_Object.Rx_Buffer, UART2_Manage_Object.Rx_Buffer_Length);
+        UART_Manage_Object->Rx_Overwrite_Num++;
     }
-    else if (huart->Instance == USART3)
+
+    UART_Manage_Object->Rx_Frame_Start = (UART_Manage_Object->Rx_Frame_Start + Length) % buffer_size;
+    UART_Manage_Object->Rx_Frame_Length -= Length;
+}
+
+/**
+ * @brief 把正在接收新帧的一块交给DMA发送, 另一块开始接收新帧; 需在关中断或发送完成中断中调用
+ *
+ * @param huart UART编号
+ * @param UART_Manage_Object 处理结构体
+ */
+static void UART_Tx_Start(UART_HandleTypeDef *huart, Struct_UART_Manage_Object *UART_Manage_Object)
+{
+    uint8_t index = UART_Manage_Object->Tx_Fill_Index;
+    uint8_t queue_num = UART_Manage_Object->Tx_Queue_Num;
+    uint16_t queue_length = UART_Manage_Object->Tx_Queue_Length;
+
+    if (queue_length == 0)
+    {
+        return;
+    }
+
+    // 先切换缓冲区再启动DMA, 发送完成回调可能在启动过程中就进入
+    UART_Manage_Object->Tx_Fill_Index = index ^ 1;
+    UART_Manage_Object->Tx_Queue_Num = 0;
+    UART_Manage_Object->Tx_Queue_Length = 0;
+    UART_Manage_Object->Tx_Busy = true;
+
+    if (HAL_UART_Transmit_DMA(huart, UART_Manage_Object->Tx_DMA_Buffer[index], queue_length) != HAL_OK)
     {
-        DBUS_Manage_Object.Callback_Function(DBUS_Manage_Object.Rx_Buffer, Size);
-        HAL_UARTEx_ReceiveToIdle_IT(huart, DBUS_Manage_Object.Rx_Buffer, DBUS_Manage_Object.Rx_Buffer_Length);
+        // HAL被占用, 退回这一块等下一次发送
+        UART_Manage_Object->Tx_Fill_Index = index;
+        UART_Manage_Object->Tx_Queue_Num = queue_num;
+        UART_Manage_Object->Tx_Queue_Length = queue_length;
+        UART_Manage_Object->Tx_Busy = huart->gState != HAL_UART_STATE_READY;
+        return;
     }
+
+    UART_Manage_Object->Tx_Frame_Num += queue_num;
+    UART_Manage_Object->Tx_Byte_Num += queue_length;
 }
 
 /************************ XXU-EIStudio (C)**************************/
@@ -14,30 +14,126 @@
 /* Includes ------------------------------------------------------------------*/
 
 #include "stm32f4xx_hal.h"
+#include "drv_dwt.h"
 
 /* Exported macros -----------------------------------------------------------*/
 
-// Struct_UART_Manage_Object 中Tx_Buffer，Rx_Buffer的缓冲区字节长度
-#define UART_BUFFER_SIZE 256
+// 各UART的接收环形缓冲区与发送缓冲区字节数, 未使用的UART设为0, 不占用内存
+// 发送缓冲区实际占用3倍(暂存区与两块乒乓缓冲区); 接收单帧最长为接收缓冲区的一半
+// 丝印UART2, 串口绘图
+#ifndef UART_USART1_RX_BUFFER_SIZE
+#define UART_USART1_RX_BUFFER_SIZE 256
+#endif
+#ifndef UART_USART1_TX_BUFFER_SIZE
+#define UART_USART1_TX_BUFFER_SIZE 256
+#endif
+#ifndef UART_USART2_RX_BUFFER_SIZE
+#define UART_USART2_RX_BUFFER_SIZE 0
+#endif
+#ifndef UART_USART2_TX_BUFFER_SIZE
+#define UART_USART2_TX_BUFFER_SIZE 0
+#endif
+// 丝印DBUS, 遥控器
+#ifndef UART_USART3_RX_BUFFER_SIZE
+#define UART_USART3_RX_BUFFER_SIZE 128
+#endif
+#ifndef UART_USART3_TX_BUFFER_SIZE
+#define UART_USART3_TX_BUFFER_SIZE 0
+#endif
+#ifndef UART_UART4_RX_BUFFER_SIZE
+#define UART_UART4_RX_BUFFER_SIZE 0
+#endif
+#ifndef UART_UART4_TX_BUFFER_SIZE
+#define UART_UART4_TX_BUFFER_SIZE 0
+#endif
+#ifndef UART_UART5_RX_BUFFER_SIZE
+#define UART_UART5_RX_BUFFER_SIZE 0
+#endif
+#ifndef UART_UART5_TX_BUFFER_SIZE
+#define UART_UART5_TX_BUFFER_SIZE 0
+#endif
+// 丝印UART1
+#ifndef UART_USART6_RX_BUFFER_SIZE
+#define UART_USART6_RX_BUFFER_SIZE 0
+#endif
+#ifndef UART_USART6_TX_BUFFER_SIZE
+#define UART_USART6_TX_BUFFER_SIZE 0
+#endif
+
+// 片上UART数, 依次为USART1, USART2, USART3, UART4, UART5, USART6
+#define UART_PORT_NUM 6
+
+// 每路UART在DMA发送期间可排队的帧数, 排队的帧在上一次发送完成后合并为一次DMA发送
+#define UART_TX_QUEUE_NUM 4
 
 /* Exported types ------------------------------------------------------------*/
 
+/**
+ * @brief 接收到的一帧在环形缓冲区中的位置, 跨过缓冲区末尾时分为两段, 数据不复制
+ *
+ * 只在回调函数执行期间有效, 回调函数返回即视为该帧已处理完, 之后这段缓冲区会被DMA覆盖
+ *
+ */
+typedef struct
+{
+    // 第一段, 从帧头到帧尾或缓冲区末尾
+    uint8_t *Data;
+    uint16_t Length;
+    // 回绕后的第二段, 从缓冲区起始处开始, 未回绕时长度为0
+    uint8_t *Wrap_Data;
+    uint16_t Wrap_Length;
+    // 接收中断交付该帧时的微秒时钟
+    uint32_t Timestamp_Us;
+} Struct_UART_Rx_Span;
+
 /**
  * @brief UART通信接收回调函数数据类型
  *
  */
-typedef void (*UART_Call_Back)(uint8_t *Buffer, uint16_t Length);
+typedef void (*UART_Call_Back)(const Struct_UART_Rx_Span *Rx_Span);
 
 /**
- * @brief UART通信处理结构体
+ * @brief UART通信处理结构体, 由UART_Init按UART外设登记, 缓冲区按该UART的配置从缓冲区池中分配
  */
 typedef struct 
 {
     UART_HandleTypeDef *UART_Handler;
-    uint8_t Tx_Buffer[UART_BUFFER_SIZE];
-    uint8_t Rx_Buffer[UART_BUFFER_SIZE];
+    // 发送暂存区, 在此组帧后调用UART_Send_Data, 数据被复制进发送队列, DMA不直接读取暂存区
+    uint8_t *Tx_Buffer;
+    // 乒乓发送缓冲区, 一块交给DMA发送时另一块接收新帧
+    uint8_t *Tx_DMA_Buffer[2];
+    // 暂存区与每块乒乓缓冲区的字节数
+    uint16_t Tx_Buffer_Size;
+    // 正在接收新帧的一块
+    uint8_t Tx_Fill_Index;
+    // 该块中排队的帧数与字节数
+    uint8_t Tx_Queue_Num;
+    uint16_t Tx_Queue_Length;
+    // 另一块正由DMA发送
+    volatile bool Tx_Busy;
+    // 交给DMA发送的帧数与字节数
+    uint32_t Tx_Frame_Num;
+    uint32_t Tx_Byte_Num;
+    // 队列满或放不下被丢弃的帧数
+    uint32_t Tx_Drop_Num;
+    // 循环DMA的接收环形缓冲区
+    uint8_t *Rx_Buffer;
+    uint16_t Rx_Buffer_Size;
+    // 单帧最大长度, 不超过Rx_Buffer_Size / 2, 收满该长度仍未空闲时按该长度分帧
     uint16_t Rx_Buffer_Length;
     UART_Call_Back Callback_Function;
+    // 尚未交付的数据在环形缓冲区中的起始位置
+    uint16_t Rx_Frame_Start;
+    // 尚未交付的字节数
+    uint16_t Rx_Frame_Length;
+    // 上一次接收事件时DMA的写指针
+    uint16_t Rx_Write_Index;
+    // 交付的帧数
+    uint32_t Rx_Frame_Num;
+    // 回调函数返回前DMA已写到该帧所在位置的次数, 该帧的数据可能已被覆盖
+    uint32_t Rx_Overwrite_Num;
+    // 接收错误(溢出、帧错误、噪声)后重新开启接收的次数
+    uint32_t Rx_Error_Num;
 }Struct_UART_Manage_Object;
 
 /* Exported variables --------------------------------------------------------*/
@@ -46,14 +142,18 @@ extern UART_HandleTypeDef huart1;//对应丝印UART2
 extern UART_HandleTypeDef huart3;////对应丝印DBUS
 //extern UART_HandleTypeDef huart6;//对应丝印UART1
 
-extern Struct_UART_Manage_Object UART1_Manage_Object;
-extern Struct_UART_Manage_Object UART2_Manage_Object;
-extern Struct_UART_Manage_Object DBUS_Manage_Object;
-
 /* Exported function declarations --------------------------------------------*/
 
 void UART_Init(UART_HandleTypeDef *huart, UART_Call_Back Callback_Function, uint16_t Rx_Buffer_Length);
 
+Struct_UART_Manage_Object *UART_Get_Manage_Object(UART_HandleTypeDef *huart);
+
+uint16_t UART_Rx_Span_Get_Length(const Struct_UART_Rx_Span *Rx_Span);
+
+uint8_t UART_Rx_Span_Get_Byte(const Struct_UART_Rx_Span *Rx_Span, uint16_t Index);
+
+uint8_t *UART_Rx_Span_Linearize(const Struct_UART_Rx_Span *Rx_Span, uint8_t *Buffer);
+
 uint8_t UART_Send_Data(UART_HandleTypeDef *huart, uint8_t *Data, uint16_t Length);
 
 void TIM_UART_PeriodElapsedCallback();
@@ -72,11 +172,13 @@ void TIM_UART_PeriodElapsedCallback();
 
 void SystemClock_Config(void);
 
-//为串口绘图(huart1/UART2_Manage_Object)功能绑定的回调函数,用于处理串口绘图指令
-void UART_Serialplot_Call_Back(uint8_t *Buffer, uint16_t Length)  
+//为串口绘图(huart1, 丝印UART2)功能绑定的回调函数,用于处理串口绘图指令
+//接收由循环DMA+空闲中断完成, Rx_Span直接指向环形缓冲区, 帧跨过缓冲区末尾时分为两段
+void UART_Serialplot_Call_Back(const Struct_UART_Rx_Span *Rx_Span)  
 {
     // 你处理接收数据的逻辑...
-    // 例如，判断指令变量数值并执行相应操作
+    // 例如，逐字节读取UART_Rx_Span_Get_Byte(Rx_Span, i)，判断指令变量数值并执行相应操作
+    // 需要连续内存时用UART_Rx_Span_Linearize(Rx_Span, buffer)，只有回绕的帧才会复制到buffer
 }
 
 int main(void)
@@ -89,17 +191,19 @@ int main(void)
   MX_DMA_Init();
   MX_USART1_UART_Init();
   
-  // 注册UART2_Manage_Object
-  UART_Init(&huart1, UART_Serialplot_Call_Back, 256);  
+  // 登记huart1, 缓冲区大小由UART_USART1_RX_BUFFER_SIZE与UART_USART1_TX_BUFFER_SIZE配置, 单帧最长100字节
+  UART_Init(&huart1, UART_Serialplot_Call_Back, 100);  
+  Struct_UART_Manage_Object *uart2 = UART_Get_Manage_Object(&huart1);
 
   while (1)
   {		
-     //自动发送UART2_Manage_Object.Tx_Buffer中的数据,在此程序中UART2_Manage_Object.Tx_Buffer中的数据还是初始化值，因为我们没给它赋值
+     //自动发送uart2->Tx_Buffer中的数据,在此程序中uart2->Tx_Buffer中的数据还是初始化值，因为我们没给它赋值
+     //UART_Send_Data不会阻塞, 数据被复制进发送队列后Tx_Buffer可立即改写; 上一帧没发完时排队, 队列满时丢弃并计入Tx_Drop_Num
 		TIM_UART_PeriodElapsedCallback();  
 
 		//若想发送任意想发的数据.例如：发送一个字节的0x55
-		UART2_Manage_Object.Tx_Buffer[0] = 0x55;  
-		UART_Send_Data(&huart1, UART2_Manage_Object.Tx_Buffer, 1);  
+		uart2->Tx_Buffer[0] = 0x55;  
+		UART_Send_Data(&huart1, uart2->Tx_Buffer, 1);  
 
 		//延时1ms
 		HAL_Delay(0);
@@ -0,0 +1,399 @@
+/**
+ * @file alg_autotuner.cpp
+ * @author WFZ
+ * @brief 继电反馈PID自整定
+ * @version 0.0
+ * @date 2026-2-4
+ *
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "alg_autotuner.h"
+
+/* Private macros ------------------------------------------------------------*/
+
+/* Private types -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+
+/* Private function declarations ---------------------------------------------*/
+
+/* Function prototypes -------------------------------------------------------*/
+
+/**
+ * @brief 初始化自整定参数
+ *
+ * @param __Relay_Amplitude 继电幅值, 执行器指令的单位
+ * @param __Relay_Hysteresis 继电滞环, 反馈的单位, 取反馈噪声峰峰值的1~2倍
+ * @param __D_T 名义控制周期, s
+ * @param __Timeout 超时时间, s
+ * @param __Error_Max 反馈偏离目标的上限, 超过即失败, 0表示不检查
+ * @param __Settle_Cycle_Num 开始测量前舍弃的周期数
+ * @param __Measure_Cycle_Num 参与平均的周期数, 不超过AUTOTUNER_CYCLE_NUM_MAX
+ * @param __Tolerance 参与平均的各周期周期与幅值的相对极差上限
+ */
+void Class_PID_Autotuner::Init(float __Relay_Amplitude, float __Relay_Hysteresis, float __D_T, float __Timeout, float __Error_Max, uint8_t __Settle_Cycle_Num, uint8_t __Measure_Cycle_Num, float __Tolerance)
+{
+    Relay_Amplitude = Math_Abs(__Relay_Amplitude);
+    Relay_Hysteresis = Math_Abs(__Relay_Hysteresis);
+    D_T = (__D_T > 0.0f) ? __D_T : 0.001f;
+    Timeout = __Timeout;
+    Error_Max = __Error_Max;
+    Settle_Cycle_Num = __Settle_Cycle_Num;
+    Measure_Cycle_Num = __Measure_Cycle_Num;
+    Math_Constrain(&Measure_Cycle_Num, (uint8_t) 1, (uint8_t) AUTOTUNER_CYCLE_NUM_MAX);
+    Tolerance = __Tolerance;
+
+    Relay.Init(D_T);
+    Status = PID_Autotuner_Status_IDLE;
+    Out = 0.0f;
+}
+
+/**
+ * @brief 开始继电激励, 调用前被整定的环应已断开
+ *
+ * @param __Target 振荡中心的目标值
+ * @param __Now 当前反馈, 用于估计静态增益
+ * @param __Bias 偏置, 即当前维持反馈所需的执行器指令, 继电输出为 __Bias ± 继电幅值
+ */
+void Class_PID_Autotuner::Start(float __Target, float __Now, float __Bias)
+{
+    Target = __Target;
+    Start_Now = __Now;
+    Bias = __Bias;
+
+    Relay.Init(D_T);
+    Relay.Relay(Relay_Amplitude, Relay_Hysteresis, Bias);
+
+    Status = PID_Autotuner_Status_RUNNING;
+    Out = Bias;
+    Time = 0.0f;
+    Pre_Relay_High = true;
+    Rising_Num = 0;
+    Cycle_Time = 0.0f;
+    Cycle_Num = 0;
+
+    Ultimate_Gain = 0.0f;
+    Ultimate_Period = 0.0f;
+    Oscillation_Amplitude = 0.0f;
+    Static_Gain = 0.0f;
+    Integrating_Gain = 0.0f;
+    Dead_Time = 0.0f;
+    Time_Constant = 0.0f;
+}
+
+/**
+ * @brief 中止继电激励, 输出回到偏置
+ *
+ */
+void Class_PID_Autotuner::Stop()
+{
+    if (Status == PID_Autotuner_Status_RUNNING)
+    {
+        Status = PID_Autotuner_Status_FAILURE;
+    }
+    Out = Bias;
+}
+
+/**
+ * @brief 按整定规则计算PID参数
+ *
+ * @param __Rule 整定规则
+ * @param __K_P 比例增益
+ * @param __K_I 积分增益, 即 K_P / T_I
+ * @param __K_D 微分增益, 即 K_P · T_D
+ * @return true 已成功整定
+ * @return false 尚无结果, 参数不变
+ */
+bool Class_PID_Autotuner::Get_Gain(Enum_PID_Autotuner_Rule __Rule, float *__K_P, float *__K_I, float *__K_D)
+{
+    if (Status != PID_Autotuner_Status_SUCCESS)
+    {
+        return (false);
+    }
+
+    float k_c, t_i, t_d = 0.0f;
+    switch (__Rule)
+    {
+    case (PID_Autotuner_Rule_ZIEGLER_NICHOLS_PI):
+    {
+        k_c = 0.45f * Ultimate_Gain;
+        t_i = Ultimate_Period / 1.2f;
+        break;
+    }
+    case (PID_Autotuner_Rule_ZIEGLER_NICHOLS_PID):
+    {
+        k_c = 0.6f * Ultimate_Gain;
+        t_i = Ultimate_Period / 2.0f;
+        t_d = Ultimate_Period / 8.0f;
+        break;
+    }
+    case (PID_Autotuner_Rule_TYREUS_LUYBEN_PI):
+    {
+        k_c = Ultimate_Gain / 3.2f;
+        t_i = 2.2f * Ultimate_Period;
+        break;
+    }
+    case (PID_Autotuner_Rule_TYREUS_LUYBEN_PID):
+    {
+        k_c = Ultimate_Gain / 2.2f;
+        t_i = 2.2f * Ultimate_Period;
+        t_d = Ultimate_Period / 6.3f;
+        break;
+    }
+    case (PID_Autotuner_Rule_SIMC_PI):
+    default:
+    {
+        // 闭环时间常数取纯滞后
+        float t_c = Dead_Time;
+        if (Static_Gain > 0.0f)
+        {
+            k_c = Time_Constant / (Static_Gain * (t_c + Dead_Time));
+            t_i = fminf(Time_Constant, 4.0f * (t_c + Dead_Time));
+        }
+        else
+        {
+            k_c = 1.0f / (Integrating_Gain * (t_c + Dead_Time));
+            t_i = 4.0f * (t_c + Dead_Time);
+        }
+        break;
+    }
+    }
+
+    *__K_P = k_c;
+    *__K_I = k_c / t_i;
+    *__K_D = k_c * t_d;
+    return (true);
+}
+
+/**
+ * @brief 按整定规则写入PID参数
+ *
+ * @param __PID 被整定的PID
+ * @param __Rule 整定规则
+ * @return true 已写入
+ * @return false 尚无结果, 参数不变
+ */
+bool Class_PID_Autotuner::Apply(Class_PID *__PID, Enum_PID_Autotuner_Rule __Rule)
+{
+    float k_p, k_i, k_d;
+    if (!Get_Gain(__Rule, &k_p, &k_i, &k_d))
+    {
+        return (false);
+    }
+
+    __PID->Set_K_P(k_p);
+    __PID->Set_K_I(k_i);
+    __PID->Set_K_D(k_d);
+    return (true);
+}
+
+/**
+ * @brief 导出整定进度与结果, 供串口绘图
+ *
+ * 依次为: 状态, 已测周期数, 已运行时间, 继电输出, Ku, Tu, 振荡幅值, 静态增益, 纯滞后, 时间常数, 所选规则的K_P/K_I/K_D
+ *
+ * @param Buffer 导出缓冲区
+ * @param Buffer_Length 缓冲区长度
+ * @param __Rule 导出参数所用的整定规则
+ * @return uint8_t 导出的数据个数
+ */
+uint8_t Class_PID_Autotuner::Export_Summary(float *Buffer, uint8_t Buffer_Length, Enum_PID_Autotuner_Rule __Rule)
+{
+    float k_p = 0.0f, k_i = 0.0f, k_d = 0.0f;
+    Get_Gain(__Rule, &k_p, &k_i, &k_d);
+
+    float summary[AUTOTUNER_EXPORT_NUM] = {
+        (float) Status, (float) Cycle_Num, Time, Out,
+        Ultimate_Gain, Ultimate_Period, Oscillation_Amplitude, Static_Gain, Dead_Time, Time_Constant,
+        k_p, k_i, k_d,
+    };
+
+    uint8_t length = 0;
+    for (; length < AUTOTUNER_EXPORT_NUM && length < Buffer_Length; length++)
+    {
+        Buffer[length] = summary[length];
+    }
+    return (length);
+}
+
+/**
+ * @brief 记录刚结束的一个完整周期
+ *
+ */
+void Class_PID_Autotuner::Cycle_Finish()
+{
+    Struct_PID_Autotuner_Cycle *cycle = &Cycle[Cycle_Num % AUTOTUNER_CYCLE_NUM_MAX];
+
+    cycle->Period = Cycle_Time;
+    cycle->Amplitude = (Cycle_Now_Max - Cycle_Now_Min) / 2.0f;
+    cycle->Now_Mean = Cycle_Now_Sum / Cycle_Time;
+    cycle->Out_Mean = Cycle_Out_Sum / Cycle_Time;
+
+    if (Cycle_Num < UINT8_MAX)
+    {
+        Cycle_Num++;
+    }
+}
+
+/**
+ * @brief 检查最近Measure_Cycle_Num个周期是否已稳定, 稳定则取平均并拟合模型
+ *
+ * @return true 已稳定
+ * @return false 未稳定
+ */
+bool Class_PID_Autotuner::Check_Converge()
+{
+    if (Cycle_Num < Measure_Cycle_Num)
+    {
+        return (false);
+    }
+
+    float period_max = 0.0f, period_min = FLT_MAX, period_sum = 0.0f;
+    float amplitude_max = 0.0f, amplitude_min = FLT_MAX, amplitude_sum = 0.0f;
+    float now_mean_sum = 0.0f, out_mean_sum = 0.0f;
+    for (uint8_t i = 0; i < Measure_Cycle_Num; i++)
+    {
+        const Struct_PID_Autotuner_Cycle *cycle = &Cycle[(Cycle_Num - 1 - i) % AUTOTUNER_CYCLE_NUM_MAX];
+        period_max = fmaxf(period_max, cycle->Period);
+        period_min = fminf(period_min, cycle->Period);
+        period_sum += cycle->Period;
+        amplitude_max = fmaxf(amplitude_max, cycle->Amplitude);
+        amplitude_min = fminf(amplitude_min, cycle->Amplitude);
+        amplitude_sum += cycle->Amplitude;
+        now_mean_sum += cycle->Now_Mean;
+        out_mean_sum += cycle->Out_Mean;
+    }
+
+    float period = period_sum / Measure_Cycle_Num;
+    float amplitude = amplitude_sum / Measure_Cycle_Num;
+    if (amplitude <= Relay_Hysteresis || period_max - period_min > Tolerance * period || amplitude_max - amplitude_min > Tolerance * amplitude)
+    {
+        return (false);
+    }
+
+    Ultimate_Period = period;
+    Oscillation_Amplitude = amplitude;
+    Ultimate_Gain = 4.0f * Relay_Amplitude / (PI * amplitude);
+    Model_Fit(now_mean_sum / Measure_Cycle_Num, out_mean_sum / Measure_Cycle_Num);
+    return (true);
+}
+
+/**
+ * @brief 由振荡点拟合对象模型, 供SIMC使用
+ *
+ * 带滞环的继电描述函数为 4d/(πa)·e^(-j·asin(ε/a)), 振荡点处对象的幅值为 πa/(4d), 相位滞后为 π - asin(ε/a).
+ * 静态增益可信时按 K·e^(-θs)/(τs+1) 拟合, 否则按 k·e^(-θs)/s 拟合
+ *
+ * @param __Now_Mean 振荡期间反馈的平均值
+ * @param __Out_Mean 振荡期间继电输出的平均值
+ */
+void Class_PID_Autotuner::Model_Fit(float __Now_Mean, float __Out_Mean)
+{
+    float omega = 2.0f * PI / Ultimate_Period;
+    float magnitude = 1.0f / Ultimate_Gain;
+    float hysteresis_ratio = fminf(Relay_Hysteresis / Oscillation_Amplitude, 1.0f);
+    float phase_lag = PI - asinf(hysteresis_ratio);
+
+    // 平均输出明显偏离偏置时才能估计静态增益, 且静态增益须大于振荡点的幅值
+    float delta_out = __Out_Mean - Bias;
+    float delta_now = __Now_Mean - Start_Now;
+    Static_Gain = 0.0f;
+    Time_Constant = 0.0f;
+    if (Math_Abs(delta_out) > 0.05f * Relay_Amplitude && delta_now / delta_out > 1.01f * magnitude)
+    {
+        float static_gain = delta_now / delta_out;
+        float omega_tau = sqrtf(static_gain * static_gain / (magnitude * magnitude) - 1.0f);
+        float dead_time = (phase_lag - atanf(omega_tau)) / omega;
+        if (dead_time > 0.0f)
+        {
+            Static_Gain = static_gain;
+            Time_Constant = omega_tau / omega;
+            Dead_Time = dead_time;
+        }
+    }
+    if (Static_Gain == 0.0f)
+    {
+        Integrating_Gain = magnitude * omega;
+        Dead_Time = (phase_lag - PI / 2.0f) / omega;
+    }
+
+    // 纯滞后不短于一个控制周期
+    Dead_Time = fmaxf(Dead_Time, D_T);
+}
+
+/**
+ * @brief 按名义控制周期推进一次
+ *
+ * @param __Now 反馈
+ */
+void Class_PID_Autotuner::TIM_Calculate_PeriodElapsedCallback(float __Now)
+{
+    TIM_Calculate_PeriodElapsedCallback(__Now, D_T);
+}
+
+/**
+ * @brief 推进一次, 继电翻转时统计周期, 振荡稳定后给出结果并停止激励
+ *
+ * @param __Now 反馈
+ * @param __D_T 距上一次调用的时间, s
+ */
+void Class_PID_Autotuner::TIM_Calculate_PeriodElapsedCallback(float __Now, float __D_T)
+{
+    if (Status != PID_Autotuner_Status_RUNNING)
+    {
+        Out = Bias;
+        return;
+    }
+
+    Time += __D_T;
+    Out = Relay.Update(__Now - Target, __D_T);
+    bool relay_high = Out > Bias;
+
+    // 超时或偏离过大时放弃, 输出回到偏置
+    if (Time > Timeout || (Error_Max > 0.0f && Math_Abs(__Now - Target) > Error_Max))
+    {
+        Status = PID_Autotuner_Status_FAILURE;
+        Out = Bias;
+        return;
+    }
+
+    // 继电输出的上升沿为一个周期的分界
+    if (relay_high && !Pre_Relay_High)
+    {
+        if (Rising_Num > Settle_Cycle_Num)
+        {
+            Cycle_Finish();
+        }
+        if (Rising_Num < UINT16_MAX)
+        {
+            Rising_Num++;
+        }
+        Cycle_Time = 0.0f;
+        Cycle_Now_Max = __Now;
+        Cycle_Now_Min = __Now;
+        Cycle_Now_Sum = 0.0f;
+        Cycle_Out_Sum = 0.0f;
+
+        if (Check_Converge())
+        {
+            Status = PID_Autotuner_Status_SUCCESS;
+            Out = Bias;
+            return;
+        }
+    }
+    Pre_Relay_High = relay_high;
+
+    // 本次继电输出保持到下一次调用
+    if (Rising_Num > 0)
+    {
+        Cycle_Time += __D_T;
+        Cycle_Now_Max = fmaxf(Cycle_Now_Max, __Now);
+        Cycle_Now_Min = fminf(Cycle_Now_Min, __Now);
+        Cycle_Now_Sum += __Now * __D_T;
+        Cycle_Out_Sum += Out * __D_T;
+    }
+}
+
+/*****************************************************************************/
@@ -0,0 +1,331 @@
+/**
+ * @file alg_autotuner.h
+ * @author WFZ
+ * @brief 继电反馈PID自整定, 以Class_Waveform的Relay激励闭环, 测出持续振荡的临界增益与周期后按整定规则给出PID参数
+ * @version 0.0
+ * @date 2026-2-4
+ *
+ */
+
+#ifndef ALG_AUTOTUNER_H
+#define ALG_AUTOTUNER_H
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "alg_waveform.h"
+#include "alg_pid.h"
+
+/* Exported macros -----------------------------------------------------------*/
+
+// 参与平均的振荡周期数上限
+#define AUTOTUNER_CYCLE_NUM_MAX 8
+// 导出给串口绘图的数据个数
+#define AUTOTUNER_EXPORT_NUM 13
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+ * @brief 自整定状态
+ *
+ */
+typedef enum
+{
+    PID_Autotuner_Status_IDLE = 0,  // 未启动
+    PID_Autotuner_Status_RUNNING,   // 继电激励中
+    PID_Autotuner_Status_SUCCESS,   // 振荡已稳定, 结果可用
+    PID_Autotuner_Status_FAILURE,   // 超时、误差超限或被中止
+} Enum_PID_Autotuner_Status;
+
+/**
+ * @brief 整定规则
+ *
+ */
+typedef enum
+{
+    PID_Autotuner_Rule_ZIEGLER_NICHOLS_PI = 0,  // K_P = 0.45Ku, T_I = Tu/1.2
+    PID_Autotuner_Rule_ZIEGLER_NICHOLS_PID,     // K_P = 0.6Ku, T_I = Tu/2, T_D = Tu/8
+    PID_Autotuner_Rule_TYREUS_LUYBEN_PI,        // K_P = Ku/3.2, T_I = 2.2Tu, 超调小于Z-N
+    PID_Autotuner_Rule_TYREUS_LUYBEN_PID,       // K_P = Ku/2.2, T_I = 2.2Tu, T_D = Tu/6.3
+    PID_Autotuner_Rule_SIMC_PI,                 // 由振荡点拟合一阶惯性加纯滞后或积分加纯滞后模型, 闭环时间常数取纯滞后
+    PID_Autotuner_Rule_NUM,
+} Enum_PID_Autotuner_Rule;
+
+/**
+ * @brief 一个完整振荡周期的测量值
+ *
+ */
+struct Struct_PID_Autotuner_Cycle
+{
+    // 周期, s
+    float Period;
+    // 反馈的半峰峰值
+    float Amplitude;
+    // 周期内反馈的平均值
+    float Now_Mean;
+    // 周期内继电输出的平均值
+    float Out_Mean;
+};
+
+/**
+ * @brief 继电反馈PID自整定
+ *
+ * 继电输出在 Bias ± Amplitude 间切换, 反馈越过 Target ± Hysteresis 时翻转, 闭环形成持续振荡.
+ * 振荡幅值a与周期Tu稳定后, 临界增益 Ku = 4·Amplitude / (π·a), 临界周期即Tu.
+ *
+ * 使用方法 ：
+ *  1) Init(继电幅值, 滞环, 控制周期), 滞环取反馈噪声峰峰值的1~2倍
+ *  2) Start(目标值, 当前反馈, 偏置), 被整定环断开, 执行器指令改由本类给出
+ *  3) 每个控制周期 TIM_Calculate_PeriodElapsedCallback(反馈), Get_Out()作为执行器指令
+ *  4) 状态为SUCCESS后, Apply(被整定的PID, 规则)写入参数, 恢复闭环
+ *
+ * 目标值与启动时的反馈不同时, 由周期内的平均输出估计静态增益, SIMC按一阶惯性加纯滞后拟合,
+ * 否则按积分加纯滞后拟合, 适用于电机速度环这类近似积分的对象
+ *
+ */
+class Class_PID_Autotuner
+{
+public:
+    void Init(float __Relay_Amplitude, float __Relay_Hysteresis, float __D_T = 0.001f, float __Timeout = 10.0f, float __Error_Max = 0.0f, uint8_t __Settle_Cycle_Num = 2, uint8_t __Measure_Cycle_Num = 4, float __Tolerance = 0.1f);
+
+    void Start(float __Target, float __Now, float __Bias = 0.0f);
+
+    void Stop();
+
+    inline Enum_PID_Autotuner_Status Get_Status();
+
+    inline float Get_Out();
+
+    inline float Get_Time();
+
+    inline uint8_t Get_Cycle_Num();
+
+    inline float Get_Ultimate_Gain();
+
+    inline float Get_Ultimate_Period();
+
+    inline float Get_Oscillation_Amplitude();
+
+    inline float Get_Static_Gain();
+
+    inline float Get_Dead_Time();
+
+    inline float Get_Time_Constant();
+
+    bool Get_Gain(Enum_PID_Autotuner_Rule __Rule, float *__K_P, float *__K_I, float *__K_D);
+
+    bool Apply(Class_PID *__PID, Enum_PID_Autotuner_Rule __Rule);
+
+    uint8_t Export_Summary(float *Buffer, uint8_t Buffer_Length, Enum_PID_Autotuner_Rule __Rule);
+
+    void TIM_Calculate_PeriodElapsedCallback(float __Now);
+
+    void TIM_Calculate_PeriodElapsedCallback(float __Now, float __D_T);
+
+protected:
+    // 初始化相关常量
+
+    // 继电幅值
+    float Relay_Amplitude = 0.0f;
+    // 继电滞环
+    float Relay_Hysteresis = 0.0f;
+    // 名义控制周期, s
+    float D_T = 0.001f;
+    // 超时时间, s
+    float Timeout = 10.0f;
+    // 反馈偏离目标的上限, 超过即失败, 0表示不检查
+    float Error_Max = 0.0f;
+    // 开始测量前舍弃的周期数
+    uint8_t Settle_Cycle_Num = 2;
+    // 参与平均的周期数
+    uint8_t Measure_Cycle_Num = 4;
+    // 参与平均的各周期周期与幅值的相对极差上限
+    float Tolerance = 0.1f;
+
+    // 内部变量
+
+    // 继电激励
+    Class_Waveform Relay;
+    // 状态
+    Enum_PID_Autotuner_Status Status = PID_Autotuner_Status_IDLE;
+    // 目标值
+    float Target = 0.0f;
+    // 偏置, 即启动前的执行器指令
+    float Bias = 0.0f;
+    // 启动时的反馈
+    float Start_Now = 0.0f;
+    // 继电输出
+    float Out = 0.0f;
+    // 已运行时间, s
+    float Time = 0.0f;
+    // 上一周期继电输出为高
+    bool Pre_Relay_High = true;
+    // 已过的上升沿数, 第一个上升沿之后开始计周期
+    uint16_t Rising_Num = 0;
+    // 当前周期已运行时间, s
+    float Cycle_Time = 0.0f;
+    // 当前周期内反馈的最大值与最小值
+    float Cycle_Now_Max = 0.0f;
+    float Cycle_Now_Min = 0.0f;
+    // 当前周期内反馈与继电输出对时间的积分
+    float Cycle_Now_Sum = 0.0f;
+    float Cycle_Out_Sum = 0.0f;
+    // 最近的完整周期, 环形存放
+    Struct_PID_Autotuner_Cycle Cycle[AUTOTUNER_CYCLE_NUM_MAX];
+    // 已记录的完整周期数
+    uint8_t Cycle_Num = 0;
+
+    // 读变量
+
+    // 临界增益
+    float Ultimate_Gain = 0.0f;
+    // 临界周期, s
+    float Ultimate_Period = 0.0f;
+    // 振荡幅值, 反馈的半峰峰值
+    float Oscillation_Amplitude = 0.0f;
+    // 静态增益, 0表示按积分对象处理
+    float Static_Gain = 0.0f;
+    // 积分对象的积分增益, 1/s
+    float Integrating_Gain = 0.0f;
+    // 拟合模型的纯滞后, s
+    float Dead_Time = 0.0f;
+    // 拟合模型的时间常数, s, 积分对象为0
+    float Time_Constant = 0.0f;
+
+    // 内部函数
+
+    void Cycle_Finish();
+
+    bool Check_Converge();
+
+    void Model_Fit(float __Now_Mean, float __Out_Mean);
+};
+
+/* Exported variables --------------------------------------------------------*/
+
+/* Exported function declarations --------------------------------------------*/
+
+/**
+ * @brief 获取状态
+ *
+ * @return Enum_PID_Autotuner_Status 状态
+ */
+inline Enum_PID_Autotuner_Status Class_PID_Autotuner::Get_Status()
+{
+    return (Status);
+}
+
+/**
+ * @brief 获取执行器指令, 未在运行时为偏置
+ *
+ * @return float 执行器指令
+ */
+inline float Class_PID_Autotuner::Get_Out()
+{
+    return (Out);
+}
+
+/**
+ * @brief 获取已运行时间
+ *
+ * @return float 已运行时间, s
+ */
+inline float Class_PID_Autotuner::Get_Time()
+{
+    return (Time);
+}
+
+/**
+ * @brief 获取已记录的完整振荡周期数, 不含舍弃的周期
+ *
+ * @return uint8_t 周期数
+ */
+inline uint8_t Class_PID_Autotuner::Get_Cycle_Num()
+{
+    return (Cycle_Num);
+}
+
+/**
+ * @brief 获取临界增益
+ *
+ * @return float 临界增益, 未成功时为0
+ */
+inline float Class_PID_Autotuner::Get_Ultimate_Gain()
+{
+    return (Ultimate_Gain);
+}
+
+/**
+ * @brief 获取临界周期
+ *
+ * @return float 临界周期, s, 未成功时为0
+ */
+inline float Class_PID_Autotuner::Get_Ultimate_Period()
+{
+    return (Ultimate_Period);
+}
+
+/**
+ * @brief 获取振荡幅值
+ *
+ * @return float 反馈的半峰峰值, 未成功时为0
+ */
+inline float Class_PID_Autotuner::Get_Oscillation_Amplitude()
+{
+    return (Oscillation_Amplitude);
+}
+
+/**
+ * @brief 获取估计的静态增益
+ *
+ * @return float 静态增益, 0表示按积分对象处理
+ */
+inline float Class_PID_Autotuner::Get_Static_Gain()
+{
+    return (Static_Gain);
+}
+
+/**
+ * @brief 获取拟合模型的纯滞后
+ *
+ * @return float 纯滞后, s
+ */
+inline float Class_PID_Autotuner::Get_Dead_Time()
+{
+    return (Dead_Time);
+}
+
+/**
+ * @brief 获取拟合模型的时间常数
+ *
+ * @return float 时间常数, s, 积分对象为0
+ */
+inline float Class_PID_Autotuner::Get_Time_Constant()
+{
+    return (Time_Constant);
+}
+
+#endif
+
+/*
+模板：
+Class_PID_Autotuner XXX_Autotuner;
+
+XXX_Autotuner.Init(2.0f, 0.5f, 0.001f);//继电幅值2A, 滞环0.5rad/s, 控制周期1ms
+
+XXX_Autotuner.Start(Target_Omega, Now_Omega, Now_Current);//从当前电流出发, 围绕目标速度振荡
+
+假设这是一个1ms执行一次的函数{
+
+		XXX_Autotuner.TIM_Calculate_PeriodElapsedCallback(Now_Omega);
+		Target_Current = XXX_Autotuner.Get_Out();//速度环断开, 电流指令由继电给出
+
+		if (XXX_Autotuner.Get_Status() == PID_Autotuner_Status_SUCCESS)
+		{
+				XXX_Autotuner.Apply(&XXX_PID_Omega, PID_Autotuner_Rule_TYREUS_LUYBEN_PI);//写入参数, 恢复速度环
+		}
+
+}
+
+*/
+
+/*****************************************************************************/
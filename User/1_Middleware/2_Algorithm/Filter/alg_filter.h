@@ -0,0 +1,657 @@
+/**
+ * @file alg_filter.h
+ * @author WFZ
+ * @brief 数字滤波器库, 只含头文件: 一阶低通、双二阶级联(DF2T)与陷波、滑动中值、滑动平均、变化率限制,
+ *        均按通道数模板化, 不做动态内存分配
+ * @version 0.0
+ * @date 2026-1-31
+ *
+ * @note 双二阶系数由截止频率与采样频率经预畸变双线性变换得到, 设计函数为constexpr,
+ *       参数为常量时系数在编译期算好, 例如
+ *           static constexpr Struct_Filter_Biquad_Coefficient Gyro_Notch = Filter_Biquad_Notch(50.0f, 1000.0f, 5.0f);
+ *       设计函数中的三角函数用级数展开实现, 只在设计时使用, 运行时滤波只有乘加.
+ *
+ */
+
+#ifndef ALG_FILTER_H
+#define ALG_FILTER_H
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "drv_math.h"
+
+/* Exported macros -----------------------------------------------------------*/
+
+// 设计函数中三角级数的项数, 自变量不超过PI/2时误差小于1e-12
+#define FILTER_SERIES_TERM_NUM (12U)
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+ * @brief 双二阶节系数, 已按a0归一化
+ *        H(z) = (B0 + B1 z^-1 + B2 z^-2) / (1 + A1 z^-1 + A2 z^-2)
+ *
+ */
+struct Struct_Filter_Biquad_Coefficient
+{
+    float B0;
+    float B1;
+    float B2;
+    float A1;
+    float A2;
+};
+
+/**
+ * @brief 一阶低通, y = Alpha * x + (1 - Alpha) * y, 与原IMU与PID微分中的写法一致
+ *
+ * @tparam Channel 通道数
+ */
+template <uint32_t Channel = 1>
+class Class_Filter_Low_Pass_1st
+{
+public:
+    void Init(float __Alpha);
+
+    void Reset(float __Value = 0.0f);
+
+    inline float Get_Out(uint32_t __Channel = 0) const;
+
+    float Update(float __Input, uint32_t __Channel = 0);
+
+protected:
+    // 新值权重, (0, 1]
+    float Alpha = 1.0f;
+
+    // 各通道输出
+    float Out[Channel] = {};
+};
+
+/**
+ * @brief 双二阶级联, 转置直接II型, 每节两个状态量
+ *
+ * @tparam Section_Num 节数, 滤波器阶数为2倍节数
+ * @tparam Channel 通道数, 各通道共用系数
+ */
+template <uint32_t Section_Num, uint32_t Channel = 1>
+class Class_Filter_Biquad
+{
+public:
+    static_assert(Section_Num > 0, "biquad needs at least one section");
+
+    void Init(const Struct_Filter_Biquad_Coefficient *__Coefficient);
+
+    void Reset();
+
+    inline float Get_Out(uint32_t __Channel = 0) const;
+
+    float Update(float __Input, uint32_t __Channel = 0);
+
+protected:
+    // 各节系数
+    Struct_Filter_Biquad_Coefficient Coefficient[Section_Num] = {};
+
+    // 各通道各节的状态量
+    float Z1[Channel][Section_Num] = {};
+    float Z2[Channel][Section_Num] = {};
+
+    // 各通道输出
+    float Out[Channel] = {};
+};
+
+/**
+ * @brief 滑动中值, 维护有序窗口, 每次更新O(Window)
+ *
+ * @tparam Window 窗口长度, 奇数
+ * @tparam Channel 通道数
+ */
+template <uint32_t Window, uint32_t Channel = 1>
+class Class_Filter_Median
+{
+public:
+    static_assert(Window % 2 == 1, "median window must be odd");
+
+    void Reset(float __Value = 0.0f);
+
+    inline float Get_Out(uint32_t __Channel = 0) const;
+
+    float Update(float __Input, uint32_t __Channel = 0);
+
+protected:
+    // 按到达顺序的环形缓冲
+    float History[Channel][Window] = {};
+    // 同一批样本的有序副本
+    float Sorted[Channel][Window] = {};
+    // 下一个被替换的位置
+    uint32_t Index[Channel] = {};
+};
+
+/**
+ * @brief 滑动平均, 环形缓冲加累计和, 每次更新O(1)
+ *
+ * @tparam Window 窗口长度
+ * @tparam Channel 通道数
+ */
+template <uint32_t Window, uint32_t Channel = 1>
+class Class_Filter_Moving_Average
+{
+public:
+    static_assert(Window > 0, "moving average window must be positive");
+
+    void Reset(float __Value = 0.0f);
+
+    inline float Get_Out(uint32_t __Channel = 0) const;
+
+    float Update(float __Input, uint32_t __Channel = 0);
+
+protected:
+    float History[Channel][Window] = {};
+    // 窗口内样本之和, 每转一圈重新求和一次, 消除累计舍入误差
+    float Sum[Channel] = {};
+    uint32_t Index[Channel] = {};
+};
+
+/**
+ * @brief 变化率限制, 上升与下降可分别设定
+ *
+ * @tparam Channel 通道数
+ */
+template <uint32_t Channel = 1>
+class Class_Filter_Rate_Limiter
+{
+public:
+    void Init(float __Rise_Rate_Max, float __Fall_Rate_Max, float __D_T = 0.001f);
+
+    void Reset(float __Value = 0.0f);
+
+    inline float Get_Out(uint32_t __Channel = 0) const;
+
+    float Update(float __Input, uint32_t __Channel = 0);
+
+    float Update(float __Input, float __D_T, uint32_t __Channel);
+
+protected:
+    // 最大上升与下降速率, 单位/s, 均为正数
+    float Rise_Rate_Max = 0.0f;
+    float Fall_Rate_Max = 0.0f;
+    // 默认更新周期, s
+    float D_T = 0.001f;
+
+    float Out[Channel] = {};
+};
+
+/* Exported variables --------------------------------------------------------*/
+
+/* Exported function declarations --------------------------------------------*/
+
+/**
+ * @brief sin级数的递归求和, 只用于constexpr设计函数
+ *
+ */
+constexpr double Filter_Sin_Series(double x2, double Term, uint32_t n)
+{
+    return ((n > FILTER_SERIES_TERM_NUM) ? Term : Term + Filter_Sin_Series(x2, -Term * x2 / ((2.0 * n) * (2.0 * n + 1.0)), n + 1));
+}
+
+/**
+ * @brief cos级数的递归求和, 只用于constexpr设计函数
+ *
+ */
+constexpr double Filter_Cos_Series(double x2, double Term, uint32_t n)
+{
+    return ((n > FILTER_SERIES_TERM_NUM) ? Term : Term + Filter_Cos_Series(x2, -Term * x2 / ((2.0 * n - 1.0) * (2.0 * n)), n + 1));
+}
+
+/**
+ * @brief 编译期tan, 自变量应在 [0, PI/2) 内
+ *
+ * @param x 输入, rad
+ * @return double tan(x)
+ */
+constexpr double Filter_Tan(double x)
+{
+    return (Filter_Sin_Series(x * x, x, 1) / Filter_Cos_Series(x * x, 1.0, 1));
+}
+
+/**
+ * @brief 预畸变后的模拟角频率比例 K = tan(PI * f / fs)
+ *
+ * @param Frequency 频率, Hz, 小于采样频率的一半
+ * @param Sample_Frequency 采样频率, Hz
+ * @return double K
+ */
+constexpr double Filter_Prewarp(double Frequency, double Sample_Frequency)
+{
+    return (Filter_Tan(3.14159265358979323846 * Frequency / Sample_Frequency));
+}
+
+/**
+ * @brief 按a0归一化双二阶系数
+ *
+ */
+constexpr Struct_Filter_Biquad_Coefficient Filter_Biquad_Normalize(double b0, double b1, double b2, double a0, double a1, double a2)
+{
+    return (Struct_Filter_Biquad_Coefficient{(float) (b0 / a0), (float) (b1 / a0), (float) (b2 / a0), (float) (a1 / a0), (float) (a2 / a0)});
+}
+
+/**
+ * @brief 二阶低通 H(s) = 1 / (s^2 + s/Q + 1) 的双线性变换
+ *
+ */
+constexpr Struct_Filter_Biquad_Coefficient Filter_Biquad_Low_Pass_K(double K, double Q)
+{
+    return (Filter_Biquad_Normalize(K * K, 2.0 * K * K, K * K, 1.0 + K / Q + K * K, 2.0 * (K * K - 1.0), 1.0 - K / Q + K * K));
+}
+
+/**
+ * @brief 二阶高通 H(s) = s^2 / (s^2 + s/Q + 1) 的双线性变换
+ *
+ */
+constexpr Struct_Filter_Biquad_Coefficient Filter_Biquad_High_Pass_K(double K, double Q)
+{
+    return (Filter_Biquad_Normalize(1.0, -2.0, 1.0, 1.0 + K / Q + K * K, 2.0 * (K * K - 1.0), 1.0 - K / Q + K * K));
+}
+
+/**
+ * @brief 陷波 H(s) = (s^2 + 1) / (s^2 + s/Q + 1) 的双线性变换
+ *
+ */
+constexpr Struct_Filter_Biquad_Coefficient Filter_Biquad_Notch_K(double K, double Q)
+{
+    return (Filter_Biquad_Normalize(1.0 + K * K, 2.0 * (K * K - 1.0), 1.0 + K * K, 1.0 + K / Q + K * K, 2.0 * (K * K - 1.0), 1.0 - K / Q + K * K));
+}
+
+/**
+ * @brief 二阶低通设计
+ *
+ * @param Cutoff_Frequency 截止频率, Hz
+ * @param Sample_Frequency 采样频率, Hz
+ * @param Q 品质因数, 0.7071为二阶巴特沃斯
+ * @return Struct_Filter_Biquad_Coefficient 系数
+ */
+constexpr Struct_Filter_Biquad_Coefficient Filter_Biquad_Low_Pass(float Cutoff_Frequency, float Sample_Frequency, float Q = 0.70710678f)
+{
+    return (Filter_Biquad_Low_Pass_K(Filter_Prewarp(Cutoff_Frequency, Sample_Frequency), Q));
+}
+
+/**
+ * @brief 二阶高通设计
+ *
+ * @param Cutoff_Frequency 截止频率, Hz
+ * @param Sample_Frequency 采样频率, Hz
+ * @param Q 品质因数, 0.7071为二阶巴特沃斯
+ * @return Struct_Filter_Biquad_Coefficient 系数
+ */
+constexpr Struct_Filter_Biquad_Coefficient Filter_Biquad_High_Pass(float Cutoff_Frequency, float Sample_Frequency, float Q = 0.70710678f)
+{
+    return (Filter_Biquad_High_Pass_K(Filter_Prewarp(Cutoff_Frequency, Sample_Frequency), Q));
+}
+
+/**
+ * @brief 陷波设计
+ *
+ * @param Center_Frequency 陷波中心频率, Hz
+ * @param Sample_Frequency 采样频率, Hz
+ * @param Q 品质因数, 越大陷波越窄, -3dB带宽为 中心频率/Q
+ * @return Struct_Filter_Biquad_Coefficient 系数
+ */
+constexpr Struct_Filter_Biquad_Coefficient Filter_Biquad_Notch(float Center_Frequency, float Sample_Frequency, float Q)
+{
+    return (Filter_Biquad_Notch_K(Filter_Prewarp(Center_Frequency, Sample_Frequency), Q));
+}
+
+/**
+ * @brief 编译期cos
+ *
+ * @param x 输入, rad, 应在 [0, PI] 内
+ * @return double cos(x)
+ */
+constexpr double Filter_Cos(double x)
+{
+    return (Filter_Cos_Series(x * x, 1.0, 1));
+}
+
+/**
+ * @brief 2N阶巴特沃斯中第Section节的品质因数, 各节截止频率相同
+ *
+ * @param Section 节号, 从0开始
+ * @param Section_Num 总节数N
+ * @return float 品质因数
+ */
+constexpr float Filter_Butterworth_Q(uint32_t Section, uint32_t Section_Num)
+{
+    return ((float) (0.5 / Filter_Cos((2.0 * Section + 1.0) * 3.14159265358979323846 / (4.0 * Section_Num))));
+}
+
+/**
+ * @brief 初始化一阶低通
+ *
+ * @param __Alpha 新值权重, (0, 1], 1为不滤波
+ */
+template <uint32_t Channel>
+void Class_Filter_Low_Pass_1st<Channel>::Init(float __Alpha)
+{
+    Alpha = __Alpha;
+    Reset();
+}
+
+/**
+ * @brief 把各通道输出置为给定值
+ *
+ * @param __Value 初值
+ */
+template <uint32_t Channel>
+void Class_Filter_Low_Pass_1st<Channel>::Reset(float __Value)
+{
+    for (uint32_t i = 0; i < Channel; i++)
+    {
+        Out[i] = __Value;
+    }
+}
+
+/**
+ * @brief 获取输出
+ *
+ * @param __Channel 通道
+ * @return float 最近一次输出
+ */
+template <uint32_t Channel>
+inline float Class_Filter_Low_Pass_1st<Channel>::Get_Out(uint32_t __Channel) const
+{
+    return (Out[__Channel]);
+}
+
+/**
+ * @brief 输入一个样本
+ *
+ * @param __Input 输入
+ * @param __Channel 通道
+ * @return float 输出
+ */
+template <uint32_t Channel>
+float Class_Filter_Low_Pass_1st<Channel>::Update(float __Input, uint32_t __Channel)
+{
+    Out[__Channel] = Alpha * __Input + (1.0f - Alpha) * Out[__Channel];
+    return (Out[__Channel]);
+}
+
+/**
+ * @brief 初始化双二阶级联
+ *
+ * @param __Coefficient 各节系数, 长度为Section_Num
+ */
+template <uint32_t Section_Num, uint32_t Channel>
+void Class_Filter_Biquad<Section_Num, Channel>::Init(const Struct_Filter_Biquad_Coefficient *__Coefficient)
+{
+    for (uint32_t i = 0; i < Section_Num; i++)
+    {
+        Coefficient[i] = __Coefficient[i];
+    }
+    Reset();
+}
+
+/**
+ * @brief 清空状态量
+ *
+ */
+template <uint32_t Section_Num, uint32_t Channel>
+void Class_Filter_Biquad<Section_Num, Channel>::Reset()
+{
+    for (uint32_t i = 0; i < Channel; i++)
+    {
+        for (uint32_t j = 0; j < Section_Num; j++)
+        {
+            Z1[i][j] = 0.0f;
+            Z2[i][j] = 0.0f;
+        }
+        Out[i] = 0.0f;
+    }
+}
+
+/**
+ * @brief 获取输出
+ *
+ * @param __Channel 通道
+ * @return float 最近一次输出
+ */
+template <uint32_t Section_Num, uint32_t Channel>
+inline float Class_Filter_Biquad<Section_Num, Channel>::Get_Out(uint32_t __Channel) const
+{
+    return (Out[__Channel]);
+}
+
+/**
+ * @brief 输入一个样本, 依次通过各节
+ *
+ * @param __Input 输入
+ * @param __Channel 通道
+ * @return float 输出
+ */
+template <uint32_t Section_Num, uint32_t Channel>
+float Class_Filter_Biquad<Section_Num, Channel>::Update(float __Input, uint32_t __Channel)
+{
+    float x = __Input;
+    float *z1 = Z1[__Channel];
+    float *z2 = Z2[__Channel];
+
+    for (uint32_t i = 0; i < Section_Num; i++)
+    {
+        const Struct_Filter_Biquad_Coefficient &c = Coefficient[i];
+        float y = c.B0 * x + z1[i];
+        z1[i] = c.B1 * x - c.A1 * y + z2[i];
+        z2[i] = c.B2 * x - c.A2 * y;
+        x = y;
+    }
+
+    Out[__Channel] = x;
+    return (x);
+}
+
+/**
+ * @brief 用给定值填满窗口
+ *
+ * @param __Value 初值
+ */
+template <uint32_t Window, uint32_t Channel>
+void Class_Filter_Median<Window, Channel>::Reset(float __Value)
+{
+    for (uint32_t i = 0; i < Channel; i++)
+    {
+        for (uint32_t j = 0; j < Window; j++)
+        {
+            History[i][j] = __Value;
+            Sorted[i][j] = __Value;
+        }
+        Index[i] = 0;
+    }
+}
+
+/**
+ * @brief 获取输出
+ *
+ * @param __Channel 通道
+ * @return float 当前窗口的中值
+ */
+template <uint32_t Window, uint32_t Channel>
+inline float Class_Filter_Median<Window, Channel>::Get_Out(uint32_t __Channel) const
+{
+    return (Sorted[__Channel][Window / 2]);
+}
+
+/**
+ * @brief 输入一个样本, 替换窗口中最旧的样本
+ *
+ * @param __Input 输入
+ * @param __Channel 通道
+ * @return float 当前窗口的中值
+ */
+template <uint32_t Window, uint32_t Channel>
+float Class_Filter_Median<Window, Channel>::Update(float __Input, uint32_t __Channel)
+{
+    float *sorted = Sorted[__Channel];
+    float oldest = History[__Channel][Index[__Channel]];
+
+    History[__Channel][Index[__Channel]] = __Input;
+    Index[__Channel] = (Index[__Channel] + 1 == Window) ? 0 : Index[__Channel] + 1;
+
+    // 找到最旧样本在有序数组中的位置, 向新值方向移动空位保持有序
+    uint32_t position = 0;
+    while (position < Window - 1 && sorted[position] != oldest)
+    {
+        position++;
+    }
+    while (position > 0 && sorted[position - 1] > __Input)
+    {
+        sorted[position] = sorted[position - 1];
+        position--;
+    }
+    while (position < Window - 1 && sorted[position + 1] < __Input)
+    {
+        sorted[position] = sorted[position + 1];
+        position++;
+    }
+    sorted[position] = __Input;
+
+    return (sorted[Window / 2]);
+}
+
+/**
+ * @brief 用给定值填满窗口
+ *
+ * @param __Value 初值
+ */
+template <uint32_t Window, uint32_t Channel>
+void Class_Filter_Moving_Average<Window, Channel>::Reset(float __Value)
+{
+    for (uint32_t i = 0; i < Channel; i++)
+    {
+        for (uint32_t j = 0; j < Window; j++)
+        {
+            History[i][j] = __Value;
+        }
+        Sum[i] = __Value * Window;
+        Index[i] = 0;
+    }
+}
+
+/**
+ * @brief 获取输出
+ *
+ * @param __Channel 通道
+ * @return float 当前窗口的平均值
+ */
+template <uint32_t Window, uint32_t Channel>
+inline float Class_Filter_Moving_Average<Window, Channel>::Get_Out(uint32_t __Channel) const
+{
+    return (Sum[__Channel] * (1.0f / Window));
+}
+
+/**
+ * @brief 输入一个样本, 替换窗口中最旧的样本
+ *
+ * @param __Input 输入
+ * @param __Channel 通道
+ * @return float 当前窗口的平均值
+ */
+template <uint32_t Window, uint32_t Channel>
+float Class_Filter_Moving_Average<Window, Channel>::Update(float __Input, uint32_t __Channel)
+{
+    float *history = History[__Channel];
+    uint32_t index = Index[__Channel];
+
+    Sum[__Channel] += __Input - history[index];
+    history[index] = __Input;
+
+    index++;
+    if (index == Window)
+    {
+        index = 0;
+        // 每转一圈重新求和, 均摊后仍为O(1)
+        float sum = 0.0f;
+        for (uint32_t i = 0; i < Window; i++)
+        {
+            sum += history[i];
+        }
+        Sum[__Channel] = sum;
+    }
+    Index[__Channel] = index;
+
+    return (Get_Out(__Channel));
+}
+
+/**
+ * @brief 初始化变化率限制
+ *
+ * @param __Rise_Rate_Max 最大上升速率, 单位/s
+ * @param __Fall_Rate_Max 最大下降速率, 单位/s, 正数
+ * @param __D_T 默认更新周期, s
+ */
+template <uint32_t Channel>
+void Class_Filter_Rate_Limiter<Channel>::Init(float __Rise_Rate_Max, float __Fall_Rate_Max, float __D_T)
+{
+    Rise_Rate_Max = Math_Abs(__Rise_Rate_Max);
+    Fall_Rate_Max = Math_Abs(__Fall_Rate_Max);
+    D_T = __D_T;
+    Reset();
+}
+
+/**
+ * @brief 把各通道输出置为给定值
+ *
+ * @param __Value 初值
+ */
+template <uint32_t Channel>
+void Class_Filter_Rate_Limiter<Channel>::Reset(float __Value)
+{
+    for (uint32_t i = 0; i < Channel; i++)
+    {
+        Out[i] = __Value;
+    }
+}
+
+/**
+ * @brief 获取输出
+ *
+ * @param __Channel 通道
+ * @return float 最近一次输出
+ */
+template <uint32_t Channel>
+inline float Class_Filter_Rate_Limiter<Channel>::Get_Out(uint32_t __Channel) const
+{
+    return (Out[__Channel]);
+}
+
+/**
+ * @brief 按默认周期向输入靠近
+ *
+ * @param __Input 输入
+ * @param __Channel 通道
+ * @return float 输出
+ */
+template <uint32_t Channel>
+float Class_Filter_Rate_Limiter<Channel>::Update(float __Input, uint32_t __Channel)
+{
+    return (Update(__Input, D_T, __Channel));
+}
+
+/**
+ * @brief 按实测周期向输入靠近
+ *
+ * @param __Input 输入
+ * @param __D_T 距上次更新的时间, s
+ * @param __Channel 通道
+ * @return float 输出
+ */
+template <uint32_t Channel>
+float Class_Filter_Rate_Limiter<Channel>::Update(float __Input, float __D_T, uint32_t __Channel)
+{
+    float delta = __Input - Out[__Channel];
+
+    Math_Constrain(&delta, -Fall_Rate_Max * __D_T, Rise_Rate_Max * __D_T);
+    Out[__Channel] += delta;
+
+    return (Out[__Channel]);
+}
+
+#endif
+
+/*****************************************************************************/
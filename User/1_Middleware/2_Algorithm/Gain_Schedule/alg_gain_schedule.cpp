@@ -0,0 +1,155 @@
+/**
+ * @file alg_gain_schedule.cpp
+ * @author WFZ
+ * @brief PID增益调度, 按调度变量在断点表中线性插值PID参数与限幅
+ * @version 0.0
+ * @date 2026-2-6
+ *
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "alg_gain_schedule.h"
+
+/* Private macros ------------------------------------------------------------*/
+
+/* Private types -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+
+/* Private function declarations ---------------------------------------------*/
+
+/* Function prototypes -------------------------------------------------------*/
+
+/**
+ * @brief 初始化增益调度, 并按表首行写入PID参数
+ *
+ * @param __PID 被调度的PID
+ * @param __Table 断点表, 调度变量严格递增, 须在调度期间保持有效
+ * @param __Point_Num 断点表行数
+ * @param __Input 调度变量的取法
+ */
+void Class_PID_Gain_Schedule::Init(Class_PID *__PID, const Struct_PID_Gain_Schedule_Point *__Table, uint8_t __Point_Num, Enum_PID_Gain_Schedule_Input __Input)
+{
+    PID = __PID;
+    Table = __Table;
+    Point_Num = __Point_Num;
+    Input = __Input;
+
+    Segment = 0;
+    if (Point_Num == 0)
+    {
+        return;
+    }
+    Pre_X = Table[0].X;
+    Now_Point = Table[0];
+    Output();
+}
+
+/**
+ * @brief 按调度变量更新PID参数, 在PID计算之前调用
+ *
+ * @param __X 调度变量
+ */
+void Class_PID_Gain_Schedule::TIM_Calculate_PeriodElapsedCallback(float __X)
+{
+    if (Input == PID_Gain_Schedule_Input_ABS)
+    {
+        __X = Math_Abs(__X);
+    }
+
+    // 单行表即固定参数, 调度变量不变时参数也不变
+    if (Point_Num < 2 || __X == Pre_X)
+    {
+        return;
+    }
+    Pre_X = __X;
+
+    Segment = Search(__X);
+    const Struct_PID_Gain_Schedule_Point *left = &Table[Segment];
+    const Struct_PID_Gain_Schedule_Point *right = &Table[Segment + 1];
+    float ratio = (__X - left->X) / (right->X - left->X);
+    Math_Constrain(&ratio, 0.0f, 1.0f);
+
+    float pre_k_i = Now_Point.K_I;
+
+    Now_Point.X = __X;
+    Now_Point.K_P = left->K_P + (right->K_P - left->K_P) * ratio;
+    Now_Point.K_I = left->K_I + (right->K_I - left->K_I) * ratio;
+    Now_Point.K_D = left->K_D + (right->K_D - left->K_D) * ratio;
+    Now_Point.K_F = left->K_F + (right->K_F - left->K_F) * ratio;
+    Now_Point.I_Out_Max = left->I_Out_Max + (right->I_Out_Max - left->I_Out_Max) * ratio;
+    Now_Point.Out_Max = left->Out_Max + (right->Out_Max - left->Out_Max) * ratio;
+
+    // 积分项输出为 K_I · 积分, K_I变化时按比例换算积分, 积分项输出保持不变
+    if (Now_Point.K_I != pre_k_i && Now_Point.K_I != 0.0f && pre_k_i != 0.0f)
+    {
+        PID->Set_Integral_Error(PID->Get_Integral_Error() * pre_k_i / Now_Point.K_I);
+    }
+
+    Output();
+}
+
+/**
+ * @brief 查找调度变量所在段, 表外取端点所在段
+ *
+ * @param __X 调度变量
+ * @return uint8_t 段号
+ */
+uint8_t Class_PID_Gain_Schedule::Search(float __X)
+{
+    uint8_t segment_max = Point_Num - 2;
+
+    // 先查上一周期所在段及其相邻段
+    if (__X >= Table[Segment].X)
+    {
+        if (Segment == segment_max || __X < Table[Segment + 1].X)
+        {
+            return (Segment);
+        }
+        if (Segment + 1 == segment_max || __X < Table[Segment + 2].X)
+        {
+            return (Segment + 1);
+        }
+    }
+    else
+    {
+        if (Segment == 0 || __X >= Table[Segment - 1].X)
+        {
+            return (Segment == 0 ? 0 : Segment - 1);
+        }
+    }
+
+    // 二分查找满足 Table[i].X <= X 的最大段号
+    uint8_t low = 0;
+    uint8_t high = segment_max;
+    while (low < high)
+    {
+        uint8_t middle = (uint8_t) ((low + high + 1) / 2);
+        if (Table[middle].X <= __X)
+        {
+            low = middle;
+        }
+        else
+        {
+            high = middle - 1;
+        }
+    }
+    return (low);
+}
+
+/**
+ * @brief 将当前参数写入PID
+ *
+ */
+void Class_PID_Gain_Schedule::Output()
+{
+    PID->Set_K_P(Now_Point.K_P);
+    PID->Set_K_I(Now_Point.K_I);
+    PID->Set_K_D(Now_Point.K_D);
+    PID->Set_K_F(Now_Point.K_F);
+    PID->Set_I_Out_Max(Now_Point.I_Out_Max);
+    PID->Set_Out_Max(Now_Point.Out_Max);
+}
+
+/*****************************************************************************/
@@ -0,0 +1,153 @@
+/**
+ * @file alg_gain_schedule.h
+ * @author WFZ
+ * @brief PID增益调度, 按调度变量在断点表中线性插值PID参数与限幅
+ * @version 0.0
+ * @date 2026-2-6
+ *
+ */
+
+#ifndef ALG_GAIN_SCHEDULE_H
+#define ALG_GAIN_SCHEDULE_H
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "alg_pid.h"
+
+/* Exported macros -----------------------------------------------------------*/
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+ * @brief 调度变量的取法
+ *
+ */
+typedef enum
+{
+    PID_Gain_Schedule_Input_SIGNED = 0,  // 直接查表, 如云台Pitch角度
+    PID_Gain_Schedule_Input_ABS,         // 取绝对值查表, 如正反转对称的轮速
+} Enum_PID_Gain_Schedule_Input;
+
+/**
+ * @brief 断点表的一行, 限幅为0表示不限制
+ *
+ */
+struct Struct_PID_Gain_Schedule_Point
+{
+    // 调度变量, 各行严格递增
+    float X;
+    float K_P;
+    float K_I;
+    float K_D;
+    float K_F;
+    float I_Out_Max;
+    float Out_Max;
+};
+
+/**
+ * @brief PID增益调度
+ *
+ * 断点表按调度变量递增存放, 两断点之间线性插值, 表外取端点的值.
+ * 调度变量每周期变化很小, 先查上一周期所在段及其相邻段, 命中时为O(1), 否则二分查找, 为O(log n).
+ * 调度变量不变时不重写PID参数; K_I变化时按比例换算积分, 积分项输出不跳变.
+ *
+ * 使用方法 ：
+ *  1) 断点表定义为const数组, 存放在Flash中, 可供多个调度共用
+ *  2) Init(被调度的PID, 断点表, 行数, 调度变量取法), 立即按表首行写入参数
+ *  3) 每个控制周期在PID计算之前 TIM_Calculate_PeriodElapsedCallback(调度变量)
+ *
+ */
+class Class_PID_Gain_Schedule
+{
+public:
+    void Init(Class_PID *__PID, const Struct_PID_Gain_Schedule_Point *__Table, uint8_t __Point_Num, Enum_PID_Gain_Schedule_Input __Input = PID_Gain_Schedule_Input_SIGNED);
+
+    inline const Struct_PID_Gain_Schedule_Point &Get_Now_Point();
+
+    inline uint8_t Get_Segment();
+
+    void TIM_Calculate_PeriodElapsedCallback(float __X);
+
+protected:
+    // 初始化相关常量
+
+    // 被调度的PID
+    Class_PID *PID = nullptr;
+    // 断点表
+    const Struct_PID_Gain_Schedule_Point *Table = nullptr;
+    // 断点表行数
+    uint8_t Point_Num = 0;
+    // 调度变量的取法
+    Enum_PID_Gain_Schedule_Input Input = PID_Gain_Schedule_Input_SIGNED;
+
+    // 内部变量
+
+    // 上一周期的调度变量
+    float Pre_X = 0.0f;
+    // 上一周期所在段, 即 Table[Segment].X <= X < Table[Segment + 1].X
+    uint8_t Segment = 0;
+
+    // 读变量
+
+    // 当前插值得到的参数
+    Struct_PID_Gain_Schedule_Point Now_Point = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+
+    // 内部函数
+
+    uint8_t Search(float __X);
+
+    void Output();
+};
+
+/* Exported variables --------------------------------------------------------*/
+
+/* Exported function declarations --------------------------------------------*/
+
+/**
+ * @brief 获取当前插值得到的参数
+ *
+ * @return const Struct_PID_Gain_Schedule_Point& 当前参数, X为查表所用的调度变量
+ */
+inline const Struct_PID_Gain_Schedule_Point &Class_PID_Gain_Schedule::Get_Now_Point()
+{
+    return (Now_Point);
+}
+
+/**
+ * @brief 获取当前所在段
+ *
+ * @return uint8_t 段号, 第i段位于第i行与第i+1行之间
+ */
+inline uint8_t Class_PID_Gain_Schedule::Get_Segment()
+{
+    return (Segment);
+}
+
+#endif
+
+/*
+模板：
+static const Struct_PID_Gain_Schedule_Point XXX_Schedule_Table[] = {
+    //X      K_P    K_I   K_D   K_F   I_Out_Max  Out_Max
+    {0.0f,   1.0f,  0.0f, 0.0f, 0.0f, 0.0f,      10.0f},
+    {20.0f,  1.0f,  0.0f, 0.0f, 0.0f, 0.0f,      10.0f},
+    {40.0f,  0.5f,  0.0f, 0.0f, 0.0f, 0.0f,      10.0f},
+};
+
+Class_PID_Gain_Schedule XXX_Schedule;
+
+XXX_Schedule.Init(&XXX_PID, XXX_Schedule_Table, sizeof(XXX_Schedule_Table) / sizeof(XXX_Schedule_Table[0]), PID_Gain_Schedule_Input_ABS);
+
+假设这是一个1ms执行一次的函数{
+
+		XXX_Schedule.TIM_Calculate_PeriodElapsedCallback(Now_Omega);//先按调度变量更新参数
+
+		XXX_PID.Set_Target(Target_Omega);
+		XXX_PID.Set_Now(Now_Omega);
+		XXX_PID.TIM_Adjust_PeriodElapsedCallback();
+
+}
+
+*/
+
+/*****************************************************************************/
@@ -17,6 +17,19 @@
 
 /* Exported macros -----------------------------------------------------------*/
 
+// 实测控制周期相对D_T的下限与上限, 反馈挤在一起或中断时按此限幅, 避免微分放大噪声、积分一次跳变
+#define PID_D_T_MIN_RATIO (0.5f)
+#define PID_D_T_MAX_RATIO (5.0f)
+
+// PID组逐个控制器遍历时的展开提示, 目标板上展开为直线代码, 主机上交给编译器向量化
+#if defined(__arm__) && defined(__clang__)
+#define PID_BANK_UNROLL _Pragma("unroll")
+#elif defined(__arm__) && defined(__GNUC__)
+#define PID_BANK_UNROLL _Pragma("GCC unroll 8")
+#else
+#define PID_BANK_UNROLL
+#endif
+
 /* Exported types ------------------------------------------------------------*/
 
 /**
@@ -48,12 +61,173 @@ typedef enum {
 } Enum_PID_Zero_Position_Integral_Bleeding;
 
 /**
- * @brief Reusable, PID算法
+ * @brief 控制周期来源
+ *
+ */
+typedef enum {
+    PID_D_T_Mode_FIXED = 0,     // 固定为D_T
+    PID_D_T_Mode_MEASURED,      // 相邻两次反馈的时间戳之差, 由Set_Now_Timestamp_Us给出
+} Enum_PID_D_T_Mode;
+
+/**
+ * @brief 条件积分, 输出被Out_Max限幅且误差使输出更加饱和时, 本周期不积分
+ *
+ */
+typedef enum {
+    PID_Conditional_Integration_DISABLE = 0,
+    PID_Conditional_Integration_ENABLE,
+} Enum_PID_Conditional_Integration;
+
+/**
+ * @brief PID功能, 作为Class_PID_T的模板参数, 未列出的功能在编译期整段去掉, 对应的设置接口不可调用
+ * @note P与I始终存在. 微分先行、D项滤波、D项限幅依赖微分项, 零位积分泄放依赖死区, 抗饱和依赖输出限幅
+ *
+ */
+typedef enum {
+    PID_Feature_DIRECTION = 1 << 0,         // 方向可设为负相关
+    PID_Feature_DEAD_ZONE = 1 << 1,         // 死区
+    PID_Feature_VARIABLE_SPEED_I = 1 << 2,  // 变速积分
+    PID_Feature_I_SEPARATE = 1 << 3,        // 积分分离
+    PID_Feature_I_LIMIT = 1 << 4,           // 积分限幅
+    PID_Feature_D = 1 << 5,                 // 微分项
+    PID_Feature_D_FIRST = 1 << 6,           // 微分先行
+    PID_Feature_D_FILTER = 1 << 7,          // D项低通滤波
+    PID_Feature_D_LIMIT = 1 << 8,           // D项限幅
+    PID_Feature_F = 1 << 9,                 // 前馈
+    PID_Feature_OUT_LIMIT = 1 << 10,        // 输出限幅
+    PID_Feature_ZPIB = 1 << 11,             // 零位积分泄放
+    PID_Feature_MEASURED_D_T = 1 << 12,     // 实测控制周期
+    PID_Feature_BANK = 1 << 13,             // 可绑定到PID组
+    PID_Feature_ANTI_WINDUP = 1 << 14,      // 输出饱和时的反算抗饱和与条件积分
+    PID_Feature_BUMPLESS = 1 << 15,         // 无扰切换
+    PID_Feature_ALL = (1 << 16) - 1,        // 全部功能, 绑定到PID组的控制器使用
+    PID_Feature_DEFAULT = PID_Feature_ALL & ~PID_Feature_BANK, // 除PID组外的全部功能, 即Class_PID
+} Enum_PID_Feature;
+
+/**
+ * @brief PID组的字段, 组内每个字段是一段长度为控制器个数的连续数组
+ * @note 开关量按浮点存放: 微分先行、零位积分泄放、条件积分与无扰切换待执行为0或1, 方向为1或-1
+ *
+ */
+typedef enum {
+    // 参数
+    PID_Bank_Field_K_P = 0,
+    PID_Bank_Field_K_I,
+    PID_Bank_Field_K_D,
+    PID_Bank_Field_K_F,
+    PID_Bank_Field_I_Out_Max,
+    PID_Bank_Field_D_Out_Max,
+    PID_Bank_Field_Out_Max,
+    PID_Bank_Field_D_T,
+    PID_Bank_Field_Dead_Zone,
+    PID_Bank_Field_I_Variable_Speed_A,
+    PID_Bank_Field_I_Variable_Speed_B,
+    PID_Bank_Field_I_Separate_Threshold,
+    PID_Bank_Field_D_First,
+    PID_Bank_Field_Direction,
+    PID_Bank_Field_D_Filter_Alpha,
+    PID_Bank_Field_Zero_Position_Integral_Bleeding,
+    PID_Bank_Field_K_Back_Calculation,
+    PID_Bank_Field_Conditional_Integration,
+    // 输入
+    PID_Bank_Field_Target,
+    PID_Bank_Field_Now,
+    // 内部状态
+    PID_Bank_Field_Pre_Target,
+    PID_Bank_Field_Pre_Out,
+    PID_Bank_Field_Pre_Error,
+    PID_Bank_Field_Integral_Error,
+    PID_Bank_Field_Filtered_D_Out,
+    PID_Bank_Field_Bumpless,
+    PID_Bank_Field_Bumpless_Out,
+    // 输出
+    PID_Bank_Field_Out,
+    PID_Bank_Field_P_Out,
+    PID_Bank_Field_I_Out,
+    PID_Bank_Field_D_Out,
+    PID_Bank_Field_F_Out,
+    PID_Bank_Field_Error,
+    PID_Bank_Field_NUM,
+} Enum_PID_Bank_Field;
+
+/**
+ * @brief Reusable, PID组, Num个控制器的参数与状态按字段连续存放, 每周期一次遍历全部计算
+ * @note 计算结果与Class_PID固定周期模式逐位相同, 组内不支持实测周期模式
+ *       控制器为启用PID_Feature_BANK的Class_PID_T, 如Class_PID_T<PID_Feature_ALL>, 由Bind_Bank绑定到组内一个槽位, 之后其接口读写的都是槽位中的数据
+ *       控制器本周期不需要计算时(如电机不在速度环或角度环模式)应关闭其槽位, 以免以过期的目标值与当前值积分
+ *
+ */
+template <uint32_t Num>
+class Class_PID_Bank
+{
+public:
+    void Init();
+
+    inline float *Get_Data();
+
+    inline float Get_Out(uint32_t Slot);
+
+    inline void Set_Target(uint32_t Slot, float __Target);
+
+    inline void Set_Now(uint32_t Slot, float __Now);
+
+    inline bool Get_Slot_Enable(uint32_t Slot);
+
+    inline void Set_Slot_Enable(uint32_t Slot, bool __Enable);
+
+    void TIM_Adjust_PeriodElapsedCallback();
+
+protected:
+    // 各字段的数据按字段连续存放, 第field个字段第slot个控制器位于 Data[field * Num + slot]
+    float Data[PID_Bank_Field_NUM * Num] = {};
+    // 各槽位是否参与计算, 未参与的槽位状态与输出保持不变
+    bool Slot_Enable[Num] = {};
+};
+
+/**
+ * @brief 功能列表合并为位掩码
+ *
+ */
+constexpr uint32_t PID_Feature_Mask()
+{
+    return (0);
+}
+
+template <typename... Type_Feature>
+constexpr uint32_t PID_Feature_Mask(Enum_PID_Feature Feature, Type_Feature... Rest)
+{
+    return (Feature | PID_Feature_Mask(Rest...));
+}
+
+/**
+ * @brief Reusable, PID算法, 模板参数为启用的功能, 见Enum_PID_Feature
+ * @note 未启用的功能: 计算中对应分支在编译期去掉, Init中对应参数被忽略, 对应的设置接口调用时编译报错.
+ *       Class_PID即除PID组外全部功能启用的实例, 与之前的实现逐位相同, 未绑定的控制器不为PID组多做判断
  *
  */
-class Class_PID
+template <Enum_PID_Feature... Features>
+class Class_PID_T
 {
 public:
+    // 启用的功能, 位掩码
+    static constexpr uint32_t Feature_Mask = PID_Feature_Mask(Features...);
+
+    /**
+     * @brief 功能是否启用
+     * @param Feature 功能
+     * @return 启用为true
+     */
+    static constexpr bool Feature_Enabled(Enum_PID_Feature Feature)
+    {
+        return ((Feature_Mask & Feature) != 0);
+    }
+
+    // 类体内尚不能调用Feature_Enabled, 依赖关系直接按掩码检查
+    static_assert((Feature_Mask & PID_Feature_D) != 0 || (Feature_Mask & (PID_Feature_D_FIRST | PID_Feature_D_FILTER | PID_Feature_D_LIMIT)) == 0,
+                  "D_FIRST, D_FILTER and D_LIMIT require PID_Feature_D");
+    static_assert((Feature_Mask & PID_Feature_DEAD_ZONE) != 0 || (Feature_Mask & PID_Feature_ZPIB) == 0, "ZPIB requires PID_Feature_DEAD_ZONE");
+    static_assert((Feature_Mask & PID_Feature_OUT_LIMIT) != 0 || (Feature_Mask & PID_Feature_ANTI_WINDUP) == 0, "ANTI_WINDUP requires PID_Feature_OUT_LIMIT");
+
     /**
      * @brief 初始化PID参数
      * @param __K_P              比例增益，需大于等于0
@@ -72,6 +246,7 @@ public:
      * @param __Direction        PID方向，默认正相关
      * @param __D_Filter_Alpha   D项低通滤波系数，0~1，越小滤波越强，0表示不使用滤波，默认0
      * @param __Zero_Position_Integral_Bleeding 零位积分泄放，默认禁用
+     * @note 未启用功能对应的参数被忽略
      */
     void Init(float __K_P, float __K_I, float __K_D, float __K_F = 0.0f,
               float __I_Out_Max = 0.0f, float __D_Out_Max = 0.0f, float __Out_Max = 0.0f,
@@ -137,7 +312,13 @@ public:
      */
     float Get_Error();
 
-    /* 各参数单独设置接口，便于运行时动态调整 */
+    /**
+     * @brief 获取本次计算使用的控制周期
+     * @return 控制周期，单位：秒，反馈未更新时为0
+     */
+    float Get_Now_D_T();
+
+    /* 各参数单独设置接口，便于运行时动态调整, 未启用功能的接口不可调用 */
     void Set_K_P(float __K_P);                ///< 设置比例增益
     void Set_K_I(float __K_I);                ///< 设置积分增益
     void Set_K_D(float __K_D);                ///< 设置微分增益
@@ -153,6 +334,14 @@ public:
     void Set_D_Filter_Alpha(float __D_Filter_Alpha); ///< 设置D项低通滤波系数
     void Set_Zero_Position_Integral_Bleeding(Enum_PID_Zero_Position_Integral_Bleeding __Zero_Position_Integral_Bleeding); ///< 设置零位积分泄放标志位
     void Set_D_Out_Max(float __D_Out_Max); ///< 设置D项限幅
+    void Set_D_T_Mode(Enum_PID_D_T_Mode __D_T_Mode); ///< 设置控制周期来源
+    void Set_Now_Timestamp_Us(uint32_t __Now_Timestamp_Us); ///< 设置当前值的采样时刻, 实测周期模式使用
+    void Set_K_Back_Calculation(float __K_Back_Calculation); ///< 设置反算抗饱和增益, 0为不启用
+    void Set_Conditional_Integration(Enum_PID_Conditional_Integration __Conditional_Integration); ///< 设置条件积分
+    void Set_Bumpless_Out(float __Bumpless_Out); ///< 无扰切换, 下一次计算的输出从该值开始
+
+    template <uint32_t Num>
+    void Bind_Bank(Class_PID_Bank<Num> *Bank, uint32_t Slot); ///< 绑定到PID组的一个槽位, 当前参数与状态随之复制过去, 需启用PID_Feature_BANK
 
     void TIM_Adjust_PeriodElapsedCallback();
 
@@ -163,12 +352,18 @@ protected:
     Enum_PID_D_First D_First;       ///< 微分先行开关
     PID_Direction Direction;        ///< PID方向
     Enum_PID_Zero_Position_Integral_Bleeding Zero_Position_Integral_Bleeding = PID_ZPIB_DISABLE; ///< 零位积分泄放
+    Enum_PID_D_T_Mode D_T_Mode = PID_D_T_Mode_FIXED; ///< 控制周期来源
+    Enum_PID_Conditional_Integration Conditional_Integration = PID_Conditional_Integration_DISABLE; ///< 条件积分
 
     /* 内部状态变量 */
     float Pre_Now = 0.0f;           ///< 上一周期当前值
     float Pre_Target = 0.0f;        ///< 上一周期目标值
     float Pre_Out = 0.0f;           ///< 上一周期输出值
     float Pre_Error = 0.0f;         ///< 上一周期误差
+    uint32_t Now_Timestamp_Us = 0;  ///< 当前值的采样时刻，us
+    uint32_t Pre_Timestamp_Us = 0;  ///< 上一次计算时当前值的采样时刻，us
+    bool Pre_Timestamp_Valid = false; ///< 已有上一次的采样时刻
+    float Now_D_T = 0.0f;           ///< 本次计算使用的控制周期，单位：秒
 
     /* 输出值（只读外部接口） */
     float Out = 0.0f;               ///< 当前PID输出值
@@ -194,18 +389,1100 @@ protected:
 
     float D_Filter_Alpha = 0.0f;  ///< D项滤波系数
 
+    float K_Back_Calculation = 0.0f; ///< 反算抗饱和增益, 1/s, 0表示不启用
+
     float Target = 0.0f;            ///< 当前目标值
     float Now = 0.0f;               ///< 当前测量值
 
     /* 读写变量 */
     float Integral_Error = 0.0f;    ///< 积分误差累计值
     float filtered_d_out = 0.0f;  ///< 滤波后的D项输出
+    bool Bumpless_Pending = false;  ///< 无扰切换待执行
+    float Bumpless_Out = 0.0f;      ///< 无扰切换的起始输出
+
+    /* PID组槽位, 绑定后参数与状态以槽位中的为准 */
+    float *Bank_Data = nullptr;     ///< 所在PID组的数据, nullptr表示未绑定
+    uint32_t Bank_Stride = 0;       ///< 所在PID组的控制器个数
+    uint32_t Bank_Slot = 0;         ///< 所在槽位
+
+    inline bool Bank_Bound();
+
+    inline float &Bank_Field(Enum_PID_Bank_Field Field);
+
+    void Bind_Bank_Data(float *__Bank_Data, uint32_t __Bank_Stride, uint32_t __Bank_Slot);
+
+    void Bank_Store();
 };
 
 /* Exported variables --------------------------------------------------------*/
 
 /* Exported function declarations --------------------------------------------*/
 
+/**
+ * @brief PID组中一个控制器的计算, 与Class_PID固定周期模式逐位相同
+ * @note 各分支都改写为先算后选, 除法无条件执行, 逻辑与或不短路, 循环体内没有控制流,
+ *       主机上以-O3 -fno-trapping-math编译时GCC将组内遍历向量化, 目标板上按PID_BANK_UNROLL展开
+ *
+ * @param Data PID组数据
+ * @param Stride 组内控制器个数
+ * @param Slot 槽位
+ */
+inline void PID_Bank_Calculate(float *Data, uint32_t Stride, uint32_t Slot)
+{
+    float *slot = Data + Slot;
+
+    float k_p = slot[PID_Bank_Field_K_P * Stride];
+    float k_i = slot[PID_Bank_Field_K_I * Stride];
+    float k_d = slot[PID_Bank_Field_K_D * Stride];
+    float k_f = slot[PID_Bank_Field_K_F * Stride];
+    float i_out_max = slot[PID_Bank_Field_I_Out_Max * Stride];
+    float d_out_max = slot[PID_Bank_Field_D_Out_Max * Stride];
+    float out_max = slot[PID_Bank_Field_Out_Max * Stride];
+    float d_t = slot[PID_Bank_Field_D_T * Stride];
+    float dead_zone = slot[PID_Bank_Field_Dead_Zone * Stride];
+    float i_variable_speed_a = slot[PID_Bank_Field_I_Variable_Speed_A * Stride];
+    float i_variable_speed_b = slot[PID_Bank_Field_I_Variable_Speed_B * Stride];
+    float i_separate_threshold = slot[PID_Bank_Field_I_Separate_Threshold * Stride];
+    float d_first = slot[PID_Bank_Field_D_First * Stride];
+    float direction = slot[PID_Bank_Field_Direction * Stride];
+    float d_filter_alpha = slot[PID_Bank_Field_D_Filter_Alpha * Stride];
+    float zero_position_integral_bleeding = slot[PID_Bank_Field_Zero_Position_Integral_Bleeding * Stride];
+    float k_back_calculation = slot[PID_Bank_Field_K_Back_Calculation * Stride];
+    float conditional_integration = slot[PID_Bank_Field_Conditional_Integration * Stride];
+    float target = slot[PID_Bank_Field_Target * Stride];
+    float now = slot[PID_Bank_Field_Now * Stride];
+    float pre_target = slot[PID_Bank_Field_Pre_Target * Stride];
+    float pre_out = slot[PID_Bank_Field_Pre_Out * Stride];
+    float pre_error = slot[PID_Bank_Field_Pre_Error * Stride];
+    float integral_error = slot[PID_Bank_Field_Integral_Error * Stride];
+    float filtered_d_out = slot[PID_Bank_Field_Filtered_D_Out * Stride];
+    float bumpless = slot[PID_Bank_Field_Bumpless * Stride];
+    float bumpless_out = slot[PID_Bank_Field_Bumpless_Out * Stride];
+    float out = slot[PID_Bank_Field_Out * Stride];
+
+    // 误差, 方向与死区
+    float error = (target - now) * direction;
+    float abs_error = Math_Abs(error);
+    bool in_dead_zone = abs_error < dead_zone;
+    error = in_dead_zone ? 0.0f : error;
+    abs_error = in_dead_zone ? 0.0f : abs_error;
+
+    float p_out = k_p * error;
+
+    // 无扰切换时微分与前馈从本周期开始
+    bool bumpless_enable = bumpless != 0.0f;
+    pre_error = bumpless_enable ? error : pre_error;
+    pre_out = bumpless_enable ? out : pre_out;
+    pre_target = bumpless_enable ? target : pre_target;
+    filtered_d_out = bumpless_enable ? 0.0f : filtered_d_out;
+
+    // 变速积分, A与B均为0时不变速
+    float speed_ratio_linear = 1.0f - (abs_error - i_variable_speed_a) / i_variable_speed_b;
+    bool speed_full = (abs_error <= i_variable_speed_a) | ((i_variable_speed_a == 0.0f) & (i_variable_speed_b == 0.0f));
+    float speed_ratio = speed_full ? 1.0f : (abs_error < i_variable_speed_a + i_variable_speed_b ? speed_ratio_linear : 0.0f);
+
+    // 积分与积分限幅, 限幅为0表示不限幅
+    float integral_error_limit = i_out_max / k_i;
+    integral_error_limit = ((k_i > 0.0f) & (i_out_max != 0.0f)) ? integral_error_limit : FLT_MAX;
+    float i_out_limit = (i_out_max != 0.0f) ? i_out_max : FLT_MAX;
+    float integral_error_accumulate = integral_error + speed_ratio * d_t * error;
+    Math_Constrain(&integral_error_accumulate, -integral_error_limit, integral_error_limit);
+    float i_out = k_i * integral_error_accumulate;
+    Math_Constrain(&i_out, -i_out_limit, i_out_limit);
+
+    // 零位积分泄放优先, 其次积分分离
+    bool bleeding = (zero_position_integral_bleeding != 0.0f) & (Math_Abs(target) < dead_zone) & (abs_error < dead_zone);
+    bool separate = (i_separate_threshold != 0.0f) & !(abs_error < i_separate_threshold);
+    float integral_error_bleeding = (Math_Abs(integral_error) > 0.0001f) ? integral_error * 0.95f : integral_error;
+    float pre_integral_error = integral_error;
+    integral_error = bleeding ? integral_error_bleeding : (separate ? 0.0f : integral_error_accumulate);
+    i_out = (bleeding | separate) ? 0.0f : i_out;
+
+    // 微分, 滤波与限幅
+    float d_difference = (d_first != 0.0f) ? (out - pre_out) : (error - pre_error);
+    float d_raw = k_d * d_difference / d_t;
+    float filtered_d_out_update = d_filter_alpha * d_raw + (1.0f - d_filter_alpha) * filtered_d_out;
+    bool d_filter = d_filter_alpha > 0.0f;
+    filtered_d_out = d_filter ? filtered_d_out_update : filtered_d_out;
+    float d_out = d_filter ? filtered_d_out_update : d_raw;
+    float d_out_limit = (d_out_max != 0.0f) ? d_out_max : FLT_MAX;
+    Math_Constrain(&d_out, -d_out_limit, d_out_limit);
+
+    float f_out = k_f * (target - pre_target) / d_t;
+
+    // 无扰切换, 积分项取起始输出减去比例项, 微分与前馈本周期为0
+    float i_out_bumpless = bumpless_out - p_out;
+    Math_Constrain(&i_out_bumpless, -i_out_limit, i_out_limit);
+    bool bumpless_integral = bumpless_enable & (k_i > 0.0f);
+    i_out = bumpless_integral ? i_out_bumpless : i_out;
+    integral_error = bumpless_integral ? i_out_bumpless / k_i : integral_error;
+
+    float out_raw = p_out + i_out + d_out + f_out;
+    out = out_raw;
+    float out_limit = (out_max != 0.0f) ? out_max : FLT_MAX;
+    Math_Constrain(&out, -out_limit, out_limit);
+
+    // 抗饱和, 条件积分撤销本周期的累加, 反算按限幅量回拉积分
+    float saturation = out - out_raw;
+    bool anti_windup = !(bleeding | separate | bumpless_enable) & (saturation != 0.0f);
+    bool conditional = anti_windup & (conditional_integration != 0.0f) & (error * saturation < 0.0f);
+    integral_error = conditional ? pre_integral_error : integral_error;
+    float integral_error_back_calculation = integral_error + k_back_calculation * saturation * d_t / k_i;
+    integral_error = (anti_windup & (k_back_calculation > 0.0f) & (k_i > 0.0f)) ? integral_error_back_calculation : integral_error;
+
+    slot[PID_Bank_Field_Pre_Target * Stride] = target;
+    slot[PID_Bank_Field_Pre_Out * Stride] = out;
+    slot[PID_Bank_Field_Pre_Error * Stride] = error;
+    slot[PID_Bank_Field_Integral_Error * Stride] = integral_error;
+    slot[PID_Bank_Field_Filtered_D_Out * Stride] = filtered_d_out;
+    slot[PID_Bank_Field_Bumpless * Stride] = 0.0f;
+    slot[PID_Bank_Field_Out * Stride] = out;
+    slot[PID_Bank_Field_P_Out * Stride] = p_out;
+    slot[PID_Bank_Field_I_Out * Stride] = i_out;
+    slot[PID_Bank_Field_D_Out * Stride] = d_out;
+    slot[PID_Bank_Field_F_Out * Stride] = f_out;
+    slot[PID_Bank_Field_Error * Stride] = error;
+}
+
+/**
+ * @brief 初始化PID组, 全部控制器参数清零, 方向为正, 控制周期0.001s
+ *
+ */
+template <uint32_t Num>
+void Class_PID_Bank<Num>::Init()
+{
+    for (uint32_t i = 0; i < PID_Bank_Field_NUM * Num; i++)
+    {
+        Data[i] = 0.0f;
+    }
+    for (uint32_t slot = 0; slot < Num; slot++)
+    {
+        Data[PID_Bank_Field_Direction * Num + slot] = 1.0f;
+        Data[PID_Bank_Field_D_T * Num + slot] = 0.001f;
+        Slot_Enable[slot] = true;
+    }
+}
+
+/**
+ * @brief 获取PID组数据, 供Class_PID绑定
+ *
+ * @return float* PID组数据
+ */
+template <uint32_t Num>
+inline float *Class_PID_Bank<Num>::Get_Data()
+{
+    return (Data);
+}
+
+/**
+ * @brief 获取一个控制器的输出
+ *
+ * @param Slot 槽位
+ * @return float 输出值
+ */
+template <uint32_t Num>
+inline float Class_PID_Bank<Num>::Get_Out(uint32_t Slot)
+{
+    return (Data[PID_Bank_Field_Out * Num + Slot]);
+}
+
+/**
+ * @brief 设定一个控制器的目标值
+ *
+ * @param Slot 槽位
+ * @param __Target 目标值
+ */
+template <uint32_t Num>
+inline void Class_PID_Bank<Num>::Set_Target(uint32_t Slot, float __Target)
+{
+    Data[PID_Bank_Field_Target * Num + Slot] = __Target;
+}
+
+/**
+ * @brief 设定一个控制器的当前值
+ *
+ * @param Slot 槽位
+ * @param __Now 当前值
+ */
+template <uint32_t Num>
+inline void Class_PID_Bank<Num>::Set_Now(uint32_t Slot, float __Now)
+{
+    Data[PID_Bank_Field_Now * Num + Slot] = __Now;
+}
+
+/**
+ * @brief 获取一个槽位是否参与计算
+ *
+ * @param Slot 槽位
+ * @return bool 参与计算为true
+ */
+template <uint32_t Num>
+inline bool Class_PID_Bank<Num>::Get_Slot_Enable(uint32_t Slot)
+{
+    return (Slot_Enable[Slot]);
+}
+
+/**
+ * @brief 设定一个槽位是否参与计算
+ *
+ * @param Slot 槽位
+ * @param __Enable 参与计算为true
+ */
+template <uint32_t Num>
+inline void Class_PID_Bank<Num>::Set_Slot_Enable(uint32_t Slot, bool __Enable)
+{
+    Slot_Enable[Slot] = __Enable;
+}
+
+/**
+ * @brief 组内参与计算的控制器计算一次, 控制器个数为编译期常量
+ *
+ */
+template <uint32_t Num>
+void Class_PID_Bank<Num>::TIM_Adjust_PeriodElapsedCallback()
+{
+    PID_BANK_UNROLL
+    for (uint32_t slot = 0; slot < Num; slot++)
+    {
+        if (Slot_Enable[slot])
+        {
+            PID_Bank_Calculate(Data, Num, slot);
+        }
+    }
+}
+
+/**
+ * @brief 绑定到PID组的一个槽位
+ *
+ * @param Bank PID组
+ * @param Slot 槽位, 小于组内控制器个数
+ */
+template <Enum_PID_Feature... Features>
+template <uint32_t Num>
+void Class_PID_T<Features...>::Bind_Bank(Class_PID_Bank<Num> *Bank, uint32_t Slot)
+{
+    // 成员模板只在调用时实例化, 检查放在这里, Class_PID的显式实例化不受影响
+    static_assert(Feature_Enabled(PID_Feature_BANK), "PID_Feature_BANK not enabled");
+    Bind_Bank_Data(Bank->Get_Data(), Num, Slot);
+}
+
+/**
+ * @brief 所在槽位中的一个字段
+ *
+ * @param Field 字段
+ * @return float& 字段的引用
+ */
+template <Enum_PID_Feature... Features>
+inline float &Class_PID_T<Features...>::Bank_Field(Enum_PID_Bank_Field Field)
+{
+    return (Bank_Data[Field * Bank_Stride + Bank_Slot]);
+}
+
+/**
+ * @brief 是否已绑定到PID组, 未启用该功能时恒为false
+ *
+ * @return 已绑定为true
+ */
+template <Enum_PID_Feature... Features>
+inline bool Class_PID_T<Features...>::Bank_Bound()
+{
+    return (Feature_Enabled(PID_Feature_BANK) && Bank_Data != nullptr);
+}
+
+
+/**
+ * @brief PID初始化
+ *
+ * @param __K_P P值
+ * @param __K_I I值
+ * @param __K_D D值
+ * @param __K_F 加速度前馈
+ * @param __I_Out_Max 积分限幅
+ * @param __Out_Max 输出限幅
+ * @param __D_T 时间片长度
+ */
+template <Enum_PID_Feature... Features>
+void Class_PID_T<Features...>::Init(float __K_P, float __K_I, float __K_D, float __K_F,
+              float __I_Out_Max, float __D_Out_Max, float __Out_Max,
+              float __D_T,
+              float __Dead_Zone, 
+              float __I_Variable_Speed_A, float __I_Variable_Speed_B, float __I_Separate_Threshold, Enum_PID_D_First __D_First,
+              PID_Direction __Direction,
+              float __D_Filter_Alpha,
+              Enum_PID_Zero_Position_Integral_Bleeding __Zero_Position_Integral_Bleeding
+            )
+{
+    // 未启用的功能取不起作用的参数
+    K_P = __K_P;
+    K_I = __K_I;
+    K_D = Feature_Enabled(PID_Feature_D) ? __K_D : 0.0f;
+    K_F = Feature_Enabled(PID_Feature_F) ? __K_F : 0.0f;
+    I_Out_Max = Feature_Enabled(PID_Feature_I_LIMIT) ? __I_Out_Max : 0.0f;
+    Out_Max = Feature_Enabled(PID_Feature_OUT_LIMIT) ? __Out_Max : 0.0f;
+    D_Out_Max = Feature_Enabled(PID_Feature_D_LIMIT) ? __D_Out_Max : 0.0f;
+    D_T = __D_T;
+    D_Filter_Alpha = Feature_Enabled(PID_Feature_D_FILTER) ? __D_Filter_Alpha : 0.0f;
+    Dead_Zone = Feature_Enabled(PID_Feature_DEAD_ZONE) ? __Dead_Zone : 0.0f;
+    I_Variable_Speed_A = Feature_Enabled(PID_Feature_VARIABLE_SPEED_I) ? __I_Variable_Speed_A : 0.0f;
+    I_Variable_Speed_B = Feature_Enabled(PID_Feature_VARIABLE_SPEED_I) ? __I_Variable_Speed_B : 0.0f;
+    I_Separate_Threshold = Feature_Enabled(PID_Feature_I_SEPARATE) ? __I_Separate_Threshold : 0.0f;
+    Zero_Position_Integral_Bleeding = Feature_Enabled(PID_Feature_ZPIB) ? __Zero_Position_Integral_Bleeding : PID_ZPIB_DISABLE;
+    D_First = Feature_Enabled(PID_Feature_D_FIRST) ? __D_First : PID_D_First_DISABLE;
+    Direction = Feature_Enabled(PID_Feature_DIRECTION) ? __Direction : PID_DIRECT;
+    if (D_T <= 0.0f) {
+        // 错误处理
+        D_T = 0.001f;
+    }
+    if (Bank_Bound())
+    {
+        Bank_Store();
+    }
+}
+
+/**
+ * @brief 获取输出值
+ *
+ * @return float 输出值
+ */
+template <Enum_PID_Feature... Features>
+float Class_PID_T<Features...>::Get_Integral_Error()
+{
+    if (Bank_Bound())
+    {
+        return (Bank_Field(PID_Bank_Field_Integral_Error));
+    }
+    return (Integral_Error);
+}
+
+/**
+ * @brief 获取输出值
+ *
+ * @return float 输出值
+ */
+template <Enum_PID_Feature... Features>
+float Class_PID_T<Features...>::Get_Out()
+{
+    if (Bank_Bound())
+    {
+        return (Bank_Field(PID_Bank_Field_Out));
+    }
+    return (Out);
+}
+
+/**
+ * @brief 获取P输出值
+ *
+ * @return float P输出值
+ */
+template <Enum_PID_Feature... Features>
+float Class_PID_T<Features...>::Get_P_Out()
+{
+    if (Bank_Bound())
+    {
+        return (Bank_Field(PID_Bank_Field_P_Out));
+    }
+    return (p_out);
+}
+
+/**
+ * @brief 获取I输出值
+ *
+ * @return float I输出值
+ */
+template <Enum_PID_Feature... Features>
+float Class_PID_T<Features...>::Get_I_Out()
+{
+    if (Bank_Bound())
+    {
+        return (Bank_Field(PID_Bank_Field_I_Out));
+    }
+    return (i_out);
+}
+
+/**
+ * @brief 获取D输出值
+ *
+ * @return float D输出值
+ */
+template <Enum_PID_Feature... Features>
+float Class_PID_T<Features...>::Get_D_Out()
+{
+    if (Bank_Bound())
+    {
+        return (Bank_Field(PID_Bank_Field_D_Out));
+    }
+    return (d_out);
+}
+
+/**
+ * @brief 获取F输出值
+ *
+ * @return float F输出值
+ */
+template <Enum_PID_Feature... Features>
+float Class_PID_T<Features...>::Get_F_Out()
+{
+    if (Bank_Bound())
+    {
+        return (Bank_Field(PID_Bank_Field_F_Out));
+    }
+    return (f_out);
+}
+
+/**
+ * @brief 获取当前误差值
+ *
+ * @return float 当前误差值
+ */
+template <Enum_PID_Feature... Features>
+float Class_PID_T<Features...>::Get_Error()
+{
+    if (Bank_Bound())
+    {
+        return (Bank_Field(PID_Bank_Field_Error));
+    }
+    return (error);
+}
+
+/**
+ * @brief 获取本次计算使用的控制周期
+ *
+ * @return float 控制周期, s, 实测周期模式下反馈未更新时为0
+ */
+template <Enum_PID_Feature... Features>
+float Class_PID_T<Features...>::Get_Now_D_T()
+{
+    if (Bank_Bound())
+    {
+        return (D_T);
+    }
+    return (Now_D_T);
+}
+
+/**
+ * @brief 设定PID的P
+ *
+ * @param __K_P PID的P
+ */
+template <Enum_PID_Feature... Features>
+void Class_PID_T<Features...>::Set_K_P(float __K_P)
+{
+    K_P = __K_P;
+    if (Bank_Bound())
+    {
+        Bank_Field(PID_Bank_Field_K_P) = K_P;
+    }
+}
+
+/**
+ * @brief 设定PID的I
+ *
+ * @param __K_I PID的I
+ */
+template <Enum_PID_Feature... Features>
+void Class_PID_T<Features...>::Set_K_I(float __K_I)
+{
+    K_I = __K_I;
+    if (Bank_Bound())
+    {
+        Bank_Field(PID_Bank_Field_K_I) = K_I;
+    }
+}
+
+/**
+ * @brief 设定PID的D
+ *
+ * @param __K_D PID的D
+ */
+template <Enum_PID_Feature... Features>
+void Class_PID_T<Features...>::Set_K_D(float __K_D)
+{
+    static_assert(Feature_Enabled(PID_Feature_D), "PID_Feature_D not enabled");
+    K_D = __K_D;
+    if (Bank_Bound())
+    {
+        Bank_Field(PID_Bank_Field_K_D) = K_D;
+    }
+}
+
+/**
+ * @brief 设定前馈
+ *
+ * @param __K_F 前馈
+ */
+template <Enum_PID_Feature... Features>
+void Class_PID_T<Features...>::Set_K_F(float __K_F)
+{
+    static_assert(Feature_Enabled(PID_Feature_F), "PID_Feature_F not enabled");
+    K_F = __K_F;
+    if (Bank_Bound())
+    {
+        Bank_Field(PID_Bank_Field_K_F) = K_F;
+    }
+}
+
+/**
+ * @brief 设定积分限幅, 0为不限制
+ *
+ * @param __I_Out_Max 积分限幅, 0为不限制
+ */
+template <Enum_PID_Feature... Features>
+void Class_PID_T<Features...>::Set_I_Out_Max(float __I_Out_Max)
+{
+    static_assert(Feature_Enabled(PID_Feature_I_LIMIT), "PID_Feature_I_LIMIT not enabled");
+    I_Out_Max = __I_Out_Max;
+    if (Bank_Bound())
+    {
+        Bank_Field(PID_Bank_Field_I_Out_Max) = I_Out_Max;
+    }
+}
+
+/**
+ * @brief 设定输出限幅, 0为不限制
+ *
+ * @param __Out_Max 输出限幅, 0为不限制
+ */
+template <Enum_PID_Feature... Features>
+void Class_PID_T<Features...>::Set_Out_Max(float __Out_Max)
+{
+    static_assert(Feature_Enabled(PID_Feature_OUT_LIMIT), "PID_Feature_OUT_LIMIT not enabled");
+    Out_Max = __Out_Max;
+    if (Bank_Bound())
+    {
+        Bank_Field(PID_Bank_Field_Out_Max) = Out_Max;
+    }
+}
+
+/**
+ * @brief 设定定速内段阈值, 0为不限制
+ *
+ * @param __I_Variable_Speed_A 定速内段阈值, 0为不限制
+ */
+template <Enum_PID_Feature... Features>
+void Class_PID_T<Features...>::Set_I_Variable_Speed_A(float __I_Variable_Speed_A)
+{
+    static_assert(Feature_Enabled(PID_Feature_VARIABLE_SPEED_I), "PID_Feature_VARIABLE_SPEED_I not enabled");
+    I_Variable_Speed_A = __I_Variable_Speed_A;
+    if (Bank_Bound())
+    {
+        Bank_Field(PID_Bank_Field_I_Variable_Speed_A) = I_Variable_Speed_A;
+    }
+}
+
+/**
+ * @brief 设定变速区间, 0为不限制
+ *
+ * @param __I_Variable_Speed_B 变速区间, 0为不限制
+ */
+template <Enum_PID_Feature... Features>
+void Class_PID_T<Features...>::Set_I_Variable_Speed_B(float __I_Variable_Speed_B)
+{
+    static_assert(Feature_Enabled(PID_Feature_VARIABLE_SPEED_I), "PID_Feature_VARIABLE_SPEED_I not enabled");
+    I_Variable_Speed_B = __I_Variable_Speed_B;
+    if (Bank_Bound())
+    {
+        Bank_Field(PID_Bank_Field_I_Variable_Speed_B) = I_Variable_Speed_B;
+    }
+}
+
+/**
+ * @brief 设定积分分离阈值, 0为不限制
+ *
+ * @param __I_Separate_Threshold 积分分离阈值, 0为不限制
+ */
+template <Enum_PID_Feature... Features>
+void Class_PID_T<Features...>::Set_I_Separate_Threshold(float __I_Separate_Threshold)
+{
+    static_assert(Feature_Enabled(PID_Feature_I_SEPARATE), "PID_Feature_I_SEPARATE not enabled");
+    I_Separate_Threshold = __I_Separate_Threshold;
+    if (Bank_Bound())
+    {
+        Bank_Field(PID_Bank_Field_I_Separate_Threshold) = I_Separate_Threshold;
+    }
+}
+
+/**
+ * @brief 设定目标值
+ *
+ * @param __Target 目标值
+ */
+template <Enum_PID_Feature... Features>
+void Class_PID_T<Features...>::Set_Target(float __Target)
+{
+    Target = __Target;
+    if (Bank_Bound())
+    {
+        Bank_Field(PID_Bank_Field_Target) = Target;
+    }
+}
+
+/**
+ * @brief 设定当前值
+ *
+ * @param __Now 当前值
+ */
+template <Enum_PID_Feature... Features>
+void Class_PID_T<Features...>::Set_Now(float __Now)
+{
+    Now = __Now;
+    if (Bank_Bound())
+    {
+        Bank_Field(PID_Bank_Field_Now) = Now;
+    }
+}
+
+/**
+ * @brief 设定积分, 一般用于积分清零
+ *
+ * @param __Set_Integral_Error 积分值
+ */
+template <Enum_PID_Feature... Features>
+void Class_PID_T<Features...>::Set_Integral_Error(float __Integral_Error)
+{
+    Integral_Error = __Integral_Error;
+    if (Bank_Bound())
+    {
+        Bank_Field(PID_Bank_Field_Integral_Error) = Integral_Error;
+    }
+}
+
+/**
+ * @brief 设置D项滤波系数
+ * @param __D_Filter_Alpha D项低通滤波系数，0~1，越小滤波越强，0表示不使用滤波
+ */
+template <Enum_PID_Feature... Features>
+void Class_PID_T<Features...>::Set_D_Filter_Alpha(float __D_Filter_Alpha) {
+    static_assert(Feature_Enabled(PID_Feature_D_FILTER), "PID_Feature_D_FILTER not enabled");
+    D_Filter_Alpha = __D_Filter_Alpha;
+    if (D_Filter_Alpha < 0.0f) D_Filter_Alpha = 0.0f;
+    if (D_Filter_Alpha > 1.0f) D_Filter_Alpha = 1.0f;
+    if (Bank_Bound()) Bank_Field(PID_Bank_Field_D_Filter_Alpha) = D_Filter_Alpha;
+}
+
+ /**
+ * @brief 设置零位积分泄放标志位
+ * @param __Zero_Position_Integral_Bleeding 零位积分泄放标志位，用于判断是否在零位
+ */
+template <Enum_PID_Feature... Features>
+void Class_PID_T<Features...>::Set_Zero_Position_Integral_Bleeding(Enum_PID_Zero_Position_Integral_Bleeding __Zero_Position_Integral_Bleeding) {
+    static_assert(Feature_Enabled(PID_Feature_ZPIB), "PID_Feature_ZPIB not enabled");
+    Zero_Position_Integral_Bleeding = __Zero_Position_Integral_Bleeding;
+    if (Bank_Bound()) Bank_Field(PID_Bank_Field_Zero_Position_Integral_Bleeding) = (Zero_Position_Integral_Bleeding == PID_ZPIB_ENABLE) ? 1.0f : 0.0f;
+}
+
+/**
+ * @brief 设置D项限幅
+ * @param __D_Out_Max D项限幅，0为不限制
+ */
+template <Enum_PID_Feature... Features>
+void Class_PID_T<Features...>::Set_D_Out_Max(float __D_Out_Max) {
+    static_assert(Feature_Enabled(PID_Feature_D_LIMIT), "PID_Feature_D_LIMIT not enabled");
+    D_Out_Max = __D_Out_Max;
+    if (Bank_Bound()) Bank_Field(PID_Bank_Field_D_Out_Max) = D_Out_Max;
+}
+
+/**
+ * @brief 设置控制周期来源, 切换时重新开始计时
+ * @param __D_T_Mode 固定为D_T或按当前值的采样时刻实测, 绑定到PID组时固定为D_T
+ */
+template <Enum_PID_Feature... Features>
+void Class_PID_T<Features...>::Set_D_T_Mode(Enum_PID_D_T_Mode __D_T_Mode) {
+    static_assert(Feature_Enabled(PID_Feature_MEASURED_D_T), "PID_Feature_MEASURED_D_T not enabled");
+    D_T_Mode = __D_T_Mode;
+    Pre_Timestamp_Valid = false;
+}
+
+/**
+ * @brief 设置当前值的采样时刻, 与Set_Now一起调用
+ * @param __Now_Timestamp_Us 当前值的采样时刻, 微秒时钟
+ */
+template <Enum_PID_Feature... Features>
+void Class_PID_T<Features...>::Set_Now_Timestamp_Us(uint32_t __Now_Timestamp_Us) {
+    static_assert(Feature_Enabled(PID_Feature_MEASURED_D_T), "PID_Feature_MEASURED_D_T not enabled");
+    Now_Timestamp_Us = __Now_Timestamp_Us;
+}
+
+/**
+ * @brief 设置反算抗饱和增益, 输出被限幅时积分按限幅量回拉
+ * @param __K_Back_Calculation 反算增益, 1/s, 一般取K_I/K_P附近, 0为不启用
+ */
+template <Enum_PID_Feature... Features>
+void Class_PID_T<Features...>::Set_K_Back_Calculation(float __K_Back_Calculation) {
+    static_assert(Feature_Enabled(PID_Feature_ANTI_WINDUP), "PID_Feature_ANTI_WINDUP not enabled");
+    K_Back_Calculation = __K_Back_Calculation;
+    if (Bank_Bound()) Bank_Field(PID_Bank_Field_K_Back_Calculation) = K_Back_Calculation;
+}
+
+/**
+ * @brief 设置条件积分, 输出被限幅且误差使输出更加饱和时不积分
+ * @param __Conditional_Integration 条件积分
+ */
+template <Enum_PID_Feature... Features>
+void Class_PID_T<Features...>::Set_Conditional_Integration(Enum_PID_Conditional_Integration __Conditional_Integration) {
+    static_assert(Feature_Enabled(PID_Feature_ANTI_WINDUP), "PID_Feature_ANTI_WINDUP not enabled");
+    Conditional_Integration = __Conditional_Integration;
+    if (Bank_Bound()) Bank_Field(PID_Bank_Field_Conditional_Integration) = (Conditional_Integration == PID_Conditional_Integration_ENABLE) ? 1.0f : 0.0f;
+}
+
+/**
+ * @brief 无扰切换, 下一次计算时积分项取值使输出从__Bumpless_Out开始, 微分与前馈重新开始, 一般在本环刚接入控制时调用
+ * @param __Bumpless_Out 起始输出, 一般为切换前执行器的指令
+ * @note K_I为0时积分项无法承接, 只重置微分与前馈
+ */
+template <Enum_PID_Feature... Features>
+void Class_PID_T<Features...>::Set_Bumpless_Out(float __Bumpless_Out) {
+    static_assert(Feature_Enabled(PID_Feature_BUMPLESS), "PID_Feature_BUMPLESS not enabled");
+    Bumpless_Pending = true;
+    Bumpless_Out = __Bumpless_Out;
+    if (Bank_Bound())
+    {
+        Bank_Field(PID_Bank_Field_Bumpless) = 1.0f;
+        Bank_Field(PID_Bank_Field_Bumpless_Out) = Bumpless_Out;
+    }
+}
+
+/**
+ * @brief 绑定到PID组的一个槽位, 当前的参数与状态复制到槽位中, 此后各接口读写槽位
+ *
+ * @param __Bank_Data PID组数据
+ * @param __Bank_Stride 组内控制器个数
+ * @param __Bank_Slot 槽位
+ */
+template <Enum_PID_Feature... Features>
+void Class_PID_T<Features...>::Bind_Bank_Data(float *__Bank_Data, uint32_t __Bank_Stride, uint32_t __Bank_Slot)
+{
+    Bank_Data = __Bank_Data;
+    Bank_Stride = __Bank_Stride;
+    Bank_Slot = __Bank_Slot;
+
+    Bank_Store();
+}
+
+/**
+ * @brief 参数与状态写入所在槽位
+ *
+ */
+template <Enum_PID_Feature... Features>
+void Class_PID_T<Features...>::Bank_Store()
+{
+    Bank_Field(PID_Bank_Field_K_P) = K_P;
+    Bank_Field(PID_Bank_Field_K_I) = K_I;
+    Bank_Field(PID_Bank_Field_K_D) = K_D;
+    Bank_Field(PID_Bank_Field_K_F) = K_F;
+    Bank_Field(PID_Bank_Field_I_Out_Max) = I_Out_Max;
+    Bank_Field(PID_Bank_Field_D_Out_Max) = D_Out_Max;
+    Bank_Field(PID_Bank_Field_Out_Max) = Out_Max;
+    Bank_Field(PID_Bank_Field_D_T) = D_T;
+    Bank_Field(PID_Bank_Field_Dead_Zone) = Dead_Zone;
+    Bank_Field(PID_Bank_Field_I_Variable_Speed_A) = I_Variable_Speed_A;
+    Bank_Field(PID_Bank_Field_I_Variable_Speed_B) = I_Variable_Speed_B;
+    Bank_Field(PID_Bank_Field_I_Separate_Threshold) = I_Separate_Threshold;
+    Bank_Field(PID_Bank_Field_D_First) = (D_First == PID_D_First_ENABLE) ? 1.0f : 0.0f;
+    Bank_Field(PID_Bank_Field_Direction) = (Direction == PID_REVERSE) ? -1.0f : 1.0f;
+    Bank_Field(PID_Bank_Field_D_Filter_Alpha) = D_Filter_Alpha;
+    Bank_Field(PID_Bank_Field_Zero_Position_Integral_Bleeding) = (Zero_Position_Integral_Bleeding == PID_ZPIB_ENABLE) ? 1.0f : 0.0f;
+    Bank_Field(PID_Bank_Field_K_Back_Calculation) = K_Back_Calculation;
+    Bank_Field(PID_Bank_Field_Conditional_Integration) = (Conditional_Integration == PID_Conditional_Integration_ENABLE) ? 1.0f : 0.0f;
+    Bank_Field(PID_Bank_Field_Target) = Target;
+    Bank_Field(PID_Bank_Field_Now) = Now;
+    Bank_Field(PID_Bank_Field_Pre_Target) = Pre_Target;
+    Bank_Field(PID_Bank_Field_Pre_Out) = Pre_Out;
+    Bank_Field(PID_Bank_Field_Pre_Error) = Pre_Error;
+    Bank_Field(PID_Bank_Field_Integral_Error) = Integral_Error;
+    Bank_Field(PID_Bank_Field_Filtered_D_Out) = filtered_d_out;
+    Bank_Field(PID_Bank_Field_Bumpless) = Bumpless_Pending ? 1.0f : 0.0f;
+    Bank_Field(PID_Bank_Field_Bumpless_Out) = Bumpless_Out;
+    Bank_Field(PID_Bank_Field_Out) = Out;
+    Bank_Field(PID_Bank_Field_P_Out) = p_out;
+    Bank_Field(PID_Bank_Field_I_Out) = i_out;
+    Bank_Field(PID_Bank_Field_D_Out) = d_out;
+    Bank_Field(PID_Bank_Field_F_Out) = f_out;
+    Bank_Field(PID_Bank_Field_Error) = error;
+}
+
+/**
+ * @brief PID调整值
+ *
+ * @return float 输出值
+ */
+template <Enum_PID_Feature... Features>
+void Class_PID_T<Features...>::TIM_Adjust_PeriodElapsedCallback()
+{
+    // 以下Feature_Enabled均为编译期常量, 未启用功能的分支被整段去掉
+
+    // 绑定到PID组时只计算所在槽位, 批量计算由Class_PID_Bank完成
+    if (Bank_Bound())
+    {
+        PID_Bank_Calculate(Bank_Data, Bank_Stride, Bank_Slot);
+        Now_D_T = D_T;
+        return;
+    }
+
+    // 添加除零保护
+    if (D_T <= 0.0f) {
+        // 记录错误或使用默认值
+        D_T = 0.001f; // 避免除零
+    }
+
+    //控制周期, 实测周期模式下为相邻两次采样的时间差, 反馈未更新时为0, 不积分, 微分保持
+    float d_t = D_T;
+    bool new_sample = true;
+    if (Feature_Enabled(PID_Feature_MEASURED_D_T) && D_T_Mode == PID_D_T_Mode_MEASURED)
+    {
+        if (Pre_Timestamp_Valid)
+        {
+            uint32_t delta_us = Now_Timestamp_Us - Pre_Timestamp_Us;
+            if (delta_us == 0)
+            {
+                d_t = 0.0f;
+                new_sample = false;
+            }
+            else
+            {
+                d_t = (float) delta_us / 1000000.0f;
+                Math_Constrain(&d_t, PID_D_T_MIN_RATIO * D_T, PID_D_T_MAX_RATIO * D_T);
+            }
+        }
+        Pre_Timestamp_Us = Now_Timestamp_Us;
+        Pre_Timestamp_Valid = true;
+    }
+    Now_D_T = d_t;
+
+    // P输出
+    p_out = 0.0f;
+    // I输出
+    i_out = 0.0f;
+    // F输出
+    f_out = 0.0f;
+    //误差
+    error = 0.0f;
+    //绝对值误差
+    float abs_error;
+    //线性变速积分
+    float speed_ratio;
+
+    error = Target - Now;
+    //根据方向调整误差符号
+    if (Feature_Enabled(PID_Feature_DIRECTION) && Direction == PID_REVERSE)
+    {
+        error = -error;
+    }
+    abs_error = Math_Abs(error);
+
+    //判断死区
+    if (Feature_Enabled(PID_Feature_DEAD_ZONE) && abs_error < Dead_Zone)
+    {
+        error = 0.0f;
+        abs_error = 0.0f;
+    }
+
+    //无扰切换, 微分与前馈从本周期开始
+    bool bumpless = Feature_Enabled(PID_Feature_BUMPLESS) && Bumpless_Pending && new_sample;
+    if (bumpless)
+    {
+        Pre_Error = error;
+        Pre_Out = Out;
+        Pre_Target = Target;
+        filtered_d_out = 0.0f;
+    }
+
+    //计算p项
+
+    p_out = K_P * error;
+
+    //计算i项
+
+    if (!Feature_Enabled(PID_Feature_VARIABLE_SPEED_I) || (I_Variable_Speed_A == 0.0f && I_Variable_Speed_B == 0.0f))
+    {
+        //非变速积分
+        speed_ratio = 1.0f;
+    }
+    else
+    {
+        //变速积分
+        if (abs_error <= I_Variable_Speed_A)
+        {
+            //误差小于A，正常积分
+            speed_ratio = 1.0f;
+        }
+        else if (abs_error < I_Variable_Speed_A + I_Variable_Speed_B)
+        {
+            //误差在A到A+B之间，线性递减
+            speed_ratio = 1.0f - (abs_error - I_Variable_Speed_A) / I_Variable_Speed_B;        
+        }
+        else
+        {
+            //误差大于A+B，停止积分
+            speed_ratio = 0.0f;
+        }
+    }
+
+    //本周期是否正常积分, 抗饱和只作用于正常积分
+    float pre_integral_error = Integral_Error;
+    bool integrating = false;
+
+    //零位积分泄放
+    bool ZPIB_Status = Feature_Enabled(PID_Feature_ZPIB) && (abs(Target) < Dead_Zone && abs_error < Dead_Zone && Zero_Position_Integral_Bleeding == PID_ZPIB_ENABLE);
+
+    if(!ZPIB_Status){
+        //积分分离
+        if (!Feature_Enabled(PID_Feature_I_SEPARATE) || I_Separate_Threshold == 0.0f)
+        {
+            //没有积分分离
+            Integral_Error += speed_ratio * d_t * error;
+            integrating = true;
+
+            //如果开启积分限幅，那么在对积分项输出限幅的同时对积分误差也进行限幅，防止积分误差一直增大
+            if(Feature_Enabled(PID_Feature_I_LIMIT) && K_I > 0.0f && I_Out_Max != 0.0f){
+                float integral_error_Max = I_Out_Max / K_I;
+                Math_Constrain(&Integral_Error, -integral_error_Max, integral_error_Max);
+            }
+
+            i_out = K_I * Integral_Error;
+            //积分限幅
+            if (Feature_Enabled(PID_Feature_I_LIMIT) && I_Out_Max != 0.0f)
+            {
+                Math_Constrain(&i_out, -I_Out_Max, I_Out_Max);
+            }
+        }
+        else
+        {
+            //积分分离使能
+            if (abs_error < I_Separate_Threshold)
+            {
+                Integral_Error += speed_ratio * d_t * error;
+                integrating = true;
+
+                //如果开启积分限幅，那么在对积分项输出限幅的同时对积分误差也进行限幅，防止积分误差一直增大
+                if(Feature_Enabled(PID_Feature_I_LIMIT) && K_I > 0.0f && I_Out_Max != 0.0f){
+                    float integral_error_Max = I_Out_Max / K_I;
+                    Math_Constrain(&Integral_Error, -integral_error_Max, integral_error_Max);
+                }
+
+                i_out = K_I * Integral_Error;
+                //积分限幅
+                if (Feature_Enabled(PID_Feature_I_LIMIT) && I_Out_Max != 0.0f)
+                {
+                    Math_Constrain(&i_out, -I_Out_Max, I_Out_Max);
+                }
+            }
+            else
+            {
+                Integral_Error = 0.0f;
+                i_out = 0.0f;
+            }
+        }
+    }
+    else//为了防止静摩擦力的存在，当电机停止时，残留的积分项输出的力不足以克服积分项让电机旋转，但是残留积分却消耗功率,
+    // 但是这个功能也不能盲目开，比如Pitch轴电机为了克服重力，就算速度为0，也要保持一个小的积分项输出，否则会导致电机旋转不稳定
+    {
+        // 在死区内，不累积新的积分
+        // 缓慢释放已有积分
+        if (fabsf(Integral_Error) > 0.0001f && new_sample)
+        {
+            // 每周期衰减5%
+            Integral_Error *= 0.95f;
+        }
+    }
+
+    //计算d项, 反馈未更新时保持上一次的值
+
+    if (Feature_Enabled(PID_Feature_D) && new_sample)
+    {
+        float d_raw = 0.0f;
+        if (!Feature_Enabled(PID_Feature_D_FIRST) || D_First == PID_D_First_DISABLE) {
+            // 没有微分先行
+            d_raw = K_D * (error - Pre_Error) / d_t;
+        } else {
+            // 微分先行使能
+            d_raw = K_D * (Out - Pre_Out) / d_t;
+        }
+
+        // 新增：D项滤波
+        if (Feature_Enabled(PID_Feature_D_FILTER) && D_Filter_Alpha > 0.0f) {
+            filtered_d_out = D_Filter_Alpha * d_raw + (1.0f - D_Filter_Alpha) * filtered_d_out;
+            d_out = filtered_d_out;
+        } else {
+            d_out = d_raw;
+        }
+
+        // 新增：D项限幅
+        if (Feature_Enabled(PID_Feature_D_LIMIT) && D_Out_Max != 0.0f)
+        {
+            Math_Constrain(&d_out, -D_Out_Max, D_Out_Max);
+        }
+    }
+
+
+    //计算前馈, 目标值每个控制周期更新一次, 按名义周期D_T计算
+
+    if (Feature_Enabled(PID_Feature_F))
+    {
+        f_out = K_F * (Target - Pre_Target) / D_T;
+    }
+
+    //无扰切换, 积分项取起始输出减去比例项, 积分无法承接时只重置微分与前馈
+
+    if (bumpless)
+    {
+        if (K_I > 0.0f)
+        {
+            i_out = Bumpless_Out - p_out;
+            if (Feature_Enabled(PID_Feature_I_LIMIT) && I_Out_Max != 0.0f)
+            {
+                Math_Constrain(&i_out, -I_Out_Max, I_Out_Max);
+            }
+            Integral_Error = i_out / K_I;
+        }
+        Bumpless_Pending = false;
+        integrating = false;
+    }
+
+    //计算总共的输出
+
+    float out_raw = p_out + i_out + d_out + f_out;
+    Out = out_raw;
+    //输出限幅
+    if (Feature_Enabled(PID_Feature_OUT_LIMIT) && Out_Max != 0.0f)
+    {
+        Math_Constrain(&Out, -Out_Max, Out_Max);
+    }
+
+    //抗饱和, 输出被限幅时生效
+    float saturation = Out - out_raw;
+    if (Feature_Enabled(PID_Feature_ANTI_WINDUP) && integrating && new_sample && saturation != 0.0f)
+    {
+        //条件积分, 误差使输出更加饱和时撤销本周期的累加
+        if (Conditional_Integration == PID_Conditional_Integration_ENABLE && error * saturation < 0.0f)
+        {
+            Integral_Error = pre_integral_error;
+        }
+        //反算, 按限幅量回拉积分, 饱和解除所需的时间约为1/K_Back_Calculation
+        if (K_Back_Calculation > 0.0f && K_I > 0.0f)
+        {
+            Integral_Error += K_Back_Calculation * saturation * d_t / K_I;
+        }
+    }
+
+    //善后工作
+    Pre_Now = Now;
+    Pre_Target = Target;
+    //微分的差分跨越的是两次采样之间的时间
+    if (new_sample)
+    {
+        Pre_Out = Out;
+        Pre_Error = error;
+    }
+}
+
+/**
+ * @brief 除PID组外全部功能启用的PID, 与改为模板之前的实现相同, 其代码在alg_pid.cpp中实例化一次
+ *
+ */
+typedef Class_PID_T<PID_Feature_DEFAULT> Class_PID;
+
+extern template class Class_PID_T<PID_Feature_DEFAULT>;
+
 #endif
 
 /*
@@ -223,6 +1500,58 @@ XXX_PID.Init(0,0,0,0,0,0,0.001);//P, I, D, F, I_Out_Max, Out_Max 均为0，D_T 
 
 }
 
+按实测周期计算积分与微分:
+XXX_PID.Set_D_T_Mode(PID_D_T_Mode_MEASURED);//D_T仍作为名义周期, 用于限幅和前馈
+
+假设这是控制周期函数{
+
+		XXX_PID.Set_Target(Target_XXX);
+		XXX_PID.Set_Now(Now_XXX);
+		XXX_PID.Set_Now_Timestamp_Us(Now_XXX_Timestamp_Us);//反馈到达时的微秒时钟, 如CAN_Get_Rx_Timestamp_Us()
+		XXX_PID.TIM_Adjust_PeriodElapsedCallback();//反馈没有更新时不积分, 微分保持上一次的值
+
+}
+
+按组批量计算:
+Class_PID_Bank<4> XXX_PID_Bank;
+Class_PID_T<PID_Feature_ALL> XXX_PID[4];//Class_PID不含PID_Feature_BANK, 需绑定的控制器另行实例化
+
+XXX_PID_Bank.Init();
+for (int i = 0; i < 4; i++)
+{
+		XXX_PID[i].Init(0,0,0,0,0,0,0.001);
+		XXX_PID[i].Bind_Bank(&XXX_PID_Bank, i);//此后XXX_PID[i]的接口读写组内第i个槽位
+}
+
+假设这是一个1ms执行一次的函数{
+
+		for (int i = 0; i < 4; i++)
+		{
+				XXX_PID[i].Set_Target(Target_XXX[i]);
+				XXX_PID[i].Set_Now(Now_XXX[i]);
+		}
+		XXX_PID_Bank.TIM_Adjust_PeriodElapsedCallback();//一次算完4个, 不再逐个调用XXX_PID[i].TIM_Adjust_PeriodElapsedCallback()
+		for (int i = 0; i < 4; i++)
+		{
+				Output[i] = XXX_PID[i].Get_Out();
+		}
+
+}
+
+输出饱和时的抗饱和, 依赖Out_Max:
+XXX_PID.Set_Conditional_Integration(PID_Conditional_Integration_ENABLE);//输出被限幅且误差使其更饱和时不积分
+XXX_PID.Set_K_Back_Calculation(K_I / K_P);//按限幅量回拉积分, 两者可同时使用
+
+控制方式切换时无扰接入:
+XXX_PID.Set_Bumpless_Out(Current_Command);//下一次计算的输出从切换前的指令开始, 不再清零积分
+
+只启用所需功能:
+Class_PID_T<PID_Feature_I_LIMIT, PID_Feature_OUT_LIMIT> XXX_PID;//只有P/I与限幅, 其余功能的计算在编译期去掉
+
+XXX_PID.Init(1.0f, 10.0f, 0.0f, 0.0f, 5.0f, 0.0f, 10.0f, 0.001f);//未启用功能的参数不起作用
+XXX_PID.Set_K_P(2.0f);//可以
+XXX_PID.Set_K_D(0.1f);//编译报错, 未启用PID_Feature_D
+
 */
 
 
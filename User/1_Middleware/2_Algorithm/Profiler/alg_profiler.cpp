@@ -0,0 +1,213 @@
+/**
+ * @file alg_profiler.cpp
+ * @author WFZ
+ * @brief 分阶段耗时统计实现
+ * @version 0.0
+ * @date 2026-1-22
+ *
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "alg_profiler.h"
+
+/* Private macros ------------------------------------------------------------*/
+
+/* Private types -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+
+/* Private function declarations ---------------------------------------------*/
+
+/* Function prototypes -------------------------------------------------------*/
+
+/**
+ * @brief 初始化
+ *
+ * @param __Budget_Cycle 单次耗时预算, 周期数, 默认1ms
+ */
+void Class_Profiler::Init(uint32_t __Budget_Cycle)
+{
+    Budget_Cycle = __Budget_Cycle;
+    Stage_Num = 0;
+}
+
+/**
+ * @brief 注册一个阶段
+ *
+ * @param __Name 阶段名称
+ * @return uint8_t 阶段编号, 按注册顺序从0递增; 超出上限时返回最后一个阶段的编号
+ */
+uint8_t Class_Profiler::Add_Stage(const char *__Name)
+{
+    if (Stage_Num >= PROFILER_STAGE_NUM_MAX)
+    {
+        return (PROFILER_STAGE_NUM_MAX - 1);
+    }
+
+    memset(&Stage[Stage_Num], 0, sizeof(Struct_Profiler_Stage));
+    Stage[Stage_Num].Name = __Name;
+    Stage[Stage_Num].Min_Cycle = UINT32_MAX;
+
+    return (Stage_Num++);
+}
+
+/**
+ * @brief 清空所有阶段的统计, 保留注册信息与正在进行的计时, 可在Begin与End之间调用
+ *
+ */
+void Class_Profiler::Reset()
+{
+    for (uint8_t i = 0; i < Stage_Num; i++)
+    {
+        Stage[i].Now_Cycle = 0;
+        Stage[i].Min_Cycle = UINT32_MAX;
+        Stage[i].Max_Cycle = 0;
+        Stage[i].Sum_Cycle = 0;
+        Stage[i].Count = 0;
+        Stage[i].Over_Budget_Count = 0;
+        memset(Stage[i].Histogram, 0, sizeof(Stage[i].Histogram));
+    }
+}
+
+/**
+ * @brief 获取最近一次耗时, us
+ *
+ * @param __Stage 阶段编号
+ * @return float 耗时, us
+ */
+float Class_Profiler::Get_Now_Us(uint8_t __Stage)
+{
+    return (DWT_Cycle_To_Us(Stage[__Stage].Now_Cycle));
+}
+
+/**
+ * @brief 获取最小耗时, us
+ *
+ * @param __Stage 阶段编号
+ * @return float 耗时, us, 尚无记录时为0
+ */
+float Class_Profiler::Get_Min_Us(uint8_t __Stage)
+{
+    if (Stage[__Stage].Count == 0)
+    {
+        return (0.0f);
+    }
+    return (DWT_Cycle_To_Us(Stage[__Stage].Min_Cycle));
+}
+
+/**
+ * @brief 获取平均耗时, us
+ *
+ * @param __Stage 阶段编号
+ * @return float 耗时, us, 尚无记录时为0
+ */
+float Class_Profiler::Get_Average_Us(uint8_t __Stage)
+{
+    if (Stage[__Stage].Count == 0)
+    {
+        return (0.0f);
+    }
+    return (DWT_Cycle_To_Us((uint32_t) (Stage[__Stage].Sum_Cycle / Stage[__Stage].Count)));
+}
+
+/**
+ * @brief 获取最大耗时, us
+ *
+ * @param __Stage 阶段编号
+ * @return float 耗时, us
+ */
+float Class_Profiler::Get_Max_Us(uint8_t __Stage)
+{
+    return (DWT_Cycle_To_Us(Stage[__Stage].Max_Cycle));
+}
+
+/**
+ * @brief 导出各阶段概要, 每个阶段依次为平均耗时us, 最大耗时us
+ *
+ * @param Buffer 输出缓冲区
+ * @param Buffer_Length 缓冲区长度
+ * @return uint8_t 写入的数据个数
+ */
+uint8_t Class_Profiler::Export_Summary(float *Buffer, uint8_t Buffer_Length)
+{
+    uint8_t length = 0;
+
+    for (uint8_t i = 0; i < Stage_Num && length + 2 <= Buffer_Length; i++)
+    {
+        Buffer[length++] = Get_Average_Us(i);
+        Buffer[length++] = Get_Max_Us(i);
+    }
+
+    return (length);
+}
+
+/**
+ * @brief 导出单个阶段的直方图, 依次为各格计数, 最小耗时us, 平均耗时us, 最大耗时us, 超预算次数
+ *
+ * @param __Stage 阶段编号
+ * @param Buffer 输出缓冲区
+ * @param Buffer_Length 缓冲区长度
+ * @return uint8_t 写入的数据个数, 编号无效时为0
+ */
+uint8_t Class_Profiler::Export_Histogram(uint8_t __Stage, float *Buffer, uint8_t Buffer_Length)
+{
+    uint8_t length = 0;
+
+    if (__Stage >= Stage_Num)
+    {
+        return (0);
+    }
+
+    for (uint8_t i = 0; i < PROFILER_HISTOGRAM_BIN_NUM && length < Buffer_Length; i++)
+    {
+        Buffer[length++] = (float) Stage[__Stage].Histogram[i];
+    }
+    if (length + 4 <= Buffer_Length)
+    {
+        Buffer[length++] = Get_Min_Us(__Stage);
+        Buffer[length++] = Get_Average_Us(__Stage);
+        Buffer[length++] = Get_Max_Us(__Stage);
+        Buffer[length++] = (float) Stage[__Stage].Over_Budget_Count;
+    }
+
+    return (length);
+}
+
+/**
+ * @brief 记录一次耗时
+ *
+ * @param __Stage 阶段统计
+ * @param Cycle 耗时, 周期数
+ */
+void Class_Profiler::Record(Struct_Profiler_Stage *__Stage, uint32_t Cycle)
+{
+    __Stage->Now_Cycle = Cycle;
+    __Stage->Sum_Cycle += Cycle;
+    __Stage->Count++;
+
+    if (Cycle < __Stage->Min_Cycle)
+    {
+        __Stage->Min_Cycle = Cycle;
+    }
+    if (Cycle > __Stage->Max_Cycle)
+    {
+        __Stage->Max_Cycle = Cycle;
+    }
+    if (Cycle > Budget_Cycle)
+    {
+        __Stage->Over_Budget_Count++;
+    }
+
+    // 按2的幂分格, 最多移位PROFILER_HISTOGRAM_BIN_NUM次
+    uint8_t bin = 0;
+    uint32_t tmp_cycle = Cycle >> PROFILER_HISTOGRAM_SHIFT;
+    while (tmp_cycle != 0 && bin < PROFILER_HISTOGRAM_BIN_NUM - 1)
+    {
+        tmp_cycle >>= 1;
+        bin++;
+    }
+    __Stage->Histogram[bin]++;
+}
+
+/*****************************************************************************/
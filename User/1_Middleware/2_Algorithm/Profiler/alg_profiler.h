@@ -0,0 +1,186 @@
+/**
+ * @file alg_profiler.h
+ * @author WFZ
+ * @brief 分阶段耗时统计, 基于DWT周期计数, 记录每个阶段的最小/平均/最大耗时与耗时分布直方图
+ * @version 0.0
+ * @date 2026-1-22
+ *
+ */
+
+#ifndef ALG_PROFILER_H
+#define ALG_PROFILER_H
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "drv_dwt.h"
+#include <string.h>
+
+/* Exported macros -----------------------------------------------------------*/
+
+// 阶段数量上限
+#define PROFILER_STAGE_NUM_MAX 10
+// 直方图格数
+#define PROFILER_HISTOGRAM_BIN_NUM 16
+// 直方图第0格的上界为 2^PROFILER_HISTOGRAM_SHIFT 个周期, 之后每格上界翻倍
+#define PROFILER_HISTOGRAM_SHIFT 6
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+ * @brief 单个阶段的耗时统计
+ *
+ * 直方图按2的幂分格, 第0格为 [0, 64) 周期, 第k格为 [64·2^(k-1), 64·2^k) 周期,
+ * 最后一格收纳所有更长的耗时, 168MHz下约为6.2ms以上
+ *
+ */
+struct Struct_Profiler_Stage
+{
+    // 阶段名称, 便于调试器中查看
+    const char *Name;
+    // 本次开始时的周期计数
+    uint32_t Start_Cycle;
+    // 最近一次耗时
+    uint32_t Now_Cycle;
+    // 最小耗时
+    uint32_t Min_Cycle;
+    // 最大耗时
+    uint32_t Max_Cycle;
+    // 累计耗时
+    uint64_t Sum_Cycle;
+    // 统计次数
+    uint32_t Count;
+    // 超出预算的次数
+    uint32_t Over_Budget_Count;
+    // 耗时分布直方图
+    uint32_t Histogram[PROFILER_HISTOGRAM_BIN_NUM];
+};
+
+/**
+ * @brief 分阶段耗时统计
+ *
+ * 使用方法 ：
+ *  1) DWT_Init(), Init(预算周期数)
+ *  2) 按顺序Add_Stage注册各阶段, 返回值即阶段编号
+ *  3) 在被测代码段前后调用Begin(编号)/End(编号)
+ *  4) Export_Summary/Export_Histogram导出给串口绘图
+ *
+ */
+class Class_Profiler
+{
+public:
+    void Init(uint32_t __Budget_Cycle = DWT_CPU_FREQUENCY / 1000U);
+
+    uint8_t Add_Stage(const char *__Name);
+
+    void Reset();
+
+    inline uint8_t Get_Stage_Num();
+
+    inline uint32_t Get_Budget_Cycle();
+
+    inline const Struct_Profiler_Stage *Get_Stage(uint8_t __Stage);
+
+    float Get_Now_Us(uint8_t __Stage);
+
+    float Get_Min_Us(uint8_t __Stage);
+
+    float Get_Average_Us(uint8_t __Stage);
+
+    float Get_Max_Us(uint8_t __Stage);
+
+    inline void Begin(uint8_t __Stage);
+
+    inline void End(uint8_t __Stage);
+
+    uint8_t Export_Summary(float *Buffer, uint8_t Buffer_Length);
+
+    uint8_t Export_Histogram(uint8_t __Stage, float *Buffer, uint8_t Buffer_Length);
+
+protected:
+    // 初始化相关常量
+
+    // 单次耗时预算, 周期数
+    uint32_t Budget_Cycle;
+
+    // 常量
+
+    // 内部变量
+
+    // 已注册的阶段数量
+    uint8_t Stage_Num = 0;
+    // 各阶段统计
+    Struct_Profiler_Stage Stage[PROFILER_STAGE_NUM_MAX];
+
+    // 读变量
+
+    // 写变量
+
+    // 读写变量
+
+    // 内部函数
+
+    void Record(Struct_Profiler_Stage *__Stage, uint32_t Cycle);
+};
+
+/* Exported variables --------------------------------------------------------*/
+
+/* Exported function declarations --------------------------------------------*/
+
+/**
+ * @brief 获取已注册的阶段数量
+ *
+ * @return uint8_t 阶段数量
+ */
+inline uint8_t Class_Profiler::Get_Stage_Num()
+{
+    return (Stage_Num);
+}
+
+/**
+ * @brief 获取单次耗时预算
+ *
+ * @return uint32_t 预算周期数
+ */
+inline uint32_t Class_Profiler::Get_Budget_Cycle()
+{
+    return (Budget_Cycle);
+}
+
+/**
+ * @brief 获取阶段统计
+ *
+ * @param __Stage 阶段编号
+ * @return const Struct_Profiler_Stage* 阶段统计, 编号无效时返回nullptr
+ */
+inline const Struct_Profiler_Stage *Class_Profiler::Get_Stage(uint8_t __Stage)
+{
+    if (__Stage >= Stage_Num)
+    {
+        return (nullptr);
+    }
+    return (&Stage[__Stage]);
+}
+
+/**
+ * @brief 阶段开始计时
+ *
+ * @param __Stage 阶段编号
+ */
+inline void Class_Profiler::Begin(uint8_t __Stage)
+{
+    Stage[__Stage].Start_Cycle = DWT_Get_Cycle();
+}
+
+/**
+ * @brief 阶段结束计时并记录
+ *
+ * @param __Stage 阶段编号
+ */
+inline void Class_Profiler::End(uint8_t __Stage)
+{
+    Record(&Stage[__Stage], DWT_Get_Cycle() - Stage[__Stage].Start_Cycle);
+}
+
+#endif
+
+/*****************************************************************************/
@@ -0,0 +1,269 @@
+/**
+ * @file alg_scheduler.cpp
+ * @author WFZ
+ * @brief 表驱动的周期任务调度实现
+ * @version 0.0
+ * @date 2026-1-27
+ *
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "alg_scheduler.h"
+
+/* Private macros ------------------------------------------------------------*/
+
+/* Private types -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+
+/* Private function declarations ---------------------------------------------*/
+
+static uint16_t Scheduler_GCD(uint16_t A, uint16_t B);
+
+/* Function prototypes -------------------------------------------------------*/
+
+/**
+ * @brief 初始化, 在Profiler中注册整个节拍的阶段"total"
+ *
+ * @param __Profiler 统计各任务耗时的Profiler, 需已Init, 其预算即为节拍预算
+ */
+void Class_Scheduler::Init(Class_Profiler *__Profiler)
+{
+    Profiler = __Profiler;
+    Total_Stage = Profiler->Add_Stage("total");
+    Task_Num = 0;
+    Last_Tick_Overrun = false;
+    Tick_Count = 0;
+    Tick_Overrun_Count = 0;
+    Now_Release_Latency_Cycle = 0;
+    Max_Release_Latency_Cycle = 0;
+}
+
+/**
+ * @brief 注册一个任务, 需在开启定时中断之前调用
+ *
+ * @param __Name 任务名称
+ * @param __Function 任务函数
+ * @param __Period 周期, 节拍数, 为0时按1处理
+ * @param __Priority 优先级
+ * @param __Deadline_Us 截止时间, 从节拍开始到任务运行完的时间, us
+ * @param __Phase 相位, 节拍数, 默认或不小于周期时自动分配
+ * @return uint8_t 任务编号, 按注册顺序从0递增; 超出上限时返回SCHEDULER_TASK_NUM_MAX, 任务不会运行
+ */
+uint8_t Class_Scheduler::Add_Task(const char *__Name, Scheduler_Task_Function __Function, uint16_t __Period, Enum_Scheduler_Priority __Priority, float __Deadline_Us, uint16_t __Phase)
+{
+    if (Task_Num >= SCHEDULER_TASK_NUM_MAX)
+    {
+        return (SCHEDULER_TASK_NUM_MAX);
+    }
+
+    if (__Period == 0)
+    {
+        __Period = 1;
+    }
+    if (__Phase >= __Period)
+    {
+        __Phase = Assign_Phase(__Period);
+    }
+
+    Struct_Scheduler_Task *task = &Task[Task_Num];
+    memset(task, 0, sizeof(Struct_Scheduler_Task));
+    task->Name = __Name;
+    task->Function = __Function;
+    task->Period = __Period;
+    task->Phase = __Phase;
+    task->Priority = __Priority;
+    task->Deadline_Cycle = DWT_Us_To_Cycle(__Deadline_Us);
+    task->Profiler_Stage = Profiler->Add_Stage(__Name);
+    // 第0个节拍起, 节拍号模周期等于相位时运行
+    task->Countdown = __Phase;
+
+    // 插入运行顺序, 排在同优先级任务之后
+    uint8_t index = Task_Num;
+    while (index > 0 && Task[Run_Order[index - 1]].Priority > __Priority)
+    {
+        Run_Order[index] = Run_Order[index - 1];
+        index--;
+    }
+    Run_Order[index] = Task_Num;
+
+    return (Task_Num++);
+}
+
+/**
+ * @brief 清空超限、放弃与响应时间统计, 保留注册信息与相位, 耗时统计由Profiler.Reset清空
+ *
+ */
+void Class_Scheduler::Reset()
+{
+    for (uint8_t i = 0; i < Task_Num; i++)
+    {
+        Task[i].Run_Count = 0;
+        Task[i].Overrun_Count = 0;
+        Task[i].Shed_Count = 0;
+        Task[i].Now_Response_Cycle = 0;
+        Task[i].Max_Response_Cycle = 0;
+    }
+    Tick_Overrun_Count = 0;
+    Max_Release_Latency_Cycle = 0;
+}
+
+/**
+ * @brief 导出调度概要, 依次为超出预算的节拍数, 节拍最大耗时us, 之后每个任务依次为超限次数, 放弃次数
+ *
+ * @param Buffer 输出缓冲区
+ * @param Buffer_Length 缓冲区长度
+ * @return uint8_t 写入的数据个数
+ */
+uint8_t Class_Scheduler::Export_Summary(float *Buffer, uint8_t Buffer_Length)
+{
+    uint8_t length = 0;
+
+    if (Buffer_Length < 2)
+    {
+        return (0);
+    }
+
+    Buffer[length++] = (float) Tick_Overrun_Count;
+    Buffer[length++] = Profiler->Get_Max_Us(Total_Stage);
+
+    for (uint8_t i = 0; i < Task_Num && length + 2 <= Buffer_Length; i++)
+    {
+        Buffer[length++] = (float) Task[i].Overrun_Count;
+        Buffer[length++] = (float) Task[i].Shed_Count;
+    }
+
+    return (length);
+}
+
+/**
+ * @brief 节拍回调, 按优先级运行本节拍到期的任务, 节拍从调用时刻开始计时
+ *
+ */
+void Class_Scheduler::Tick()
+{
+    Tick(DWT_Get_Cycle());
+}
+
+/**
+ * @brief 节拍回调, 在定时中断挂起的控制线程中调用, 响应时间与截止时间从定时中断的时刻开始计时
+ *
+ * @param __Release_Cycle 定时中断记录的DWT周期数
+ */
+void Class_Scheduler::Tick(uint32_t __Release_Cycle)
+{
+    uint32_t budget_cycle = Profiler->Get_Budget_Cycle();
+    uint32_t tick_start_cycle = __Release_Cycle;
+
+    // 从定时中断到控制线程开始运行的延迟
+    Now_Release_Latency_Cycle = DWT_Get_Cycle() - __Release_Cycle;
+    if (Now_Release_Latency_Cycle > Max_Release_Latency_Cycle)
+    {
+        Max_Release_Latency_Cycle = Now_Release_Latency_Cycle;
+    }
+
+    Profiler->Begin(Total_Stage);
+
+    for (uint8_t i = 0; i < Task_Num; i++)
+    {
+        Struct_Scheduler_Task *task = &Task[Run_Order[i]];
+
+        if (task->Countdown != 0)
+        {
+            task->Countdown--;
+            continue;
+        }
+        task->Countdown = task->Period - 1;
+
+        // 过载时放弃低优先级任务, 以上一次的耗时预估本次耗时
+        if (task->Priority >= Scheduler_Priority_LOW)
+        {
+            uint32_t elapsed_cycle = DWT_Get_Cycle() - tick_start_cycle;
+            uint32_t expect_cycle = Profiler->Get_Stage(task->Profiler_Stage)->Now_Cycle;
+            if (Last_Tick_Overrun || elapsed_cycle + expect_cycle > budget_cycle)
+            {
+                task->Shed_Count++;
+                continue;
+            }
+        }
+
+        Profiler->Begin(task->Profiler_Stage);
+        task->Function();
+        Profiler->End(task->Profiler_Stage);
+
+        task->Run_Count++;
+        task->Now_Response_Cycle = DWT_Get_Cycle() - tick_start_cycle;
+        if (task->Now_Response_Cycle > task->Max_Response_Cycle)
+        {
+            task->Max_Response_Cycle = task->Now_Response_Cycle;
+        }
+        if (task->Now_Response_Cycle > task->Deadline_Cycle)
+        {
+            task->Overrun_Count++;
+        }
+    }
+
+    Profiler->End(Total_Stage);
+
+    Last_Tick_Overrun = Profiler->Get_Stage(Total_Stage)->Now_Cycle > budget_cycle;
+    if (Last_Tick_Overrun)
+    {
+        Tick_Overrun_Count++;
+    }
+    Tick_Count++;
+}
+
+/**
+ * @brief 自动分配相位, 选择与已注册的多节拍任务相遇次数最少的相位, 相同时取最小的相位
+ *
+ * @param __Period 周期, 节拍数
+ * @return uint16_t 相位
+ */
+uint16_t Class_Scheduler::Assign_Phase(uint16_t __Period)
+{
+    uint16_t best_phase = 0;
+    uint16_t best_cost = UINT16_MAX;
+
+    for (uint16_t phase = 0; phase < __Period; phase++)
+    {
+        uint16_t cost = 0;
+
+        // 每节拍运行的任务与任何相位都相遇, 不参与比较
+        for (uint8_t i = 0; i < Task_Num; i++)
+        {
+            if (Task[i].Period > 1 && (phase + __Period - Task[i].Phase % __Period) % Scheduler_GCD(__Period, Task[i].Period) == 0)
+            {
+                cost++;
+            }
+        }
+
+        if (cost < best_cost)
+        {
+            best_cost = cost;
+            best_phase = phase;
+        }
+    }
+
+    return (best_phase);
+}
+
+/**
+ * @brief 最大公约数
+ *
+ * @param A 正整数
+ * @param B 正整数
+ * @return uint16_t 最大公约数
+ */
+static uint16_t Scheduler_GCD(uint16_t A, uint16_t B)
+{
+    while (B != 0)
+    {
+        uint16_t tmp = A % B;
+        A = B;
+        B = tmp;
+    }
+    return (A);
+}
+
+/*****************************************************************************/
@@ -0,0 +1,232 @@
+/**
+ * @file alg_scheduler.h
+ * @author WFZ
+ * @brief 表驱动的周期任务调度, 挂在1ms定时中断中, 任务声明周期、相位、优先级与截止时间,
+ *        自动错开相位, 统计截止时间超限, 过载时放弃低优先级任务
+ * @version 0.0
+ * @date 2026-1-27
+ *
+ */
+
+#ifndef ALG_SCHEDULER_H
+#define ALG_SCHEDULER_H
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "alg_profiler.h"
+
+/* Exported macros -----------------------------------------------------------*/
+
+// 任务数量上限, 与耗时统计的"total"阶段一起不超过PROFILER_STAGE_NUM_MAX
+#define SCHEDULER_TASK_NUM_MAX (PROFILER_STAGE_NUM_MAX - 1)
+// 相位由调度器自动分配
+#define SCHEDULER_PHASE_AUTO (0xFFFF)
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+ * @brief 任务优先级, 同一节拍内按优先级依次运行, 同优先级按注册顺序
+ *
+ */
+enum Enum_Scheduler_Priority
+{
+    // 控制链路, 从不放弃
+    Scheduler_Priority_CRITICAL = 0,
+    // 状态检测、统计等, 从不放弃
+    Scheduler_Priority_NORMAL,
+    // 遥测等, 过载时放弃本次运行
+    Scheduler_Priority_LOW,
+};
+
+/**
+ * @brief 任务函数
+ *
+ */
+typedef void (*Scheduler_Task_Function)();
+
+/**
+ * @brief 一个周期任务
+ *
+ */
+struct Struct_Scheduler_Task
+{
+    // 任务名称, 同时作为耗时统计的阶段名
+    const char *Name;
+    Scheduler_Task_Function Function;
+    // 周期, 节拍数
+    uint16_t Period;
+    // 相位, 在节拍号模周期等于相位的节拍运行
+    uint16_t Phase;
+    Enum_Scheduler_Priority Priority;
+    // 截止时间, 从节拍开始到任务运行完的周期数
+    uint32_t Deadline_Cycle;
+    // 耗时统计中的阶段编号
+    uint8_t Profiler_Stage;
+    // 距下一次运行的节拍数
+    uint16_t Countdown;
+    // 运行次数
+    uint32_t Run_Count;
+    // 超出截止时间的次数
+    uint32_t Overrun_Count;
+    // 过载被放弃的次数
+    uint32_t Shed_Count;
+    // 最近一次与最大的响应时间, 从节拍开始到任务运行完的周期数
+    uint32_t Now_Response_Cycle;
+    uint32_t Max_Response_Cycle;
+};
+
+/**
+ * @brief 表驱动的周期任务调度
+ *
+ * 使用方法 ：
+ *  1) DWT_Init(), Profiler.Init(节拍预算), Init(&Profiler)
+ *  2) Add_Task注册各任务, 返回值即任务编号, 同优先级的任务按注册顺序运行
+ *  3) 在1ms定时中断中调用Tick(), 或定时中断只记录DWT周期数并挂起控制线程, 在控制线程中调用Tick(周期数)
+ *  4) 运行耗时的最小/平均/最大值与直方图由Profiler统计, 超限与放弃次数用Export_Summary导出
+ *
+ * 相位自动分配时, 选择与已注册的多节拍任务在同一节拍相遇次数最少的相位,
+ * 周期P1与P2的两个任务相位之差是gcd(P1, P2)的倍数时才会相遇
+ *
+ * 上一节拍超出预算, 或本节拍已用时间加上任务上一次的耗时将超出预算时视为过载,
+ * 过载时Scheduler_Priority_LOW的任务放弃本次运行, 下一个周期照常运行
+ *
+ */
+class Class_Scheduler
+{
+public:
+    void Init(Class_Profiler *__Profiler);
+
+    uint8_t Add_Task(const char *__Name, Scheduler_Task_Function __Function, uint16_t __Period, Enum_Scheduler_Priority __Priority, float __Deadline_Us, uint16_t __Phase = SCHEDULER_PHASE_AUTO);
+
+    void Reset();
+
+    inline uint8_t Get_Task_Num();
+
+    inline const Struct_Scheduler_Task *Get_Task(uint8_t __Task);
+
+    inline uint32_t Get_Tick_Count();
+
+    inline uint32_t Get_Tick_Overrun_Count();
+
+    inline float Get_Now_Release_Latency_Us();
+
+    inline float Get_Max_Release_Latency_Us();
+
+    uint8_t Export_Summary(float *Buffer, uint8_t Buffer_Length);
+
+    void Tick();
+
+    void Tick(uint32_t __Release_Cycle);
+
+protected:
+    // 初始化相关常量
+
+    // 统计各任务耗时的Profiler, 其预算即为节拍预算
+    Class_Profiler *Profiler;
+    // Profiler中整个节拍的阶段编号
+    uint8_t Total_Stage;
+
+    // 常量
+
+    // 内部变量
+
+    // 已注册的任务数量
+    uint8_t Task_Num = 0;
+    // 各任务, 按注册顺序
+    Struct_Scheduler_Task Task[SCHEDULER_TASK_NUM_MAX];
+    // 运行顺序, 按优先级排列的任务编号
+    uint8_t Run_Order[SCHEDULER_TASK_NUM_MAX];
+    // 上一节拍超出预算
+    bool Last_Tick_Overrun = false;
+
+    // 读变量
+
+    // 节拍数
+    uint32_t Tick_Count = 0;
+    // 超出预算的节拍数
+    uint32_t Tick_Overrun_Count = 0;
+    // 最近一次与最大的释放延迟, 从定时中断到节拍开始运行的周期数
+    uint32_t Now_Release_Latency_Cycle = 0;
+    uint32_t Max_Release_Latency_Cycle = 0;
+
+    // 写变量
+
+    // 读写变量
+
+    // 内部函数
+
+    uint16_t Assign_Phase(uint16_t __Period);
+};
+
+/* Exported variables --------------------------------------------------------*/
+
+/* Exported function declarations --------------------------------------------*/
+
+/**
+ * @brief 获取已注册的任务数量
+ *
+ * @return uint8_t 任务数量
+ */
+inline uint8_t Class_Scheduler::Get_Task_Num()
+{
+    return (Task_Num);
+}
+
+/**
+ * @brief 获取任务
+ *
+ * @param __Task 任务编号
+ * @return const Struct_Scheduler_Task* 任务, 编号无效时返回nullptr
+ */
+inline const Struct_Scheduler_Task *Class_Scheduler::Get_Task(uint8_t __Task)
+{
+    if (__Task >= Task_Num)
+    {
+        return (nullptr);
+    }
+    return (&Task[__Task]);
+}
+
+/**
+ * @brief 获取节拍数
+ *
+ * @return uint32_t 节拍数
+ */
+inline uint32_t Class_Scheduler::Get_Tick_Count()
+{
+    return (Tick_Count);
+}
+
+/**
+ * @brief 获取超出预算的节拍数
+ *
+ * @return uint32_t 节拍数
+ */
+inline uint32_t Class_Scheduler::Get_Tick_Overrun_Count()
+{
+    return (Tick_Overrun_Count);
+}
+
+/**
+ * @brief 获取最近一次的释放延迟
+ *
+ * @return float 从定时中断到节拍开始运行的时间, us
+ */
+inline float Class_Scheduler::Get_Now_Release_Latency_Us()
+{
+    return (DWT_Cycle_To_Us(Now_Release_Latency_Cycle));
+}
+
+/**
+ * @brief 获取最大的释放延迟
+ *
+ * @return float 从定时中断到节拍开始运行的时间, us
+ */
+inline float Class_Scheduler::Get_Max_Release_Latency_Us()
+{
+    return (DWT_Cycle_To_Us(Max_Release_Latency_Cycle));
+}
+
+#endif
+
+/*****************************************************************************/
@@ -401,8 +401,16 @@ void Class_Waveform::Relay(float __Amplitude, float __Hys, float __Bias)
 
 float Class_Waveform::Update(float __Feedback)
 {
+    return (Update(__Feedback, DT_s));
+}
+
+// 按实测周期推进, __DT_s 由调用方根据时间戳给出
+float Class_Waveform::Update(float __Feedback, float __DT_s)
+{
+    float dt = (__DT_s > 0.0f) ? __DT_s : 0.0f;
+
     // 走时间
-    Time_s += DT_s;
+    Time_s += dt;
 
     float y = Output;
 
@@ -421,20 +429,20 @@ float Class_Waveform::Update(float __Feedback)
 
         case Waveform_Type_SQUARE:
         {
-            Phase_01 = Wrap_01(Phase_01 + Square_Freq_Hz * DT_s);
+            Phase_01 = Wrap_01(Phase_01 + Square_Freq_Hz * dt);
             float hi = (Phase_01 < Square_Duty) ? 1.0f : -1.0f;
             y = Offset + Amplitude * hi;
         } break;
 
         case Waveform_Type_SINE:
         {
-            Phase_01 = Wrap_01(Phase_01 + Sine_Freq_Hz * DT_s);
+            Phase_01 = Wrap_01(Phase_01 + Sine_Freq_Hz * dt);
             y = Offset + Amplitude * sinf(2.0f * WAVE_PI * Phase_01);
         } break;
 
         case Waveform_Type_TRIANGLE:
         {
-            Phase_01 = Wrap_01(Phase_01 + Wave_Freq_Hz * DT_s);
+            Phase_01 = Wrap_01(Phase_01 + Wave_Freq_Hz * dt);
             float p = Phase_01;
             float tri = (p < 0.5f) ? (4.0f * p - 1.0f) : (3.0f - 4.0f * p); // [-1,1]
             y = Offset + Amplitude * tri;
@@ -442,7 +450,7 @@ float Class_Waveform::Update(float __Feedback)
 
         case Waveform_Type_SAW:
         {
-            Phase_01 = Wrap_01(Phase_01 + Wave_Freq_Hz * DT_s);
+            Phase_01 = Wrap_01(Phase_01 + Wave_Freq_Hz * dt);
             float saw = 2.0f * Phase_01 - 1.0f; // [-1,1)
             y = Offset + Amplitude * saw;
         } break;
@@ -494,13 +502,13 @@ float Class_Waveform::Update(float __Feedback)
                 float k = tt / Chirp_T_s;
                 f = Chirp_F0_Hz + (Chirp_F1_Hz - Chirp_F0_Hz) * k;
             }
-            Phase_01 = Wrap_01(Phase_01 + f * DT_s);
+            Phase_01 = Wrap_01(Phase_01 + f * dt);
             y = Offset + Chirp_A * sinf(2.0f * WAVE_PI * Phase_01);
         } break;
 
         case Waveform_Type_PRBS:
         {
-            PRBS_Bit_Timer_s += DT_s;
+            PRBS_Bit_Timer_s += dt;
             if (PRBS_Bit_Timer_s >= PRBS_Bit_T_s)
             {
                 PRBS_Bit_Timer_s -= PRBS_Bit_T_s;
@@ -111,6 +111,9 @@ public:
     // 对 Relay：__Feedback 传你的反馈量（角度/角速度/速度等）
     float Update(float __Feedback = 0.0f);
 
+    // 按实测周期 __DT_s(s) 推进一次, 用于控制周期存在抖动的场合
+    float Update(float __Feedback, float __DT_s);
+
 private:
 
     // 当前波形类型
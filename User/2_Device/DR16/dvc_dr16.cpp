@@ -23,24 +23,13 @@
 /* Function prototypes -------------------------------------------------------*/
 
 /**
- * @brief 遥控器DR16初始化
+ * @brief 遥控器DR16初始化, 需在该UART的UART_Init之后调用
  *
  * @param huart 指定的UART
  */
 void Class_DR16::Init(UART_HandleTypeDef *huart)
 {
-    if (huart->Instance == USART6)
-    {
-        UART_Manage_Object = &UART1_Manage_Object;
-    }
-    else if (huart->Instance == USART1)
-    {
-        UART_Manage_Object = &UART2_Manage_Object;
-    }
-    else if (huart->Instance == USART3)
-    {
-        UART_Manage_Object = &DBUS_Manage_Object;
-    }
+    UART_Manage_Object = UART_Get_Manage_Object(huart);
     // 初始化数据为0
     memset(&Data, 0, sizeof(Data));
     memset(&Pre_UART_Rx_Data, 0, sizeof(Pre_UART_Rx_Data));
@@ -184,11 +173,12 @@ void Class_DR16::Judge_Key(Enum_DR16_Key_Status *Key, uint8_t Status, uint8_t Pr
 /**
  * @brief 数据处理过程
  *
+ * @param Rx_Data 一帧遥控器数据
  */
-void Class_DR16::Data_Process()
+void Class_DR16::Data_Process(const Struct_DR16_UART_Data *Rx_Data)
 {
     //数据处理过程
-    Struct_DR16_UART_Data *tmp_buffer = (Struct_DR16_UART_Data *)UART_Manage_Object->Rx_Buffer;
+    const Struct_DR16_UART_Data *tmp_buffer = Rx_Data;
 
     // 检查原始数据是否在DR16有效范围内
     if (tmp_buffer->Channel_0 < 364 || tmp_buffer->Channel_0 > 1684 ||
@@ -240,19 +230,56 @@ void Class_DR16::Data_Process()
     }
 }
 /**
- * @brief UART通信接收回调函数
+ * @brief UART通信接收回调函数, 在接收中断中调用, 只把帧放入邮箱, 解析在控制线程中进行
+ *
+ * @param Rx_Span 接收的一帧, 位于UART接收环形缓冲区中
+ */
+void Class_DR16::UART_RxCpltCallback(const Struct_UART_Rx_Span *Rx_Span)
+{
+    //长度不是18字节的帧(上电时的半帧、干扰)直接丢弃, 也不算在线
+    if (UART_Rx_Span_Get_Length(Rx_Span) != sizeof(Struct_DR16_UART_Data))
+    {
+        return;
+    }
+
+    //环形缓冲区会被后续数据覆盖, 拷贝到邮箱, 控制线程来不及取走时新帧覆盖旧帧
+    uint8_t *rx_data = UART_Rx_Span_Linearize(Rx_Span, (uint8_t *) &Rx_Mailbox);
+    if (rx_data != (uint8_t *) &Rx_Mailbox)
+    {
+        memcpy(&Rx_Mailbox, rx_data, sizeof(Struct_DR16_UART_Data));
+    }
+    Rx_Mailbox_Timestamp_Us = Rx_Span->Timestamp_Us;
+    Rx_Mailbox_Pending = true;
+}
+
+/**
+ * @brief TIM定时器中断处理邮箱中的帧, 在控制线程中调用
  *
- * @param Rx_Data 接收的数据
  */
-void Class_DR16::UART_RxCpltCallback(uint8_t *Rx_Data)
+void Class_DR16::TIM1ms_Process_PeriodElapsedCallback()
 {
+    Struct_DR16_UART_Data rx_data;
+
+    if (!Rx_Mailbox_Pending)
+    {
+        return;
+    }
+
+    //关中断取走邮箱, 避免与接收中断同时读写
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    memcpy(&rx_data, &Rx_Mailbox, sizeof(Struct_DR16_UART_Data));
+    Rx_Timestamp_Us = Rx_Mailbox_Timestamp_Us;
+    Rx_Mailbox_Pending = false;
+    __set_PRIMASK(primask);
+
     //滑动窗口, 判断遥控器是否在线
     Flag += 1;
 
-    Data_Process();
+    Data_Process(&rx_data);
 
     //保留数据
-    memcpy(&Pre_UART_Rx_Data, UART_Manage_Object->Rx_Buffer, 18 * sizeof(uint8_t));
+    memcpy(&Pre_UART_Rx_Data, &rx_data, sizeof(Struct_DR16_UART_Data));
 }
 
 /**
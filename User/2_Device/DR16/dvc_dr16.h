@@ -167,7 +167,10 @@ public:
     inline Enum_DR16_Key_Status Get_Keyboard_Key_B();
     inline float Get_Yaw();
 
-    void UART_RxCpltCallback(uint8_t *Rx_Data);
+    inline uint32_t Get_Rx_Timestamp_Us();
+
+    void UART_RxCpltCallback(const Struct_UART_Rx_Span *Rx_Span);
+    void TIM1ms_Process_PeriodElapsedCallback();
     void TIM1msMod50_Alive_PeriodElapsedCallback();
 
 protected:
@@ -185,6 +188,12 @@ protected:
 
     //内部变量
 
+    //接收中断放入的最新一帧, 由控制线程取走
+    Struct_DR16_UART_Data Rx_Mailbox;
+    //邮箱中有未处理的帧
+    volatile bool Rx_Mailbox_Pending = false;
+    //邮箱中的帧到达时的微秒时钟
+    uint32_t Rx_Mailbox_Timestamp_Us = 0;
     //前一时刻的遥控器状态信息
     Struct_DR16_UART_Data Pre_UART_Rx_Data;
     //当前时刻的遥控器接收flag
@@ -196,6 +205,8 @@ protected:
 
     //遥控器状态
     Enum_DR16_Status DR16_Status = DR16_Status_DISABLE;
+    //最近一次处理的帧到达时的微秒时钟
+    uint32_t Rx_Timestamp_Us = 0;
     // DR16对外接口信息
     Struct_DR16_Data Data;
 
@@ -207,7 +218,7 @@ protected:
 
     void Judge_Switch(Enum_DR16_Switch_Status *Switch, uint8_t Status, uint8_t Pre_Status);
     void Judge_Key(Enum_DR16_Key_Status *Key, uint8_t Status, uint8_t Pre_Status);
-    void Data_Process();
+    void Data_Process(const Struct_DR16_UART_Data *Rx_Data);
 };
 
 /* Exported variables --------------------------------------------------------*/
@@ -504,6 +515,16 @@ float Class_DR16::Get_Yaw()
     return (Data.Yaw);
 }
 
+/**
+ * @brief 获取最近一次处理的帧到达时的微秒时钟
+ *
+ * @return uint32_t 微秒时钟
+ */
+uint32_t Class_DR16::Get_Rx_Timestamp_Us()
+{
+    return (Rx_Timestamp_Us);
+}
+
 #endif
 
 /******************************************************************/
@@ -268,54 +268,21 @@ void Class_BMI088::GetRawData(void)
  * 
 */ 
 void Class_BMI088::Filter_data(void) {
-    
-    // 1. 异常值检测
-    if (fabsf(Data.gyro_x - prev_filtered_gyro_x) > Gyro_Outlier_Threshold) {
-        // 数据突变过大，认为是异常值，使用上一次的有效值
-        Data.gyro_x = prev_filtered_gyro_x;
-    }
+    float *data[6] = {&Data.gyro_x, &Data.gyro_y, &Data.gyro_z, &Data.acc_x, &Data.acc_y, &Data.acc_z};
 
-    if (fabsf(Data.gyro_y - prev_filtered_gyro_y) > Gyro_Outlier_Threshold) {
-        // 数据突变过大，认为是异常值，使用上一次的有效值
-        Data.gyro_y = prev_filtered_gyro_y;
-    }
-    
-    if (fabsf(Data.gyro_z - prev_filtered_gyro_z) > Gyro_Outlier_Threshold) {
-        // 数据突变过大，认为是异常值，使用上一次的有效值
-        Data.gyro_z = prev_filtered_gyro_z;
-    }
+    for (uint32_t i = 0; i < 6; i++)
+    {
+        float threshold = (i < 3) ? Gyro_Outlier_Threshold : Acc_Outlier_Threshold;
 
-    if (fabsf(Data.acc_x - prev_filtered_acc_x) > Acc_Outlier_Threshold) {
-        // 数据突变过大，认为是异常值，使用上一次的有效值
-        Data.acc_x = prev_filtered_acc_x;
-    }
-    
-    if (fabsf(Data.acc_y - prev_filtered_acc_y) > Acc_Outlier_Threshold) {
-        // 数据突变过大，认为是异常值，使用上一次的有效值
-        Data.acc_y = prev_filtered_acc_y;
-    }
-    
-    if (fabsf(Data.acc_z - prev_filtered_acc_z) > Acc_Outlier_Threshold) {
-        // 数据突变过大，认为是异常值，使用上一次的有效值
-        Data.acc_z = prev_filtered_acc_z;
+        // 1. 异常值检测, 数据突变过大认为是异常值, 使用上一次的有效值
+        if (fabsf(*data[i] - Filter_IMU.Get_Out(i)) > threshold)
+        {
+            *data[i] = Filter_IMU.Get_Out(i);
+        }
+
+        // 2. 一阶低通滤波
+        *data[i] = Filter_IMU.Update(*data[i], i);
     }
-        
-    // 2. 一阶低通滤波
-    Data.gyro_x = Filter_Alpha_Light * Data.gyro_x + (1.0f - Filter_Alpha_Light) * prev_filtered_gyro_x;
-    Data.gyro_y = Filter_Alpha_Light * Data.gyro_y + (1.0f - Filter_Alpha_Light) * prev_filtered_gyro_y;
-    Data.gyro_z = Filter_Alpha_Light * Data.gyro_z + (1.0f - Filter_Alpha_Light) * prev_filtered_gyro_z;
-    
-    Data.acc_x = Filter_Alpha_Light * Data.acc_x + (1.0f - Filter_Alpha_Light) * prev_filtered_acc_x;
-    Data.acc_y = Filter_Alpha_Light * Data.acc_y + (1.0f - Filter_Alpha_Light) * prev_filtered_acc_y;
-    Data.acc_z = Filter_Alpha_Light * Data.acc_z + (1.0f - Filter_Alpha_Light) * prev_filtered_acc_z;
-    
-    prev_filtered_gyro_x = Data.gyro_x;
-    prev_filtered_gyro_y = Data.gyro_y;
-    prev_filtered_gyro_z = Data.gyro_z;
-    
-    prev_filtered_acc_x = Data.acc_x;
-    prev_filtered_acc_y = Data.acc_y;
-    prev_filtered_acc_z = Data.acc_z;
 }
 
 /**
@@ -338,6 +305,8 @@ void Class_BMI088::Init(void)
 {
     uint8_t acc_id = 0, gyro_id = 0;
     uint8_t retry = 0;
+
+    Filter_IMU.Init(Filter_Alpha_Light);
         
     // 设置灵敏度
     SetAccSensitivity();
@@ -464,6 +433,7 @@ void Class_BMI088::Calibrate(uint16_t sample_count)
 void Class_BMI088::TIM_Calculate_PeriodElapsedCallback()
 {
     GetData();
+    Timestamp_Us = DWT_Get_Us();
 
     // 对IMU数据进行滤波
     Filter_data();
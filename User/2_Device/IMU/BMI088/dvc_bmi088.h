@@ -17,6 +17,8 @@
 #include <string.h>
 #include "dvc_buzzer.h"
 #include "drv_math.h"
+#include "drv_dwt.h"
+#include "alg_filter.h"
 
 /* Exported macros -----------------------------------------------------------*/
 
@@ -175,6 +177,8 @@ public:
 
     inline float Get_Temperature(void);
 
+    inline uint32_t Get_Timestamp_Us(void);
+
 private:
 
     //配置加速度/陀螺仪的量程/带宽
@@ -191,6 +195,9 @@ private:
     //加速度，角速度，温度处理后的数据
     BMI088_Data_t Data;
 
+    //最近一次采样的微秒时钟
+    uint32_t Timestamp_Us = 0;
+
     //上一时刻陀螺仪数据
     float prev_gyro_x = 0.0f;
     float prev_gyro_y = 0.0f;
@@ -201,15 +208,8 @@ private:
     float prev_acc_y = 0.0f;
     float prev_acc_z = 0.0f;
 
-    // 上一次的陀螺仪滤波值
-    float prev_filtered_gyro_x = 0.0f;
-    float prev_filtered_gyro_y = 0.0f;
-    float prev_filtered_gyro_z = 0.0f;
-
-    // 上一次的加速度计滤波值
-    float prev_filtered_acc_x = 0.0f;
-    float prev_filtered_acc_y = 0.0f;
-    float prev_filtered_acc_z = 0.0f;
+    // 陀螺仪xyz与加速度计xyz共6通道的一阶低通, 输出即上一次的滤波值
+    Class_Filter_Low_Pass_1st<6> Filter_IMU;
 
     // 滤波相关变量
     // 常规滤波系数
@@ -343,5 +343,14 @@ inline float Class_BMI088::Get_Temperature(void)
     return Data.temperature; 
 }
 
+/**
+ * @brief 获取最近一次采样的时间戳
+ * @return uint32_t 读出该采样时的微秒时钟
+ */
+inline uint32_t Class_BMI088::Get_Timestamp_Us(void) 
+{ 
+    return Timestamp_Us; 
+}
+
 #endif
 
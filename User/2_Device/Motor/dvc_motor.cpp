@@ -20,6 +20,9 @@
 
 /* Private function declarations ---------------------------------------------*/
 
+template <typename Type_Motor>
+static void Motor_CAN_Rx_Handler(void *Object, uint8_t *Rx_Data);
+
 /* Function prototypes -------------------------------------------------------*/
 
 /**
@@ -31,7 +34,7 @@
  */
 uint8_t * allocate_tx_data(CAN_HandleTypeDef *hcan, Enum_Motor_ID __CAN_ID,Enum_GM6020_Driver_Mode __Driver_Mode = GM6020_Driver_Mode_Voltage)
 {
-    uint8_t *tmp_tx_data_ptr;
+    uint8_t *tmp_tx_data_ptr = NULL;
     if (hcan == &hcan1)
     {
         switch (__CAN_ID)
@@ -140,6 +143,11 @@ uint8_t * allocate_tx_data(CAN_HandleTypeDef *hcan, Enum_Motor_ID __CAN_ID,Enum_
             }       
         }
         break;
+        default:
+        {
+            // 未定义的ID不分配发送缓冲区, 返回NULL
+        }
+        break;
         }
     }
 	 else if (hcan == &hcan2)
@@ -250,8 +258,15 @@ uint8_t * allocate_tx_data(CAN_HandleTypeDef *hcan, Enum_Motor_ID __CAN_ID,Enum_
 					 }       
 			 }
 			 break;
+			 default:
+			 {
+					 // 未定义的ID不分配发送缓冲区, 返回NULL
+			 }
+			 break;
 			 }
 	 }
+    // 登记所在的控制报文, 由TIM_CAN_PeriodElapsedCallback定时发送
+    CAN_Register_Tx_Data(hcan, tmp_tx_data_ptr);
     return (tmp_tx_data_ptr);
 }
 
@@ -303,6 +318,8 @@ void Class_Motor_GM6020::Init(CAN_HandleTypeDef *hcan, Enum_Motor_ID __ID, Enum_
     Voltage_Max = __Voltage_Max;
     Current_Max = __Current_Max;
     CAN_Tx_Data = allocate_tx_data(hcan, __ID, __Driver_Mode);//给每个电机类分配两个字节的位置来存放要发送给电机的数据
+    // 登记反馈报文, 收到后由CAN_Rx_Dispatch直接调用本电机的CAN_RxCpltCallback
+    CAN_Register_Rx_Handler(hcan, 0x200 + __ID, Motor_CAN_Rx_Handler<Class_Motor_GM6020>, this);
 }
 
 /**
@@ -314,8 +331,9 @@ void Class_Motor_GM6020::CAN_RxCpltCallback(uint8_t *Rx_Data)
 {
     // 滑动窗口, 判断电机是否在线
     Flag += 1;
+    Rx_Timestamp_Us = CAN_Get_Rx_Timestamp_Us();
 
-    Data_Process();
+    Data_Process(Rx_Data);
 }
 
 /**
@@ -412,13 +430,18 @@ void Class_Motor_GM6020::TIM_Power_Limit_After_Calculate_PeriodElapsedCallback()
 }
 */
 
-void Class_Motor_GM6020::Data_Process()
+/**
+ * @brief 数据处理过程
+ *
+ * @param Rx_Buffer 接收的数据
+ */
+void Class_Motor_GM6020::Data_Process(uint8_t *Rx_Buffer)
 {
     // 数据处理过程
     int16_t delta_encoder;
     uint16_t tmp_encoder;
     int16_t tmp_omega, tmp_current;
-    Struct_Motor_CAN_Rx_Data *tmp_buffer = (Struct_Motor_CAN_Rx_Data *) CAN_Manage_Object->Rx_Buffer.Data;
+    Struct_Motor_CAN_Rx_Data *tmp_buffer = (Struct_Motor_CAN_Rx_Data *) Rx_Buffer;
 
     // 处理大小端
     Math_Endian_Reverse_16((void *) &tmp_buffer->Encoder_Reverse, (void *) &tmp_encoder);
@@ -458,9 +481,11 @@ void Class_Motor_GM6020::PID_Calculate()
 {
     // 根据控制模式选择速度反馈源
     float speed_feedback = Rx_Data.Now_Omega;  // 默认使用CAN反馈
+    uint32_t speed_timestamp_us = Rx_Timestamp_Us;
     
     if (External_Omega_Flag) {
         speed_feedback = External_Omega_Feedback;  // 使用外部反馈,作为PID当前值输入量
+        speed_timestamp_us = External_Omega_Timestamp_Us;
         Now_External_Omega = External_Omega_Feedback; //更新当前速度供外部调用
         External_Omega_Active_Flag = true;
     }else{
@@ -468,6 +493,11 @@ void Class_Motor_GM6020::PID_Calculate()
         External_Omega_Active_Flag = false;
     }
 
+    // 以反馈的采样时刻驱动各环, 实测周期模式下据此计算积分与微分
+    PID_Angle.Set_Now_Timestamp_Us(Rx_Timestamp_Us);
+    PID_Omega.Set_Now_Timestamp_Us(speed_timestamp_us);
+    PID_Current.Set_Now_Timestamp_Us(Rx_Timestamp_Us);
+
     switch (Control_Method)
     {
     case (Motor_Control_Method_VOLTAGE):
@@ -681,6 +711,8 @@ void Class_Motor_C610::Init(CAN_HandleTypeDef *hcan, Enum_Motor_ID __ID, Enum_Mo
     Gearbox_Rate = __Gearbox_Rate;
     Current_Max = __Current_Max;
     CAN_Tx_Data = allocate_tx_data(hcan, __ID);
+    // 登记反馈报文, 收到后由CAN_Rx_Dispatch直接调用本电机的CAN_RxCpltCallback
+    CAN_Register_Rx_Handler(hcan, 0x200 + __ID, Motor_CAN_Rx_Handler<Class_Motor_C610>, this);
 }
 
 /**
@@ -692,8 +724,9 @@ void Class_Motor_C610::CAN_RxCpltCallback(uint8_t *Rx_Data)
 {
     // 滑动窗口, 判断电机是否在线
     Flag += 1;
+    Rx_Timestamp_Us = CAN_Get_Rx_Timestamp_Us();
 
-    Data_Process();
+    Data_Process(Rx_Data);
 }
 
 /**
@@ -739,14 +772,15 @@ void Class_Motor_C610::TIM_Calculate_PeriodElapsedCallback()
 /**
  * @brief 数据处理过程
  *
+ * @param Rx_Buffer 接收的数据
  */
-void Class_Motor_C610::Data_Process()
+void Class_Motor_C610::Data_Process(uint8_t *Rx_Buffer)
 {
     // 数据处理过程
     int16_t delta_encoder;
     uint16_t tmp_encoder;
     int16_t tmp_omega, tmp_current;
-    Struct_Motor_CAN_Rx_Data *tmp_buffer = (Struct_Motor_CAN_Rx_Data *) CAN_Manage_Object->Rx_Buffer.Data;
+    Struct_Motor_CAN_Rx_Data *tmp_buffer = (Struct_Motor_CAN_Rx_Data *) Rx_Buffer;
 
     // 处理大小端
     Math_Endian_Reverse_16((void *) &tmp_buffer->Encoder_Reverse, (void *) &tmp_encoder);
@@ -783,6 +817,10 @@ void Class_Motor_C610::Data_Process()
  */
 void Class_Motor_C610::PID_Calculate()
 {
+    // 以反馈到达时刻作为各环的采样时刻, 实测周期模式下据此计算积分与微分
+    PID_Angle.Set_Now_Timestamp_Us(Rx_Timestamp_Us);
+    PID_Omega.Set_Now_Timestamp_Us(Rx_Timestamp_Us);
+
     switch (Control_Method)
     {
     case (Motor_Control_Method_CURRENT):
@@ -860,6 +898,8 @@ void Class_Motor_C620::Init(CAN_HandleTypeDef *hcan, Enum_Motor_ID __ID, Enum_Mo
     Gearbox_Rate = __Gearbox_Rate;
     Current_Max = __Current_Max;
     CAN_Tx_Data = allocate_tx_data(hcan, __ID);
+    // 登记反馈报文, 收到后由CAN_Rx_Dispatch直接调用本电机的CAN_RxCpltCallback
+    CAN_Register_Rx_Handler(hcan, 0x200 + __ID, Motor_CAN_Rx_Handler<Class_Motor_C620>, this);
 }
 
 /**
@@ -871,8 +911,9 @@ void Class_Motor_C620::CAN_RxCpltCallback(uint8_t *Rx_Data)
 {
     // 滑动窗口, 判断电机是否在线
     Flag += 1;
+    Rx_Timestamp_Us = CAN_Get_Rx_Timestamp_Us();
 
-    Data_Process();
+    Data_Process(Rx_Data);
 }
 
 /**
@@ -950,14 +991,15 @@ void Class_Motor_C620::TIM_Power_Limit_After_Calculate_PeriodElapsedCallback()
 /**
  * @brief 数据处理过程
  *
+ * @param Rx_Buffer 接收的数据
  */
-void Class_Motor_C620::Data_Process()
+void Class_Motor_C620::Data_Process(uint8_t *Rx_Buffer)
 {
     // 数据处理过程
     int16_t delta_encoder;
     uint16_t tmp_encoder;
     int16_t tmp_omega, tmp_current;
-    Struct_Motor_CAN_Rx_Data *tmp_buffer = (Struct_Motor_CAN_Rx_Data *) CAN_Manage_Object->Rx_Buffer.Data;
+    Struct_Motor_CAN_Rx_Data *tmp_buffer = (Struct_Motor_CAN_Rx_Data *) Rx_Buffer;
 
     // 处理大小端
     Math_Endian_Reverse_16((void *) &tmp_buffer->Encoder_Reverse, (void *) &tmp_encoder);
@@ -995,6 +1037,10 @@ void Class_Motor_C620::Data_Process()
  */
 void Class_Motor_C620::PID_Calculate()
 {
+    // 以反馈到达时刻作为各环的采样时刻, 实测周期模式下据此计算积分与微分
+    PID_Angle.Set_Now_Timestamp_Us(Rx_Timestamp_Us);
+    PID_Omega.Set_Now_Timestamp_Us(Rx_Timestamp_Us);
+
     switch (Control_Method)
     {
     case (Motor_Control_Method_CURRENT):
@@ -1111,4 +1157,17 @@ void Class_Motor_C620::Output()
     CAN_Tx_Data[1] = (int16_t) Out;
 }
 
+/**
+ * @brief CAN接收注册表的处理函数, 转交给对应电机对象
+ *
+ * @tparam Type_Motor 电机类
+ * @param Object 电机对象
+ * @param Rx_Data 接收的数据
+ */
+template <typename Type_Motor>
+static void Motor_CAN_Rx_Handler(void *Object, uint8_t *Rx_Data)
+{
+    ((Type_Motor *) Object)->CAN_RxCpltCallback(Rx_Data);
+}
+
 /*****************************************************************************/
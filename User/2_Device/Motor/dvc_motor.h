@@ -161,6 +161,8 @@ public:
 
     inline float Get_Now_Omega();
 
+    inline uint32_t Get_Rx_Timestamp_Us();
+
     bool External_Omega_Active_Flag = false;
 		
     inline float Get_Now_External_Omega();
@@ -213,7 +215,7 @@ public:
 
     //inline void Set_Power_Factor(float __Power_Factor); //功率限制逻辑暂时不开启
 
-    inline void Set_External_Omega(float __External_Omega);
+    inline void Set_External_Omega(float __External_Omega, uint32_t __Timestamp_Us = DWT_Get_Us());
 
     inline void Set_Out(float __Out);
 
@@ -281,9 +283,12 @@ protected:
     Enum_Motor_Status Motor_Status = Motor_Status_DISABLE;
     // 电机对外接口信息
     Struct_Motor_Rx_Data Rx_Data;
+    // 最近一帧反馈报文的到达时刻, us
+    uint32_t Rx_Timestamp_Us = 0;
     //外部速度反馈标志和值
     bool External_Omega_Flag = false;  ///< 是否使用外部速度反馈
     float External_Omega_Feedback = 0.0f;  ///< 外部速度反馈值
+    uint32_t External_Omega_Timestamp_Us = 0;  ///< 外部速度反馈的采样时刻, us
     // 下一时刻的功率估计值, W
     //float Power_Estimate; // 功率限制逻辑暂时不开启
     // 外部输入的角速度, rad/s
@@ -313,7 +318,7 @@ protected:
     //float Power_Factor = 1.0f; // 功率限制逻辑暂时不开启
 
     //内部函数
-    void Data_Process();
+    void Data_Process(uint8_t *Rx_Buffer);
 
     void PID_Calculate();
 
@@ -346,6 +351,8 @@ public:
 
     inline float Get_Now_Omega();
 
+    inline uint32_t Get_Rx_Timestamp_Us();
+
     inline float Get_Now_Current();
 
     inline Enum_Motor_Control_Method Get_Control_Method();
@@ -427,6 +434,8 @@ protected:
     Enum_Motor_Status Motor_Status = Motor_Status_DISABLE;
     // 电机对外接口信息
     Struct_Motor_Rx_Data Rx_Data;
+    // 最近一帧反馈报文的到达时刻, us
+    uint32_t Rx_Timestamp_Us = 0;
 
     // 写变量
 
@@ -447,7 +456,7 @@ protected:
 
     // 内部函数
 
-    void Data_Process();
+    void Data_Process(uint8_t *Rx_Buffer);
 
     void PID_Calculate();
 
@@ -488,6 +497,8 @@ public:
 
     inline float Get_Now_Omega();
 
+    inline uint32_t Get_Rx_Timestamp_Us();
+
     inline float Get_Now_Current();
 
     inline uint8_t Get_Now_Temperature();
@@ -583,6 +594,8 @@ protected:
     Enum_Motor_Status Motor_Status = Motor_Status_DISABLE;
     // 电机对外接口信息
     Struct_Motor_Rx_Data Rx_Data;
+    // 最近一帧反馈报文的到达时刻, us
+    uint32_t Rx_Timestamp_Us = 0;
     // 下一时刻的功率估计值, W
     //float Power_Estimate; // 功率限制逻辑暂时不开启
     
@@ -607,7 +620,7 @@ protected:
 
     // 内部函数
 
-    void Data_Process();
+    void Data_Process(uint8_t *Rx_Buffer);
 
     void PID_Calculate();
 
@@ -758,6 +771,16 @@ inline float Class_Motor_GM6020::Get_Now_Omega()
     return (Rx_Data.Now_Omega);
 }
 
+/**
+ * @brief 获取最近一帧反馈报文的到达时刻
+ *
+ * @return uint32_t 到达时刻, us
+ */
+inline uint32_t Class_Motor_GM6020::Get_Rx_Timestamp_Us()
+{
+    return (Rx_Timestamp_Us);
+}
+
 /**
  * @brief 获取当前的外部输入角速度, 单位rad/s
  *
@@ -926,12 +949,33 @@ inline float Class_Motor_GM6020::Get_Out()
 }
 
 /**
- * @brief 设定电机控制方式
+ * @brief 设定电机控制方式, 切换时新接入的环无扰切换, 以切换前的指令为起始输出
  *
  * @param __Control_Method 电机控制方式
  */
 inline void Class_Motor_GM6020::Set_Control_Method(Enum_Motor_Control_Method __Control_Method)
 {
+    if (__Control_Method != Control_Method)
+    {
+        bool omega_active = Control_Method == Motor_Control_Method_OMEGA || Control_Method == Motor_Control_Method_ANGLE;
+        bool new_omega_active = __Control_Method == Motor_Control_Method_OMEGA || __Control_Method == Motor_Control_Method_ANGLE;
+
+        // 角度环输出为速度指令, 原先没有速度指令时取实测速度
+        if (__Control_Method == Motor_Control_Method_ANGLE)
+        {
+            PID_Angle.Set_Bumpless_Out(omega_active ? Target_Omega : Rx_Data.Now_Omega);
+        }
+        // 速度环输出为电流指令, 电压控制下原先没有电流指令时取实测电流
+        if (new_omega_active && !omega_active)
+        {
+            PID_Omega.Set_Bumpless_Out(Control_Method == Motor_Control_Method_VOLTAGE ? Rx_Data.Now_Current : Target_Current);
+        }
+        // 电流环只在电压驱动下使用, 输出为电压指令
+        if (Driver_Mode == GM6020_Driver_Mode_Voltage && Control_Method == Motor_Control_Method_VOLTAGE)
+        {
+            PID_Current.Set_Bumpless_Out(Target_Voltage);
+        }
+    }
     Control_Method = __Control_Method;
 }
 
@@ -1021,10 +1065,12 @@ inline void Class_Motor_GM6020::Set_Power_Factor(float __Power_Factor)
  * @brief 设置外部速度反馈
  *
  * @param __External_Omega 外部速度反馈值 (rad/s)
+ * @param __Timestamp_Us 外部速度的采样时刻, us, 缺省取调用时刻
  */
-inline void Class_Motor_GM6020::Set_External_Omega(float __External_Omega)
+inline void Class_Motor_GM6020::Set_External_Omega(float __External_Omega, uint32_t __Timestamp_Us)
 {
     External_Omega_Feedback = __External_Omega;
+    External_Omega_Timestamp_Us = __Timestamp_Us;
     External_Omega_Flag = true;
 }
 
@@ -1108,6 +1154,16 @@ inline float Class_Motor_C610::Get_Now_Omega()
     return (Rx_Data.Now_Omega);
 }
 
+/**
+ * @brief 获取最近一帧反馈报文的到达时刻
+ *
+ * @return uint32_t 到达时刻, us
+ */
+inline uint32_t Class_Motor_C610::Get_Rx_Timestamp_Us()
+{
+    return (Rx_Timestamp_Us);
+}
+
 /**
  * @brief 获取当前的电流, A
  *
@@ -1189,12 +1245,28 @@ inline float Class_Motor_C610::Get_Out()
 }
 
 /**
- * @brief 设定电机控制方式
+ * @brief 设定电机控制方式, 切换时新接入的环无扰切换, 以切换前的指令为起始输出
  *
- * @param __Motor_Control_Method 电机控制方式
+ * @param __Control_Method 电机控制方式
  */
 inline void Class_Motor_C610::Set_Control_Method(Enum_Motor_Control_Method __Control_Method)
 {
+    if (__Control_Method != Control_Method)
+    {
+        bool omega_active = Control_Method == Motor_Control_Method_OMEGA || Control_Method == Motor_Control_Method_ANGLE;
+        bool new_omega_active = __Control_Method == Motor_Control_Method_OMEGA || __Control_Method == Motor_Control_Method_ANGLE;
+
+        // 角度环输出为速度指令, 原先没有速度指令时取实测速度
+        if (__Control_Method == Motor_Control_Method_ANGLE)
+        {
+            PID_Angle.Set_Bumpless_Out(omega_active ? Target_Omega : Rx_Data.Now_Omega);
+        }
+        // 速度环输出为电流指令
+        if (new_omega_active && !omega_active)
+        {
+            PID_Omega.Set_Bumpless_Out(Target_Current);
+        }
+    }
     Control_Method = __Control_Method;
 }
 
@@ -1356,6 +1428,16 @@ inline float Class_Motor_C620::Get_Now_Omega()
     return (Rx_Data.Now_Omega);
 }
 
+/**
+ * @brief 获取最近一帧反馈报文的到达时刻
+ *
+ * @return uint32_t 到达时刻, us
+ */
+inline uint32_t Class_Motor_C620::Get_Rx_Timestamp_Us()
+{
+    return (Rx_Timestamp_Us);
+}
+
 /**
  * @brief 获取当前的电流, A
  *
@@ -1483,12 +1565,28 @@ inline float Class_Motor_C620::Get_Out()
 }
 
 /**
- * @brief 设定电机控制方式
+ * @brief 设定电机控制方式, 切换时新接入的环无扰切换, 以切换前的指令为起始输出
  *
- * @param __Motor_C620_Control_Method 电机控制方式
+ * @param __Control_Method 电机控制方式
  */
 inline void Class_Motor_C620::Set_Control_Method(Enum_Motor_Control_Method __Control_Method)
 {
+    if (__Control_Method != Control_Method)
+    {
+        bool omega_active = Control_Method == Motor_Control_Method_OMEGA || Control_Method == Motor_Control_Method_ANGLE;
+        bool new_omega_active = __Control_Method == Motor_Control_Method_OMEGA || __Control_Method == Motor_Control_Method_ANGLE;
+
+        // 角度环输出为速度指令, 原先没有速度指令时取实测速度
+        if (__Control_Method == Motor_Control_Method_ANGLE)
+        {
+            PID_Angle.Set_Bumpless_Out(omega_active ? Target_Omega : Rx_Data.Now_Omega);
+        }
+        // 速度环输出为电流指令
+        if (new_omega_active && !omega_active)
+        {
+            PID_Omega.Set_Bumpless_Out(Target_Current);
+        }
+    }
     Control_Method = __Control_Method;
 }
 
@@ -23,7 +23,7 @@
 /* Function prototypes -------------------------------------------------------*/
 
 /**
- * @brief 串口绘图初始化. 优化方案：UART_HandleTypeDef *huart 改成 UART_Manage_Object *UART_Manage_Object，下面的if逻辑也进行改动
+ * @brief 串口绘图初始化, 需在该UART的UART_Init之后调用
  *
  * @param __huart 指定的UART
  * @param __Serialplot_Rx_Variable_Assignment_Num 接收指令字典的数量
@@ -33,18 +33,7 @@
  */
 void Class_Serialplot::Init(UART_HandleTypeDef *huart, uint8_t __Serialplot_Rx_Variable_Assignment_Num, char **__Serialplot_Rx_Variable_Assignment_List, Enum_Serialplot_Data_Type __Serialplot_Tx_Data_Type, uint8_t __Frame_Header)
 {
-    if (huart->Instance == USART6)
-    {
-        UART_Manage_Object = &UART1_Manage_Object;
-    }
-    else if (huart->Instance == USART1)
-    {
-        UART_Manage_Object = &UART2_Manage_Object;
-    }
-    else if (huart->Instance == USART3)
-    {
-        UART_Manage_Object = &DBUS_Manage_Object;
-    }
+    UART_Manage_Object = UART_Get_Manage_Object(huart);
 
     UART_Rx_Variable_Num = __Serialplot_Rx_Variable_Assignment_Num;
     UART_Rx_Variable_List = __Serialplot_Rx_Variable_Assignment_List;
@@ -57,27 +46,36 @@ void Class_Serialplot::Init(UART_HandleTypeDef *huart, uint8_t __Serialplot_Rx_V
 /**
  * @brief 判断指令变量名
  *
+ * @param Rx_Span 接收的指令
  * @return uint8_t 指令数值位置的指针, 也就是"variable=value#"中v的坐标
  */
-uint8_t Class_Serialplot::Judge_Variable_Name()
+uint8_t Class_Serialplot::Judge_Variable_Name(const Struct_UART_Rx_Span *Rx_Span)
 {
     //临时存储变量名
     char tmp_variable_name[SERIALPLOT_RX_VARIABLE_ASSIGNMENT_MAX_LENGTH];
     //等号位置标记
     int flag;
+    int length = UART_Rx_Span_Get_Length(Rx_Span);
 
     //记录变量名并标记等号位置
-    for (flag = 0; UART_Manage_Object->Rx_Buffer[flag] != '='; flag++)
+    for (flag = 0; flag < length && flag < SERIALPLOT_RX_VARIABLE_ASSIGNMENT_MAX_LENGTH - 1 && UART_Rx_Span_Get_Byte(Rx_Span, flag) != '='; flag++)
     {
-        tmp_variable_name[flag] = UART_Manage_Object->Rx_Buffer[flag];
+        tmp_variable_name[flag] = UART_Rx_Span_Get_Byte(Rx_Span, flag);
     }
     tmp_variable_name[flag] = 0;
 
+    //没有等号, 不是赋值指令
+    if (flag >= length || UART_Rx_Span_Get_Byte(Rx_Span, flag) != '=')
+    {
+        Variable_Index = -1;
+        return (flag);
+    }
+
     //比对是否在列表中
 		for (int i = 0; i < UART_Rx_Variable_Num; i++)
 		{
         //如果在则标记变量名编号
-        if (strcmp(tmp_variable_name, (char *)((int)UART_Rx_Variable_List + SERIALPLOT_RX_VARIABLE_ASSIGNMENT_MAX_LENGTH * i)) == 0)
+        if (strcmp(tmp_variable_name, (char *)((intptr_t)UART_Rx_Variable_List + SERIALPLOT_RX_VARIABLE_ASSIGNMENT_MAX_LENGTH * i)) == 0)
         {
             Variable_Index = i;
             return (flag + 1);
@@ -91,11 +89,14 @@ uint8_t Class_Serialplot::Judge_Variable_Name()
 /**
  * @brief 判断指令变量数值
  *
+ * @param Rx_Span 接收的指令
+ * @param flag 数值在指令中的起始位置
  */
-void Class_Serialplot::Judge_Variable_Value(int flag)
+void Class_Serialplot::Judge_Variable_Value(const Struct_UART_Rx_Span *Rx_Span, int flag)
 {
     //小数点位置, 是否有负号
     int tmp_dot_flag, tmp_sign_coefficient, i;
+    int length = UART_Rx_Span_Get_Length(Rx_Span);
 
     tmp_dot_flag = 0;
     tmp_sign_coefficient = 1;
@@ -108,29 +109,35 @@ void Class_Serialplot::Judge_Variable_Value(int flag)
     }
 
     //判断是否有负号
-    if (UART_Manage_Object->Rx_Buffer[flag] == '-')
+    if (flag < length && UART_Rx_Span_Get_Byte(Rx_Span, flag) == '-')
     {
         tmp_sign_coefficient = -1;
         flag++;
     }
 
     //计算值并注意小数点是否存在及其位置
-    for (i = flag; UART_Manage_Object->Rx_Buffer[i] != '#' && UART_Manage_Object->Rx_Buffer[i] != 0; i++)
+    for (i = flag; i < length && UART_Rx_Span_Get_Byte(Rx_Span, i) != '#' && UART_Rx_Span_Get_Byte(Rx_Span, i) != 0; i++)
     {
-        if (UART_Manage_Object->Rx_Buffer[i] == '.')
+        if (UART_Rx_Span_Get_Byte(Rx_Span, i) == '.')
         {
             tmp_dot_flag = i;
         }
         else
         {
-            Variable_Value = Variable_Value * 10.0f + (UART_Manage_Object->Rx_Buffer[i] - '0');
+            Variable_Value = Variable_Value * 10.0f + (UART_Rx_Span_Get_Byte(Rx_Span, i) - '0');
         }
     }
 
     //如果有小数点则考虑
     if (tmp_dot_flag != 0)
     {
-        Variable_Value /= pow(10.0f, i - tmp_dot_flag - 1.0f);
+        //小数位数有限, 逐位累乘即可, 避免双精度pow
+        float tmp_scale = 1.0f;
+        for (int j = tmp_dot_flag + 1; j < i; j++)
+        {
+            tmp_scale *= 10.0f;
+        }
+        Variable_Value /= tmp_scale;
     }
 
     Variable_Value *= tmp_sign_coefficient;
@@ -142,7 +149,7 @@ void Class_Serialplot::Judge_Variable_Value(int flag)
  */
 void Class_Serialplot::Output()
 {
-    for (int i = 0; i < 256; i++)
+    for (int i = 0; i < UART_Manage_Object->Tx_Buffer_Size; i++)
     {
         UART_Manage_Object->Tx_Buffer[i] = 0;
     }
@@ -213,22 +220,86 @@ void Class_Serialplot::Set_Data(uint8_t Number, ...)
     va_start(data_ptr, Number);
     for (int i = 0; i < Number; i++)
     {
-        Data[i] = (void *)va_arg(data_ptr, int);
+        Data[i] = va_arg(data_ptr, void *);
     }
     va_end(data_ptr);
     Data_Number = Number;
 }
 
 /**
- * @brief UART通信接收回调函数
+ * @brief 以连续数组添加被发送的数据, 适用于通道数在运行时才确定的场合
+ *
+ * @param Number 添加的数据数量, 至多20个
+ * @param Data_Array 数据数组首地址, 发送前需保持有效
+ */
+void Class_Serialplot::Set_Data_Array(uint8_t Number, const float *Data_Array)
+{
+    if (Number > 20)
+    {
+        Number = 20;
+    }
+    for (int i = 0; i < Number; i++)
+    {
+        Data[i] = &Data_Array[i];
+    }
+    Data_Number = Number;
+}
+
+/**
+ * @brief UART通信接收回调函数, 在接收中断中调用, 只把指令拷贝到邮箱, 解析在控制线程中进行
+ *
+ * @param Rx_Span 接收的一帧指令, 位于UART接收环形缓冲区中, 超出单条指令最大长度的部分丢弃
+ */
+void Class_Serialplot::UART_RxCpltCallback(const Struct_UART_Rx_Span *Rx_Span)
+{
+    uint16_t length = UART_Rx_Span_Get_Length(Rx_Span);
+
+    if (length > SERIALPLOT_RX_VARIABLE_ASSIGNMENT_MAX_LENGTH)
+    {
+        length = SERIALPLOT_RX_VARIABLE_ASSIGNMENT_MAX_LENGTH;
+    }
+    for (uint16_t i = 0; i < length; i++)
+    {
+        Rx_Command[i] = UART_Rx_Span_Get_Byte(Rx_Span, i);
+    }
+    Rx_Command_Length = length;
+    Rx_Command_Timestamp_Us = Rx_Span->Timestamp_Us;
+    Rx_Command_Pending = true;
+}
+
+/**
+ * @brief TIM定时器中断解析邮箱中的指令, 在控制线程中调用
  *
- * @param Rx_Data 接收的数据
+ * @return true 解析了一条新指令, 结果由Get_Variable_Index与Get_Variable_Value获取
+ * @return false 没有新指令
  */
-void Class_Serialplot::UART_RxCpltCallback(uint8_t *Rx_Data)
+bool Class_Serialplot::TIM_Read_PeriodElapsedCallback()
 {
+    uint8_t command[SERIALPLOT_RX_VARIABLE_ASSIGNMENT_MAX_LENGTH];
+    Struct_UART_Rx_Span span;
     int flag;
-    flag = Judge_Variable_Name();
-    Judge_Variable_Value(flag);
+
+    if (!Rx_Command_Pending)
+    {
+        return (false);
+    }
+
+    //关中断取走邮箱, 避免与接收中断同时读写
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    span.Length = Rx_Command_Length;
+    memcpy(command, Rx_Command, span.Length);
+    span.Timestamp_Us = Rx_Command_Timestamp_Us;
+    Rx_Command_Pending = false;
+    __set_PRIMASK(primask);
+
+    span.Data = command;
+    span.Wrap_Data = NULL;
+    span.Wrap_Length = 0;
+
+    flag = Judge_Variable_Name(&span);
+    Judge_Variable_Value(&span, flag);
+    return (true);
 }
 
 /**
@@ -54,8 +54,10 @@ public:
     double Get_Variable_Value();
 
     void Set_Data(uint8_t Number, ...);
+    void Set_Data_Array(uint8_t Number, const float *Data_Array);
 
-    void UART_RxCpltCallback(uint8_t *Rx_Data);
+    void UART_RxCpltCallback(const Struct_UART_Rx_Span *Rx_Span);
+    bool TIM_Read_PeriodElapsedCallback();
     void TIM_Write_PeriodElapsedCallback();
 
 protected:
@@ -90,6 +92,12 @@ protected:
     int8_t Variable_Index = 0;
     //当前接收的指令在指令字典中的值
     float Variable_Value = 0.0f;
+    //接收中断放入的最新一条指令, 由控制线程取走解析
+    uint8_t Rx_Command[SERIALPLOT_RX_VARIABLE_ASSIGNMENT_MAX_LENGTH];
+    uint16_t Rx_Command_Length = 0;
+    uint32_t Rx_Command_Timestamp_Us = 0;
+    //邮箱中有未解析的指令
+    volatile bool Rx_Command_Pending = false;
 
     //读变量
 
@@ -99,8 +107,8 @@ protected:
 
     //内部函数
 
-    uint8_t Judge_Variable_Name();
-    void Judge_Variable_Value(int flag);
+    uint8_t Judge_Variable_Name(const Struct_UART_Rx_Span *Rx_Span);
+    void Judge_Variable_Value(const Struct_UART_Rx_Span *Rx_Span, int flag);
     void Output();
 };
 
@@ -131,9 +139,19 @@ static char Variable_Assignment_List[][SERIALPLOT_RX_VARIABLE_ASSIGNMENT_MAX_LEN
 
 void SystemClock_Config(void);
 
-void UART_Serialplot_Call_Back(uint8_t *Buffer, uint16_t Length)
+void UART_Serialplot_Call_Back(const Struct_UART_Rx_Span *Rx_Span)
 {
-    serialplot.UART_RxCpltCallback(Buffer);
+    //接收中断中只拷贝指令
+    serialplot.UART_RxCpltCallback(Rx_Span);
+}
+
+void Serialplot_Command_Process()
+{
+    //没有新指令
+    if (!serialplot.TIM_Read_PeriodElapsedCallback())
+    {
+        return;
+    }
     switch (serialplot.Get_Variable_Index())
     {
         case(0):
@@ -180,6 +198,7 @@ int main(void)
     Now_Omega = 3.0f;
     serialplot.Set_Data(2, &Now_Omega, &Target_Omega);
 
+    Serialplot_Command_Process();//解析接收到的指令
     serialplot.TIM_Write_PeriodElapsedCallback();//将要向serialplot发送的数据输出到UART_Manage_Object发送缓冲区
     TIM_UART_PeriodElapsedCallback();//发送UART_Manage_Object发送缓冲区的数据到serialplot(串口)
     
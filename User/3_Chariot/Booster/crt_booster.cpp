@@ -36,14 +36,24 @@ void Class_Booster::Init()
     //拨弹盘
     Motor_Driver.PID_Angle.Init(50.0f, 0.0f, 0.0f, 0.0f,0.0f, 0.0f,20.0f ); 
     Motor_Driver.PID_Omega.Init(3.40f, 200.0f, 0.0f, 0.0f,10.0f, 10.0f, 10.0f);
+    //积分增益大, 按反馈报文的实际间隔积分
+    Motor_Driver.PID_Omega.Set_D_T_Mode(PID_D_T_Mode_MEASURED);
+    // 堵转或加减速时输出饱和, 不再继续积分
+    Motor_Driver.PID_Omega.Set_Conditional_Integration(PID_Conditional_Integration_ENABLE);
 
     Motor_Driver.Init(&hcan2, Motor_CAN_ID_0x203, Motor_Control_Method_OMEGA);
+    //继电幅值0.3A, 滞环0.5rad/s, 振荡周期约45ms; 偏离目标20rad/s或5s未稳定即放弃
+    Autotuner.Init(0.3f, 0.5f, 0.001f, 5.0f, 20.0f);
     
     //摩擦轮
     Motor_Friction_Left.PID_Omega.Init(0.15f, 0.3f, 0.002f, 0.0f,20.0f, 20.0f, 20.0f);
+    Motor_Friction_Left.PID_Omega.Set_D_T_Mode(PID_D_T_Mode_MEASURED);
+    Motor_Friction_Left.PID_Omega.Set_Conditional_Integration(PID_Conditional_Integration_ENABLE);
     Motor_Friction_Left.Init(&hcan2, Motor_CAN_ID_0x201, Motor_Control_Method_OMEGA, 1);
     
     Motor_Friction_Right.PID_Omega.Init(0.15f, 0.3f, 0.002f, 0.0f,20.0f, 20.0f, 20.0f);
+    Motor_Friction_Right.PID_Omega.Set_D_T_Mode(PID_D_T_Mode_MEASURED);
+    Motor_Friction_Right.PID_Omega.Set_Conditional_Integration(PID_Conditional_Integration_ENABLE);
     Motor_Friction_Right.Init(&hcan2, Motor_CAN_ID_0x202, Motor_Control_Method_OMEGA,1);
     
 
@@ -52,8 +62,8 @@ void Class_Booster::Init()
 
 void Class_Booster::Trigger_Spot()
 {
-    // 正在打一发就别重复触发
-    if (Spot_Busy) return;
+    // 正在打一发就别重复触发, 自整定期间不响应
+    if (Spot_Busy || Control_Type == Booster_Control_Type_AUTOTUNE) return;
 
     const float step_angle = 2.0f * PI / Ammo_Num_Per_Round;
 
@@ -66,6 +76,17 @@ void Class_Booster::Trigger_Spot()
     Control_Type = Booster_Control_Type_SPOT;
 }
 
+void Class_Booster::Start_Autotune()
+{
+    const float driver_auto_omega = Auto_Ammo_Frequency * 2.0f * PI / Ammo_Num_Per_Round;
+
+    // 速度环断开, 电流从0开始在 ±继电幅值 间切换
+    Autotuner.Start(-driver_auto_omega, Motor_Driver.Get_Now_Omega(), 0.0f);
+
+    Spot_Busy = false;
+    Control_Type = Booster_Control_Type_AUTOTUNE;
+}
+
 void Class_Booster::TIM_100ms_Alive_PeriodElapsedCallback()
 {
     Motor_Driver.TIM_100ms_Alive_PeriodElapsedCallback();
@@ -96,8 +117,7 @@ void Class_Booster::Output()
         Motor_Friction_Left.Set_Control_Method(Motor_Control_Method_OMEGA);
         Motor_Friction_Right.Set_Control_Method(Motor_Control_Method_OMEGA);
 
-        Motor_Driver.PID_Angle.Set_Integral_Error(0.0f);
-        Motor_Driver.PID_Omega.Set_Integral_Error(0.0f);
+        // 拨弹电机的角度环与速度环此时不参与计算, 重新接入时由Set_Control_Method无扰切换
         Motor_Friction_Left.PID_Omega.Set_Integral_Error(0.0f);
         Motor_Friction_Right.PID_Omega.Set_Integral_Error(0.0f);
 
@@ -158,6 +178,27 @@ void Class_Booster::Output()
         Motor_Driver.Set_Target_Omega(-driver_auto_omega);
     }
     break;
+
+    case Booster_Control_Type_AUTOTUNE:
+    {
+        // 自整定：摩擦停，拨弹电流由继电给出
+        Motor_Driver.Set_Control_Method(Motor_Control_Method_CURRENT);
+        Motor_Friction_Left.Set_Control_Method(Motor_Control_Method_OMEGA);
+        Motor_Friction_Right.Set_Control_Method(Motor_Control_Method_OMEGA);
+
+        Motor_Friction_Left.Set_Target_Omega(0.0f);
+        Motor_Friction_Right.Set_Target_Omega(0.0f);
+
+        Autotuner.TIM_Calculate_PeriodElapsedCallback(Motor_Driver.Get_Now_Omega());
+        Motor_Driver.Set_Target_Current(Autotuner.Get_Out());
+
+        // 成功或失败都回到全停, 参数由串口指令确认后写入
+        if (Autotuner.Get_Status() != PID_Autotuner_Status_RUNNING)
+        {
+            Control_Type = Booster_Control_Type_DISABLE;
+        }
+    }
+    break;
     }
 }
 
@@ -25,6 +25,7 @@
 
 #include "dvc_motor.h"
 #include "drv_math.h"
+#include "alg_autotuner.h"
 
 /* Exported macros -----------------------------------------------------------*/
 
@@ -40,6 +41,7 @@ typedef enum
     Booster_Control_Type_CEASEFIRE,    // 预热（摩擦转 + 拨弹停）
     Booster_Control_Type_SPOT,         // 单发（拨弹走一格，立刻回到 CEASEFIRE）
     Booster_Control_Type_AUTO,         // 连发（拨弹恒速）
+    Booster_Control_Type_AUTOTUNE,     // 拨弹速度环继电自整定（摩擦停，结束后回到 DISABLE）
 } Enum_Booster_Control_Type;
 
 /**
@@ -59,11 +61,23 @@ public:
     //右摩擦轮电机
     Class_Motor_C620 Motor_Friction_Right;
 
+    //拨弹盘速度环自整定
+    Class_PID_Autotuner Autotuner;
+
     void Init(); 
 
     inline Enum_Booster_Control_Type Get_Booster_Control_Type() const { return Control_Type; }
 
-    inline void Set_Booster_Control_Type(Enum_Booster_Control_Type t) { Control_Type = t; }
+    // 自整定期间只响应 DISABLE，用于中止（遥控器 S1 拨到 UP 即可）
+    inline void Set_Booster_Control_Type(Enum_Booster_Control_Type t)
+    {
+        if (Control_Type == Booster_Control_Type_AUTOTUNE)
+        {
+            if (t != Booster_Control_Type_DISABLE) return;
+            Autotuner.Stop();
+        }
+        Control_Type = t;
+    }
 
     inline void Set_Friction_Omega(float omega_radps) { Friction_Omega = omega_radps; }
 
@@ -74,6 +88,9 @@ public:
     // 触发一次单发（你在遥控器逻辑里做“边沿触发”时调用）
     void Trigger_Spot();
 
+    // 开始拨弹盘速度环自整定，以连发时的拨盘角速度为振荡中心（整定前清空弹仓）
+    void Start_Autotune();
+
     // 放到 1ms 任务里调用
     void TIM_1ms_Calculate_PeriodElapsedCallback();
 
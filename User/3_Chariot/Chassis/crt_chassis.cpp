@@ -18,6 +18,10 @@
 
 /* Private variables ---------------------------------------------------------*/
 
+// 运动学矩阵按引用参与乘法, C++11下需要类外定义
+constexpr Class_Matrix<4, 3> Class_Chassis::Inverse_Kinematics_Matrix;
+constexpr Class_Matrix<3, 4> Class_Chassis::Forward_Kinematics_Matrix;
+
 /* Private function declarations ---------------------------------------------*/
 
 /* Function prototypes -------------------------------------------------------*/
@@ -60,7 +64,7 @@ void Class_Chassis::TIM_100ms_Alive_PeriodElapsedCallback(void)
  * @brief TIM定时器中断解算回调函数
  *
  */
-void Class_Chassis::TIM_2ms_Resolution_PeriodElapsedCallback(void)
+void Class_Chassis::TIM_1ms_Resolution_PeriodElapsedCallback(void)
 {
     Self_Resolution();
 }
@@ -69,7 +73,7 @@ void Class_Chassis::TIM_2ms_Resolution_PeriodElapsedCallback(void)
  * @brief TIM定时器中断控制回调函数
  *
  */
-void Class_Chassis::TIM_2ms_Control_PeriodElapsedCallback()
+void Class_Chassis::TIM_1ms_Control_PeriodElapsedCallback()
 {
     Kinematics_Inverse_Resolution();
 
@@ -82,34 +86,18 @@ void Class_Chassis::TIM_2ms_Control_PeriodElapsedCallback()
  */
 void Class_Chassis::Self_Resolution(void)
 {
-    Now_Velocity_X = 0.0f;
-    Now_Velocity_Y = 0.0f;
-    Now_Omega = 0.0f;
-
-    float wheel_omega[4];
+    Class_Vector<4> wheel_omega;
     for (int i = 0; i < 4; i++)
+    {
         wheel_omega[i] = Motor[i].Get_Now_Omega();
+    }
 
-    float wheel_speeds[4];
-    for (int i = 0; i < 4; i++)
-        wheel_speeds[i] = wheel_omega[i] * Wheel_Radius;
-
-    // 右侧轮电机安装方向与左侧相反：这里把实测值反号回“轮子线速度”物理方向
-    wheel_speeds[2] = -wheel_speeds[2];  // 右前
-    wheel_speeds[3] = -wheel_speeds[3];  // 右后
-
-    // 旋转半径
-    float R = Chassis_Half_Length + Chassis_Half_Width;
-
-    // 统一的麦轮模型（前x 左y 上z，+omega 逆时针）：
-    // v_LR(0)= vx + vy - w*R
-    // v_LF(1)= vx - vy - w*R
-    // v_RF(2)= vx + vy + w*R
-    // v_RR(3)= vx - vy + w*R
+    // 模型与电机方向见Forward_Kinematics_Matrix
+    Class_Vector<3> velocity = Forward_Kinematics_Matrix * wheel_omega;
 
-    Now_Velocity_X = (wheel_speeds[0] + wheel_speeds[1] + wheel_speeds[2] + wheel_speeds[3]) / 4.0f;
-    Now_Velocity_Y = (wheel_speeds[0] - wheel_speeds[1] + wheel_speeds[2] - wheel_speeds[3]) / 4.0f;
-    Now_Omega      = (-wheel_speeds[0] - wheel_speeds[1] + wheel_speeds[2] + wheel_speeds[3]) / (4.0f * R);
+    Now_Velocity_X = velocity[0];
+    Now_Velocity_Y = velocity[1];
+    Now_Omega      = velocity[2];
 }
 
 
@@ -119,8 +107,6 @@ void Class_Chassis::Self_Resolution(void)
  */
 void Class_Chassis::Kinematics_Inverse_Resolution(void)
 {
-    float wheel_speeds[4];
-
     // 根据模式选择坐标系
     if (Crt_Move_CS_Mode == Crt_Move_GCS){
         Kinematics_GimbalToChassis();
@@ -130,24 +116,18 @@ void Class_Chassis::Kinematics_Inverse_Resolution(void)
     Math_Constrain(&Target_Velocity_Y, -Chassis_Max_Speed, Chassis_Max_Speed);
     Math_Constrain(&Target_Omega,      -Chassis_Max_Omega, Chassis_Max_Omega);
 
-    // 旋转半径
-    float R = Chassis_Half_Length + Chassis_Half_Width;
-
-    // 统一的麦轮逆解（前x 左y 上z，+omega 逆时针）
-    // 0:左后(LR) 1:左前(LF) 2:右前(RF) 3:右后(RR)
-    wheel_speeds[0] = Target_Velocity_X + Target_Velocity_Y - Target_Omega * R; // LR
-    wheel_speeds[1] = Target_Velocity_X - Target_Velocity_Y - Target_Omega * R; // LF
-    wheel_speeds[2] = Target_Velocity_X + Target_Velocity_Y + Target_Omega * R; // RF
-    wheel_speeds[3] = Target_Velocity_X - Target_Velocity_Y + Target_Omega * R; // RR
+    Class_Vector<3> velocity;
+    velocity[0] = Target_Velocity_X;
+    velocity[1] = Target_Velocity_Y;
+    velocity[2] = Target_Omega;
 
-    // 右侧轮电机方向相反：对下发目标取反，保轮子线速与模型一致
-    wheel_speeds[2] = -wheel_speeds[2];
-    wheel_speeds[3] = -wheel_speeds[3];
+    // 模型与电机方向见Inverse_Kinematics_Matrix
+    Class_Vector<4> wheel_omega = Inverse_Kinematics_Matrix * velocity;
 
-    Target_Wheel_Omega[0] = wheel_speeds[0] / Wheel_Radius;
-    Target_Wheel_Omega[1] = wheel_speeds[1] / Wheel_Radius;
-    Target_Wheel_Omega[2] = wheel_speeds[2] / Wheel_Radius;
-    Target_Wheel_Omega[3] = wheel_speeds[3] / Wheel_Radius;
+    for (int i = 0; i < 4; i++)
+    {
+        Target_Wheel_Omega[i] = wheel_omega[i];
+    }
 }
 
 
@@ -161,9 +141,12 @@ void Class_Chassis::Kinematics_GimbalToChassis(void)
     // v_chassis = R(theta) * v_gimbal
     const float x_g = Target_Velocity_X;
     const float y_g = Target_Velocity_Y;
+    float sin_angle, cos_angle;
+
+    Math_Sin_Cos(Gimbal_Angle, &sin_angle, &cos_angle);
 
-    Target_Velocity_X = x_g * cosf(Gimbal_Angle) - y_g * sinf(Gimbal_Angle);
-    Target_Velocity_Y = x_g * sinf(Gimbal_Angle) + y_g * cosf(Gimbal_Angle);
+    Target_Velocity_X = x_g * cos_angle - y_g * sin_angle;
+    Target_Velocity_Y = x_g * sin_angle + y_g * cos_angle;
 }
 
 
@@ -181,10 +164,9 @@ void Class_Chassis::Output_To_Motor()
         // 底盘失能
         for (int i = 0; i < 4; i++)
         {
+            // 速度环此时不参与计算, 重新接入时由Set_Control_Method无扰切换
             Motor[i].Set_Control_Method(Motor_Control_Method_CURRENT);
 
-            Motor[i].PID_Omega.Set_Integral_Error(0.0f);
-
             Motor[i].Set_Target_Current(0.0f);
 
             Motor[i].Set_Feedforward_Current(0.0f);
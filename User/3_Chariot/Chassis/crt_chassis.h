@@ -27,6 +27,7 @@
 
 #include "dvc_motor.h"
 #include "drv_math.h"
+#include "drv_matrix.h"
 
 /* Exported macros -----------------------------------------------------------*/
 
@@ -107,17 +108,39 @@ public:
 
     void TIM_100ms_Alive_PeriodElapsedCallback();
 
-    void TIM_2ms_Resolution_PeriodElapsedCallback();
+    void TIM_1ms_Resolution_PeriodElapsedCallback();
 
-    void TIM_2ms_Control_PeriodElapsedCallback();
+    void TIM_1ms_Control_PeriodElapsedCallback();
 
 protected:
     // 初始化相关常量
 
     // 常量
-    const float Chassis_Half_Length = 0.185f;  // 底盘长度的一半 L/2 单位m
-    const float Chassis_Half_Width = 0.2f;  // 底盘宽度的一半 W/2 单位m
-    const float Wheel_Radius = 0.075f; //轮子半径 单位m
+    static constexpr float Chassis_Half_Length = 0.185f;  // 底盘长度的一半 L/2 单位m
+    static constexpr float Chassis_Half_Width = 0.2f;  // 底盘宽度的一半 W/2 单位m
+    static constexpr float Wheel_Radius = 0.075f; //轮子半径 单位m
+    static constexpr float Chassis_Rotate_Radius = Chassis_Half_Length + Chassis_Half_Width; //旋转半径 R = L/2 + W/2 单位m
+
+    // 统一的麦轮模型（前x 左y 上z，+omega 逆时针）, 轮序 0:左后(LR) 1:左前(LF) 2:右前(RF) 3:右后(RR)
+    // v_LR(0)= vx + vy - w*R
+    // v_LF(1)= vx - vy - w*R
+    // v_RF(2)= vx + vy + w*R
+    // v_RR(3)= vx - vy + w*R
+    // 右侧轮电机安装方向与左侧相反, 已并入矩阵中2、3号轮的符号
+
+    // 运动学逆解矩阵, [vx, vy, omega] -> 四个电机角速度
+    static constexpr Class_Matrix<4, 3> Inverse_Kinematics_Matrix = {{
+        { 1.0f / Wheel_Radius,  1.0f / Wheel_Radius, -Chassis_Rotate_Radius / Wheel_Radius},
+        { 1.0f / Wheel_Radius, -1.0f / Wheel_Radius, -Chassis_Rotate_Radius / Wheel_Radius},
+        {-1.0f / Wheel_Radius, -1.0f / Wheel_Radius, -Chassis_Rotate_Radius / Wheel_Radius},
+        {-1.0f / Wheel_Radius,  1.0f / Wheel_Radius, -Chassis_Rotate_Radius / Wheel_Radius},
+    }};
+    // 运动学正解矩阵, 四个电机角速度 -> [vx, vy, omega], 即逆解矩阵的最小二乘伪逆
+    static constexpr Class_Matrix<3, 4> Forward_Kinematics_Matrix = {{
+        { Wheel_Radius / 4.0f,  Wheel_Radius / 4.0f, -Wheel_Radius / 4.0f, -Wheel_Radius / 4.0f},
+        { Wheel_Radius / 4.0f, -Wheel_Radius / 4.0f, -Wheel_Radius / 4.0f,  Wheel_Radius / 4.0f},
+        {-Wheel_Radius / (4.0f * Chassis_Rotate_Radius), -Wheel_Radius / (4.0f * Chassis_Rotate_Radius), -Wheel_Radius / (4.0f * Chassis_Rotate_Radius), -Wheel_Radius / (4.0f * Chassis_Rotate_Radius)},
+    }};
 
     // 内部变量
 
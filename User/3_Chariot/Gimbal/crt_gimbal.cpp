@@ -42,6 +42,8 @@ void Class_Gimbal::Init()
                             PID_ZPIB_ENABLE
                             );//积分限幅和积分分离阈值按照角度环实际情况修改
     //，，，积分分离阈值再量
+    //速度反馈来自IMU, 按IMU采样的实际间隔积分
+    Motor_Yaw.PID_Omega.Set_D_T_Mode(PID_D_T_Mode_MEASURED);
 
     Motor_Yaw.Init(&hcan1,Motor_CAN_ID_0x208,Motor_Control_Method_OMEGA,-3128);
 
@@ -158,15 +160,7 @@ void Class_Gimbal::Motor_Nearest_Transposition()
     float tmp_delta_angle;
 
     // Yaw就近转位
-    tmp_delta_angle = fmod(Target_Yaw_Angle - Now_Yaw_Angle, 2.0f * PI);
-    if (tmp_delta_angle > PI)
-    {
-        tmp_delta_angle -= 2.0f * PI;
-    }
-    else if (tmp_delta_angle < -PI)
-    {
-        tmp_delta_angle += 2.0f * PI;
-    }
+    tmp_delta_angle = Math_Wrap_Pi(Target_Yaw_Angle - Now_Yaw_Angle);
     //Target_Yaw_Angle = Motor_Yaw.Get_Now_Angle() + tmp_delta_angle;
     Target_Yaw_Angle = Now_Yaw_Angle + tmp_delta_angle;
 
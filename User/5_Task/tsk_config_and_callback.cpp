@@ -20,6 +20,9 @@
 #include "crt_booster.h"
 #include "drv_math.h"
 #include "alg_waveform.h"
+#include "alg_profiler.h"
+#include "alg_scheduler.h"
+#include "drv_swi.h"
 
 /* Private macros ------------------------------------------------------------*/
 
@@ -38,9 +41,19 @@ static char Serialplot_Variable_Assignment_List[][SERIALPLOT_RX_VARIABLE_ASSIGNM
         "io",
         "do",
         "free",
+        // 耗时统计导出: 0正常绘图, 1各阶段平均/最大耗时, 2清空统计后同1, 10+n第n阶段直方图
+        "prof",
+        // CAN总线统计导出: 0正常绘图, 1 CAN1总线统计, 2 CAN2总线统计, 3清空统计后同1, 10+n第n个登记ID的到达间隔直方图
+        "can",
+        // 调度统计导出: 0正常绘图, 1超预算节拍数/节拍最大耗时与各任务超限/放弃次数, 2清空统计后同1
+        "sched",
+        // 拨弹速度环自整定: 0中止并恢复正常绘图, 1开始继电激励, 10+n按第n种规则写入参数; 非0时导出整定进度与结果
+        "tune",
 };
 
 Class_Waveform Waveform;
+// 波形发生器本节拍的输出, 供串口绘图
+float Waveform_Value = 0.0f;
 
 Class_DR16 dr16;
 
@@ -50,88 +63,68 @@ Class_Gimbal Gimbal;
 
 Class_Booster Booster;
 
+// 1ms任务调度
+Class_Scheduler Scheduler;
+// 各任务耗时统计, 阶段0为整个节拍, 之后按任务注册顺序
+Class_Profiler Profiler;
+// 耗时统计导出模式, 由串口指令prof设定
+uint8_t Profiler_Export_Mode = 0;
+// 耗时统计导出缓冲区, 对应串口绘图的20个通道
+float Profiler_Export_Data[20];
+// CAN总线统计导出模式, 由串口指令can设定, 耗时统计导出优先
+uint8_t CAN_Export_Mode = 0;
+// CAN总线统计导出缓冲区, 对应串口绘图的20个通道
+float CAN_Export_Data[20];
+// 调度统计导出模式, 由串口指令sched设定, 耗时统计与CAN总线统计导出优先
+uint8_t Scheduler_Export_Mode = 0;
+// 调度统计导出缓冲区, 对应串口绘图的20个通道
+float Scheduler_Export_Data[20];
+// 自整定导出模式, 由串口指令tune设定, 以上各项导出优先
+uint8_t Autotune_Export_Mode = 0;
+// 自整定导出参数所用的整定规则
+Enum_PID_Autotuner_Rule Autotune_Export_Rule = PID_Autotuner_Rule_SIMC_PI;
+// 自整定导出缓冲区, 对应串口绘图的20个通道
+float Autotune_Export_Data[20];
+// TIM4中断记录的最近一次节拍的DWT周期数
+volatile uint32_t Control_Tick_Cycle = 0;
+// TIM4中断记录的最近一次节拍的时间戳, us
+volatile uint32_t Control_Tick_Us = 0;
+// 控制线程上一次运行对应的节拍时间戳, us
+uint32_t Control_Pre_Tick_Us = 0;
+bool Control_Pre_Tick_Valid = false;
+// 控制线程两次运行之间的实测周期, s, 供按实际周期积分的任务使用
+float Control_Dt_s = 0.001f;
+// TIM4中断挂起、控制线程尚未处理的节拍数
+volatile uint32_t Control_Tick_Pending = 0;
+// 控制线程来不及处理而合并掉的节拍数
+uint32_t Control_Tick_Missed_Num = 0;
+
 bool init_finished = false;
 /* Private function declarations ---------------------------------------------*/
 
 /* Function prototypes -------------------------------------------------------*/
 
 /**
- * @brief CAN1回调函数
+ * @brief UART1串口绘图回调函数, 在接收中断中只拷贝指令
  *
- * @param Rx_Buffer CAN1收到的消息
+ * @param Rx_Span UART1收到的消息
  */
-void CAN1_Callback_Function(Struct_CAN_Rx_Buffer * Rx_Buffer){
-    switch (Rx_Buffer->Header.StdId)
-    {
-
-        case (0x208):
-        {
-            Gimbal.Motor_Yaw.CAN_RxCpltCallback(Rx_Buffer->Data);
-        }
-        break;
-        case (0x205):
-        {
-            Gimbal.Motor_Pitch.CAN_RxCpltCallback(Rx_Buffer->Data);
-        }
-        break;
-        case (0x201):
-        {
-            Chassis.Motor[0].CAN_RxCpltCallback(Rx_Buffer->Data);
-        }
-        break;
-        case (0x202):
-        {
-            Chassis.Motor[1].CAN_RxCpltCallback(Rx_Buffer->Data);
-        }
-        break;
-        case (0x203):
-        {
-            Chassis.Motor[2].CAN_RxCpltCallback(Rx_Buffer->Data);
-        }
-        break;
-        case (0x204):
-        {
-            Chassis.Motor[3].CAN_RxCpltCallback(Rx_Buffer->Data);
-        }
-        break;
-    }
+void UART_Serialplot_Call_Back(const Struct_UART_Rx_Span *Rx_Span)
+{
+    serialplot.UART_RxCpltCallback(Rx_Span);
 }
 
 /**
- * @brief CAN2回调函数
+ * @brief 串口绘图指令处理, 在控制线程中解析接收中断拷贝的指令
  *
- * @param Rx_Buffer CAN2收到的消息
  */
-void CAN2_Callback_Function(Struct_CAN_Rx_Buffer * Rx_Buffer){
-    switch (Rx_Buffer->Header.StdId)
+void Serialplot_Command_Process()
+{
+    //没有新指令
+    if (!serialplot.TIM_Read_PeriodElapsedCallback())
     {
-        case (0x201):
-        {
-            Booster.Motor_Friction_Left.CAN_RxCpltCallback(Rx_Buffer->Data);
-        }
-        break;
-        case (0x202):
-        {
-            Booster.Motor_Friction_Right.CAN_RxCpltCallback(Rx_Buffer->Data);
-        }
-        break;
-        case (0x203):
-        {
-            Booster.Motor_Driver.CAN_RxCpltCallback(Rx_Buffer->Data);
-        }
-        break;
+        return;
     }
-}
-
-/**
- * @brief UART1串口绘图回调函数
- *
- * @param Buffer UART1收到的消息
- * @param Length 长度
- */
-void UART_Serialplot_Call_Back(uint8_t *Buffer, uint16_t Length)
-{
-    serialplot.UART_RxCpltCallback(Buffer);
     switch (serialplot.Get_Variable_Index())
     {
 				
@@ -171,50 +164,95 @@ void UART_Serialplot_Call_Back(uint8_t *Buffer, uint16_t Length)
 
         }
         break;
+        case(7):
+        {
+            Profiler_Export_Mode = (uint8_t) serialplot.Get_Variable_Value();
+        }
+        break;
+        case(8):
+        {
+            CAN_Export_Mode = (uint8_t) serialplot.Get_Variable_Value();
+        }
+        break;
+        case(9):
+        {
+            Scheduler_Export_Mode = (uint8_t) serialplot.Get_Variable_Value();
+        }
+        break;
+        case(10):
+        {
+            Autotune_Export_Mode = (uint8_t) serialplot.Get_Variable_Value();
+            if (Autotune_Export_Mode == 0 && Booster.Get_Booster_Control_Type() == Booster_Control_Type_AUTOTUNE)
+            {
+                Booster.Set_Booster_Control_Type(Booster_Control_Type_DISABLE);
+            }
+            else if (Autotune_Export_Mode == 1)
+            {
+                Booster.Start_Autotune();
+            }
+            else if (Autotune_Export_Mode >= 10 && Autotune_Export_Mode - 10 < PID_Autotuner_Rule_NUM)
+            {
+                // 未成功时参数不变
+                Autotune_Export_Rule = (Enum_PID_Autotuner_Rule) (Autotune_Export_Mode - 10);
+                Booster.Autotuner.Apply(&Booster.Motor_Driver.PID_Omega, Autotune_Export_Rule);
+            }
+        }
+        break;
     }
 }
 
 /**
- * @brief UART3遥控器回调函数
+ * @brief UART3遥控器回调函数, 在接收中断中只把帧放入邮箱
  *
- * @param Buffer UART3收到的消息
- * @param Length 长度
+ * @param Rx_Span UART3收到的消息
  */
-void UART_DR16_Call_Back(uint8_t *Buffer, uint16_t Length)  
+void UART_DR16_Call_Back(const Struct_UART_Rx_Span *Rx_Span)  
 {
-	dr16.UART_RxCpltCallback(Buffer);
+	dr16.UART_RxCpltCallback(Rx_Span);
 }
 
 
 /**
- * @brief TIM4任务回调函数
+ * @brief 输入任务, 本周期收到的遥控器帧与电机反馈统一在控制计算之前处理, 各电机的反馈属于同一时刻
  *
  */
-void Task1ms_TIM4_Callback()
-{    
-
-    //波形发生
-    float Waveform_Value = Waveform.Update();
+void Task_Input()
+{
+    dr16.TIM1ms_Process_PeriodElapsedCallback();
+    CAN_Rx_Dispatch(&hcan1);
+    CAN_Rx_Dispatch(&hcan2);
+}
 
-    // 底盘
-    //用定时器控制，控制频率为电机回传频率
+/**
+ * @brief 底盘任务, 控制频率为电机回传频率
+ *
+ */
+void Task_Chassis()
+{
     Chassis.Set_Gimbal_Angle(Gimbal.Get_Now_Yaw_Angle());
     Chassis.Set_Target_Velocity_X(dr16.Get_Left_Y() * Chassis.Get_Chassis_Max_Speed());
     Chassis.Set_Target_Velocity_Y(-dr16.Get_Left_X() * Chassis.Get_Chassis_Max_Speed());
     Chassis.Set_Target_Omega(dr16.Get_Yaw() * Chassis.Get_Chassis_Max_Omega());
-    Chassis.TIM_2ms_Control_PeriodElapsedCallback();
-    Chassis.TIM_2ms_Resolution_PeriodElapsedCallback();
+    Chassis.TIM_1ms_Control_PeriodElapsedCallback();
+    Chassis.TIM_1ms_Resolution_PeriodElapsedCallback();
+}
 
-    // 云台Yaw
-    //用定时器控制，控制频率为电机回传频率
+/**
+ * @brief 云台任务, 控制频率为电机回传频率, 含BMI088的SPI阻塞读取
+ *
+ */
+void Task_Gimbal()
+{
     //Gimbal.Set_Target_Yaw_Omega(-dr16.Get_Right_X() * 2 * PI );
     Gimbal.Set_Target_Yaw_Omega(-dr16.Get_Mouse_X()*50 * 2 * PI );
 	Gimbal.Motor_Yaw.Set_Feedforward_Omega(-Chassis.Get_Now_Omega());
 
     //计算云台相对底盘角速度，考虑pitch角度的投影
-    float gimbal_yaw_imu_omega = (Gimbal.IMU_Gimbal.Get_Gyro_Z()) * cosf(Gimbal.Get_Now_Pitch_Angle()) + (Gimbal.IMU_Gimbal.Get_Gyro_X()) * sinf(Gimbal.Get_Now_Pitch_Angle());
+    float sin_pitch, cos_pitch;
+    Math_Sin_Cos(Gimbal.Get_Now_Pitch_Angle(), &sin_pitch, &cos_pitch);
+    float gimbal_yaw_imu_omega = (Gimbal.IMU_Gimbal.Get_Gyro_Z()) * cos_pitch + (Gimbal.IMU_Gimbal.Get_Gyro_X()) * sin_pitch;
     float gimbal_yaw_extern_omega = gimbal_yaw_imu_omega - Chassis.Get_Now_Omega();
-    Gimbal.Motor_Yaw.Set_External_Omega(gimbal_yaw_extern_omega);
+    Gimbal.Motor_Yaw.Set_External_Omega(gimbal_yaw_extern_omega, Gimbal.IMU_Gimbal.Get_Timestamp_Us());
 
     // 云台Pitch
     // 用定时器控制，控制频率为电机回传频率
@@ -269,20 +307,26 @@ void Task1ms_TIM4_Callback()
     }
 	/**************************斜坡减速，防止pitch轴击打限位***********************************/
 		
-    // 1) 积分得到目标角（dt=0.001）
+    // 1) 按控制线程实测周期积分得到目标角
     float tmp_gimbal_pitch = Gimbal.Get_Target_Pitch_Angle();
-    tmp_gimbal_pitch += pitch_omega_cmd * 0.001f;
+    tmp_gimbal_pitch += pitch_omega_cmd * Control_Dt_s;
     Gimbal.Set_Target_Pitch_Angle(tmp_gimbal_pitch);
 
     // 2) 速度前馈
     Gimbal.Motor_Pitch.Set_Feedforward_Omega(pitch_omega_cmd);
 
-	Gimbal.Motor_Pitch.Set_External_Omega(-Gimbal.IMU_Gimbal.Get_Gyro_Y());
+	Gimbal.Motor_Pitch.Set_External_Omega(-Gimbal.IMU_Gimbal.Get_Gyro_Y(), Gimbal.IMU_Gimbal.Get_Timestamp_Us());
 
     Gimbal.TIM_1ms_Resolution_PeriodElapsedCallback();
     Gimbal.TIM_1ms_Control_PeriodElapsedCallback();
+}
 
-    //发射机构
+/**
+ * @brief 发射机构任务
+ *
+ */
+void Task_Booster()
+{
     // ===== Booster 遥控器逻辑 =====
     /*
     static int last_s2 = 0;
@@ -437,22 +481,62 @@ else if (s1 == DR16_Switch_Status_DOWN)
 
     // 运行 Booster
     Booster.TIM_1ms_Calculate_PeriodElapsedCallback();
-    
+}
+
+/**
+ * @brief CAN发送任务, 发送本周期各电机的控制报文
+ *
+ */
+void Task_CAN_Tx()
+{
     TIM_CAN_PeriodElapsedCallback();
+}
 
-    //serialplot调试
-    static int interaction_mod2 = 0;
-    interaction_mod2++;
-    if (interaction_mod2 == 2)
-    {
-        interaction_mod2 = 0;	
+/**
+ * @brief CAN总线统计任务, 周期为CAN_STATISTIC_PERIOD_MS
+ *
+ */
+void Task_CAN_Statistic()
+{
+    TIM_100ms_CAN_Statistic_PeriodElapsedCallback();
+}
+
+/**
+ * @brief 遥控器存活检测任务, 50ms
+ *
+ */
+void Task_DR16_Alive()
+{
+    dr16.TIM1msMod50_Alive_PeriodElapsedCallback();
+}
+
+/**
+ * @brief 电机存活检测任务, 100ms
+ *
+ */
+void Task_Motor_Alive()
+{
+    Chassis.TIM_100ms_Alive_PeriodElapsedCallback();
+    Gimbal.TIM_100ms_Alive_PeriodElapsedCallback();
+    Booster.TIM_100ms_Alive_PeriodElapsedCallback();
+}
+
+/**
+ * @brief 串口绘图任务, 2ms, 过载时放弃
+ *
+ */
+void Task_Serialplot()
+{
+    Serialplot_Command_Process();
 
-        float mouse_x = -dr16.Get_Mouse_X()*50 * 2 * PI ;
-        float Gimbal_Yaw_Now_Omega = Gimbal.Get_Now_Yaw_Omega();
+    float mouse_x = -dr16.Get_Mouse_X()*50 * 2 * PI ;
+    float Gimbal_Yaw_Now_Omega = Gimbal.Get_Now_Yaw_Omega();
 
-        float mouse_y = -dr16.Get_Mouse_Y()*50 * 2 * PI ;
-        float Gimbal_Pitch_Now_Omega = Gimbal.Get_Now_Pitch_Omega();
+    float mouse_y = -dr16.Get_Mouse_Y()*50 * 2 * PI ;
+    float Gimbal_Pitch_Now_Omega = Gimbal.Get_Now_Pitch_Omega();
 
+    if (Profiler_Export_Mode == 0 && CAN_Export_Mode == 0 && Scheduler_Export_Mode == 0 && Autotune_Export_Mode == 0)
+    {
         //serialplot调试
         serialplot.Set_Data(5,
             &Gimbal_Yaw_Now_Omega,
@@ -460,15 +544,117 @@ else if (s1 == DR16_Switch_Status_DOWN)
             &Gimbal_Pitch_Now_Omega,
             &mouse_y,
             &Waveform_Value
-        );				
+        );
+    }
+    else if (Profiler_Export_Mode != 0)
+    {
+        //耗时统计导出
+        uint8_t profiler_data_num;
+        if (Profiler_Export_Mode == 2)
+        {
+            Profiler.Reset();
+            Profiler_Export_Mode = 1;
+        }
+        if (Profiler_Export_Mode == 1)
+        {
+            profiler_data_num = Profiler.Export_Summary(Profiler_Export_Data, 20);
+        }
+        else
+        {
+            profiler_data_num = Profiler.Export_Histogram(Profiler_Export_Mode - 10, Profiler_Export_Data, 20);
+        }
+        serialplot.Set_Data_Array(profiler_data_num, Profiler_Export_Data);
+    }
+    else if (CAN_Export_Mode != 0)
+    {
+        //CAN总线统计导出
+        uint8_t can_data_num;
+        if (CAN_Export_Mode == 3)
+        {
+            CAN_Statistic_Reset();
+            CAN_Export_Mode = 1;
+        }
+        if (CAN_Export_Mode == 1 || CAN_Export_Mode == 2)
+        {
+            can_data_num = CAN_Statistic_Export_Summary(CAN_Export_Mode == 1 ? &hcan1 : &hcan2, CAN_Export_Data, 20);
+        }
+        else
+        {
+            can_data_num = CAN_Statistic_Export_Jitter(CAN_Export_Mode - 10, CAN_Export_Data, 20);
+        }
+        serialplot.Set_Data_Array(can_data_num, CAN_Export_Data);
+    }
+    else if (Scheduler_Export_Mode != 0)
+    {
+        //调度统计导出
+        if (Scheduler_Export_Mode == 2)
+        {
+            Scheduler.Reset();
+            Scheduler_Export_Mode = 1;
+        }
+        uint8_t scheduler_data_num = Scheduler.Export_Summary(Scheduler_Export_Data, 20);
+        serialplot.Set_Data_Array(scheduler_data_num, Scheduler_Export_Data);
+    }
+    else
+    {
+        //自整定进度与结果导出
+        uint8_t autotune_data_num = Booster.Autotuner.Export_Summary(Autotune_Export_Data, 20, Autotune_Export_Rule);
+        serialplot.Set_Data_Array(autotune_data_num, Autotune_Export_Data);
+    }
 
-        serialplot.TIM_Write_PeriodElapsedCallback();
-        TIM_UART_PeriodElapsedCallback();
+    serialplot.TIM_Write_PeriodElapsedCallback();
+    TIM_UART_PeriodElapsedCallback();
 
-    }
+}
 
+/**
+ * @brief TIM4任务回调函数, 只记录节拍时刻并挂起控制线程
+ *
+ */
+void Task1ms_TIM4_Callback()
+{    
+    Control_Tick_Cycle = DWT_Get_Cycle();
+    Control_Tick_Us = DWT_Get_Us();
+    Control_Tick_Pending++;
+    SWI_Trigger();
 }
 
+/**
+ * @brief 控制线程, 在PendSV中运行, 由调度器运行本节拍到期的任务, 可被CAN、UART与TIM4中断抢占
+ *
+ */
+void Task_Control_Thread()
+{
+    //关中断取走节拍, 运行期间到达的节拍会再次挂起PendSV, 返回后咬尾进入
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint32_t release_cycle = Control_Tick_Cycle;
+    uint32_t release_us = Control_Tick_Us;
+    uint32_t pending = Control_Tick_Pending;
+    Control_Tick_Pending = 0;
+    __set_PRIMASK(primask);
+
+    if (pending == 0)
+    {
+        return;
+    }
+    //积压的节拍只运行一次, 任务周期以控制线程运行的次数计
+    Control_Tick_Missed_Num += pending - 1;
+
+    //实测周期, 合并节拍时自然变长, 长时间停顿后限幅防止积分跳变
+    if (Control_Pre_Tick_Valid == true)
+    {
+        Control_Dt_s = DWT_Us_Diff_To_s(release_us, Control_Pre_Tick_Us);
+        Math_Constrain(&Control_Dt_s, 0.0f, 0.005f);
+    }
+    Control_Pre_Tick_Us = release_us;
+    Control_Pre_Tick_Valid = true;
+
+    //波形发生
+    Waveform_Value = Waveform.Update(0.0f, Control_Dt_s);
+
+    Scheduler.Tick(release_cycle);
+}
 
 /**
  * @brief 初始化任务
@@ -476,16 +662,33 @@ else if (s1 == DR16_Switch_Status_DOWN)
  */
 void Task_Init()
 {
-    //CAN总线初始化
-	CAN_Init(&hcan1,CAN1_Callback_Function);
-    CAN_Init(&hcan2,CAN2_Callback_Function);
+    //CAN总线初始化, 电机反馈报文在各电机Init中按ID登记, 无需回调函数
+	CAN_Init(&hcan1,NULL);
+    CAN_Init(&hcan2,NULL);
     //UART初始化
 	UART_Init(&huart1, UART_Serialplot_Call_Back, 100);
 	UART_Init(&huart3,UART_DR16_Call_Back,18);
 	//TIM初始化
 	TIM_Init(&htim4,Task1ms_TIM4_Callback);
+    //控制线程初始化, PendSV为最低优先级
+    SWI_Init(Task_Control_Thread);
     //serialplot初始化
-	serialplot.Init(&huart1,20,(char **)Serialplot_Variable_Assignment_List);
+	serialplot.Init(&huart1,sizeof(Serialplot_Variable_Assignment_List) / SERIALPLOT_RX_VARIABLE_ASSIGNMENT_MAX_LENGTH,(char **)Serialplot_Variable_Assignment_List);
+    //耗时统计与调度初始化, 节拍预算为1ms
+    DWT_Init();
+    Profiler.Init(DWT_CPU_FREQUENCY / 1000U);
+    Scheduler.Init(&Profiler);
+    //控制链路每节拍按顺序运行, 截止时间为从TIM4中断到运行完的时间
+    Scheduler.Add_Task("input", Task_Input, 1, Scheduler_Priority_CRITICAL, 200.0f);
+    Scheduler.Add_Task("chassis", Task_Chassis, 1, Scheduler_Priority_CRITICAL, 400.0f);
+    Scheduler.Add_Task("gimbal", Task_Gimbal, 1, Scheduler_Priority_CRITICAL, 700.0f);
+    Scheduler.Add_Task("booster", Task_Booster, 1, Scheduler_Priority_CRITICAL, 800.0f);
+    Scheduler.Add_Task("can_tx", Task_CAN_Tx, 1, Scheduler_Priority_CRITICAL, 900.0f);
+    //多节拍任务自动错开相位
+    Scheduler.Add_Task("can_stat", Task_CAN_Statistic, CAN_STATISTIC_PERIOD_MS, Scheduler_Priority_NORMAL, 1000.0f);
+    Scheduler.Add_Task("dr16_alive", Task_DR16_Alive, 50, Scheduler_Priority_NORMAL, 1000.0f);
+    Scheduler.Add_Task("motor_alive", Task_Motor_Alive, 100, Scheduler_Priority_NORMAL, 1000.0f);
+    Scheduler.Add_Task("serialplot", Task_Serialplot, 2, Scheduler_Priority_LOW, 1000.0f);
     //waveform初始化
     Waveform.Init();
     Waveform.Noise(0.02f);
@@ -499,6 +702,20 @@ void Task_Init()
 	Gimbal.Init();
     //booster初始化
     Booster.Init();
+    //CAN接收登记检查, 有ID冲突时会有电机收不到反馈, 长鸣后复位
+    if (CAN_Get_Register_Error_Num() != 0)
+    {
+        for(int i=0;i<5;i++)
+        {
+            dvc_buzzer_SetOn();
+            HAL_Delay(500);
+            dvc_buzzer_SetOff();
+            HAL_Delay(200);
+        }
+        HAL_NVIC_SystemReset();
+    }
+    //按登记的ID配置CAN硬件过滤器, 其他节点的报文不再进入接收中断
+    CAN_Filter_Apply();
 	// 使能调度时钟
 	HAL_TIM_Base_Start_IT(&htim4);
     //Laser启动